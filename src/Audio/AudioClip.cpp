@@ -31,6 +31,10 @@ namespace GameEngine {
             return true;
         }
         
+        return Decode(filepath) && CreateBuffer();
+    }
+    
+    bool AudioClip::Decode(const std::string& filepath) {
         m_filepath = filepath;
         
         std::string extension = filepath.substr(filepath.find_last_of('.') + 1);
@@ -46,6 +50,38 @@ namespace GameEngine {
         }
     }
     
+    bool AudioClip::CreateBuffer() {
+        if (m_loaded) {
+            return true;
+        }
+        if (m_data.empty()) {
+            Logger::Error("No decoded audio data to upload: " + m_filepath);
+            return false;
+        }
+        
+#ifdef OPENAL_AVAILABLE
+        alGenBuffers(1, &m_bufferID);
+        ALenum format;
+        if (m_channels == 1) {
+            format = (m_bitsPerSample == 8) ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
+        } else {
+            format = (m_bitsPerSample == 8) ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
+        }
+        alBufferData(m_bufferID, format, m_data.data(), static_cast<ALsizei>(m_data.size()), m_sampleRate);
+        
+        ALenum error = alGetError();
+        if (error != AL_NO_ERROR) {
+            Logger::Error("OpenAL error loading audio buffer for " + m_filepath + ": " + std::to_string(error));
+            alDeleteBuffers(1, &m_bufferID);
+            m_bufferID = 0;
+            return false;
+        }
+#endif
+        
+        m_loaded = true;
+        return true;
+    }
+    
     void AudioClip::Unload() {
         if (!m_loaded) return;
         
@@ -137,27 +173,7 @@ namespace GameEngine {
         
         CalculateDuration();
         
-#ifdef OPENAL_AVAILABLE
-        alGenBuffers(1, &m_bufferID);
-        ALenum format;
-        if (m_channels == 1) {
-            format = (m_bitsPerSample == 8) ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
-        } else {
-            format = (m_bitsPerSample == 8) ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
-        }
-        alBufferData(m_bufferID, format, m_data.data(), static_cast<ALsizei>(m_data.size()), m_sampleRate);
-        
-        ALenum error = alGetError();
-        if (error != AL_NO_ERROR) {
-            Logger::Error("OpenAL error loading WAV buffer: " + std::to_string(error));
-            alDeleteBuffers(1, &m_bufferID);
-            m_bufferID = 0;
-            return false;
-        }
-#endif
-        
-        m_loaded = true;
-        Logger::Info("Loaded WAV file: " + filepath + 
+        Logger::Info("Decoded WAV file: " + filepath + 
                     " (" + std::to_string(m_channels) + " channels, " +
                     std::to_string(m_sampleRate) + " Hz, " +
                     std::to_string(m_bitsPerSample) + " bits, " +
@@ -231,22 +247,7 @@ namespace GameEngine {
         
         CalculateDuration();
         
-#ifdef OPENAL_AVAILABLE
-        alGenBuffers(1, &m_bufferID);
-        ALenum format = (m_channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-        alBufferData(m_bufferID, format, m_data.data(), static_cast<ALsizei>(m_data.size()), m_sampleRate);
-        
-        ALenum error = alGetError();
-        if (error != AL_NO_ERROR) {
-            Logger::Error("OpenAL error loading MP3 buffer: " + std::to_string(error));
-            alDeleteBuffers(1, &m_bufferID);
-            m_bufferID = 0;
-            return false;
-        }
-#endif
-        
-        m_loaded = true;
-        Logger::Info("Loaded MP3 file: " + filepath + 
+        Logger::Info("Decoded MP3 file: " + filepath + 
                      " (" + std::to_string(m_channels) + " channels, " +
                      std::to_string(m_sampleRate) + " Hz, " +
                      std::to_string(m_bitsPerSample) + " bits, " +
@@ -18,6 +18,10 @@ namespace GameEngine {
         ~AudioClip();
         
         bool LoadFromFile(const std::string& filepath);
+        // The two halves of LoadFromFile: Decode reads and decodes into memory on any thread,
+        // CreateBuffer hands the samples to OpenAL and marks the clip loaded
+        bool Decode(const std::string& filepath);
+        bool CreateBuffer();
         void Unload();
         
         // Audio data access
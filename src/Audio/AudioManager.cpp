@@ -3,6 +3,7 @@
 #include "AudioSource.h"
 #include "../Core/Logging/Logger.h"
 #include "../Core/Profiling/Profiler.h"
+#include "../Core/Streaming/AssetStreamer.h"
 #ifdef OPENAL_AVAILABLE
 #include <AL/al.h>
 #include <AL/alc.h>
@@ -189,6 +190,59 @@ namespace GameEngine {
         }
     }
     
+    std::shared_future<AudioClip*> AudioManager::LoadAudioClipAsync(const std::string& filepath) {
+        std::promise<AudioClip*> ready;
+        if (!m_initialized) {
+            Logger::Warning("AudioManager not initialized");
+            ready.set_value(nullptr);
+            return ready.get_future().share();
+        }
+        
+        auto it = m_audioClips.find(filepath);
+        if (it != m_audioClips.end()) {
+            ready.set_value(it->second.get());
+            return ready.get_future().share();
+        }
+        auto pendingIt = m_pendingClips.find(filepath);
+        if (pendingIt != m_pendingClips.end()) {
+            return pendingIt->second;
+        }
+        
+        auto promise = std::make_shared<std::promise<AudioClip*>>();
+        std::shared_future<AudioClip*> future = promise->get_future().share();
+        m_pendingClips[filepath] = future;
+        
+        std::weak_ptr<AudioManager*> self = m_self;
+        AssetStreamer::Instance().Submit([self, filepath, promise]() {
+            auto clip = std::make_shared<std::unique_ptr<AudioClip>>(std::make_unique<AudioClip>());
+            bool decoded = (*clip)->Decode(filepath);
+            size_t bytes = decoded ? (*clip)->GetData().size() : 0;
+            AssetStreamer::Instance().EnqueueUpload(bytes, [self, filepath, promise, clip, decoded]() {
+                auto manager = self.lock();
+                if (!manager) {
+                    promise->set_value(nullptr);
+                    return;
+                }
+                AudioManager* owner = *manager;
+                owner->m_pendingClips.erase(filepath);
+                
+                auto existing = owner->m_audioClips.find(filepath);
+                if (existing != owner->m_audioClips.end()) {
+                    promise->set_value(existing->second.get());
+                } else if (decoded && owner->m_initialized && (*clip)->CreateBuffer()) {
+                    AudioClip* clipPtr = clip->get();
+                    owner->m_audioClips[filepath] = std::move(*clip);
+                    Logger::Info("Streamed audio clip: " + filepath);
+                    promise->set_value(clipPtr);
+                } else {
+                    Logger::Error("Failed to stream audio clip: " + filepath);
+                    promise->set_value(nullptr);
+                }
+            });
+        });
+        return future;
+    }
+    
     void AudioManager::UnloadAudioClip(const std::string& filepath) {
         auto it = m_audioClips.find(filepath);
         if (it != m_audioClips.end()) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -29,6 +30,9 @@ namespace GameEngine {
         
         // Audio clip management
         AudioClip* LoadAudioClip(const std::string& filepath);
+        // Decodes on an AssetStreamer worker and creates the buffer during the next upload
+        // pass; the future yields the cached clip, or nullptr if decoding failed
+        std::shared_future<AudioClip*> LoadAudioClipAsync(const std::string& filepath);
         void UnloadAudioClip(const std::string& filepath);
         
         // Audio source management
@@ -55,6 +59,9 @@ namespace GameEngine {
         Vector3 m_listenerUp = Vector3(0, 1, 0);
         
         std::unordered_map<std::string, std::unique_ptr<AudioClip>> m_audioClips;
+        std::unordered_map<std::string, std::shared_future<AudioClip*>> m_pendingClips;
+        // Streamed uploads hold a weak reference so they are skipped once the manager is gone
+        std::shared_ptr<AudioManager*> m_self = std::make_shared<AudioManager*>(this);
         std::vector<std::unique_ptr<AudioSource>> m_audioSources;
         
         // OpenAL context (will be implemented as void* for now)
@@ -0,0 +1,35 @@
+#include "CharacterControllerComponent.h"
+#include "../../Physics/PhysicsWorld.h"
+
+namespace GameEngine {
+
+CharacterControllerComponent::CharacterControllerComponent()
+    : m_controller(std::make_unique<CharacterController>()) {
+}
+
+CharacterControllerComponent::CharacterControllerComponent(PhysicsWorld* physicsWorld)
+    : m_controller(std::make_unique<CharacterController>()), m_physicsWorld(physicsWorld) {
+    if (m_physicsWorld && m_controller) {
+        m_physicsWorld->AddCharacterController(m_controller.get());
+    }
+}
+
+CharacterControllerComponent::~CharacterControllerComponent() {
+    if (m_physicsWorld && m_controller) {
+        m_physicsWorld->RemoveCharacterController(m_controller.get());
+    }
+}
+
+void CharacterControllerComponent::SetPhysicsWorld(PhysicsWorld* physicsWorld) {
+    if (m_physicsWorld && m_controller) {
+        m_physicsWorld->RemoveCharacterController(m_controller.get());
+    }
+    
+    m_physicsWorld = physicsWorld;
+    
+    if (m_physicsWorld && m_controller) {
+        m_physicsWorld->AddCharacterController(m_controller.get());
+    }
+}
+
+}
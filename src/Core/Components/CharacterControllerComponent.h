@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../ECS/Component.h"
+#include "../../Physics/Character/CharacterController.h"
+#include <memory>
+
+namespace GameEngine {
+    class PhysicsWorld;
+    
+    // Kinematic alternative to RigidBodyComponent for players and NPCs. The controller is
+    // stepped by PhysicsWorld and its position is copied to the transform by PhysicsSystem.
+    class CharacterControllerComponent : public Component<CharacterControllerComponent> {
+    public:
+        CharacterControllerComponent();
+        CharacterControllerComponent(PhysicsWorld* physicsWorld);
+        ~CharacterControllerComponent();
+        
+        CharacterController* GetController() const { return m_controller.get(); }
+        void SetPhysicsWorld(PhysicsWorld* physicsWorld);
+        
+        float jumpSpeed = 5.0f;
+        
+    private:
+        std::unique_ptr<CharacterController> m_controller;
+        PhysicsWorld* m_physicsWorld = nullptr;
+    };
+}
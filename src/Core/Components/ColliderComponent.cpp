@@ -107,6 +107,12 @@ void ColliderComponent::GenerateFromMesh(MeshComponent* meshComponent, ColliderS
             break;
         }
         case ColliderShapeType::ConvexHull: {
+            if (!mesh->GetCollisionPositions().empty()) {
+                SetConvexHullCollider(mesh->GetCollisionPositions());
+                Logger::Info("Generated convex hull collider from " + std::to_string(mesh->GetCollisionPositions().size()) +
+                            " baked collision positions");
+                break;
+            }
             std::vector<Vector3> positions;
             positions.reserve(vertices.size());
             
@@ -120,6 +126,12 @@ void ColliderComponent::GenerateFromMesh(MeshComponent* meshComponent, ColliderS
             break;
         }
         case ColliderShapeType::TriangleMesh: {
+            if (!mesh->GetCollisionPositions().empty()) {
+                SetTriangleMeshCollider(mesh->GetCollisionPositions(), mesh->GetCollisionIndices());
+                Logger::Info("Generated triangle mesh collider from " + std::to_string(mesh->GetCollisionPositions().size()) +
+                            " baked collision positions and " + std::to_string(mesh->GetCollisionIndices().size()) + " indices");
+                break;
+            }
             std::vector<Vector3> positions;
             positions.reserve(vertices.size());
             
@@ -4,6 +4,7 @@
 #include "../../Physics/Colliders/ColliderShape.h"
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 namespace GameEngine {
     class TransformComponent;
@@ -47,11 +48,17 @@ namespace GameEngine {
         TransformComponent* GetOwnerTransform() const { return m_ownerTransform; }
         
     private:
+        friend class PhysicsWorld;
+        static constexpr uint32_t InvalidStaticIndex = 0xFFFFFFFFu;
+        
         std::shared_ptr<ColliderShape> m_colliderShape;
         bool m_isTrigger = false;
         float m_restitution = 0.5f;
         float m_friction = 0.5f;
 
         TransformComponent* m_ownerTransform = nullptr;
+        
+        // Slot in PhysicsWorld's static collider list, maintained by the world for O(1) membership
+        uint32_t m_staticIndex = InvalidStaticIndex;
     };
 }
@@ -1,5 +1,7 @@
 #include "MeshComponent.h"
 #include "../Logging/Logger.h"
+#include "../../Rendering/Core/AssetCache.h"
+#include "../../Rendering/Core/TextureAtlas.h"
 
 namespace GameEngine {
     MeshComponent::MeshComponent() {
@@ -26,21 +28,77 @@ namespace GameEngine {
         
         m_mesh = mesh;
         m_meshType = "custom";
+        m_pendingMesh = AssetHandle<Mesh>();
         Logger::Debug("MeshComponent mesh set to custom mesh");
     }
     
     void MeshComponent::SetMesh(const std::string& meshType) {
         m_meshType = meshType;
+        m_pendingMesh = AssetHandle<Mesh>();
         CreateMeshFromType(meshType);
     }
     
+    void MeshComponent::SetMeshAsync(const std::string& meshType) {
+        // Primitives and unknown types are cheap, and resolve exactly as SetMesh does
+        if (meshType.substr(0, 4) != "obj:" && meshType.substr(0, 5) != "mesh:") {
+            SetMesh(meshType);
+            return;
+        }
+        
+        AssetHandle<Mesh> handle = AssetCache::Instance().GetMeshAsync(meshType);
+        m_meshType = meshType;
+        m_pendingMesh = handle;
+        if (!handle.IsReady()) {
+            // Keep showing the current mesh rather than flashing the placeholder
+            if (!m_mesh) {
+                m_mesh = handle.GetPlaceholder();
+            }
+            Logger::Debug("Streaming mesh " + meshType);
+        }
+        ResolvePendingMesh();
+    }
+    
+    bool MeshComponent::SetAtlasRegion(std::shared_ptr<TextureAtlas> atlas, const std::string& regionName) {
+        const TextureAtlas::Region* region = atlas ? atlas->GetRegion(regionName) : nullptr;
+        if (!region) {
+            Logger::Warning("MeshComponent: atlas has no region " + regionName);
+            return false;
+        }
+        m_uvTransform = region->uvTransform;
+        m_atlas = std::move(atlas);
+        return true;
+    }
+    
+    void MeshComponent::ClearAtlasRegion() {
+        m_atlas.reset();
+        m_uvTransform = Vector4(1.0f, 1.0f, 0.0f, 0.0f);
+    }
+    
+    std::shared_ptr<Texture> MeshComponent::GetAlbedoTexture() const {
+        return m_atlas ? m_atlas->GetTexture() : nullptr;
+    }
+    
+    void MeshComponent::ResolvePendingMesh() const {
+        if (!m_pendingMesh.IsReady()) {
+            return;
+        }
+        if (m_pendingMesh.IsLoaded()) {
+            m_mesh = m_pendingMesh.Get();
+        } else {
+            Logger::Error("Failed to stream mesh " + m_meshType + ", keeping current mesh");
+        }
+        m_pendingMesh = AssetHandle<Mesh>();
+    }
+    
     void MeshComponent::LoadMeshFromOBJ(const std::string& filepath) {
         try {
-            auto loadedMesh = std::make_shared<Mesh>(Mesh::LoadFromOBJ(filepath));
+            // Every component loading the same file shares one Mesh and its GPU buffers
+            auto loadedMesh = AssetCache::Instance().GetMesh("obj:" + filepath);
             
-            if (loadedMesh && loadedMesh->GetVertices().size() > 0) {
+            if (loadedMesh && loadedMesh->GetVertexCount() > 0) {
                 m_mesh = loadedMesh;
                 m_meshType = "obj:" + filepath;
+                m_pendingMesh = AssetHandle<Mesh>();
                 Logger::Info("Successfully loaded OBJ mesh from: " + filepath);
             } else {
                 Logger::Error("Failed to load OBJ mesh from: " + filepath + ", keeping current mesh");
@@ -53,26 +111,19 @@ namespace GameEngine {
     
     void MeshComponent::CreateMeshFromType(const std::string& meshType) {
         try {
-            if (meshType == "cube") {
-                m_mesh = std::make_shared<Mesh>(Mesh::CreateCube(1.0f));
-                Logger::Debug("Created cube mesh for MeshComponent");
-            }
-            else if (meshType == "sphere") {
-                m_mesh = std::make_shared<Mesh>(Mesh::CreateSphere(1.0f, 32));
-                Logger::Debug("Created sphere mesh for MeshComponent");
-            }
-            else if (meshType == "plane") {
-                m_mesh = std::make_shared<Mesh>(Mesh::CreatePlane(1.0f, 1.0f));
-                Logger::Debug("Created plane mesh for MeshComponent");
-            }
-            else if (meshType.substr(0, 4) == "obj:") {
+            if (meshType.substr(0, 4) == "obj:") {
                 std::string filepath = meshType.substr(4);
                 LoadMeshFromOBJ(filepath);
                 return; // LoadMeshFromOBJ handles logging
             }
-            else {
+            
+            // Built-in primitives are shared through the asset cache, so N spheres are one Mesh
+            m_mesh = AssetCache::Instance().GetMesh(meshType);
+            if (m_mesh) {
+                Logger::Debug("Using shared " + meshType + " mesh for MeshComponent");
+            } else {
                 Logger::Warning("Unknown mesh type: " + meshType + ", defaulting to cube");
-                m_mesh = std::make_shared<Mesh>(Mesh::CreateCube(1.0f));
+                m_mesh = AssetCache::Instance().GetMesh("cube");
                 m_meshType = "cube";
             }
             
@@ -82,7 +133,7 @@ namespace GameEngine {
         }
         catch (const std::exception& e) {
             Logger::Error("Exception creating mesh of type " + meshType + ": " + e.what());
-            m_mesh = std::make_shared<Mesh>(Mesh::CreateCube(1.0f));
+            m_mesh = AssetCache::Instance().GetMesh("cube");
             m_meshType = "cube";
             if (m_mesh && !m_mesh->IsUploaded()) {
                 m_mesh->Upload();
@@ -2,10 +2,15 @@
 
 #include "../ECS/Component.h"
 #include "../../Rendering/Meshes/Mesh.h"
+#include "../Streaming/AssetStreamer.h"
+#include "../Math/Vector4.h"
 #include <memory>
 #include <string>
 
 namespace GameEngine {
+    class TextureAtlas;
+    class Texture;
+
     class MeshComponent : public Component<MeshComponent> {
     public:
         MeshComponent();
@@ -18,8 +23,19 @@ namespace GameEngine {
         void SetMesh(const std::string& meshType);
         void LoadMeshFromOBJ(const std::string& filepath);
         
-        std::shared_ptr<Mesh> GetMesh() const { return m_mesh; }
-        bool HasMesh() const { return m_mesh != nullptr; }
+        // Streams "obj:"/"mesh:" types in the background and shows the placeholder cube until
+        // the mesh is uploaded; GetMesh() switches over on the first call after that
+        void SetMeshAsync(const std::string& meshType);
+        void LoadMeshFromOBJAsync(const std::string& filepath) { SetMeshAsync("obj:" + filepath); }
+        bool IsMeshStreaming() const { return m_pendingMesh.IsValid(); }
+        
+        std::shared_ptr<Mesh> GetMesh() const {
+            if (m_pendingMesh.IsValid()) {
+                ResolvePendingMesh();
+            }
+            return m_mesh;
+        }
+        bool HasMesh() const { return GetMesh() != nullptr; }
         
         // Rendering properties
         bool IsVisible() const { return m_visible; }
@@ -35,11 +51,23 @@ namespace GameEngine {
         float GetRoughness() const { return m_roughness; }
         void SetRoughness(float roughness) { m_roughness = roughness; }
         
+        // Albedo from a region of a shared atlas: the mesh's UVs are remapped into the region
+        // per instance, so props using the same atlas and mesh draw as one batch. False and
+        // unchanged if the atlas has no such region.
+        bool SetAtlasRegion(std::shared_ptr<TextureAtlas> atlas, const std::string& regionName);
+        void ClearAtlasRegion();
+        const std::shared_ptr<TextureAtlas>& GetAtlas() const { return m_atlas; }
+        std::shared_ptr<Texture> GetAlbedoTexture() const;
+        // (1, 1, 0, 0) without an atlas
+        const Vector4& GetUVTransform() const { return m_uvTransform; }
+        
         // Mesh type for serialization
         const std::string& GetMeshType() const { return m_meshType; }
         
     private:
-        std::shared_ptr<Mesh> m_mesh;
+        // Mutable so a const GetMesh() can swap in a finished stream
+        mutable std::shared_ptr<Mesh> m_mesh;
+        mutable AssetHandle<Mesh> m_pendingMesh;
         std::string m_meshType;
         bool m_visible = true;
         
@@ -47,7 +75,10 @@ namespace GameEngine {
         Vector3 m_color = Vector3(1.0f, 1.0f, 1.0f);
         float m_metallic = 0.0f;
         float m_roughness = 0.5f;
+        std::shared_ptr<TextureAtlas> m_atlas;
+        Vector4 m_uvTransform = Vector4(1.0f, 1.0f, 0.0f, 0.0f);
         
         void CreateMeshFromType(const std::string& meshType);
+        void ResolvePendingMesh() const;
     };
 }
@@ -33,6 +33,14 @@ void RigidBodyComponent::SetPhysicsWorld(PhysicsWorld* physicsWorld) {
     }
 }
 
+void RigidBodyComponent::SetPhysicsWorldDeferred(PhysicsWorld* physicsWorld) {
+    if (m_physicsWorld && m_rigidBody) {
+        m_physicsWorld->RemoveRigidBody(m_rigidBody.get());
+    }
+    
+    m_physicsWorld = physicsWorld;
+}
+
 void RigidBodyComponent::SetColliderComponent(ColliderComponent* colliderComponent) {
     m_colliderComponent = colliderComponent;
     
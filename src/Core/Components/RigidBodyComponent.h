@@ -15,6 +15,10 @@ namespace GameEngine {
         
         RigidBody* GetRigidBody() const { return m_rigidBody.get(); }
         void SetPhysicsWorld(PhysicsWorld* physicsWorld);
+        // Records the world without registering the body; the caller adds it later as part
+        // of a PhysicsWorld::AddRigidBodies batch (see World::BeginBulkLoad)
+        void SetPhysicsWorldDeferred(PhysicsWorld* physicsWorld);
+        PhysicsWorld* GetPhysicsWorld() const { return m_physicsWorld; }
         
         // Collider integration
         void SetColliderComponent(class ColliderComponent* colliderComponent);
@@ -1,5 +1,6 @@
 #include "World.h"
 #include "../Logging/Logger.h"
+#include "../../Physics/PhysicsWorld.h"
 
 namespace GameEngine {
 
@@ -40,6 +41,25 @@ bool World::IsEntityValid(Entity entity) const {
     return std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end();
 }
 
+void World::EndBulkLoad() {
+    if (m_bulkLoadDepth == 0 || --m_bulkLoadDepth > 0) return;
+    
+    // Entities are looked up again since some may have been destroyed during the load
+    std::vector<RigidBody*> bodies;
+    bodies.reserve(m_pendingRigidBodies.size());
+    for (Entity entity : m_pendingRigidBodies) {
+        auto* component = GetComponent<RigidBodyComponent>(entity);
+        if (component && component->GetRigidBody() && component->GetPhysicsWorld() == m_physicsWorld) {
+            bodies.push_back(component->GetRigidBody());
+        }
+    }
+    m_pendingRigidBodies.clear();
+    
+    if (m_physicsWorld && !bodies.empty()) {
+        m_physicsWorld->AddRigidBodies(bodies);
+    }
+}
+
 void World::Update(float deltaTime) {
     for (auto& system : m_systems) {
         system->Update(this, deltaTime);
@@ -4,6 +4,7 @@
 #include "Component.h"
 #include "System.h"
 #include "../Components/RigidBodyComponent.h"
+#include "../Components/CharacterControllerComponent.h"
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -49,6 +50,28 @@ namespace GameEngine {
         void SetPhysicsWorld(PhysicsWorld* physicsWorld) { m_physicsWorld = physicsWorld; }
         PhysicsWorld* GetPhysicsWorld() const { return m_physicsWorld; }
         
+        // Rigid bodies added while a bulk load is open are registered in one AddRigidBodies
+        // batch when the outermost load ends, so a scene load builds the broadphase once.
+        // Loads nest; prefer BulkLoadScope so a load that throws still ends.
+        void BeginBulkLoad() { ++m_bulkLoadDepth; }
+        void EndBulkLoad();
+        bool IsBulkLoading() const { return m_bulkLoadDepth > 0; }
+        
+        class BulkLoadScope {
+        public:
+            explicit BulkLoadScope(World* world) : m_world(world) {
+                if (m_world) m_world->BeginBulkLoad();
+            }
+            ~BulkLoadScope() {
+                if (m_world) m_world->EndBulkLoad();
+            }
+            BulkLoadScope(const BulkLoadScope&) = delete;
+            BulkLoadScope& operator=(const BulkLoadScope&) = delete;
+            
+        private:
+            World* m_world;
+        };
+        
     private:
         EntityID m_nextEntityID = 1;
         std::vector<Entity> m_entities;
@@ -56,6 +79,8 @@ namespace GameEngine {
         std::vector<std::unique_ptr<ISystem>> m_systems;
         std::unordered_map<std::type_index, ISystem*> m_systemMap;
         PhysicsWorld* m_physicsWorld = nullptr;
+        int m_bulkLoadDepth = 0;
+        std::vector<Entity> m_pendingRigidBodies;
     };
     
     // Template implementations
@@ -76,7 +101,11 @@ namespace GameEngine {
         if (!IsEntityValid(entity)) return nullptr;
         
         std::unique_ptr<RigidBodyComponent> component;
-        if (m_physicsWorld) {
+        if (m_physicsWorld && IsBulkLoading()) {
+            component = std::make_unique<RigidBodyComponent>();
+            component->SetPhysicsWorldDeferred(m_physicsWorld);
+            m_pendingRigidBodies.push_back(entity);
+        } else if (m_physicsWorld) {
             component = std::make_unique<RigidBodyComponent>(m_physicsWorld);
         } else {
             component = std::make_unique<RigidBodyComponent>();
@@ -87,6 +116,23 @@ namespace GameEngine {
         return componentPtr;
     }
     
+    // Specialization for CharacterControllerComponent to pass PhysicsWorld
+    template<>
+    inline CharacterControllerComponent* World::AddComponent<CharacterControllerComponent>(Entity entity) {
+        if (!IsEntityValid(entity)) return nullptr;
+        
+        std::unique_ptr<CharacterControllerComponent> component;
+        if (m_physicsWorld) {
+            component = std::make_unique<CharacterControllerComponent>(m_physicsWorld);
+        } else {
+            component = std::make_unique<CharacterControllerComponent>();
+        }
+        
+        CharacterControllerComponent* componentPtr = component.get();
+        m_components[entity.GetID()][GetComponentTypeID<CharacterControllerComponent>()] = std::move(component);
+        return componentPtr;
+    }
+    
     template<typename T>
     T* World::GetComponent(Entity entity) {
         if (!IsEntityValid(entity)) return nullptr;
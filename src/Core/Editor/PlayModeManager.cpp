@@ -6,6 +6,8 @@
 #include "../Components/TransformComponent.h"
 #include "../Components/MovementComponent.h"
 #include "../Components/RigidBodyComponent.h"
+#include "../Components/CharacterControllerComponent.h"
+#include "../../Physics/PhysicsWorld.h"
 #include <GLFW/glfw3.h>
 
 namespace GameEngine {
@@ -95,6 +97,13 @@ namespace GameEngine {
         if (m_currentMode == EditorMode::Edit) {
             SaveSceneState();
             InitializePhysicsFromTransforms();
+            
+            // Snapshot after the bodies were synced so exiting play mode restores the exact start state
+            m_hasPhysicsSnapshot = false;
+            if (PhysicsWorld* physicsWorld = m_world->GetPhysicsWorld()) {
+                physicsWorld->SaveSnapshot(m_physicsSnapshot);
+                m_hasPhysicsSnapshot = true;
+            }
         }
         
         Timer::Reset();
@@ -192,6 +201,12 @@ namespace GameEngine {
             return;
         }
         
+        PhysicsWorld* physicsWorld = m_world->GetPhysicsWorld();
+        bool physicsRestored = m_hasPhysicsSnapshot && physicsWorld && physicsWorld->RestoreSnapshot(m_physicsSnapshot);
+        if (m_hasPhysicsSnapshot && !physicsRestored) {
+            Logger::Warning("Physics snapshot could not be restored, resetting body velocities instead");
+        }
+        
         for (const auto& entityState : m_savedSceneState.entities) {
             Entity entity = Entity(entityState.entityId);
             
@@ -217,7 +232,7 @@ namespace GameEngine {
                 }
                 
                 auto* rigidBodyComp = m_world->GetComponent<RigidBodyComponent>(entity);
-                if (rigidBodyComp) {
+                if (rigidBodyComp && !physicsRestored) {
                     RigidBody* rigidBody = rigidBodyComp->GetRigidBody();
                     if (rigidBody) {
                         rigidBody->SetVelocity(Vector3::Zero);
@@ -277,6 +292,13 @@ namespace GameEngine {
                     initializedCount++;
                 }
             }
+            
+            auto* characterComp = m_world->GetComponent<CharacterControllerComponent>(entity);
+            if (transformComp && characterComp && characterComp->GetController()) {
+                characterComp->GetController()->SetPosition(transformComp->transform.GetPosition());
+                characterComp->GetController()->SetVerticalSpeed(0.0f);
+                initializedCount++;
+            }
         }
         
         Logger::Info("Initialized " + std::to_string(initializedCount) + " RigidBody positions from TransformComponents");
@@ -4,6 +4,7 @@
 #include <vector>
 #include "../Math/Vector3.h"
 #include "../Math/Quaternion.h"
+#include "../../Physics/PhysicsSnapshot.h"
 
 namespace GameEngine {
     class World;
@@ -70,6 +71,10 @@ namespace GameEngine {
             std::vector<EntityState> entities;
         } m_savedSceneState;
         
+        // Physics state at the moment play mode started; restored in one pass on exit
+        PhysicsSnapshot m_physicsSnapshot;
+        bool m_hasPhysicsSnapshot = false;
+        
         bool m_initialized = false;
     };
 }
@@ -19,9 +19,11 @@
 #include "Scenes/TestSceneManager.h"
 #include "Scripting/External/ExternalScriptManager.h"
 #include "Project/ProjectManager.h"
+#include "Streaming/AssetStreamer.h"
 #include "../Rendering/Renderer.h"
 #include "../Rendering/RenderManager.h"
 #include "../Rendering/Meshes/Mesh.h"
+#include "../Rendering/Core/AssetCache.h"
 #include "../Rendering/Lighting/Light.h"
 #include "../Rendering/Debug/DebugRenderer.h"
 #include "../Physics/PhysicsWorld.h"
@@ -295,6 +297,9 @@ void Engine::Render() {
         }
     }
 
+    // Finished background loads get their GPU uploads here, a budgeted slice per frame
+    AssetStreamer::Instance().ProcessUploads();
+
     m_renderManager->BeginFrame(renderData);
     m_renderManager->Render(m_world.get());
     
@@ -378,6 +383,8 @@ void Engine::Shutdown() {
     Profiler::Shutdown();
     DebugRenderer::Shutdown();
     ExternalScriptManager::Instance().Shutdown();
+    // Loads still in flight are dropped before the world and context they would upload into
+    AssetStreamer::Instance().Shutdown();
     
     m_engineUI.reset();
     if (m_testSceneManager) {
@@ -391,6 +398,8 @@ void Engine::Shutdown() {
     m_renderer.reset();
     m_inputManager.reset();
     m_world.reset();
+    // Pinned assets own GPU buffers and must go before the context does
+    AssetCache::Instance().Clear();
     m_window.reset();
     
     glfwTerminate();
@@ -11,8 +11,10 @@ LogLevel Logger::s_logLevel = LogLevel::Info;
 bool Logger::s_consoleOutput = true;
 bool Logger::s_fileOutput = true;
 bool Logger::s_initialized = false;
+std::recursive_mutex Logger::s_mutex;
 
 void Logger::Initialize(const std::string& filename, LogLevel level) {
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
     if (s_initialized) {
         Shutdown();
     }
@@ -32,6 +34,7 @@ void Logger::Initialize(const std::string& filename, LogLevel level) {
 }
 
 void Logger::Shutdown() {
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
     if (s_initialized) {
         Info("Logger shutting down");
         
@@ -77,6 +80,7 @@ void Logger::EnableFileOutput(bool enable) {
 }
 
 void Logger::Log(LogLevel level, const std::string& message) {
+    std::lock_guard<std::recursive_mutex> lock(s_mutex);
     if (!s_initialized && level >= LogLevel::Warning) {
         Initialize();
     }
@@ -115,7 +119,9 @@ std::string Logger::GetTimestamp() {
     localtime_s(&timeinfo, &time_t);
     ss << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S");
 #else
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    struct tm timeinfo;
+    localtime_r(&time_t, &timeinfo);
+    ss << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S");
 #endif
     ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
     
@@ -3,6 +3,7 @@
 #include <string>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 namespace GameEngine {
     enum class LogLevel {
@@ -38,5 +39,7 @@ namespace GameEngine {
         static bool s_consoleOutput;
         static bool s_fileOutput;
         static bool s_initialized;
+        // Asset streaming and parallel loaders log from worker threads
+        static std::recursive_mutex s_mutex;
     };
 }
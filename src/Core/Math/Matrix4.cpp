@@ -16,13 +16,16 @@ Matrix4::Matrix4(float diagonal) {
 Matrix4::Matrix4(const std::array<float, 16>& values) : m(values) {}
 
 Matrix4 Matrix4::operator*(const Matrix4& other) const {
+    // Storage is column-major (element row r, column c at m[c * 4 + r]), so this * other
+    // applies other first, matching GLSL's projection * view * model
     Matrix4 result;
-    for (int row = 0; row < 4; ++row) {
-        for (int col = 0; col < 4; ++col) {
-            result(row, col) = 0.0f;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            float sum = 0.0f;
             for (int k = 0; k < 4; ++k) {
-                result(row, col) += (*this)(row, k) * other(k, col);
+                sum += m[k * 4 + row] * other.m[col * 4 + k];
             }
+            result.m[col * 4 + row] = sum;
         }
     }
     return result;
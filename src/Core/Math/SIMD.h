@@ -0,0 +1,9 @@
+#pragma once
+
+// GE_SSE2 is defined when SSE2 intrinsics can be used unconditionally: always on x86-64,
+// and on 32-bit x86 when the compiler targets SSE2. Code using it keeps a scalar path for
+// other targets.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GE_SSE2 1
+#include <emmintrin.h>
+#endif
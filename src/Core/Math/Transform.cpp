@@ -1,7 +1,13 @@
 #include "Transform.h"
+#include <algorithm>
+#include <atomic>
 
 namespace GameEngine {
 
+namespace {
+std::atomic<uint64_t> s_versionCounter{0};
+}
+
 Matrix4 QuaternionToMatrix(const Quaternion& q) {
     float x = q.x, y = q.y, z = q.z, w = q.w;
     float x2 = x + x, y2 = y + y, z2 = z + z;
@@ -135,8 +141,22 @@ Vector3 Transform::GetWorldScale() const {
     return m_scale;
 }
 
+uint64_t Transform::NextVersion() {
+    return s_versionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 void Transform::MarkDirty() {
     m_isDirty = true;
+    m_version = NextVersion();
+}
+
+uint64_t Transform::GetHierarchyVersion() const {
+    // A sum could repeat after a reparent; the newest version only ever grows
+    uint64_t version = m_version;
+    for (const Transform* parent = m_parent; parent; parent = parent->m_parent) {
+        version = std::max(version, parent->m_version);
+    }
+    return version;
 }
 
 void Transform::UpdateMatrices() const {
@@ -144,7 +164,7 @@ void Transform::UpdateMatrices() const {
     Matrix4 rotation = QuaternionToMatrix(m_rotation);
     Matrix4 scale = Matrix4::Scale(m_scale);
     
-    m_localToWorld = scale * rotation * translation;
+    m_localToWorld = translation * rotation * scale;
     
     if (m_parent) {
         m_localToWorld = m_parent->GetLocalToWorldMatrix() * m_localToWorld;
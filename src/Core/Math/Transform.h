@@ -3,6 +3,7 @@
 #include "Vector3.h"
 #include "Quaternion.h"
 #include "Matrix4.h"
+#include <cstdint>
 
 namespace GameEngine {
     class Transform {
@@ -43,7 +44,15 @@ namespace GameEngine {
         Quaternion GetWorldRotation() const;
         Vector3 GetWorldScale() const;
         
+        // Every change takes the next value of a counter shared by all transforms, so versions
+        // are never reused. The hierarchy version is the newest version along the parent chain:
+        // it increases whenever this transform or any parent changes or is reparented, so
+        // caches of world-space data can be refreshed only for transforms that moved.
+        uint64_t GetVersion() const { return m_version; }
+        uint64_t GetHierarchyVersion() const;
+        
     private:
+        static uint64_t NextVersion();
         void MarkDirty();
         void UpdateMatrices() const;
         
@@ -56,5 +65,6 @@ namespace GameEngine {
         mutable Matrix4 m_localToWorld;
         mutable Matrix4 m_worldToLocal;
         mutable bool m_isDirty = true;
+        uint64_t m_version = NextVersion();
     };
 }
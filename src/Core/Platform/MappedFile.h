@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace GameEngine {
+    // Read-only memory mapping of a whole file. The contents stay valid until Close() or
+    // destruction; nothing is copied, so parsers can work directly on the mapped bytes.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_open; }
+        const char* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_open = false;            // An empty file is open but has no mapping
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+}
@@ -142,35 +142,39 @@ namespace GameEngine {
         size_t expectedCount = 0;
         std::vector<std::pair<uint32_t, uint32_t>> parentChildPairs; // child ID, parent ID
         
-        while (std::getline(file, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            
-            if (line.find("Name: ") == 0) {
-                m_name = line.substr(6);
-            }
-            else if (line.find("GameObjectCount: ") == 0) {
-                expectedCount = std::stoul(line.substr(17));
-            }
-            else if (line.find("[GameObject_") == 0) {
-                std::streampos currentPos = file.tellg();
+        {
+            // Ends the bulk load even when a malformed line makes the parsing below throw
+            World::BulkLoadScope bulkLoad(m_world);
+            while (std::getline(file, line)) {
+                if (line.empty() || line[0] == '#') continue;
                 
-                GameObject gameObject = DeserializeGameObject(file);
-                if (gameObject.IsValid()) {
-                    RegisterGameObject(gameObject);
-                    
-                    std::streampos endPos = file.tellg();
-                    file.seekg(currentPos);
+                if (line.find("Name: ") == 0) {
+                    m_name = line.substr(6);
+                }
+                else if (line.find("GameObjectCount: ") == 0) {
+                    expectedCount = std::stoul(line.substr(17));
+                }
+                else if (line.find("[GameObject_") == 0) {
+                    std::streampos currentPos = file.tellg();
                     
-                    std::string objLine;
-                    while (std::getline(file, objLine) && !objLine.empty() && objLine[0] != '[') {
-                        if (objLine.find("ParentID: ") == 0) {
-                            uint32_t parentID = std::stoul(objLine.substr(10));
-                            parentChildPairs.emplace_back(gameObject.GetEntity().GetID(), parentID);
-                            break;
+                    GameObject gameObject = DeserializeGameObject(file);
+                    if (gameObject.IsValid()) {
+                        RegisterGameObject(gameObject);
+                        
+                        std::streampos endPos = file.tellg();
+                        file.seekg(currentPos);
+                        
+                        std::string objLine;
+                        while (std::getline(file, objLine) && !objLine.empty() && objLine[0] != '[') {
+                            if (objLine.find("ParentID: ") == 0) {
+                                uint32_t parentID = std::stoul(objLine.substr(10));
+                                parentChildPairs.emplace_back(gameObject.GetEntity().GetID(), parentID);
+                                break;
+                            }
                         }
+                        
+                        file.seekg(endPos);
                     }
-                    
-                    file.seekg(endPos);
                 }
             }
         }
@@ -363,6 +367,13 @@ namespace GameEngine {
                  << collider->GetRestitution() << "," << collider->GetFriction() << ","
                  << p0 << "," << p1 << "," << p2 << "\n";
         }
+
+        if (gameObject.HasComponent<RigidBodyComponent>()) {
+            const RigidBody* body = gameObject.GetComponent<RigidBodyComponent>()->GetRigidBody();
+            file << "RigidBodyComponent: " << static_cast<int>(body->GetBodyType()) << ","
+                 << body->GetMass() << "," << body->GetRestitution() << "," << body->GetFriction() << ","
+                 << body->GetDamping() << "," << body->GetAngularDamping() << "\n";
+        }
         
         if (auto* transform = gameObject.GetTransform()) {
             if (transform->transform.GetParent()) {
@@ -452,7 +463,9 @@ namespace GameEngine {
                 std::getline(ss, roughnessStr, ',');
                 std::getline(ss, visibleStr, ',');
                 
-                auto* mesh = gameObject.AddComponent<MeshComponent>(typeStr);
+                // File meshes stream in behind the placeholder so a large scene loads without a hitch
+                auto* mesh = gameObject.AddComponent<MeshComponent>();
+                mesh->SetMeshAsync(typeStr);
                 mesh->SetColor(Vector3(std::stof(rStr), std::stof(gStr), std::stof(bStr)));
                 mesh->SetMetallic(std::stof(metallicStr));
                 mesh->SetRoughness(std::stof(roughnessStr));
@@ -495,6 +508,30 @@ namespace GameEngine {
                     }
                 }
             }
+            else if (line.find("RigidBodyComponent: ") == 0) {
+                std::stringstream ss(line.substr(20));
+                std::string typeStr, massStr, restStr, fricStr, dampStr, angDampStr;
+                std::getline(ss, typeStr, ',');
+                std::getline(ss, massStr, ',');
+                std::getline(ss, restStr, ',');
+                std::getline(ss, fricStr, ',');
+                std::getline(ss, dampStr, ',');
+                std::getline(ss, angDampStr, ',');
+                
+                // Registered with the physics world in LoadFromFile's bulk batch
+                auto* rigidBodyComp = gameObject.AddComponent<RigidBodyComponent>();
+                RigidBody* body = rigidBodyComp->GetRigidBody();
+                body->SetBodyType(static_cast<RigidBodyType>(std::stoi(typeStr)));
+                body->SetMass(std::stof(massStr));
+                body->SetRestitution(std::stof(restStr));
+                body->SetFriction(std::stof(fricStr));
+                body->SetDamping(std::stof(dampStr));
+                body->SetAngularDamping(std::stof(angDampStr));
+                if (auto* transform = gameObject.GetTransform()) {
+                    body->SetPosition(transform->transform.GetPosition());
+                    body->SetRotation(transform->transform.GetRotation());
+                }
+            }
             else if (line.find("ParentID: ") == 0) {
                 Logger::Debug("Found ParentID entry during deserialization - will restore hierarchy in second pass");
             }
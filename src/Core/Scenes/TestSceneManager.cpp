@@ -29,27 +29,30 @@ void TestSceneManager::LoadScene(TestSceneType sceneType) {
     m_currentSceneType = sceneType;
     m_animationTime = 0.0f;
     
-    switch (sceneType) {
-        case TestSceneType::BasicLighting:
-            CreateBasicLightingScene();
-            m_currentSceneName = "Basic Lighting Test";
-            break;
-        case TestSceneType::MultipleLight:
-            CreateMultipleLightScene();
-            m_currentSceneName = "Multiple Lights Test";
-            break;
-        case TestSceneType::PBRMaterials:
-            CreatePBRMaterialsScene();
-            m_currentSceneName = "PBR Materials Test";
-            break;
-        case TestSceneType::PostProcessing:
-            CreatePostProcessingScene();
-            m_currentSceneName = "Post-Processing Test";
-            break;
-        case TestSceneType::Raytracing:
-            CreateRaytracingScene();
-            m_currentSceneName = "Raytracing Test";
-            break;
+    {
+        World::BulkLoadScope bulkLoad(m_world);
+        switch (sceneType) {
+            case TestSceneType::BasicLighting:
+                CreateBasicLightingScene();
+                m_currentSceneName = "Basic Lighting Test";
+                break;
+            case TestSceneType::MultipleLight:
+                CreateMultipleLightScene();
+                m_currentSceneName = "Multiple Lights Test";
+                break;
+            case TestSceneType::PBRMaterials:
+                CreatePBRMaterialsScene();
+                m_currentSceneName = "PBR Materials Test";
+                break;
+            case TestSceneType::PostProcessing:
+                CreatePostProcessingScene();
+                m_currentSceneName = "Post-Processing Test";
+                break;
+            case TestSceneType::Raytracing:
+                CreateRaytracingScene();
+                m_currentSceneName = "Raytracing Test";
+                break;
+        }
     }
     
     Logger::Info("Test scene loaded: " + m_currentSceneName);
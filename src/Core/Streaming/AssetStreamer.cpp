@@ -0,0 +1,153 @@
+#include "AssetStreamer.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <limits>
+
+namespace GameEngine {
+
+AssetStreamer& AssetStreamer::Instance() {
+    static AssetStreamer instance;
+    return instance;
+}
+
+AssetStreamer::~AssetStreamer() {
+    Shutdown();
+}
+
+void AssetStreamer::StartWorkers() {
+    // One core stays with the main thread, which renders and runs the uploads
+    unsigned int workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    m_stopping = false;
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&AssetStreamer::WorkerLoop, this);
+    }
+    Logger::Info("AssetStreamer started " + std::to_string(workerCount) + " worker threads");
+}
+
+void AssetStreamer::Enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        if (m_workers.empty()) {
+            StartWorkers();
+        }
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void AssetStreamer::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_jobMutex);
+    while (true) {
+        m_jobAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping) {
+            return;
+        }
+        std::function<void()> job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        ++m_activeJobs;
+
+        lock.unlock();
+        job();
+        job = nullptr;      // Release captured state before reporting the job as done
+        lock.lock();
+
+        --m_activeJobs;
+        if (m_jobs.empty() && m_activeJobs == 0) {
+            m_jobsDone.notify_all();
+        }
+    }
+}
+
+void AssetStreamer::EnqueueUpload(size_t bytes, std::function<void()> upload) {
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_uploads.push_back({bytes, std::move(upload)});
+}
+
+size_t AssetStreamer::ProcessUploads(size_t byteBudget, double timeBudgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    size_t uploadedBytes = 0;
+    size_t uploadCount = 0;
+
+    while (true) {
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            if (m_uploads.empty()) {
+                break;
+            }
+            if (uploadCount > 0) {
+                double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (uploadedBytes + m_uploads.front().bytes > byteBudget || elapsedMs >= timeBudgetMs) {
+                    break;
+                }
+            }
+            upload = std::move(m_uploads.front());
+            m_uploads.pop_front();
+        }
+
+        // Outside the lock: uploads may queue follow-up work
+        upload.run();
+        uploadedBytes += upload.bytes;
+        ++uploadCount;
+    }
+
+    m_lastFrameUploadBytes = uploadedBytes;
+    return uploadedBytes;
+}
+
+void AssetStreamer::SetUploadBudget(size_t bytesPerFrame, double msPerFrame) {
+    m_uploadByteBudget = bytesPerFrame;
+    m_uploadTimeBudgetMs = std::max(0.0, msPerFrame);
+}
+
+void AssetStreamer::WaitForJobs() {
+    std::unique_lock<std::mutex> lock(m_jobMutex);
+    m_jobsDone.wait(lock, [this]() { return m_workers.empty() || (m_jobs.empty() && m_activeJobs == 0); });
+}
+
+void AssetStreamer::Flush() {
+    // An upload can submit further jobs, so alternate until both queues stay empty
+    do {
+        WaitForJobs();
+        ProcessUploads(std::numeric_limits<size_t>::max(), std::numeric_limits<double>::infinity());
+    } while (GetPendingJobCount() > 0 || GetPendingUploadCount() > 0);
+}
+
+void AssetStreamer::Shutdown() {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_stopping = true;
+        workers.swap(m_workers);
+        jobs.swap(m_jobs);
+    }
+    m_jobAvailable.notify_all();
+    m_jobsDone.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::deque<Upload> uploads;
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        uploads.swap(m_uploads);
+    }
+    if (!workers.empty()) {
+        Logger::Info("AssetStreamer stopped, dropped " + std::to_string(jobs.size()) + " jobs and " +
+                     std::to_string(uploads.size()) + " uploads");
+    }
+}
+
+size_t AssetStreamer::GetPendingJobCount() const {
+    std::lock_guard<std::mutex> lock(m_jobMutex);
+    return m_jobs.size() + m_activeJobs;
+}
+
+size_t AssetStreamer::GetPendingUploadCount() const {
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    return m_uploads.size();
+}
+
+}
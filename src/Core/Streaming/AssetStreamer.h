@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+namespace GameEngine {
+    // Result of an asynchronous load. Get() returns the placeholder until the asset has been
+    // decoded and uploaded, then the asset itself; a failed load keeps the placeholder.
+    template<typename T>
+    class AssetHandle {
+    public:
+        AssetHandle() = default;
+        AssetHandle(std::shared_future<std::shared_ptr<T>> future, std::shared_ptr<T> placeholder)
+            : m_future(std::move(future)), m_placeholder(std::move(placeholder)) {}
+
+        // Already loaded asset, e.g. a cache hit
+        static AssetHandle Ready(std::shared_ptr<T> asset) {
+            std::promise<std::shared_ptr<T>> promise;
+            promise.set_value(std::move(asset));
+            return AssetHandle(promise.get_future().share(), nullptr);
+        }
+
+        bool IsValid() const { return m_future.valid(); }
+        bool IsReady() const {
+            return m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+        // Ready and loaded successfully
+        bool IsLoaded() const { return IsReady() && GetLoaded() != nullptr; }
+
+        std::shared_ptr<T> Get() const {
+            if (IsReady()) {
+                if (auto asset = GetLoaded()) {
+                    return asset;
+                }
+            }
+            return m_placeholder;
+        }
+        const std::shared_ptr<T>& GetPlaceholder() const { return m_placeholder; }
+
+    private:
+        std::shared_ptr<T> GetLoaded() const {
+            try {
+                return m_future.get();
+            }
+            catch (const std::future_error&) {
+                // Broken promise: the streamer shut down before the upload ran
+                return nullptr;
+            }
+        }
+
+        std::shared_future<std::shared_ptr<T>> m_future;
+        std::shared_ptr<T> m_placeholder;
+    };
+
+    // Background loading in two stages. File I/O and decoding run as jobs on a worker pool;
+    // anything that needs the GL (or AL) context is queued back as an upload and runs on the
+    // main thread in ProcessUploads, which Engine::Render calls once per frame with a byte and
+    // time budget so a burst of finished loads is spread over several frames.
+    class AssetStreamer {
+    public:
+        static AssetStreamer& Instance();
+
+        // Runs job on a worker thread; workers start on first use
+        template<typename F>
+        std::future<std::invoke_result_t<F>> Submit(F&& job) {
+            using Result = std::invoke_result_t<F>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+            std::future<Result> future = task->get_future();
+            Enqueue([task]() { (*task)(); });
+            return future;
+        }
+
+        // Queues main-thread work costing roughly bytes of GPU transfer; safe from any thread
+        void EnqueueUpload(size_t bytes, std::function<void()> upload);
+
+        // Runs queued uploads in order until the byte or time budget is spent. At least one
+        // upload runs per call so an asset larger than the budget still goes through.
+        size_t ProcessUploads(size_t byteBudget, double timeBudgetMs);
+        size_t ProcessUploads() { return ProcessUploads(m_uploadByteBudget, m_uploadTimeBudgetMs); }
+
+        void SetUploadBudget(size_t bytesPerFrame, double msPerFrame);
+        size_t GetUploadByteBudget() const { return m_uploadByteBudget; }
+        double GetUploadTimeBudget() const { return m_uploadTimeBudgetMs; }
+
+        // Blocks until no job is queued or running; uploads they produced stay queued
+        void WaitForJobs();
+        // Loading screens: finishes every job and upload regardless of budget
+        void Flush();
+
+        // Stops the workers and drops whatever is still queued; handles to dropped loads keep
+        // their placeholders. Submitting again restarts the pool.
+        void Shutdown();
+
+        size_t GetPendingJobCount() const;
+        size_t GetPendingUploadCount() const;
+        size_t GetLastFrameUploadBytes() const { return m_lastFrameUploadBytes; }
+        size_t GetWorkerCount() const { return m_workers.size(); }
+
+    private:
+        AssetStreamer() = default;
+        ~AssetStreamer();
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+        struct Upload {
+            size_t bytes = 0;
+            std::function<void()> run;
+        };
+
+        void Enqueue(std::function<void()> job);
+        void StartWorkers();
+        void WorkerLoop();
+
+        mutable std::mutex m_jobMutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_jobsDone;
+        std::deque<std::function<void()>> m_jobs;
+        size_t m_activeJobs = 0;
+        bool m_stopping = false;
+        std::vector<std::thread> m_workers;
+
+        mutable std::mutex m_uploadMutex;
+        std::deque<Upload> m_uploads;
+
+        // About 16 MB/s of transfer at 60 fps and a quarter of a 60 Hz frame
+        size_t m_uploadByteBudget = 256 * 1024;
+        double m_uploadTimeBudgetMs = 4.0;
+        size_t m_lastFrameUploadBytes = 0;
+    };
+}
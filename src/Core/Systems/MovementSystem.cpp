@@ -3,6 +3,7 @@
 #include "../Components/MovementComponent.h"
 #include "../Components/TransformComponent.h"
 #include "../Components/RigidBodyComponent.h"
+#include "../Components/CharacterControllerComponent.h"
 #include "../Platform/Input.h"
 #include "../Platform/Window.h"
 #include "../Editor/PlayModeManager.h"
@@ -35,8 +36,27 @@ void MovementSystem::UpdateMovement(World* world, float deltaTime) {
         auto* transform = world->GetComponent<TransformComponent>(entity);
         
         if (movement && transform) {
-            if (m_playModeManager && m_playModeManager->IsInPlayMode() && 
-                world->HasComponent<RigidBodyComponent>(entity)) {
+            bool inPlayMode = m_playModeManager && m_playModeManager->IsInPlayMode();
+            auto* character = world->GetComponent<CharacterControllerComponent>(entity);
+            if (inPlayMode && character && character->GetController()) {
+                // Walk on the ground plane; the controller applies gravity and collision when physics steps
+                Vector3 forward = transform->transform.GetForward();
+                Vector3 right = transform->transform.GetRight();
+                forward.y = 0.0f;
+                right.y = 0.0f;
+                Vector3 moveDirection = right * movementInput.x + forward * movementInput.z;
+                if (moveDirection.LengthSquared() > 0.0f) {
+                    moveDirection.Normalize();
+                }
+                movement->velocity = moveDirection * movement->movementSpeed;
+                character->GetController()->SetMoveVelocity(movement->velocity);
+                if (movementInput.y > 0.0f) {
+                    character->GetController()->Jump(character->jumpSpeed);
+                }
+                continue;
+            }
+            
+            if (inPlayMode && world->HasComponent<RigidBodyComponent>(entity)) {
                 continue; // Let physics handle position updates
             }
             
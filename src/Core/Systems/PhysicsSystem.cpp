@@ -2,6 +2,7 @@
 #include "../ECS/World.h"
 #include "../Components/TransformComponent.h"
 #include "../Components/RigidBodyComponent.h"
+#include "../Components/CharacterControllerComponent.h"
 #include "../Components/ColliderComponent.h"
 #include "../Editor/PlayModeManager.h"
 #include "../Logging/Logger.h"
@@ -37,10 +38,19 @@ void PhysicsSystem::SynchronizePhysicsToTransforms(World* world) {
                 transformComp->transform.SetRotation(rigidBody->GetRotation());
             }
         }
+        
+        auto* characterComp = world->GetComponent<CharacterControllerComponent>(entity);
+        if (characterComp && transformComp && characterComp->GetController()) {
+            transformComp->transform.SetPosition(characterComp->GetController()->GetPosition());
+        }
     }
 }
 
 void PhysicsSystem::UpdateColliderPhysicsIntegration(World* world) {
+    // Newly found static colliders are registered in one batch so a scene load builds the
+    // broadphase once instead of inserting thousands of colliders one at a time
+    std::vector<ColliderComponent*> newStaticColliders;
+    
     for (const auto& entity : world->GetEntities()) {
         auto* rigidBodyComp = world->GetComponent<RigidBodyComponent>(entity);
         auto* colliderComp = world->GetComponent<ColliderComponent>(entity);
@@ -71,15 +81,19 @@ void PhysicsSystem::UpdateColliderPhysicsIntegration(World* world) {
             colliderComp->SetOwnerTransform(transformComp);
             if (colliderComp->HasCollider()) {
                 if (m_physicsWorld && m_registeredStaticColliders.find(colliderComp) == m_registeredStaticColliders.end()) {
-                    m_physicsWorld->AddStaticCollider(colliderComp);
+                    newStaticColliders.push_back(colliderComp);
                     m_registeredStaticColliders.insert(colliderComp);
-                    Logger::Debug("Registered static collider with PhysicsWorld for entity: " + std::to_string(entity.GetID()));
                 } else if (!m_physicsWorld) {
                     Logger::Warning("PhysicsWorld not available - cannot register static collider for entity: " + std::to_string(entity.GetID()));
                 }
             }
         }
     }
+    
+    if (!newStaticColliders.empty()) {
+        m_physicsWorld->AddStaticColliders(newStaticColliders);
+        Logger::Debug("Registered " + std::to_string(newStaticColliders.size()) + " static colliders with PhysicsWorld");
+    }
 }
 
 void PhysicsSystem::CleanupStaticColliders(World* world) {
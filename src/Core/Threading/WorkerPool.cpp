@@ -0,0 +1,117 @@
+#include "WorkerPool.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+
+namespace GameEngine {
+
+namespace {
+// Set on pool workers and on a caller while it runs a loop, so nested loops run inline
+thread_local bool t_insideLoop = false;
+}
+
+WorkerPool& WorkerPool::Instance() {
+    static WorkerPool instance;
+    return instance;
+}
+
+WorkerPool::~WorkerPool() {
+    Shutdown();
+}
+
+size_t WorkerPool::GetThreadCount() const {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void WorkerPool::Run(size_t count, size_t maxThreads, ItemFunction function, const void* context) {
+    maxThreads = std::min({maxThreads, count, GetThreadCount()});
+    std::unique_lock<std::mutex> dispatch(m_dispatchMutex, std::defer_lock);
+    if (maxThreads <= 1 || t_insideLoop || !dispatch.try_lock()) {
+        for (size_t item = 0; item < count; ++item) {
+            function(context, item, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        if (m_workers.empty()) {
+            StartWorkers();
+        }
+        m_function = function;
+        m_context = context;
+        m_itemCount = count;
+        m_threadLimit = maxThreads;
+        m_nextThread = 1;
+        m_nextItem.store(0, std::memory_order_relaxed);
+        m_busyWorkers = m_workers.size();
+        ++m_workGeneration;
+    }
+    m_workReady.notify_all();
+
+    t_insideLoop = true;
+    ProcessItems(0);
+    t_insideLoop = false;
+
+    // Callers rely on every item having finished, e.g. before the next joint batch
+    std::unique_lock<std::mutex> lock(m_workMutex);
+    m_workDone.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void WorkerPool::ProcessItems(size_t thread) {
+    for (;;) {
+        size_t item = m_nextItem.fetch_add(1, std::memory_order_relaxed);
+        if (item >= m_itemCount) break;
+        m_function(m_context, item, thread);
+    }
+}
+
+void WorkerPool::StartWorkers() {
+    // One hardware thread is left for the caller, which also processes items
+    unsigned int threadCount = static_cast<unsigned int>(GetThreadCount());
+    m_stopWorkers = false;
+    m_workers.reserve(threadCount - 1);
+    for (unsigned int t = 1; t < threadCount; ++t) {
+        m_workers.emplace_back(&WorkerPool::WorkerLoop, this, m_workGeneration);
+    }
+    Logger::Info("WorkerPool started " + std::to_string(m_workers.size()) + " worker threads");
+}
+
+void WorkerPool::Shutdown() {
+    std::lock_guard<std::mutex> dispatch(m_dispatchMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_stopWorkers = true;
+    }
+    m_workReady.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+void WorkerPool::WorkerLoop(uint64_t startGeneration) {
+    t_insideLoop = true;
+    uint64_t seenGeneration = startGeneration;
+    for (;;) {
+        size_t thread = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_workMutex);
+            m_workReady.wait(lock, [&] { return m_stopWorkers || m_workGeneration != seenGeneration; });
+            if (m_stopWorkers) return;
+            seenGeneration = m_workGeneration;
+            thread = m_nextThread++;
+        }
+
+        // Workers beyond the loop's thread limit only report back
+        if (thread < m_threadLimit) {
+            ProcessItems(thread);
+        }
+
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        if (--m_busyWorkers == 0) {
+            m_workDone.notify_one();
+        }
+    }
+}
+
+}
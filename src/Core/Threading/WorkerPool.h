@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameEngine {
+    // Persistent threads for data-parallel loops that run many times per frame (joint
+    // batches, raytracing tiles, silhouette jobs). Workers start on first use and sleep
+    // between loops; the calling thread takes items too, so a loop never waits idle.
+    // Long-running background work such as asset decoding belongs on AssetStreamer instead.
+    class WorkerPool {
+    public:
+        static WorkerPool& Instance();
+
+        // Threads a loop can use, the caller included
+        size_t GetThreadCount() const;
+
+        // Calls fn(item, thread) for every item below count and returns once all have run.
+        // Items are handed out from a shared cursor so one expensive item does not hold up a
+        // fixed split. thread is below min(maxThreads, GetThreadCount()) and is 0 for the
+        // caller, so it can index per-thread scratch buffers. A loop started from inside
+        // another one, or while a different thread's loop is running, runs serially on the
+        // calling thread as thread 0 rather than waiting.
+        template<typename F>
+        void ParallelFor(size_t count, size_t maxThreads, const F& fn) {
+            Run(count, maxThreads, [](const void* context, size_t item, size_t thread) {
+                (*static_cast<const F*>(context))(item, thread);
+            }, &fn);
+        }
+        template<typename F>
+        void ParallelFor(size_t count, const F& fn) { ParallelFor(count, GetThreadCount(), fn); }
+
+        // Joins the workers; the next loop starts them again
+        void Shutdown();
+
+    private:
+        using ItemFunction = void (*)(const void* context, size_t item, size_t thread);
+
+        WorkerPool() = default;
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        void Run(size_t count, size_t maxThreads, ItemFunction function, const void* context);
+        void ProcessItems(size_t thread);
+        void StartWorkers();
+        void WorkerLoop(uint64_t startGeneration);
+
+        // Held for the whole of a loop so only one caller dispatches at a time
+        std::mutex m_dispatchMutex;
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_workMutex;
+        std::condition_variable m_workReady;
+        std::condition_variable m_workDone;
+        uint64_t m_workGeneration = 0;
+        size_t m_busyWorkers = 0;
+        bool m_stopWorkers = false;
+
+        // Current loop, written under m_workMutex before the generation changes
+        ItemFunction m_function = nullptr;
+        const void* m_context = nullptr;
+        size_t m_itemCount = 0;
+        size_t m_threadLimit = 0;
+        size_t m_nextThread = 0;
+        std::atomic<size_t> m_nextItem{0};
+    };
+}
@@ -4,6 +4,7 @@
 #include "../../Core/Logging/Logger.h"
 #include "../../Core/Profiling/Profiler.h"
 #include <algorithm>
+#include <string>
 
 namespace GameEngine {
 
@@ -33,6 +34,9 @@ void PhysicsWorld2D::Shutdown() {
     
     Logger::Info("Shutting down 2D Physics World...");
     
+    for (RigidBody2D* body : m_rigidBodies) {
+        body->m_worldIndex = RigidBody2D::InvalidWorldIndex;
+    }
     m_rigidBodies.clear();
     m_collisions.clear();
     m_quadTree.reset();
@@ -81,22 +85,45 @@ void PhysicsWorld2D::FixedUpdate(float fixedDeltaTime) {
 }
 
 void PhysicsWorld2D::AddRigidBody(RigidBody2D* rigidBody) {
-    if (!rigidBody) return;
+    if (!rigidBody || ContainsRigidBody(rigidBody)) return;
     
-    auto it = std::find(m_rigidBodies.begin(), m_rigidBodies.end(), rigidBody);
-    if (it == m_rigidBodies.end()) {
-        m_rigidBodies.push_back(rigidBody);
-        Logger::Debug("Added RigidBody2D to physics world");
-    }
+    rigidBody->m_worldIndex = static_cast<uint32_t>(m_rigidBodies.size());
+    m_rigidBodies.push_back(rigidBody);
+    Logger::Debug("Added RigidBody2D to physics world");
 }
 
 void PhysicsWorld2D::RemoveRigidBody(RigidBody2D* rigidBody) {
-    if (!rigidBody) return;
+    if (!rigidBody || !ContainsRigidBody(rigidBody)) return;
+    
+    uint32_t index = rigidBody->m_worldIndex;
+    RigidBody2D* last = m_rigidBodies.back();
+    m_rigidBodies[index] = last;
+    last->m_worldIndex = index;
+    m_rigidBodies.pop_back();
+    rigidBody->m_worldIndex = RigidBody2D::InvalidWorldIndex;
+    Logger::Debug("Removed RigidBody2D from physics world");
+}
+
+bool PhysicsWorld2D::ContainsRigidBody(const RigidBody2D* rigidBody) const {
+    if (!rigidBody) return false;
+    uint32_t index = rigidBody->m_worldIndex;
+    return index < m_rigidBodies.size() && m_rigidBodies[index] == rigidBody;
+}
+
+void PhysicsWorld2D::AddRigidBodies(std::span<RigidBody2D* const> rigidBodies) {
+    size_t previousCount = m_rigidBodies.size();
+    m_rigidBodies.reserve(previousCount + rigidBodies.size());
+    
+    for (RigidBody2D* body : rigidBodies) {
+        if (!body || ContainsRigidBody(body)) continue;
+        body->m_worldIndex = static_cast<uint32_t>(m_rigidBodies.size());
+        m_rigidBodies.push_back(body);
+    }
     
-    auto it = std::find(m_rigidBodies.begin(), m_rigidBodies.end(), rigidBody);
-    if (it != m_rigidBodies.end()) {
-        m_rigidBodies.erase(it);
-        Logger::Debug("Removed RigidBody2D from physics world");
+    // The quadtree is rebuilt from the body list every step, so nothing else to update here
+    size_t added = m_rigidBodies.size() - previousCount;
+    if (added > 0) {
+        Logger::Debug("Added " + std::to_string(added) + " RigidBody2Ds to physics world");
     }
 }
 
@@ -147,13 +174,7 @@ void PhysicsWorld2D::IntegratePositions(float deltaTime) {
 void PhysicsWorld2D::UpdateSpatialPartitioning() {
     if (!m_quadTree) return;
     
-    m_quadTree->Clear();
-    
-    for (RigidBody2D* body : m_rigidBodies) {
-        if (body) {
-            m_quadTree->Insert(body);
-        }
-    }
+    m_quadTree->Build(m_rigidBodies);
 }
 
 void PhysicsWorld2D::SetWorldBounds(const Vector2& min, const Vector2& max) {
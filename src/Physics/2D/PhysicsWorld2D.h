@@ -4,6 +4,7 @@
 #include "Spatial/QuadTree.h"
 #include <vector>
 #include <memory>
+#include <span>
 
 namespace GameEngine {
     class RigidBody2D;
@@ -24,9 +25,12 @@ namespace GameEngine {
         void SetGravity(const Vector2& gravity) { m_gravity = gravity; }
         const Vector2& GetGravity() const { return m_gravity; }
         
-        // Rigid body management
+        // Rigid body management. Membership is tracked by an index stored in each body, so adding
+        // and removing are O(1); removal moves the last body into the freed slot.
         void AddRigidBody(RigidBody2D* rigidBody);
         void RemoveRigidBody(RigidBody2D* rigidBody);
+        bool ContainsRigidBody(const RigidBody2D* rigidBody) const;
+        void AddRigidBodies(std::span<RigidBody2D* const> rigidBodies);
         const std::vector<RigidBody2D*>& GetRigidBodies() const { return m_rigidBodies; }
         
         // Collision detection
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Core/Math/Vector2.h"
+#include <cstdint>
 
 namespace GameEngine {
     class PhysicsMaterial;
@@ -122,6 +123,9 @@ namespace GameEngine {
         Vector2 WorldDirectionToLocal(const Vector2& worldDirection) const;
         
     private:
+        friend class PhysicsWorld2D;
+        static constexpr uint32_t InvalidWorldIndex = 0xFFFFFFFFu;
+        
         // Transform (2D)
         Vector2 m_position = Vector2::Zero;
         float m_rotation = 0.0f; // Angle in radians
@@ -163,5 +167,8 @@ namespace GameEngine {
         Collider2DType m_colliderType = Collider2DType::None;
         Vector2 m_colliderSize = Vector2::One; // For box colliders
         float m_colliderRadius = 0.5f; // For circle colliders
+        
+        // Slot in the owning PhysicsWorld2D's body list, maintained by the world for O(1) membership
+        uint32_t m_worldIndex = InvalidWorldIndex;
     };
 }
@@ -95,6 +95,50 @@ void QuadTree::Insert(RigidBody2D* body) {
     }
 }
 
+void QuadTree::Build(const std::vector<RigidBody2D*>& bodies) {
+    Clear();
+    
+    std::vector<BuildItem> items;
+    items.reserve(bodies.size());
+    for (RigidBody2D* body : bodies) {
+        if (body) {
+            items.push_back(BuildItem{GetBodyBounds(body), body, -1});
+        }
+    }
+    BuildRange(items, 0, items.size());
+}
+
+// Same placement as repeated Insert calls, but each body's bounds are computed once and
+// every node is split at most once
+void QuadTree::BuildRange(std::vector<BuildItem>& items, size_t begin, size_t end) {
+    if (end - begin <= static_cast<size_t>(MAX_OBJECTS) || m_level >= MAX_LEVELS) {
+        for (size_t i = begin; i < end; ++i) {
+            m_objects.push_back(items[i].body);
+        }
+        return;
+    }
+    
+    Split();
+    for (size_t i = begin; i < end; ++i) {
+        items[i].quadrant = GetIndex(items[i].bounds);
+    }
+    std::sort(items.begin() + begin, items.begin() + end,
+              [](const BuildItem& a, const BuildItem& b) { return a.quadrant < b.quadrant; });
+    
+    size_t i = begin;
+    while (i < end && items[i].quadrant < 0) {
+        m_objects.push_back(items[i].body);
+        ++i;
+    }
+    while (i < end) {
+        int quadrant = items[i].quadrant;
+        size_t quadrantEnd = i;
+        while (quadrantEnd < end && items[quadrantEnd].quadrant == quadrant) ++quadrantEnd;
+        m_nodes[quadrant]->BuildRange(items, i, quadrantEnd);
+        i = quadrantEnd;
+    }
+}
+
 void QuadTree::Retrieve(std::vector<RigidBody2D*>& returnObjects, RigidBody2D* body) {
     if (!body) return;
     
@@ -161,9 +205,10 @@ void QuadTree::Split() {
 
 int QuadTree::GetIndex(RigidBody2D* body) {
     if (!body) return -1;
-    
-    QuadTreeBounds bodyBounds = GetBodyBounds(body);
-    
+    return GetIndex(GetBodyBounds(body));
+}
+
+int QuadTree::GetIndex(const QuadTreeBounds& bodyBounds) const {
     for (int i = 0; i < 4; ++i) {
         QuadTreeBounds quadrantBounds = m_bounds.GetQuadrant(i);
         
@@ -30,6 +30,8 @@ namespace GameEngine {
         
         void Clear();
         void Insert(RigidBody2D* body);
+        // Replaces the tree contents with a top-down build over all bodies at once
+        void Build(const std::vector<RigidBody2D*>& bodies);
         void Retrieve(std::vector<RigidBody2D*>& returnObjects, RigidBody2D* body);
         void Retrieve(std::vector<RigidBody2D*>& returnObjects, const QuadTreeBounds& bounds);
         
@@ -39,6 +41,12 @@ namespace GameEngine {
         void GetAllBounds(std::vector<QuadTreeBounds>& bounds) const;
         
     private:
+        struct BuildItem {
+            QuadTreeBounds bounds;
+            RigidBody2D* body;
+            int quadrant;
+        };
+        
         int m_level;
         QuadTreeBounds m_bounds;
         std::vector<RigidBody2D*> m_objects;
@@ -46,6 +54,8 @@ namespace GameEngine {
         
         void Split();
         int GetIndex(RigidBody2D* body);
+        int GetIndex(const QuadTreeBounds& bodyBounds) const;
+        void BuildRange(std::vector<BuildItem>& items, size_t begin, size_t end);
         QuadTreeBounds GetBodyBounds(RigidBody2D* body);
     };
 }
@@ -0,0 +1,626 @@
+#include "CharacterController.h"
+#include "../PhysicsWorld.h"
+#include "../RigidBody/RigidBody.h"
+#include "../Spatial/Octree.h"
+#include "../Colliders/ColliderShape.h"
+#include "../../Core/Components/ColliderComponent.h"
+#include "../../Core/Components/TransformComponent.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine {
+
+namespace {
+    constexpr float kEpsilon = 1e-6f;
+
+    Vector3 ClosestPointOnSegment(const Vector3& a, const Vector3& b, const Vector3& point) {
+        Vector3 ab = b - a;
+        float lengthSq = ab.LengthSquared();
+        if (lengthSq < kEpsilon) return a;
+        float t = std::clamp((point - a).Dot(ab) / lengthSq, 0.0f, 1.0f);
+        return a + ab * t;
+    }
+
+    // Closest points between segments p1q1 and p2q2 (Ericson, Real-Time Collision Detection 5.1.9)
+    void ClosestPointsSegmentSegment(const Vector3& p1, const Vector3& q1, const Vector3& p2, const Vector3& q2,
+                                     Vector3& c1, Vector3& c2) {
+        Vector3 d1 = q1 - p1;
+        Vector3 d2 = q2 - p2;
+        Vector3 r = p1 - p2;
+        float a = d1.LengthSquared();
+        float e = d2.LengthSquared();
+        float f = d2.Dot(r);
+        float s = 0.0f;
+        float t = 0.0f;
+
+        if (a <= kEpsilon && e <= kEpsilon) {
+            c1 = p1;
+            c2 = p2;
+            return;
+        }
+        if (a <= kEpsilon) {
+            t = std::clamp(f / e, 0.0f, 1.0f);
+        } else {
+            float c = d1.Dot(r);
+            if (e <= kEpsilon) {
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            } else {
+                float b = d1.Dot(d2);
+                float denom = a * e - b * b;
+                s = denom > kEpsilon ? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+                t = (b * s + f) / e;
+                if (t < 0.0f) {
+                    t = 0.0f;
+                    s = std::clamp(-c / a, 0.0f, 1.0f);
+                } else if (t > 1.0f) {
+                    t = 1.0f;
+                    s = std::clamp((b - c) / a, 0.0f, 1.0f);
+                }
+            }
+        }
+        c1 = p1 + d1 * s;
+        c2 = p2 + d2 * t;
+    }
+
+    // Closest point on triangle abc to p (Ericson 5.1.5)
+    Vector3 ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+        Vector3 ab = b - a;
+        Vector3 ac = c - a;
+        Vector3 ap = p - a;
+        float d1 = ab.Dot(ap);
+        float d2 = ac.Dot(ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+        Vector3 bp = p - b;
+        float d3 = ab.Dot(bp);
+        float d4 = ac.Dot(bp);
+        if (d3 >= 0.0f && d4 <= d3) return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            return a + ab * (d1 / (d1 - d3));
+        }
+
+        Vector3 cp = p - c;
+        float d5 = ab.Dot(cp);
+        float d6 = ac.Dot(cp);
+        if (d6 >= 0.0f && d5 <= d6) return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            return a + ac * (d2 / (d2 - d6));
+        }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+    // Golden-section search for the minimum of a convex function on [0, 1]
+    template<typename Func>
+    float MinimizeOnUnitInterval(Func&& f) {
+        const float invPhi = 0.6180340f;
+        float lo = 0.0f;
+        float hi = 1.0f;
+        float x1 = hi - invPhi;
+        float x2 = lo + invPhi;
+        float f1 = f(x1);
+        float f2 = f(x2);
+        for (int i = 0; i < 20; ++i) {
+            if (f1 < f2) {
+                hi = x2;
+                x2 = x1;
+                f2 = f1;
+                x1 = hi - invPhi * (hi - lo);
+                f1 = f(x1);
+            } else {
+                lo = x1;
+                x1 = x2;
+                f1 = f2;
+                x2 = lo + invPhi * (hi - lo);
+                f2 = f(x2);
+            }
+        }
+        float t = 0.5f * (lo + hi);
+        // The minimum may sit on an endpoint, which the interior probes only approach
+        if (f(0.0f) <= f(t)) return 0.0f;
+        if (f(1.0f) < f(t)) return 1.0f;
+        return t;
+    }
+
+    // Signed distance from a point to a box centered at the origin, with its outward gradient
+    float BoxSignedDistance(const Vector3& q, const Vector3& halfExtents, Vector3& gradient) {
+        Vector3 d(std::fabs(q.x) - halfExtents.x, std::fabs(q.y) - halfExtents.y, std::fabs(q.z) - halfExtents.z);
+        if (d.x > 0.0f || d.y > 0.0f || d.z > 0.0f) {
+            Vector3 clamped(std::clamp(q.x, -halfExtents.x, halfExtents.x),
+                            std::clamp(q.y, -halfExtents.y, halfExtents.y),
+                            std::clamp(q.z, -halfExtents.z, halfExtents.z));
+            Vector3 delta = q - clamped;
+            float distance = delta.Length();
+            gradient = distance > kEpsilon ? delta / distance : Vector3::Up;
+            return distance;
+        }
+        int axis = (d.x > d.y) ? (d.x > d.z ? 0 : 2) : (d.y > d.z ? 1 : 2);
+        gradient = Vector3::Zero;
+        gradient[axis] = q[axis] >= 0.0f ? 1.0f : -1.0f;
+        return d[axis];
+    }
+
+    bool BoundsOverlap(const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB) {
+        return minA.x <= maxB.x && maxA.x >= minB.x &&
+               minA.y <= maxB.y && maxA.y >= minB.y &&
+               minA.z <= maxB.z && maxA.z >= minB.z;
+    }
+}
+
+Vector3 CharacterController::GetFootPosition() const {
+    return m_position - Vector3::Up * (m_settings.height * 0.5f + m_settings.radius);
+}
+
+void CharacterController::Jump(float speed) {
+    m_pendingJumpSpeed = speed;
+}
+
+bool CharacterController::IsWalkable(const Vector3& normal) const {
+    const float degToRad = 3.14159265f / 180.0f;
+    return normal.y >= std::cos(m_settings.maxSlopeDegrees * degToRad) - 1e-4f;
+}
+
+bool CharacterController::FindGround(const SweepHit& hit, const Vector3& position, Vector3& groundNormal) const {
+    if (!hit.hit || hit.normal.y <= kEpsilon) return false;
+    if (IsWalkable(hit.normal)) {
+        groundNormal = hit.normal;
+        return true;
+    }
+    if (hit.proxyIndex < 0) return false;
+
+    Vector3 inward(-hit.normal.x, 0.0f, -hit.normal.z);
+    if (inward.LengthSquared() < kEpsilon) return false;
+    inward = inward.Normalized();
+
+    Vector3 bottom = position - Vector3::Up * (m_settings.height * 0.5f);
+    Vector3 contact = bottom - hit.normal * m_settings.radius;
+    Vector3 probe = contact + inward * (2.0f * m_settings.skinWidth) + Vector3::Up * (2.0f * m_settings.skinWidth);
+
+    Vector3 surfaceNormal;
+    float distance = ProxyDistance(m_proxies[hit.proxyIndex], probe, probe, 0.0f, surfaceNormal);
+    if (distance < 0.0f || !IsWalkable(surfaceNormal)) return false;
+    groundNormal = surfaceNormal;
+    return true;
+}
+
+void CharacterController::Step(const PhysicsWorld& world, float deltaTime) {
+    if (!m_enabled || deltaTime <= 0.0f) return;
+
+    Vector3 start = m_position;
+    float gravity = world.GetGravity().y;
+
+    if (m_grounded && m_pendingJumpSpeed > 0.0f) {
+        m_verticalSpeed = m_pendingJumpSpeed;
+    } else if (m_grounded && m_verticalSpeed <= 0.0f) {
+        m_verticalSpeed = 0.0f;
+    } else {
+        m_verticalSpeed += gravity * deltaTime;
+    }
+    m_pendingJumpSpeed = 0.0f;
+
+    Vector3 displacement(m_moveVelocity.x * deltaTime, m_verticalSpeed * deltaTime, m_moveVelocity.z * deltaTime);
+    uint32_t flags = Move(world, displacement);
+
+    if ((flags & CharacterCollisionBelow) && m_verticalSpeed < 0.0f) {
+        m_verticalSpeed = 0.0f;
+    }
+    if ((flags & CharacterCollisionAbove) && m_verticalSpeed > 0.0f) {
+        m_verticalSpeed = 0.0f;
+    }
+    m_velocity = (m_position - start) / deltaTime;
+}
+
+uint32_t CharacterController::Move(const PhysicsWorld& world, const Vector3& displacement) {
+    const CharacterControllerSettings& s = m_settings;
+    bool wasGrounded = m_grounded;
+
+    // One broadphase query covering every sub-move of this call
+    float reach = displacement.Length() + s.stepOffset + s.snapDistance + 2.0f * s.skinWidth;
+    Vector3 extent(s.radius + reach, s.height * 0.5f + s.radius + reach, s.radius + reach);
+    GatherProxies(world, m_position - extent, m_position + extent);
+
+    Depenetrate();
+
+    m_grounded = false;
+    m_collisionFlags = CharacterCollisionNone;
+
+    Vector3 horizontal(displacement.x, 0.0f, displacement.z);
+    Vector3 vertical(0.0f, displacement.y, 0.0f);
+
+    if (horizontal.LengthSquared() > kEpsilon * kEpsilon) {
+        bool canStep = wasGrounded && displacement.y <= 0.0f;
+        Vector3 remaining = horizontal;
+        for (int i = 0; i < s.maxSlideIterations && remaining.LengthSquared() > kEpsilon * kEpsilon; ++i) {
+            SweepHit hit = Sweep(m_position, remaining);
+            m_position += remaining * hit.fraction;
+            if (!hit.hit) break;
+
+            remaining *= (1.0f - hit.fraction);
+            Vector3 groundNormal;
+            bool ground = FindGround(hit, m_position, groundNormal);
+            if (ground) {
+                m_collisionFlags |= CharacterCollisionBelow;
+                m_grounded = true;
+                m_groundNormal = groundNormal;
+            } else if (hit.normal.y < -0.5f) {
+                m_collisionFlags |= CharacterCollisionAbove;
+            } else {
+                if (canStep && TryStepUp(remaining)) {
+                    canStep = false;
+                    remaining = Vector3::Zero;
+                    break;
+                }
+                m_collisionFlags |= CharacterCollisionSides;
+            }
+
+            // Walls and steep slopes only block horizontally, so walking into them never climbs
+            Vector3 normal = hit.normal;
+            if (!ground) {
+                Vector3 flat(normal.x, 0.0f, normal.z);
+                if (flat.LengthSquared() > kEpsilon) normal = flat.Normalized();
+            }
+            remaining -= normal * remaining.Dot(normal);
+        }
+    }
+
+    if (vertical.LengthSquared() > kEpsilon * kEpsilon) {
+        Vector3 remaining = vertical;
+        for (int i = 0; i < s.maxSlideIterations && remaining.LengthSquared() > kEpsilon * kEpsilon; ++i) {
+            SweepHit hit = Sweep(m_position, remaining);
+            m_position += remaining * hit.fraction;
+            if (!hit.hit) break;
+
+            remaining *= (1.0f - hit.fraction);
+            Vector3 groundNormal;
+            if (FindGround(hit, m_position, groundNormal)) {
+                // Landing on walkable ground stops vertical motion instead of sliding downhill
+                m_collisionFlags |= CharacterCollisionBelow;
+                m_grounded = true;
+                m_groundNormal = groundNormal;
+                break;
+            }
+            m_collisionFlags |= hit.normal.y < -0.5f ? CharacterCollisionAbove : CharacterCollisionSides;
+            remaining -= hit.normal * remaining.Dot(hit.normal);
+        }
+    }
+
+    // Ground probe: keeps contact when walking downhill or off small ledges, and reports
+    // grounded state even when this move had no downward component
+    if (!m_grounded && displacement.y <= 0.0f) {
+        float probe = wasGrounded ? s.snapDistance : 2.0f * s.skinWidth;
+        SweepHit hit = Sweep(m_position, Vector3::Up * -probe);
+        Vector3 landed = m_position + Vector3::Up * (-probe * hit.fraction);
+        Vector3 groundNormal;
+        if (FindGround(hit, landed, groundNormal)) {
+            m_position = landed;
+            m_collisionFlags |= CharacterCollisionBelow;
+            m_grounded = true;
+            m_groundNormal = groundNormal;
+        }
+    }
+    if (!m_grounded) {
+        m_groundNormal = Vector3::Up;
+    }
+
+    return m_collisionFlags;
+}
+
+bool CharacterController::TryStepUp(const Vector3& horizontalDisplacement) {
+    const float skin = m_settings.skinWidth;
+    Vector3 saved = m_position;
+
+    SweepHit up = Sweep(m_position, Vector3::Up * m_settings.stepOffset);
+    float raised = m_settings.stepOffset * up.fraction;
+    if (raised <= skin) return false;
+    m_position += Vector3::Up * raised;
+
+    SweepHit forward = Sweep(m_position, horizontalDisplacement);
+    if (forward.fraction * horizontalDisplacement.Length() <= skin) {
+        m_position = saved;
+        return false;
+    }
+    m_position += horizontalDisplacement * forward.fraction;
+
+    float dropDistance = raised + skin;
+    SweepHit down = Sweep(m_position, Vector3::Up * -dropDistance);
+    Vector3 landed = m_position + Vector3::Up * (-dropDistance * down.fraction);
+    Vector3 groundNormal;
+    if (!FindGround(down, landed, groundNormal)) {
+        m_position = saved;
+        return false;
+    }
+    m_position = landed;
+
+    m_collisionFlags |= CharacterCollisionBelow;
+    m_grounded = true;
+    m_groundNormal = groundNormal;
+    return true;
+}
+
+void CharacterController::Depenetrate() {
+    const float halfSegment = m_settings.height * 0.5f;
+    const float skin = m_settings.skinWidth;
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        Vector3 push = Vector3::Zero;
+        Vector3 a = m_position + Vector3::Up * halfSegment;
+        Vector3 b = m_position - Vector3::Up * halfSegment;
+        for (const ShapeProxy& proxy : m_proxies) {
+            Vector3 normal;
+            float distance = ProxyDistance(proxy, a, b, m_settings.radius, normal);
+            if (distance < 0.5f * skin) {
+                push += normal * (skin - distance);
+            }
+        }
+        if (push.LengthSquared() < kEpsilon * kEpsilon) break;
+        m_position += push;
+    }
+}
+
+// Conservative advancement. Along a straight move the distance to each convex shape is a convex
+// function of the move fraction, so a tangent (Newton) step never passes the first contact.
+CharacterController::SweepHit CharacterController::Sweep(const Vector3& from, const Vector3& displacement) const {
+    SweepHit result;
+    float length = displacement.Length();
+    if (length < kEpsilon) return result;
+
+    const float skin = m_settings.skinWidth;
+    const float halfSegment = m_settings.height * 0.5f;
+    const float capsuleReach = halfSegment + m_settings.radius;
+
+    float t = 0.0f;
+    for (int iteration = 0; iteration < 32; ++iteration) {
+        Vector3 position = from + displacement * t;
+        Vector3 a = position + Vector3::Up * halfSegment;
+        Vector3 b = position - Vector3::Up * halfSegment;
+        Vector3 capsuleMin = position - Vector3(m_settings.radius, capsuleReach, m_settings.radius);
+        Vector3 capsuleMax = position + Vector3(m_settings.radius, capsuleReach, m_settings.radius);
+        float travel = (1.0f - t) * length + skin;
+        Vector3 reachVec(travel, travel, travel);
+
+        float step = 1.0f - t;
+        bool blocked = false;
+        float mostOpposing = 0.0f;
+        Vector3 nearestNormal;
+        int nearestProxy = -1;
+        for (size_t p = 0; p < m_proxies.size(); ++p) {
+            const ShapeProxy& proxy = m_proxies[p];
+            if (!BoundsOverlap(capsuleMin - reachVec, capsuleMax + reachVec, proxy.boundsMin, proxy.boundsMax)) continue;
+
+            Vector3 normal;
+            float distance = ProxyDistance(proxy, a, b, m_settings.radius, normal);
+            float rate = displacement.Dot(normal);  // d(distance)/dt
+            if (rate >= -kEpsilon * length) continue; // Moving parallel or away can never hit this shape
+
+            if (distance <= skin * 1.25f) {
+                if (!blocked || rate < mostOpposing) {
+                    mostOpposing = rate;
+                    result.normal = normal;
+                    result.proxyIndex = static_cast<int>(p);
+                }
+                blocked = true;
+                continue;
+            }
+            float proxyStep = (distance - skin) / -rate;
+            if (proxyStep < step) {
+                step = proxyStep;
+                nearestNormal = normal;
+                nearestProxy = static_cast<int>(p);
+            }
+        }
+
+        if (blocked) {
+            result.hit = true;
+            result.fraction = t;
+            return result;
+        }
+        t += step;
+        if (t >= 1.0f) {
+            result.fraction = 1.0f;
+            return result;
+        }
+        result.normal = nearestNormal;
+        result.proxyIndex = nearestProxy;
+    }
+
+    // Out of iterations: stop where we are, which is still separated
+    result.hit = true;
+    result.fraction = t;
+    return result;
+}
+
+float CharacterController::ProxyDistance(const ShapeProxy& proxy, const Vector3& segmentA, const Vector3& segmentB, float radius, Vector3& normal) {
+    switch (proxy.kind) {
+        case ShapeProxy::Kind::Sphere: {
+            Vector3 closest = ClosestPointOnSegment(segmentA, segmentB, proxy.center);
+            Vector3 delta = closest - proxy.center;
+            float length = delta.Length();
+            normal = length > kEpsilon ? delta / length : Vector3::Up;
+            return length - proxy.radius - radius;
+        }
+        case ShapeProxy::Kind::Capsule: {
+            Vector3 c1, c2;
+            ClosestPointsSegmentSegment(segmentA, segmentB, proxy.center + proxy.axis, proxy.center - proxy.axis, c1, c2);
+            Vector3 delta = c1 - c2;
+            float length = delta.Length();
+            normal = length > kEpsilon ? delta / length : Vector3::Up;
+            return length - proxy.radius - radius;
+        }
+        case ShapeProxy::Kind::Plane: {
+            float da = proxy.axis.Dot(segmentA) - proxy.radius;
+            float db = proxy.axis.Dot(segmentB) - proxy.radius;
+            normal = proxy.axis;
+            return std::min(da, db) - radius;
+        }
+        case ShapeProxy::Kind::Box: {
+            Vector3 localA = proxy.inverseRotation.RotateVector(segmentA - proxy.center);
+            Vector3 localB = proxy.inverseRotation.RotateVector(segmentB - proxy.center);
+            Vector3 localSegment = localB - localA;
+            Vector3 gradient;
+            float t = MinimizeOnUnitInterval([&](float u) {
+                return BoxSignedDistance(localA + localSegment * u, proxy.halfExtents, gradient);
+            });
+            float distance = BoxSignedDistance(localA + localSegment * t, proxy.halfExtents, gradient);
+            normal = proxy.rotation.RotateVector(gradient);
+            return distance - radius;
+        }
+        case ShapeProxy::Kind::Triangle: {
+            Vector3 segment = segmentB - segmentA;
+            float t = MinimizeOnUnitInterval([&](float u) {
+                Vector3 p = segmentA + segment * u;
+                return (p - ClosestPointOnTriangle(p, proxy.v0, proxy.v1, proxy.v2)).LengthSquared();
+            });
+            Vector3 p = segmentA + segment * t;
+            Vector3 delta = p - ClosestPointOnTriangle(p, proxy.v0, proxy.v1, proxy.v2);
+            float length = delta.Length();
+            if (length > kEpsilon) {
+                normal = delta / length;
+            } else {
+                // Segment touches the triangle: push out along the face normal, toward the capsule middle
+                normal = (proxy.v1 - proxy.v0).Cross(proxy.v2 - proxy.v0).Normalized();
+                Vector3 middle = (segmentA + segmentB) * 0.5f;
+                if (normal.Dot(middle - proxy.v0) < 0.0f) normal = -normal;
+            }
+            return length - radius;
+        }
+    }
+    normal = Vector3::Up;
+    return 1e30f;
+}
+
+void CharacterController::GatherProxies(const PhysicsWorld& world, const Vector3& boundsMin, const Vector3& boundsMax) {
+    m_proxies.clear();
+    m_colliderScratch.clear();
+    m_bodyScratch.clear();
+    world.QueryOverlaps(AABB(boundsMin, boundsMax), m_colliderScratch, m_bodyScratch);
+
+    for (ColliderComponent* collider : m_colliderScratch) {
+        TransformComponent* transform = collider->GetOwnerTransform();
+        Vector3 position = transform ? transform->transform.GetWorldPosition() : Vector3::Zero;
+        Quaternion rotation = transform ? transform->transform.GetWorldRotation() : Quaternion::Identity();
+        Vector3 scale = transform ? transform->transform.GetWorldScale() : Vector3::One;
+        AddColliderProxies(collider, position, rotation, scale, boundsMin, boundsMax);
+    }
+    for (RigidBody* body : m_bodyScratch) {
+        ColliderComponent* collider = body->GetColliderComponent();
+        if (!collider) continue;
+        TransformComponent* transform = body->GetTransformComponent();
+        Vector3 scale = transform ? transform->transform.GetWorldScale() : Vector3::One;
+        AddColliderProxies(collider, body->GetPosition(), body->GetRotation(), scale, boundsMin, boundsMax);
+    }
+}
+
+void CharacterController::AddColliderProxies(ColliderComponent* collider, const Vector3& position, const Quaternion& rotation, const Vector3& scale,
+                                             const Vector3& boundsMin, const Vector3& boundsMax) {
+    if (!collider || !collider->HasCollider() || collider->IsTrigger()) return;
+
+    auto shape = collider->GetColliderShape();
+    ShapeProxy proxy;
+    proxy.center = position;
+    proxy.rotation = rotation.Normalized();
+    proxy.inverseRotation = proxy.rotation.Conjugate();
+    float maxScale = std::max({std::fabs(scale.x), std::fabs(scale.y), std::fabs(scale.z)});
+
+    auto setBoxBounds = [&](ShapeProxy& box) {
+        Vector3 ax = box.rotation.RotateVector(Vector3(box.halfExtents.x, 0.0f, 0.0f));
+        Vector3 ay = box.rotation.RotateVector(Vector3(0.0f, box.halfExtents.y, 0.0f));
+        Vector3 az = box.rotation.RotateVector(Vector3(0.0f, 0.0f, box.halfExtents.z));
+        Vector3 extent(std::fabs(ax.x) + std::fabs(ay.x) + std::fabs(az.x),
+                       std::fabs(ax.y) + std::fabs(ay.y) + std::fabs(az.y),
+                       std::fabs(ax.z) + std::fabs(ay.z) + std::fabs(az.z));
+        box.boundsMin = box.center - extent;
+        box.boundsMax = box.center + extent;
+    };
+
+    switch (shape->GetType()) {
+        case ColliderShapeType::Sphere: {
+            auto sphere = std::static_pointer_cast<SphereCollider>(shape);
+            proxy.kind = ShapeProxy::Kind::Sphere;
+            proxy.radius = sphere->GetRadius() * maxScale;
+            proxy.boundsMin = proxy.center - Vector3(proxy.radius);
+            proxy.boundsMax = proxy.center + Vector3(proxy.radius);
+            break;
+        }
+        case ColliderShapeType::Box: {
+            auto box = std::static_pointer_cast<BoxCollider>(shape);
+            proxy.kind = ShapeProxy::Kind::Box;
+            const Vector3& e = box->GetHalfExtents();
+            proxy.halfExtents = Vector3(e.x * std::fabs(scale.x), e.y * std::fabs(scale.y), e.z * std::fabs(scale.z));
+            setBoxBounds(proxy);
+            break;
+        }
+        case ColliderShapeType::Capsule: {
+            auto capsule = std::static_pointer_cast<CapsuleCollider>(shape);
+            proxy.kind = ShapeProxy::Kind::Capsule;
+            proxy.axis = proxy.rotation.RotateVector(Vector3::Up) * (capsule->GetHeight() * 0.5f * std::fabs(scale.y));
+            proxy.radius = capsule->GetRadius() * std::max(std::fabs(scale.x), std::fabs(scale.z));
+            Vector3 axisExtent(std::fabs(proxy.axis.x), std::fabs(proxy.axis.y), std::fabs(proxy.axis.z));
+            proxy.boundsMin = proxy.center - axisExtent - Vector3(proxy.radius);
+            proxy.boundsMax = proxy.center + axisExtent + Vector3(proxy.radius);
+            break;
+        }
+        case ColliderShapeType::Plane: {
+            auto plane = std::static_pointer_cast<PlaneCollider>(shape);
+            proxy.kind = ShapeProxy::Kind::Plane;
+            proxy.axis = plane->GetNormal().Normalized();
+            proxy.radius = proxy.axis.Dot(position + proxy.axis * plane->GetDistance());
+            proxy.boundsMin = Vector3(-1e30f);
+            proxy.boundsMax = Vector3(1e30f);
+            break;
+        }
+        case ColliderShapeType::ConvexHull: {
+            // Approximated by the hull's oriented local bounding box
+            auto hull = std::static_pointer_cast<ConvexHullCollider>(shape);
+            const auto& vertices = hull->GetVertices();
+            if (vertices.empty()) return;
+            Vector3 localMin = vertices[0];
+            Vector3 localMax = vertices[0];
+            for (const Vector3& v : vertices) {
+                localMin = Vector3::Min(localMin, v);
+                localMax = Vector3::Max(localMax, v);
+            }
+            Vector3 localCenter = (localMin + localMax) * 0.5f;
+            Vector3 e = (localMax - localMin) * 0.5f;
+            proxy.kind = ShapeProxy::Kind::Box;
+            proxy.center = position + proxy.rotation.RotateVector(localCenter * scale);
+            proxy.halfExtents = Vector3(e.x * std::fabs(scale.x), e.y * std::fabs(scale.y), e.z * std::fabs(scale.z));
+            setBoxBounds(proxy);
+            break;
+        }
+        case ColliderShapeType::TriangleMesh: {
+            auto mesh = std::static_pointer_cast<TriangleMeshCollider>(shape);
+            const auto& vertices = mesh->GetVertices();
+            const auto& indices = mesh->GetIndices();
+            proxy.kind = ShapeProxy::Kind::Triangle;
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size()) continue;
+                proxy.v0 = position + proxy.rotation.RotateVector(vertices[indices[i]] * scale);
+                proxy.v1 = position + proxy.rotation.RotateVector(vertices[indices[i + 1]] * scale);
+                proxy.v2 = position + proxy.rotation.RotateVector(vertices[indices[i + 2]] * scale);
+                proxy.boundsMin = Vector3::Min(proxy.v0, Vector3::Min(proxy.v1, proxy.v2));
+                proxy.boundsMax = Vector3::Max(proxy.v0, Vector3::Max(proxy.v1, proxy.v2));
+                if (BoundsOverlap(proxy.boundsMin, proxy.boundsMax, boundsMin, boundsMax)) {
+                    m_proxies.push_back(proxy);
+                }
+            }
+            return;
+        }
+        default:
+            return;
+    }
+
+    if (BoundsOverlap(proxy.boundsMin, proxy.boundsMax, boundsMin, boundsMax)) {
+        m_proxies.push_back(proxy);
+    }
+}
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include "../../Core/Math/Quaternion.h"
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+    class PhysicsWorld;
+    class RigidBody;
+    class ColliderComponent;
+
+    enum CharacterCollisionFlags : uint32_t {
+        CharacterCollisionNone = 0,
+        CharacterCollisionSides = 1 << 0,
+        CharacterCollisionAbove = 1 << 1,
+        CharacterCollisionBelow = 1 << 2
+    };
+
+    struct CharacterControllerSettings {
+        float radius = 0.4f;
+        float height = 1.0f;            // Cylinder part, matching CapsuleCollider; total height is height + 2 * radius
+        float skinWidth = 0.02f;        // Gap kept between the capsule and geometry
+        float stepOffset = 0.3f;        // Highest ledge that can be stepped onto
+        float maxSlopeDegrees = 45.0f;  // Steeper surfaces are treated as walls
+        float snapDistance = 0.2f;      // How far down to search for ground after walking off a ledge or downhill
+        int maxSlideIterations = 4;
+    };
+
+    // Kinematic capsule moved with swept queries against static colliders and rigid bodies.
+    // It never enters the dynamic solver: bodies block it but are not pushed, and it is not
+    // pushed back. The capsule is always upright and its position is the capsule center.
+    class CharacterController {
+    public:
+        CharacterController() = default;
+        explicit CharacterController(const CharacterControllerSettings& settings) : m_settings(settings) {}
+
+        // Moves by displacement with collide-and-slide, step-up and ground snapping.
+        // Returns a CharacterCollisionFlags mask. Safe to call concurrently for different
+        // controllers as long as the physics world is not modified meanwhile.
+        uint32_t Move(const PhysicsWorld& world, const Vector3& displacement);
+
+        // Integrates move velocity, gravity and jumping, then calls Move
+        void Step(const PhysicsWorld& world, float deltaTime);
+
+        void SetPosition(const Vector3& position) { m_position = position; }
+        const Vector3& GetPosition() const { return m_position; }
+        Vector3 GetFootPosition() const;
+
+        // Horizontal intent used by Step; the vertical part is ignored
+        void SetMoveVelocity(const Vector3& velocity) { m_moveVelocity = velocity; }
+        const Vector3& GetMoveVelocity() const { return m_moveVelocity; }
+        void Jump(float speed);
+        float GetVerticalSpeed() const { return m_verticalSpeed; }
+        void SetVerticalSpeed(float speed) { m_verticalSpeed = speed; }
+        Vector3 GetVelocity() const { return m_velocity; }
+
+        bool IsGrounded() const { return m_grounded; }
+        const Vector3& GetGroundNormal() const { return m_groundNormal; }
+        uint32_t GetCollisionFlags() const { return m_collisionFlags; }
+
+        CharacterControllerSettings& GetSettings() { return m_settings; }
+        const CharacterControllerSettings& GetSettings() const { return m_settings; }
+
+        bool IsEnabled() const { return m_enabled; }
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+    private:
+        // World-space snapshot of one nearby collider, built once per Move
+        struct ShapeProxy {
+            enum class Kind : uint8_t { Sphere, Box, Capsule, Plane, Triangle };
+            Kind kind = Kind::Sphere;
+            Vector3 center;
+            Quaternion rotation;
+            Quaternion inverseRotation;
+            Vector3 halfExtents;        // Box
+            Vector3 axis;               // Capsule segment half vector, plane normal
+            float radius = 0.0f;        // Sphere/capsule radius, plane offset
+            Vector3 v0, v1, v2;         // Triangle corners
+            Vector3 boundsMin, boundsMax;
+        };
+
+        struct SweepHit {
+            bool hit = false;
+            float fraction = 1.0f;
+            Vector3 normal;
+            int proxyIndex = -1;
+        };
+
+        void GatherProxies(const PhysicsWorld& world, const Vector3& boundsMin, const Vector3& boundsMax);
+        void AddColliderProxies(ColliderComponent* collider, const Vector3& position, const Quaternion& rotation, const Vector3& scale,
+                                const Vector3& boundsMin, const Vector3& boundsMax);
+
+        // Signed distance between the capsule segment [segmentA, segmentB] with the given radius and
+        // one shape; normal is the direction that increases the distance fastest
+        static float ProxyDistance(const ShapeProxy& proxy, const Vector3& segmentA, const Vector3& segmentB, float radius, Vector3& normal);
+        SweepHit Sweep(const Vector3& from, const Vector3& displacement) const;
+        void Depenetrate();
+        uint32_t SlideMove(const Vector3& displacement, bool horizontal);
+        bool TryStepUp(const Vector3& horizontalDisplacement);
+        bool IsWalkable(const Vector3& normal) const;
+        // True if the hit supports the capsule from below. Resting on a ledge edge reports a slanted
+        // contact normal, so the surface just inside the edge is probed for the real ground normal.
+        bool FindGround(const SweepHit& hit, const Vector3& position, Vector3& groundNormal) const;
+
+        CharacterControllerSettings m_settings;
+        Vector3 m_position;
+        Vector3 m_moveVelocity;
+        Vector3 m_velocity;
+        float m_verticalSpeed = 0.0f;
+        bool m_grounded = false;
+        float m_pendingJumpSpeed = 0.0f;
+        Vector3 m_groundNormal = Vector3::Up;
+        uint32_t m_collisionFlags = CharacterCollisionNone;
+        bool m_enabled = true;
+
+        // Scratch storage reused between moves so steady-state stepping does not allocate
+        std::vector<ShapeProxy> m_proxies;
+        std::vector<ColliderComponent*> m_colliderScratch;
+        std::vector<RigidBody*> m_bodyScratch;
+    };
+}
@@ -0,0 +1,183 @@
+#include "ContactEvents.h"
+#include "CollisionDetection.h"
+#include "../RigidBody/RigidBody.h"
+#include "../../Core/Components/ColliderComponent.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace GameEngine {
+
+void ContactEventQueue::Swap() {
+    m_writeIndex ^= 1;
+    m_buffers[m_writeIndex].clear();
+}
+
+void ContactEventQueue::Clear() {
+    m_buffers[0].clear();
+    m_buffers[1].clear();
+}
+
+bool ContactPairTracker::MakePair(const CollisionInfo& info, TrackedPair& out) {
+    if (!info.hasCollision) return false;
+
+    out.bodyA = info.bodyA;
+    out.bodyB = info.bodyB;
+    out.colliderA = info.colliderA ? info.colliderA : (info.bodyA ? info.bodyA->GetColliderComponent() : nullptr);
+    out.colliderB = info.colliderB ? info.colliderB : (info.bodyB ? info.bodyB->GetColliderComponent() : nullptr);
+
+    // Colliders identify a pair; bodies are only used when no collider is attached
+    out.keyA = out.colliderA ? reinterpret_cast<uintptr_t>(out.colliderA) : reinterpret_cast<uintptr_t>(out.bodyA);
+    out.keyB = out.colliderB ? reinterpret_cast<uintptr_t>(out.colliderB) : reinterpret_cast<uintptr_t>(out.bodyB);
+    if (out.keyA == 0 || out.keyB == 0 || out.keyA == out.keyB) return false;
+
+    out.isTrigger = (out.colliderA && out.colliderA->IsTrigger()) || (out.colliderB && out.colliderB->IsTrigger());
+    out.info = &info;
+    return true;
+}
+
+ContactEvent ContactPairTracker::MakeEvent(ContactEventType type, const TrackedPair& pair) {
+    ContactEvent event;
+    event.type = type;
+    event.bodyA = pair.bodyA;
+    event.bodyB = pair.bodyB;
+    event.colliderA = pair.colliderA;
+    event.colliderB = pair.colliderB;
+    if (pair.info) {
+        event.contactPoint = pair.info->contactPoint;
+        event.normal = pair.info->normal;
+        event.penetration = pair.info->penetration;
+    }
+    return event;
+}
+
+void ContactPairTracker::Update(const std::vector<CollisionInfo>& collisions, ContactEventQueue& queue) {
+    m_currentPairs.clear();
+    m_currentPairs.reserve(collisions.size());
+
+    for (const auto& info : collisions) {
+        TrackedPair pair;
+        if (!MakePair(info, pair)) continue;
+        if (pair.keyA > pair.keyB) {
+            std::swap(pair.keyA, pair.keyB);
+            std::swap(pair.bodyA, pair.bodyB);
+            std::swap(pair.colliderA, pair.colliderB);
+            pair.flipped = true;
+        }
+        m_currentPairs.push_back(pair);
+    }
+
+    // Detection may run multithreaded, so order is arbitrary and the same pair can appear twice
+    std::sort(m_currentPairs.begin(), m_currentPairs.end());
+    m_currentPairs.erase(std::unique(m_currentPairs.begin(), m_currentPairs.end(),
+                                     [](const TrackedPair& a, const TrackedPair& b) { return a.SameKey(b); }),
+                         m_currentPairs.end());
+
+    auto emit = [&](ContactEventType type, const TrackedPair& pair) {
+        ContactEvent event = MakeEvent(type, pair);
+        if (pair.info && pair.flipped) event.normal = -event.normal;
+        queue.Push(event);
+    };
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < m_currentPairs.size() || j < m_previousPairs.size()) {
+        if (j >= m_previousPairs.size() || (i < m_currentPairs.size() && m_currentPairs[i] < m_previousPairs[j])) {
+            const TrackedPair& pair = m_currentPairs[i++];
+            emit(pair.isTrigger ? ContactEventType::TriggerEnter : ContactEventType::ContactBegin, pair);
+        } else if (i >= m_currentPairs.size() || m_previousPairs[j] < m_currentPairs[i]) {
+            TrackedPair pair = m_previousPairs[j++];
+            pair.info = nullptr;
+            emit(pair.isTrigger ? ContactEventType::TriggerExit : ContactEventType::ContactEnd, pair);
+        } else {
+            const TrackedPair& pair = m_currentPairs[i++];
+            const TrackedPair& previous = m_previousPairs[j++];
+            if (pair.isTrigger != previous.isTrigger) {
+                // Trigger flag toggled while touching: close the old relationship and open the new one
+                TrackedPair closing = previous;
+                closing.info = nullptr;
+                emit(closing.isTrigger ? ContactEventType::TriggerExit : ContactEventType::ContactEnd, closing);
+                emit(pair.isTrigger ? ContactEventType::TriggerEnter : ContactEventType::ContactBegin, pair);
+            } else if (!pair.isTrigger) {
+                emit(ContactEventType::ContactStay, pair);
+            }
+        }
+    }
+
+    for (auto& pair : m_currentPairs) {
+        pair.info = nullptr;
+    }
+    std::swap(m_previousPairs, m_currentPairs);
+}
+
+// removedSide(body, collider) tells whether one side of a pair is leaving the world
+template<typename Predicate>
+void ContactPairTracker::ForgetPairs(const Predicate& removedSide, ContactEventQueue* queue) {
+    auto end = std::remove_if(m_previousPairs.begin(), m_previousPairs.end(), [&](const TrackedPair& pair) {
+        bool removedA = removedSide(pair.bodyA, pair.colliderA);
+        bool removedB = removedSide(pair.bodyB, pair.colliderB);
+        if (!removedA && !removedB) return false;
+        if (queue) {
+            // The partner still sees the relationship end; the removed side may be destroyed next
+            ContactEvent event = MakeEvent(pair.isTrigger ? ContactEventType::TriggerExit : ContactEventType::ContactEnd, pair);
+            if (removedA) {
+                event.bodyA = nullptr;
+                event.colliderA = nullptr;
+            }
+            if (removedB) {
+                event.bodyB = nullptr;
+                event.colliderB = nullptr;
+            }
+            queue->Push(event);
+        }
+        return true;
+    });
+    m_previousPairs.erase(end, m_previousPairs.end());
+}
+
+void ContactPairTracker::Forget(const RigidBody* body, ContactEventQueue* queue) {
+    if (!body) return;
+    const ColliderComponent* collider = body->GetColliderComponent();
+    ForgetPairs([&](const RigidBody* pairBody, const ColliderComponent* pairCollider) {
+        return pairBody == body || (collider && pairCollider == collider);
+    }, queue);
+}
+
+void ContactPairTracker::Forget(const ColliderComponent* collider, ContactEventQueue* queue) {
+    if (!collider) return;
+    ForgetPairs([&](const RigidBody*, const ColliderComponent* pairCollider) {
+        return pairCollider == collider;
+    }, queue);
+}
+
+void ContactPairTracker::SaveState(uint8_t* dst) const {
+    if (!m_previousPairs.empty()) {
+        std::memcpy(dst, m_previousPairs.data(), m_previousPairs.size() * sizeof(TrackedPair));
+    }
+}
+
+void ContactPairTracker::RestoreState(const uint8_t* src, size_t pairCount,
+                                      const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& staticColliders) {
+    m_previousPairs.resize(pairCount);
+    if (pairCount == 0) return;
+    std::memcpy(m_previousPairs.data(), src, pairCount * sizeof(TrackedPair));
+
+    // Objects removed since the snapshot may already be destroyed, so membership is decided by
+    // address alone and only registered bodies are dereferenced
+    std::vector<const void*> registeredBodies(bodies.begin(), bodies.end());
+    std::vector<const void*> registeredStatics(staticColliders.begin(), staticColliders.end());
+    std::sort(registeredBodies.begin(), registeredBodies.end());
+    std::sort(registeredStatics.begin(), registeredStatics.end());
+    auto registered = [&](const RigidBody* body, const ColliderComponent* collider) {
+        if (body) {
+            return std::binary_search(registeredBodies.begin(), registeredBodies.end(), static_cast<const void*>(body)) &&
+                   (!collider || body->GetColliderComponent() == collider);
+        }
+        return collider && std::binary_search(registeredStatics.begin(), registeredStatics.end(), static_cast<const void*>(collider));
+    };
+    m_previousPairs.erase(std::remove_if(m_previousPairs.begin(), m_previousPairs.end(), [&](const TrackedPair& pair) {
+        return !registered(pair.bodyA, pair.colliderA) || !registered(pair.bodyB, pair.colliderB);
+    }), m_previousPairs.end());
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+    class RigidBody;
+    class ColliderComponent;
+    struct CollisionInfo;
+
+    enum class ContactEventType : uint8_t {
+        ContactBegin = 0,
+        ContactStay,
+        ContactEnd,
+        TriggerEnter,
+        TriggerExit
+    };
+
+    struct ContactEvent {
+        ContactEventType type = ContactEventType::ContactBegin;
+        RigidBody* bodyA = nullptr;
+        RigidBody* bodyB = nullptr;
+        ColliderComponent* colliderA = nullptr;
+        ColliderComponent* colliderB = nullptr;
+        Vector3 contactPoint;
+        Vector3 normal;            // Points from A to B; zero for End/Exit events
+        float penetration = 0.0f;
+    };
+
+    // Double-buffered event storage. The physics step writes into the back buffer,
+    // Swap() publishes it, and readers drain the front buffer until the next Swap().
+    // Every ContactBegin/TriggerEnter is followed by exactly one ContactEnd/TriggerExit, also
+    // when a participant leaves the world while touching: that pair then ends in the next
+    // published buffer with the removed side's body and collider set to null.
+    class ContactEventQueue {
+    public:
+        void Push(const ContactEvent& event) { m_buffers[m_writeIndex].push_back(event); }
+        void Swap();
+        void Clear();
+
+        const std::vector<ContactEvent>& GetEvents() const { return m_buffers[m_writeIndex ^ 1]; }
+        size_t GetPendingCount() const { return m_buffers[m_writeIndex].size(); }
+
+    private:
+        std::vector<ContactEvent> m_buffers[2];
+        int m_writeIndex = 0;
+    };
+
+    // Tracks the set of touching pairs between steps and emits begin/stay/end
+    // (or trigger enter/exit) events by diffing two sorted pair lists.
+    class ContactPairTracker {
+    public:
+        void Update(const std::vector<CollisionInfo>& collisions, ContactEventQueue& queue);
+
+        // Drops pairs involving a body/collider that is leaving the world and pushes their
+        // End/Exit events to queue with the removed side nulled; without a queue no events are sent
+        void Forget(const RigidBody* body, ContactEventQueue* queue);
+        void Forget(const ColliderComponent* collider, ContactEventQueue* queue);
+        void Clear() { m_previousPairs.clear(); m_currentPairs.clear(); }
+
+        size_t GetActivePairCount() const { return m_previousPairs.size(); }
+
+        // Raw pair cache for physics snapshots. Restored pairs naming a body or collider that
+        // is no longer registered are dropped without events; their pointers are never dereferenced.
+        static size_t GetPairStateSize() { return sizeof(TrackedPair); }
+        void SaveState(uint8_t* dst) const;
+        void RestoreState(const uint8_t* src, size_t pairCount,
+                          const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& staticColliders);
+
+    private:
+        struct TrackedPair {
+            uintptr_t keyA = 0;
+            uintptr_t keyB = 0;
+            bool isTrigger = false;
+            bool flipped = false;                // Participants swapped relative to info
+            const CollisionInfo* info = nullptr; // Valid only during Update()
+            RigidBody* bodyA = nullptr;
+            RigidBody* bodyB = nullptr;
+            ColliderComponent* colliderA = nullptr;
+            ColliderComponent* colliderB = nullptr;
+
+            bool operator<(const TrackedPair& other) const {
+                return keyA != other.keyA ? keyA < other.keyA : keyB < other.keyB;
+            }
+            bool SameKey(const TrackedPair& other) const {
+                return keyA == other.keyA && keyB == other.keyB;
+            }
+        };
+
+        static bool MakePair(const CollisionInfo& info, TrackedPair& out);
+        static ContactEvent MakeEvent(ContactEventType type, const TrackedPair& pair);
+        template<typename Predicate>
+        void ForgetPairs(const Predicate& removedSide, ContactEventQueue* queue);
+
+        std::vector<TrackedPair> m_previousPairs;
+        std::vector<TrackedPair> m_currentPairs;
+    };
+}
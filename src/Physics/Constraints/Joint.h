@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include "../../Core/Math/Quaternion.h"
+#include <cstdint>
+
+namespace GameEngine {
+    class RigidBody;
+
+    enum class JointType : uint8_t {
+        Distance = 0,   // Keeps anchor points within [minDistance, maxDistance]
+        BallSocket,     // Anchor points coincide, free rotation
+        Hinge,          // Ball socket plus a shared rotation axis, optional limits and motor
+        Fixed           // Anchor points coincide and relative orientation is locked
+    };
+
+    using JointHandle = uint32_t;
+    constexpr JointHandle INVALID_JOINT_HANDLE = 0xFFFFFFFFu;
+
+    // One scalar velocity constraint. Linear rows act on the anchor points,
+    // angular rows act on the relative angular velocity only.
+    struct JointRow {
+        Vector3 axis;
+        float effectiveMass = 0.0f;     // 1 / (J M^-1 J^T); zero marks the row inactive
+        float bias = 0.0f;
+        float targetVelocity = 0.0f;    // Used by motors
+        float impulse = 0.0f;           // Accumulated over the step, kept for warm starting
+        float lowerImpulse = -1e30f;
+        float upperImpulse = 1e30f;
+    };
+
+    struct Joint {
+        static constexpr int MaxLinearRows = 3;
+        static constexpr int MaxAngularRows = 4;
+        // Fixed angular row layout for hinges so accumulated impulses stay in their slot
+        static constexpr int HingeLimitRow = 2;
+        static constexpr int HingeMotorRow = 3;
+
+        JointType type = JointType::BallSocket;
+        JointHandle handle = INVALID_JOINT_HANDLE;
+        RigidBody* bodyA = nullptr;     // nullptr anchors the joint to the world
+        RigidBody* bodyB = nullptr;
+        bool enabled = true;
+
+        // Body-space definition
+        Vector3 localAnchorA;
+        Vector3 localAnchorB;
+        Vector3 localAxisA;             // Hinge axis
+        Vector3 localAxisB;
+        Vector3 localReferenceA;        // Hinge zero angle, perpendicular to the axis
+        Vector3 localReferenceB;
+        Quaternion restRotation;        // Fixed joint: rotation of B relative to A at creation
+
+        // Distance joint range
+        float minDistance = 0.0f;
+        float maxDistance = 0.0f;
+
+        // Hinge limits (radians) and motor
+        bool enableLimit = false;
+        float lowerAngle = 0.0f;
+        float upperAngle = 0.0f;
+        bool enableMotor = false;
+        float motorSpeed = 0.0f;        // Target relative angular speed (rad/s)
+        float maxMotorTorque = 0.0f;
+
+        // Solver cache, rebuilt every step by JointSolver::PreStep
+        Vector3 rA;
+        Vector3 rB;
+        float invMassA = 0.0f;
+        float invMassB = 0.0f;
+        bool dynamicA = false;
+        bool dynamicB = false;
+        bool active = false;
+        uint8_t linearRowCount = 0;
+        uint8_t angularRowCount = 0;
+        JointRow linearRows[MaxLinearRows];
+        JointRow angularRows[MaxAngularRows];
+    };
+}
@@ -0,0 +1,536 @@
+#include "JointSolver.h"
+#include "../RigidBody/RigidBody.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Threading/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr float kUnbounded = 1e30f;
+constexpr int kMaxColors = 64;
+
+Vector3 BodyPosition(const RigidBody* body) {
+    return body ? body->GetPosition() : Vector3::Zero;
+}
+
+Quaternion BodyRotation(const RigidBody* body) {
+    return body ? body->GetRotation() : Quaternion::Identity();
+}
+
+Vector3 InvInertiaMultiply(const RigidBody* body, bool dynamic, const Vector3& v) {
+    if (!dynamic || body->IsFreezeRotation()) return Vector3::Zero;
+    return body->InvInertiaWorldMultiply(v);
+}
+
+Vector3 AnyPerpendicular(const Vector3& n) {
+    Vector3 other = std::fabs(n.x) < 0.57735f ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+    return n.Cross(other).Normalized();
+}
+
+float ComputeEffectiveMass(float K) {
+    return K > 1e-8f ? 1.0f / K : 0.0f;
+}
+
+}
+
+JointHandle JointSolver::AllocateJoint(JointType type, RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchorA, const Vector3& worldAnchorB) {
+    if (!bodyB || bodyA == bodyB) {
+        Logger::Warning("JointSolver: joint needs a distinct bodyB (bodyA may be null to anchor to the world)");
+        return INVALID_JOINT_HANDLE;
+    }
+
+    JointHandle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<JointHandle>(m_handleToIndex.size());
+        m_handleToIndex.push_back(INVALID_JOINT_HANDLE);
+    }
+
+    Joint joint;
+    joint.type = type;
+    joint.handle = handle;
+    joint.bodyA = bodyA;
+    joint.bodyB = bodyB;
+    joint.localAnchorA = BodyRotation(bodyA).Inverse().RotateVector(worldAnchorA - BodyPosition(bodyA));
+    joint.localAnchorB = BodyRotation(bodyB).Inverse().RotateVector(worldAnchorB - BodyPosition(bodyB));
+
+    m_handleToIndex[handle] = static_cast<uint32_t>(m_joints.size());
+    m_joints.push_back(joint);
+    m_batchesDirty = true;
+    return handle;
+}
+
+JointHandle JointSolver::CreateDistanceJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchorA, const Vector3& worldAnchorB) {
+    JointHandle handle = AllocateJoint(JointType::Distance, bodyA, bodyB, worldAnchorA, worldAnchorB);
+    if (Joint* joint = GetJoint(handle)) {
+        float length = (worldAnchorB - worldAnchorA).Length();
+        joint->minDistance = length;
+        joint->maxDistance = length;
+    }
+    return handle;
+}
+
+JointHandle JointSolver::CreateBallSocketJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor) {
+    return AllocateJoint(JointType::BallSocket, bodyA, bodyB, worldAnchor, worldAnchor);
+}
+
+JointHandle JointSolver::CreateHingeJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor, const Vector3& worldAxis) {
+    JointHandle handle = AllocateJoint(JointType::Hinge, bodyA, bodyB, worldAnchor, worldAnchor);
+    if (Joint* joint = GetJoint(handle)) {
+        Vector3 axis = worldAxis.Normalized();
+        if (axis.LengthSquared() < 1e-8f) axis = Vector3::Up;
+        Vector3 reference = AnyPerpendicular(axis);
+        Quaternion invA = BodyRotation(bodyA).Inverse();
+        Quaternion invB = BodyRotation(bodyB).Inverse();
+        joint->localAxisA = invA.RotateVector(axis);
+        joint->localAxisB = invB.RotateVector(axis);
+        joint->localReferenceA = invA.RotateVector(reference);
+        joint->localReferenceB = invB.RotateVector(reference);
+    }
+    return handle;
+}
+
+JointHandle JointSolver::CreateFixedJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor) {
+    JointHandle handle = AllocateJoint(JointType::Fixed, bodyA, bodyB, worldAnchor, worldAnchor);
+    if (Joint* joint = GetJoint(handle)) {
+        joint->restRotation = (BodyRotation(bodyA).Inverse() * BodyRotation(bodyB)).Normalized();
+    }
+    return handle;
+}
+
+void JointSolver::RemoveJoint(JointHandle handle) {
+    if (handle >= m_handleToIndex.size() || m_handleToIndex[handle] == INVALID_JOINT_HANDLE) return;
+
+    uint32_t index = m_handleToIndex[handle];
+    uint32_t last = static_cast<uint32_t>(m_joints.size() - 1);
+    if (index != last) {
+        m_joints[index] = m_joints[last];
+        m_handleToIndex[m_joints[index].handle] = index;
+    }
+    m_joints.pop_back();
+    m_handleToIndex[handle] = INVALID_JOINT_HANDLE;
+    m_freeHandles.push_back(handle);
+    m_batchesDirty = true;
+}
+
+void JointSolver::RemoveJointsForBody(const RigidBody* body) {
+    if (!body) return;
+    for (size_t i = m_joints.size(); i-- > 0;) {
+        if (m_joints[i].bodyA == body || m_joints[i].bodyB == body) {
+            RemoveJoint(m_joints[i].handle);
+        }
+    }
+}
+
+void JointSolver::Clear() {
+    m_joints.clear();
+    m_handleToIndex.clear();
+    m_freeHandles.clear();
+    m_batchStarts.clear();
+    m_batchesDirty = true;
+}
+
+Joint* JointSolver::GetJoint(JointHandle handle) {
+    if (handle >= m_handleToIndex.size() || m_handleToIndex[handle] == INVALID_JOINT_HANDLE) return nullptr;
+    return &m_joints[m_handleToIndex[handle]];
+}
+
+const Joint* JointSolver::GetJoint(JointHandle handle) const {
+    return const_cast<JointSolver*>(this)->GetJoint(handle);
+}
+
+void JointSolver::SetJointEnabled(JointHandle handle, bool enabled) {
+    if (Joint* joint = GetJoint(handle)) {
+        joint->enabled = enabled;
+    }
+}
+
+void JointSolver::SetDistanceLimits(JointHandle handle, float minDistance, float maxDistance) {
+    Joint* joint = GetJoint(handle);
+    if (!joint || joint->type != JointType::Distance) return;
+    joint->minDistance = std::max(0.0f, std::min(minDistance, maxDistance));
+    joint->maxDistance = std::max(minDistance, maxDistance);
+}
+
+void JointSolver::SetHingeLimits(JointHandle handle, bool enable, float lowerAngle, float upperAngle) {
+    Joint* joint = GetJoint(handle);
+    if (!joint || joint->type != JointType::Hinge) return;
+    joint->enableLimit = enable;
+    joint->lowerAngle = std::min(lowerAngle, upperAngle);
+    joint->upperAngle = std::max(lowerAngle, upperAngle);
+}
+
+void JointSolver::SetHingeMotor(JointHandle handle, bool enable, float motorSpeed, float maxMotorTorque) {
+    Joint* joint = GetJoint(handle);
+    if (!joint || joint->type != JointType::Hinge) return;
+    joint->enableMotor = enable;
+    joint->motorSpeed = motorSpeed;
+    joint->maxMotorTorque = std::max(0.0f, maxMotorTorque);
+}
+
+float JointSolver::GetHingeAngle(JointHandle handle) const {
+    const Joint* joint = GetJoint(handle);
+    if (!joint || joint->type != JointType::Hinge) return 0.0f;
+    return ComputeHingeAngle(*joint);
+}
+
+float JointSolver::ComputeHingeAngle(const Joint& joint) const {
+    Quaternion qA = BodyRotation(joint.bodyA);
+    Quaternion qB = BodyRotation(joint.bodyB);
+    Vector3 axis = qA.RotateVector(joint.localAxisA).Normalized();
+    Vector3 refA = qA.RotateVector(joint.localReferenceA);
+    Vector3 refB = qB.RotateVector(joint.localReferenceB);
+    return std::atan2(axis.Dot(refA.Cross(refB)), refA.Dot(refB));
+}
+
+void JointSolver::SaveImpulses(uint8_t* dst) const {
+    for (size_t i = 0; i < m_joints.size(); ++i) {
+        const Joint& joint = m_joints[i];
+        ImpulseRecord record;
+        record.handle = joint.handle;
+        for (int r = 0; r < Joint::MaxLinearRows; ++r) record.linear[r] = joint.linearRows[r].impulse;
+        for (int r = 0; r < Joint::MaxAngularRows; ++r) record.angular[r] = joint.angularRows[r].impulse;
+        std::memcpy(dst + i * sizeof(ImpulseRecord), &record, sizeof(ImpulseRecord));
+    }
+}
+
+void JointSolver::RestoreImpulses(const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        ImpulseRecord record;
+        std::memcpy(&record, src + i * sizeof(ImpulseRecord), sizeof(ImpulseRecord));
+        Joint* joint = GetJoint(record.handle);
+        if (!joint) continue;
+        for (int r = 0; r < Joint::MaxLinearRows; ++r) joint->linearRows[r].impulse = record.linear[r];
+        for (int r = 0; r < Joint::MaxAngularRows; ++r) joint->angularRows[r].impulse = record.angular[r];
+    }
+}
+
+void JointSolver::RebuildBatches() {
+    // Greedy coloring: a joint takes the lowest color not yet used by either of its dynamic bodies.
+    // Joints that exhaust the palette go into a trailing batch that is always solved serially.
+    std::unordered_map<const RigidBody*, uint64_t> usedColors;
+    usedColors.reserve(m_joints.size() * 2);
+    std::vector<int> colors(m_joints.size(), kMaxColors);
+    std::vector<size_t> colorCounts(kMaxColors + 1, 0);
+
+    for (size_t i = 0; i < m_joints.size(); ++i) {
+        Joint& joint = m_joints[i];
+        joint.dynamicA = joint.bodyA && joint.bodyA->IsDynamic();
+        joint.dynamicB = joint.bodyB && joint.bodyB->IsDynamic();
+
+        uint64_t mask = 0;
+        if (joint.dynamicA) mask |= usedColors[joint.bodyA];
+        if (joint.dynamicB) mask |= usedColors[joint.bodyB];
+
+        int color = kMaxColors;
+        for (int c = 0; c < kMaxColors; ++c) {
+            if (!(mask & (uint64_t(1) << c))) { color = c; break; }
+        }
+        if (color < kMaxColors) {
+            if (joint.dynamicA) usedColors[joint.bodyA] |= uint64_t(1) << color;
+            if (joint.dynamicB) usedColors[joint.bodyB] |= uint64_t(1) << color;
+        }
+        colors[i] = color;
+        colorCounts[color]++;
+    }
+
+    std::vector<size_t> offsets(kMaxColors + 2, 0);
+    for (int c = 0; c <= kMaxColors; ++c) {
+        offsets[c + 1] = offsets[c] + colorCounts[c];
+    }
+
+    m_batchStarts.clear();
+    for (int c = 0; c <= kMaxColors; ++c) {
+        if (colorCounts[c] > 0) m_batchStarts.push_back(offsets[c]);
+    }
+    m_batchStarts.push_back(m_joints.size());
+
+    std::vector<Joint> sorted(m_joints.size());
+    for (size_t i = 0; i < m_joints.size(); ++i) {
+        size_t dst = offsets[colors[i]]++;
+        sorted[dst] = m_joints[i];
+        m_handleToIndex[sorted[dst].handle] = static_cast<uint32_t>(dst);
+    }
+    m_joints.swap(sorted);
+    m_serialStart = m_joints.size() - colorCounts[kMaxColors];
+    m_batchesDirty = false;
+
+    if (colorCounts[kMaxColors] > 0) {
+        Logger::Debug("JointSolver: " + std::to_string(colorCounts[kMaxColors]) + " joints exceed the batch palette and are solved serially");
+    }
+}
+
+void JointSolver::PreStep(float deltaTime) {
+    m_deltaTime = deltaTime;
+    if (m_joints.empty()) return;
+
+    for (const Joint& joint : m_joints) {
+        if (joint.dynamicA != (joint.bodyA && joint.bodyA->IsDynamic()) ||
+            joint.dynamicB != (joint.bodyB && joint.bodyB->IsDynamic())) {
+            m_batchesDirty = true;
+            break;
+        }
+    }
+    if (m_batchesDirty) {
+        RebuildBatches();
+    }
+
+    const float invDt = deltaTime > 0.0f ? 1.0f / deltaTime : 0.0f;
+    const float biasFactor = m_baumgarte * invDt;
+
+    for (Joint& joint : m_joints) {
+        RigidBody* A = joint.bodyA;
+        RigidBody* B = joint.bodyB;
+
+        bool awakeA = joint.dynamicA && !A->IsSleeping();
+        bool awakeB = joint.dynamicB && !B->IsSleeping();
+        joint.active = joint.enabled && (awakeA || awakeB);
+        if (!joint.active) continue;
+        // Connected bodies sleep and wake together
+        if (joint.dynamicA && !awakeA) A->WakeUp();
+        if (joint.dynamicB && !awakeB) B->WakeUp();
+
+        Vector3 pA = BodyPosition(A);
+        Vector3 pB = BodyPosition(B);
+        Quaternion qA = BodyRotation(A);
+        Quaternion qB = BodyRotation(B);
+        joint.rA = qA.RotateVector(joint.localAnchorA);
+        joint.rB = qB.RotateVector(joint.localAnchorB);
+        joint.invMassA = joint.dynamicA ? A->GetInverseMass() : 0.0f;
+        joint.invMassB = joint.dynamicB ? B->GetInverseMass() : 0.0f;
+
+        Vector3 separation = (pB + joint.rB) - (pA + joint.rA);
+
+        auto setLinearRow = [&](JointRow& row, const Vector3& axis, float C, float lower, float upper) {
+            Vector3 rnA = joint.rA.Cross(axis);
+            Vector3 rnB = joint.rB.Cross(axis);
+            float K = joint.invMassA + joint.invMassB +
+                      rnA.Dot(InvInertiaMultiply(A, joint.dynamicA, rnA)) +
+                      rnB.Dot(InvInertiaMultiply(B, joint.dynamicB, rnB));
+            row.axis = axis;
+            row.effectiveMass = ComputeEffectiveMass(K);
+            row.bias = biasFactor * C;
+            row.targetVelocity = 0.0f;
+            row.lowerImpulse = lower;
+            row.upperImpulse = upper;
+        };
+        auto setAngularRow = [&](JointRow& row, const Vector3& axis, float C, float lower, float upper) {
+            float K = axis.Dot(InvInertiaMultiply(A, joint.dynamicA, axis)) +
+                      axis.Dot(InvInertiaMultiply(B, joint.dynamicB, axis));
+            row.axis = axis;
+            row.effectiveMass = ComputeEffectiveMass(K);
+            row.bias = biasFactor * C;
+            row.targetVelocity = 0.0f;
+            row.lowerImpulse = lower;
+            row.upperImpulse = upper;
+        };
+        auto disableRow = [](JointRow& row) {
+            row.effectiveMass = 0.0f;
+            row.impulse = 0.0f;
+        };
+        auto setPointRows = [&]() {
+            joint.linearRowCount = 3;
+            setLinearRow(joint.linearRows[0], Vector3(1.0f, 0.0f, 0.0f), separation.x, -kUnbounded, kUnbounded);
+            setLinearRow(joint.linearRows[1], Vector3(0.0f, 1.0f, 0.0f), separation.y, -kUnbounded, kUnbounded);
+            setLinearRow(joint.linearRows[2], Vector3(0.0f, 0.0f, 1.0f), separation.z, -kUnbounded, kUnbounded);
+        };
+
+        joint.linearRowCount = 0;
+        joint.angularRowCount = 0;
+
+        switch (joint.type) {
+            case JointType::Distance: {
+                joint.linearRowCount = 1;
+                JointRow& row = joint.linearRows[0];
+                float length = separation.Length();
+                Vector3 axis = length > 1e-6f ? separation / length : Vector3(0.0f, 1.0f, 0.0f);
+                if (joint.maxDistance - joint.minDistance < m_linearSlop) {
+                    setLinearRow(row, axis, length - joint.maxDistance, -kUnbounded, kUnbounded);
+                } else if (length > joint.maxDistance) {
+                    setLinearRow(row, axis, length - joint.maxDistance, -kUnbounded, 0.0f);
+                } else if (length < joint.minDistance) {
+                    setLinearRow(row, axis, length - joint.minDistance, 0.0f, kUnbounded);
+                } else {
+                    disableRow(row);
+                }
+                break;
+            }
+            case JointType::BallSocket:
+                setPointRows();
+                break;
+            case JointType::Hinge: {
+                setPointRows();
+                joint.angularRowCount = Joint::MaxAngularRows;
+                Vector3 axisA = qA.RotateVector(joint.localAxisA).Normalized();
+                Vector3 axisB = qB.RotateVector(joint.localAxisB).Normalized();
+                Vector3 t1 = AnyPerpendicular(axisA);
+                Vector3 t2 = axisA.Cross(t1);
+                Vector3 misalignment = axisA.Cross(axisB);
+                setAngularRow(joint.angularRows[0], t1, misalignment.Dot(t1), -kUnbounded, kUnbounded);
+                setAngularRow(joint.angularRows[1], t2, misalignment.Dot(t2), -kUnbounded, kUnbounded);
+
+                JointRow& limitRow = joint.angularRows[Joint::HingeLimitRow];
+                if (joint.enableLimit) {
+                    float angle = ComputeHingeAngle(joint);
+                    if (joint.upperAngle - joint.lowerAngle < 1e-3f) {
+                        setAngularRow(limitRow, axisA, angle - joint.lowerAngle, -kUnbounded, kUnbounded);
+                    } else if (angle <= joint.lowerAngle) {
+                        setAngularRow(limitRow, axisA, angle - joint.lowerAngle, 0.0f, kUnbounded);
+                    } else if (angle >= joint.upperAngle) {
+                        setAngularRow(limitRow, axisA, angle - joint.upperAngle, -kUnbounded, 0.0f);
+                    } else {
+                        disableRow(limitRow);
+                    }
+                } else {
+                    disableRow(limitRow);
+                }
+
+                JointRow& motorRow = joint.angularRows[Joint::HingeMotorRow];
+                if (joint.enableMotor && joint.maxMotorTorque > 0.0f) {
+                    float maxImpulse = joint.maxMotorTorque * deltaTime;
+                    setAngularRow(motorRow, axisA, 0.0f, -maxImpulse, maxImpulse);
+                    motorRow.bias = 0.0f;
+                    motorRow.targetVelocity = joint.motorSpeed;
+                } else {
+                    disableRow(motorRow);
+                }
+                break;
+            }
+            case JointType::Fixed: {
+                setPointRows();
+                joint.angularRowCount = 3;
+                Quaternion target = qA * joint.restRotation;
+                Quaternion delta = (qB * target.Inverse()).Normalized();
+                if (delta.w < 0.0f) delta = delta * -1.0f;
+                Vector3 error(2.0f * delta.x, 2.0f * delta.y, 2.0f * delta.z);
+                setAngularRow(joint.angularRows[0], Vector3(1.0f, 0.0f, 0.0f), error.x, -kUnbounded, kUnbounded);
+                setAngularRow(joint.angularRows[1], Vector3(0.0f, 1.0f, 0.0f), error.y, -kUnbounded, kUnbounded);
+                setAngularRow(joint.angularRows[2], Vector3(0.0f, 0.0f, 1.0f), error.z, -kUnbounded, kUnbounded);
+                break;
+            }
+        }
+
+        // Warm start with last step's impulses (or reset them)
+        Vector3 linearImpulse = Vector3::Zero;
+        Vector3 angularImpulseA = Vector3::Zero;
+        Vector3 angularImpulseB = Vector3::Zero;
+        for (int r = 0; r < joint.linearRowCount; ++r) {
+            JointRow& row = joint.linearRows[r];
+            if (!m_warmStarting || row.effectiveMass == 0.0f) { row.impulse = 0.0f; continue; }
+            row.impulse = std::clamp(row.impulse, row.lowerImpulse, row.upperImpulse);
+            Vector3 P = row.axis * row.impulse;
+            linearImpulse += P;
+            angularImpulseA += joint.rA.Cross(P);
+            angularImpulseB += joint.rB.Cross(P);
+        }
+        for (int r = 0; r < joint.angularRowCount; ++r) {
+            JointRow& row = joint.angularRows[r];
+            if (!m_warmStarting || row.effectiveMass == 0.0f) { row.impulse = 0.0f; continue; }
+            row.impulse = std::clamp(row.impulse, row.lowerImpulse, row.upperImpulse);
+            angularImpulseA += row.axis * row.impulse;
+            angularImpulseB += row.axis * row.impulse;
+        }
+        if (joint.dynamicA) {
+            A->SetVelocity(A->GetVelocity() - linearImpulse * joint.invMassA);
+            A->SetAngularVelocity(A->GetAngularVelocity() - InvInertiaMultiply(A, true, angularImpulseA));
+        }
+        if (joint.dynamicB) {
+            B->SetVelocity(B->GetVelocity() + linearImpulse * joint.invMassB);
+            B->SetAngularVelocity(B->GetAngularVelocity() + InvInertiaMultiply(B, true, angularImpulseB));
+        }
+    }
+}
+
+void JointSolver::SolveRange(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        Joint& joint = m_joints[i];
+        if (!joint.active) continue;
+
+        RigidBody* A = joint.bodyA;
+        RigidBody* B = joint.bodyB;
+        Vector3 vA = joint.dynamicA ? A->GetVelocity() : Vector3::Zero;
+        Vector3 wA = joint.dynamicA ? A->GetAngularVelocity() : Vector3::Zero;
+        Vector3 vB = joint.dynamicB ? B->GetVelocity() : Vector3::Zero;
+        Vector3 wB = joint.dynamicB ? B->GetAngularVelocity() : Vector3::Zero;
+
+        // Angular rows first so the motor and limits see the point constraint's correction last
+        for (int r = 0; r < joint.angularRowCount; ++r) {
+            JointRow& row = joint.angularRows[r];
+            if (row.effectiveMass == 0.0f) continue;
+            float Cdot = row.axis.Dot(wB - wA);
+            float lambda = -(Cdot - row.targetVelocity + row.bias) * row.effectiveMass;
+            float previous = row.impulse;
+            row.impulse = std::clamp(previous + lambda, row.lowerImpulse, row.upperImpulse);
+            lambda = row.impulse - previous;
+            Vector3 L = row.axis * lambda;
+            wA -= InvInertiaMultiply(A, joint.dynamicA, L);
+            wB += InvInertiaMultiply(B, joint.dynamicB, L);
+        }
+
+        for (int r = 0; r < joint.linearRowCount; ++r) {
+            JointRow& row = joint.linearRows[r];
+            if (row.effectiveMass == 0.0f) continue;
+            Vector3 relVel = (vB + wB.Cross(joint.rB)) - (vA + wA.Cross(joint.rA));
+            float Cdot = row.axis.Dot(relVel);
+            float lambda = -(Cdot + row.bias) * row.effectiveMass;
+            float previous = row.impulse;
+            row.impulse = std::clamp(previous + lambda, row.lowerImpulse, row.upperImpulse);
+            lambda = row.impulse - previous;
+            Vector3 P = row.axis * lambda;
+            vA -= P * joint.invMassA;
+            wA -= InvInertiaMultiply(A, joint.dynamicA, joint.rA.Cross(P));
+            vB += P * joint.invMassB;
+            wB += InvInertiaMultiply(B, joint.dynamicB, joint.rB.Cross(P));
+        }
+
+        if (joint.dynamicA) {
+            A->SetVelocity(vA);
+            A->SetAngularVelocity(wA);
+        }
+        if (joint.dynamicB) {
+            B->SetVelocity(vB);
+            B->SetAngularVelocity(wB);
+        }
+    }
+}
+
+void JointSolver::SolveVelocities() {
+    if (m_joints.empty() || m_batchStarts.size() < 2) return;
+
+    auto workerCount = WorkerPool::Instance().GetThreadCount();
+    for (size_t b = 0; b + 1 < m_batchStarts.size(); ++b) {
+        size_t begin = m_batchStarts[b];
+        size_t end = m_batchStarts[b + 1];
+        size_t total = end - begin;
+
+        if (workerCount <= 1 || total < m_parallelBatchThreshold || begin >= m_serialStart) {
+            SolveRange(begin, end);
+            continue;
+        }
+
+        SolveBatchParallel(begin, end);
+    }
+}
+
+void JointSolver::SolveBatchParallel(size_t begin, size_t end) {
+    WorkerPool& pool = WorkerPool::Instance();
+    // A few chunks per thread so uneven joint types still balance
+    const size_t threadCount = pool.GetThreadCount();
+    const size_t chunkSize = std::max<size_t>(32, (end - begin + threadCount * 4 - 1) / (threadCount * 4));
+    const size_t chunkCount = (end - begin + chunkSize - 1) / chunkSize;
+    // ParallelFor returns once every chunk is solved, which the next batch relies on since
+    // it may touch the same bodies
+    pool.ParallelFor(chunkCount, [&](size_t chunk, size_t) {
+        size_t start = begin + chunk * chunkSize;
+        SolveRange(start, std::min(end, start + chunkSize));
+    });
+}
+
+}
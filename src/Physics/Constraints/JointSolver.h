@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Joint.h"
+#include <vector>
+
+namespace GameEngine {
+    class RigidBody;
+
+    // Owns all joints in one contiguous array and solves them with sequential impulses.
+    // Joints are graph-colored so that no two joints in the same batch write the same
+    // dynamic body; each batch is a contiguous range that can be split across threads.
+    // Large batches are split into chunks on the shared WorkerPool, since batches are
+    // dispatched many times per step.
+    class JointSolver {
+    public:
+        JointSolver() = default;
+        ~JointSolver() = default;
+
+        // Creation (anchors/axes are given in world space at the current body poses)
+        JointHandle CreateDistanceJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchorA, const Vector3& worldAnchorB);
+        JointHandle CreateBallSocketJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor);
+        JointHandle CreateHingeJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor, const Vector3& worldAxis);
+        JointHandle CreateFixedJoint(RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchor);
+
+        void RemoveJoint(JointHandle handle);
+        void RemoveJointsForBody(const RigidBody* body);
+        void Clear();
+
+        Joint* GetJoint(JointHandle handle);
+        const Joint* GetJoint(JointHandle handle) const;
+        const std::vector<Joint>& GetJoints() const { return m_joints; }
+        size_t GetJointCount() const { return m_joints.size(); }
+        size_t GetBatchCount() const { return m_batchStarts.empty() ? 0 : m_batchStarts.size() - 1; }
+
+        // Limits and motors
+        void SetJointEnabled(JointHandle handle, bool enabled);
+        void SetDistanceLimits(JointHandle handle, float minDistance, float maxDistance);
+        void SetHingeLimits(JointHandle handle, bool enable, float lowerAngle = 0.0f, float upperAngle = 0.0f);
+        void SetHingeMotor(JointHandle handle, bool enable, float motorSpeed = 0.0f, float maxMotorTorque = 0.0f);
+        float GetHingeAngle(JointHandle handle) const;
+
+        // Solver settings
+        void SetBaumgarte(float beta) { m_baumgarte = beta; }
+        float GetBaumgarte() const { return m_baumgarte; }
+        void SetWarmStarting(bool enable) { m_warmStarting = enable; }
+        bool GetWarmStarting() const { return m_warmStarting; }
+        void SetParallelBatchThreshold(size_t threshold) { m_parallelBatchThreshold = threshold; }
+
+        // Accumulated impulses (the warm-start cache) for physics snapshots
+        struct ImpulseRecord {
+            JointHandle handle = INVALID_JOINT_HANDLE;
+            float linear[Joint::MaxLinearRows] = {};
+            float angular[Joint::MaxAngularRows] = {};
+        };
+        void SaveImpulses(uint8_t* dst) const;
+        void RestoreImpulses(const uint8_t* src, size_t count);
+
+        // Called by PhysicsWorld once per step before the iteration loop, then once per iteration
+        void PreStep(float deltaTime);
+        void SolveVelocities();
+
+    private:
+        JointHandle AllocateJoint(JointType type, RigidBody* bodyA, RigidBody* bodyB, const Vector3& worldAnchorA, const Vector3& worldAnchorB);
+        void RebuildBatches();
+        void SolveRange(size_t begin, size_t end);
+        void SolveBatchParallel(size_t begin, size_t end);
+        float ComputeHingeAngle(const Joint& joint) const;
+
+        std::vector<Joint> m_joints;
+        std::vector<uint32_t> m_handleToIndex;     // INVALID_JOINT_HANDLE for freed handles
+        std::vector<JointHandle> m_freeHandles;
+        std::vector<size_t> m_batchStarts;         // Batch b spans [m_batchStarts[b], m_batchStarts[b + 1])
+        size_t m_serialStart = 0;                  // Joints past this index could not be colored
+        bool m_batchesDirty = true;
+
+        float m_deltaTime = 1.0f / 60.0f;
+        float m_baumgarte = 0.2f;
+        float m_linearSlop = 0.005f;
+        bool m_warmStarting = true;
+        size_t m_parallelBatchThreshold = 256;
+    };
+}
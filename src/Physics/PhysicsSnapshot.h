@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RigidBody/RigidBody.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine {
+    // Contiguous binary copy of a PhysicsWorld's simulation state (bodies, joint impulses,
+    // contact pair cache and the step accumulator). The buffer is reused between saves, so
+    // repeated SaveSnapshot/RestoreSnapshot calls do not allocate once it has grown.
+    class PhysicsSnapshot {
+    public:
+        static constexpr uint32_t Magic = 0x53594850; // "PHYS"
+        static constexpr uint32_t Version = 1;
+
+        struct Header {
+            uint32_t magic = Magic;
+            uint32_t version = Version;
+            uint32_t bodyCount = 0;
+            uint32_t jointCount = 0;
+            uint32_t contactPairCount = 0;
+            float accumulator = 0.0f;
+        };
+
+        struct BodyRecord {
+            uint64_t bodyId = 0;        // Identity check only; valid within the process that saved it
+            RigidBody::SimulationState state;
+        };
+
+        bool IsValid() const { return m_data.size() >= sizeof(Header); }
+        const uint8_t* GetData() const { return m_data.data(); }
+        size_t GetSize() const { return m_data.size(); }
+
+        // For storing snapshots in rollback ring buffers or sending them elsewhere
+        void Assign(const uint8_t* data, size_t size) { m_data.assign(data, data + size); }
+        void Clear() { m_data.clear(); }
+        void Reserve(size_t size) { m_data.reserve(size); }
+
+    private:
+        friend class PhysicsWorld;
+        uint8_t* Resize(size_t size) { m_data.resize(size); return m_data.data(); }
+
+        std::vector<uint8_t> m_data;
+    };
+}
@@ -2,13 +2,21 @@
 #include "RigidBody/RigidBody.h"
 #include "Collision/CollisionDetection.h"
 #include "Spatial/Octree.h"
+#include "Constraints/JointSolver.h"
+#include "Character/CharacterController.h"
+#include "PhysicsSnapshot.h"
 #include "2D/PhysicsWorld2D.h"
+#include "../Core/Components/ColliderComponent.h"
 #include "../Core/Logging/Logger.h"
 #include "../Core/Profiling/Profiler.h"
+#include "../Core/Threading/WorkerPool.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <string>
 #include <vector>
 
 namespace GameEngine {
@@ -25,10 +33,14 @@ void PhysicsWorld::Initialize() {
         return;
     }
     
+    for (RigidBody* body : m_rigidBodies) {
+        body->m_worldIndex = RigidBody::InvalidWorldIndex;
+    }
     m_rigidBodies.clear();
     
     AABB worldBounds(Vector3(-1000, -1000, -1000), Vector3(1000, 1000, 1000));
     m_octree = std::make_unique<Octree>(worldBounds);
+    m_jointSolver = std::make_unique<JointSolver>();
     
     if (m_enable2DPhysics) {
         m_physicsWorld2D = std::make_unique<PhysicsWorld2D>();
@@ -43,8 +55,15 @@ void PhysicsWorld::Initialize() {
 
 void PhysicsWorld::Shutdown() {
     if (m_initialized) {
+        for (RigidBody* body : m_rigidBodies) {
+            body->m_worldIndex = RigidBody::InvalidWorldIndex;
+        }
         m_rigidBodies.clear();
+        m_characterControllers.clear();
         m_octree.reset();
+        m_jointSolver.reset();
+        m_contactTracker.Clear();
+        m_contactEvents.Clear();
         
         if (m_physicsWorld2D) {
             m_physicsWorld2D->Shutdown();
@@ -63,25 +82,28 @@ void PhysicsWorld::Update(float deltaTime) {
     if (!m_initialized) return;
     
     const float fixedDeltaTime = 1.0f / 60.0f; // 60 FPS physics
-    static float accumulator = 0.0f;
     
-    accumulator += deltaTime;
+    m_accumulator += deltaTime;
     
     int stepCount = 0;
-    while (accumulator >= fixedDeltaTime && stepCount < m_maxPhysicsStepsPerFrame) {
+    while (m_accumulator >= fixedDeltaTime && stepCount < m_maxPhysicsStepsPerFrame) {
         FixedUpdate(fixedDeltaTime);
-        accumulator -= fixedDeltaTime;
+        m_accumulator -= fixedDeltaTime;
         stepCount++;
     }
     
     if (stepCount >= m_maxPhysicsStepsPerFrame) {
         Logger::Warning("Physics accumulator hit max steps limit (" + std::to_string(m_maxPhysicsStepsPerFrame) + ") with deltaTime: " + std::to_string(deltaTime));
-        accumulator = 0.0f;
+        m_accumulator = 0.0f;
     }
     
     if (stepCount > 1) {
         Logger::Debug("Physics processed " + std::to_string(stepCount) + " steps in single frame");
     }
+    
+    if (m_contactEventsEnabled) {
+        m_contactEvents.Swap();
+    }
 }
 
 void PhysicsWorld::FixedUpdate(float fixedDeltaTime) {
@@ -95,11 +117,23 @@ void PhysicsWorld::FixedUpdate(float fixedDeltaTime) {
         DetectCollisions();
     }
     
+    if (m_contactEventsEnabled) {
+        PROFILE_SCOPE("Physics::ContactEvents");
+        m_contactTracker.Update(m_collisions, m_contactEvents);
+    }
+    
+    if (m_jointSolver) {
+        PROFILE_SCOPE("Physics::JointPreStep");
+        m_jointSolver->PreStep(fixedDeltaTime);
+    }
+    
     {
         PROFILE_SCOPE("Physics::ResolveCollisions");
-        const int solverIterations = 8;
-        for (int it = 0; it < solverIterations; ++it) {
+        for (int it = 0; it < m_solverIterations; ++it) {
             ResolveCollisions();
+            if (m_jointSolver) {
+                m_jointSolver->SolveVelocities();
+            }
         }
     }
     
@@ -108,6 +142,11 @@ void PhysicsWorld::FixedUpdate(float fixedDeltaTime) {
         IntegratePositions(fixedDeltaTime);
     }
     
+    if (!m_characterControllers.empty()) {
+        PROFILE_SCOPE("Physics::CharacterControllers");
+        UpdateCharacterControllers(fixedDeltaTime);
+    }
+    
     if (m_enable2DPhysics && m_physicsWorld2D) {
         PROFILE_SCOPE("Physics::2DPhysicsUpdate");
         m_physicsWorld2D->FixedUpdate(fixedDeltaTime);
@@ -115,32 +154,83 @@ void PhysicsWorld::FixedUpdate(float fixedDeltaTime) {
 }
 
 void PhysicsWorld::AddRigidBody(RigidBody* rigidBody) {
-    if (!rigidBody) return;
+    if (!rigidBody || ContainsRigidBody(rigidBody)) return;
     
-    auto it = std::find(m_rigidBodies.begin(), m_rigidBodies.end(), rigidBody);
-    if (it == m_rigidBodies.end()) {
-        m_rigidBodies.push_back(rigidBody);
-        
-        if (m_octree && m_useSpatialPartitioning) {
-            m_octree->Insert(rigidBody);
-        }
-        
-        Logger::Debug("Added RigidBody to PhysicsWorld");
+    rigidBody->m_worldIndex = static_cast<uint32_t>(m_rigidBodies.size());
+    m_rigidBodies.push_back(rigidBody);
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        m_octree->Insert(rigidBody);
     }
+    
+    Logger::Debug("Added RigidBody to PhysicsWorld");
 }
 
 void PhysicsWorld::RemoveRigidBody(RigidBody* rigidBody) {
-    if (!rigidBody) return;
+    if (!rigidBody || !ContainsRigidBody(rigidBody)) return;
     
-    auto it = std::find(m_rigidBodies.begin(), m_rigidBodies.end(), rigidBody);
-    if (it != m_rigidBodies.end()) {
-        m_rigidBodies.erase(it);
-        
-        if (m_octree && m_useSpatialPartitioning) {
-            m_octree->Remove(rigidBody);
+    uint32_t index = rigidBody->m_worldIndex;
+    RigidBody* last = m_rigidBodies.back();
+    m_rigidBodies[index] = last;
+    last->m_worldIndex = index;
+    m_rigidBodies.pop_back();
+    rigidBody->m_worldIndex = RigidBody::InvalidWorldIndex;
+    
+    m_contactTracker.Forget(rigidBody, m_contactEventsEnabled ? &m_contactEvents : nullptr);
+    if (m_jointSolver) {
+        m_jointSolver->RemoveJointsForBody(rigidBody);
+    }
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        m_octree->Remove(rigidBody);
+    }
+    
+    Logger::Debug("Removed RigidBody from PhysicsWorld");
+}
+
+bool PhysicsWorld::ContainsRigidBody(const RigidBody* rigidBody) const {
+    if (!rigidBody) return false;
+    uint32_t index = rigidBody->m_worldIndex;
+    return index < m_rigidBodies.size() && m_rigidBodies[index] == rigidBody;
+}
+
+void PhysicsWorld::AddRigidBodies(std::span<RigidBody* const> rigidBodies) {
+    size_t previousCount = m_rigidBodies.size();
+    m_rigidBodies.reserve(previousCount + rigidBodies.size());
+    
+    for (RigidBody* body : rigidBodies) {
+        // The index check also catches duplicates within the batch
+        if (!body || ContainsRigidBody(body)) continue;
+        body->m_worldIndex = static_cast<uint32_t>(m_rigidBodies.size());
+        m_rigidBodies.push_back(body);
+    }
+    
+    size_t added = m_rigidBodies.size() - previousCount;
+    if (added == 0) return;
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        if (ShouldRebuildBroadphase(added, m_rigidBodies.size() + m_staticColliders.size())) {
+            m_octree->Build(m_rigidBodies, m_staticColliders);
+        } else {
+            for (size_t i = previousCount; i < m_rigidBodies.size(); ++i) {
+                m_octree->Insert(m_rigidBodies[i]);
+            }
         }
-        
-        Logger::Debug("Removed RigidBody from PhysicsWorld");
+    }
+    ReserveCollisionStorage();
+    
+    Logger::Debug("Added " + std::to_string(added) + " RigidBodies to PhysicsWorld");
+}
+
+bool PhysicsWorld::ShouldRebuildBroadphase(size_t added, size_t total) const {
+    return added >= 64 || added * 4 >= total;
+}
+
+// Warm up the contact buffer so the first steps after a large load do not grow it repeatedly
+void PhysicsWorld::ReserveCollisionStorage() {
+    size_t expected = (m_rigidBodies.size() + m_staticColliders.size()) * 2;
+    if (m_collisions.capacity() < expected) {
+        m_collisions.reserve(expected);
     }
 }
 
@@ -408,31 +498,68 @@ void PhysicsWorld::ResolveCollisions() {
 }
 
 void PhysicsWorld::AddStaticCollider(ColliderComponent* collider) {
-    if (!collider) return;
+    if (!collider || ContainsStaticCollider(collider)) return;
     
-    auto it = std::find(m_staticColliders.begin(), m_staticColliders.end(), collider);
-    if (it == m_staticColliders.end()) {
-        m_staticColliders.push_back(collider);
-        
-        if (m_octree && m_useSpatialPartitioning) {
-        }
-        
-        Logger::Debug("Added static ColliderComponent to PhysicsWorld");
+    collider->m_staticIndex = static_cast<uint32_t>(m_staticColliders.size());
+    m_staticColliders.push_back(collider);
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        m_octree->Insert(collider);
     }
+    
+    Logger::Debug("Added static ColliderComponent to PhysicsWorld");
 }
 
 void PhysicsWorld::RemoveStaticCollider(ColliderComponent* collider) {
-    if (!collider) return;
+    if (!collider || !ContainsStaticCollider(collider)) return;
     
-    auto it = std::find(m_staticColliders.begin(), m_staticColliders.end(), collider);
-    if (it != m_staticColliders.end()) {
-        m_staticColliders.erase(it);
-        
-        if (m_octree && m_useSpatialPartitioning) {
+    uint32_t index = collider->m_staticIndex;
+    ColliderComponent* last = m_staticColliders.back();
+    m_staticColliders[index] = last;
+    last->m_staticIndex = index;
+    m_staticColliders.pop_back();
+    collider->m_staticIndex = ColliderComponent::InvalidStaticIndex;
+    
+    m_contactTracker.Forget(collider, m_contactEventsEnabled ? &m_contactEvents : nullptr);
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        m_octree->Remove(collider);
+    }
+    
+    Logger::Debug("Removed static ColliderComponent from PhysicsWorld");
+}
+
+bool PhysicsWorld::ContainsStaticCollider(const ColliderComponent* collider) const {
+    if (!collider) return false;
+    uint32_t index = collider->m_staticIndex;
+    return index < m_staticColliders.size() && m_staticColliders[index] == collider;
+}
+
+void PhysicsWorld::AddStaticColliders(std::span<ColliderComponent* const> colliders) {
+    size_t previousCount = m_staticColliders.size();
+    m_staticColliders.reserve(previousCount + colliders.size());
+    
+    for (ColliderComponent* collider : colliders) {
+        if (!collider || ContainsStaticCollider(collider)) continue;
+        collider->m_staticIndex = static_cast<uint32_t>(m_staticColliders.size());
+        m_staticColliders.push_back(collider);
+    }
+    
+    size_t added = m_staticColliders.size() - previousCount;
+    if (added == 0) return;
+    
+    if (m_octree && m_useSpatialPartitioning) {
+        if (ShouldRebuildBroadphase(added, m_rigidBodies.size() + m_staticColliders.size())) {
+            m_octree->Build(m_rigidBodies, m_staticColliders);
+        } else {
+            for (size_t i = previousCount; i < m_staticColliders.size(); ++i) {
+                m_octree->Insert(m_staticColliders[i]);
+            }
         }
-        
-        Logger::Debug("Removed static ColliderComponent from PhysicsWorld");
     }
+    ReserveCollisionStorage();
+    
+    Logger::Debug("Added " + std::to_string(added) + " static ColliderComponents to PhysicsWorld");
 }
 
 void PhysicsWorld::IntegrateVelocities(float deltaTime) {
@@ -513,13 +640,145 @@ void PhysicsWorld::IntegratePositions(float deltaTime) {
 
 void PhysicsWorld::UpdateSpatialPartitioning() {
     if (m_octree && m_useSpatialPartitioning) {
-        m_octree->Clear();
-        for (RigidBody* body : m_rigidBodies) {
-            if (body) {
-                m_octree->Insert(body);
-            }
+        m_octree->Build(m_rigidBodies, m_staticColliders);
+    }
+}
+
+void PhysicsWorld::AddCharacterController(CharacterController* controller) {
+    if (!controller) return;
+    
+    auto it = std::find(m_characterControllers.begin(), m_characterControllers.end(), controller);
+    if (it == m_characterControllers.end()) {
+        m_characterControllers.push_back(controller);
+        Logger::Debug("Added CharacterController to PhysicsWorld");
+    }
+}
+
+void PhysicsWorld::RemoveCharacterController(CharacterController* controller) {
+    if (!controller) return;
+    
+    auto it = std::find(m_characterControllers.begin(), m_characterControllers.end(), controller);
+    if (it != m_characterControllers.end()) {
+        m_characterControllers.erase(it);
+        Logger::Debug("Removed CharacterController from PhysicsWorld");
+    }
+}
+
+void PhysicsWorld::UpdateCharacterControllers(float deltaTime) {
+    // Controllers only read the world, so they can be stepped in parallel. They do not collide
+    // with each other.
+    WorkerPool& pool = WorkerPool::Instance();
+    const size_t threadCount = pool.GetThreadCount();
+    size_t total = m_characterControllers.size();
+    const size_t minPerWorker = 16;
+    if (threadCount <= 1 || total < 2 * minPerWorker) {
+        for (CharacterController* controller : m_characterControllers) {
+            controller->Step(*this, deltaTime);
         }
+        return;
+    }
+    size_t chunk = std::max<size_t>(minPerWorker, (total + threadCount - 1) / threadCount);
+    size_t chunkCount = (total + chunk - 1) / chunk;
+    pool.ParallelFor(chunkCount, [this, chunk, total, deltaTime](size_t c, size_t) {
+        size_t end = std::min(total, (c + 1) * chunk);
+        for (size_t i = c * chunk; i < end; ++i) {
+            m_characterControllers[i]->Step(*this, deltaTime);
+        }
+    });
+}
+
+void PhysicsWorld::QueryOverlaps(const AABB& bounds, std::vector<ColliderComponent*>& staticColliders, std::vector<RigidBody*>& bodies) const {
+    if (m_octree && m_useSpatialPartitioning) {
+        m_octree->Query(bounds, staticColliders);
+        m_octree->Query(bounds, bodies);
+        return;
+    }
+    // Without spatial partitioning every collider is a candidate
+    staticColliders.insert(staticColliders.end(), m_staticColliders.begin(), m_staticColliders.end());
+    bodies.insert(bodies.end(), m_rigidBodies.begin(), m_rigidBodies.end());
+}
+
+namespace {
+    size_t AlignSnapshotOffset(size_t offset) {
+        return (offset + 15) & ~size_t(15);
+    }
+}
+
+void PhysicsWorld::SaveSnapshot(PhysicsSnapshot& snapshot) const {
+    PhysicsSnapshot::Header header;
+    header.bodyCount = static_cast<uint32_t>(m_rigidBodies.size());
+    header.jointCount = m_jointSolver ? static_cast<uint32_t>(m_jointSolver->GetJointCount()) : 0;
+    header.contactPairCount = static_cast<uint32_t>(m_contactTracker.GetActivePairCount());
+    header.accumulator = m_accumulator;
+
+    size_t bodyOffset = AlignSnapshotOffset(sizeof(header));
+    size_t jointOffset = AlignSnapshotOffset(bodyOffset + header.bodyCount * sizeof(PhysicsSnapshot::BodyRecord));
+    size_t pairOffset = AlignSnapshotOffset(jointOffset + header.jointCount * sizeof(JointSolver::ImpulseRecord));
+    size_t totalSize = pairOffset + header.contactPairCount * ContactPairTracker::GetPairStateSize();
+
+    uint8_t* data = snapshot.Resize(totalSize);
+    std::memcpy(data, &header, sizeof(header));
+
+    PhysicsSnapshot::BodyRecord record;
+    for (size_t i = 0; i < m_rigidBodies.size(); ++i) {
+        RigidBody* body = m_rigidBodies[i];
+        record.bodyId = reinterpret_cast<uintptr_t>(body);
+        body->GetSimulationState(record.state);
+        std::memcpy(data + bodyOffset + i * sizeof(record), &record, sizeof(record));
+    }
+
+    if (m_jointSolver && header.jointCount > 0) {
+        m_jointSolver->SaveImpulses(data + jointOffset);
+    }
+    m_contactTracker.SaveState(data + pairOffset);
+}
+
+bool PhysicsWorld::RestoreSnapshot(const PhysicsSnapshot& snapshot) {
+    if (!snapshot.IsValid()) return false;
+
+    const uint8_t* data = snapshot.GetData();
+    PhysicsSnapshot::Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != PhysicsSnapshot::Magic || header.version != PhysicsSnapshot::Version) {
+        Logger::Warning("PhysicsWorld::RestoreSnapshot: unsupported snapshot format");
+        return false;
+    }
+
+    size_t bodyOffset = AlignSnapshotOffset(sizeof(header));
+    size_t jointOffset = AlignSnapshotOffset(bodyOffset + header.bodyCount * sizeof(PhysicsSnapshot::BodyRecord));
+    size_t pairOffset = AlignSnapshotOffset(jointOffset + header.jointCount * sizeof(JointSolver::ImpulseRecord));
+    size_t totalSize = pairOffset + header.contactPairCount * ContactPairTracker::GetPairStateSize();
+    if (snapshot.GetSize() < totalSize || header.bodyCount != m_rigidBodies.size()) {
+        Logger::Warning("PhysicsWorld::RestoreSnapshot: snapshot does not match the registered bodies");
+        return false;
+    }
+
+    // Validate identities before touching anything so a mismatch leaves the world untouched
+    PhysicsSnapshot::BodyRecord record;
+    for (size_t i = 0; i < m_rigidBodies.size(); ++i) {
+        std::memcpy(&record.bodyId, data + bodyOffset + i * sizeof(record) + offsetof(PhysicsSnapshot::BodyRecord, bodyId), sizeof(record.bodyId));
+        if (record.bodyId != reinterpret_cast<uintptr_t>(m_rigidBodies[i])) {
+            Logger::Warning("PhysicsWorld::RestoreSnapshot: body set changed since the snapshot was taken");
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < m_rigidBodies.size(); ++i) {
+        RigidBody* body = m_rigidBodies[i];
+        std::memcpy(&record, data + bodyOffset + i * sizeof(record), sizeof(record));
+        Vector3 previousPosition = body->GetPosition();
+        body->SetSimulationState(record.state);
+        if (m_octree && m_useSpatialPartitioning && (body->GetPosition() - previousPosition).Length() > 0.1f) {
+            m_octree->Update(body);
+        }
+    }
+
+    if (m_jointSolver) {
+        m_jointSolver->RestoreImpulses(data + jointOffset, header.jointCount);
     }
+    m_contactTracker.RestoreState(data + pairOffset, header.contactPairCount, m_rigidBodies, m_staticColliders);
+    m_accumulator = header.accumulator;
+    return true;
 }
 
 }
@@ -2,8 +2,10 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 #include "../Core/Math/Vector3.h"
 #include "Collision/CollisionDetection.h"
+#include "Collision/ContactEvents.h"
 
 namespace GameEngine {
     class RigidBody;
@@ -12,6 +14,10 @@ namespace GameEngine {
     class World;
     class Octree;
     class PhysicsWorld2D;
+    class JointSolver;
+    class PhysicsSnapshot;
+    class CharacterController;
+    struct AABB;
     
     class PhysicsWorld {
     public:
@@ -28,18 +34,41 @@ namespace GameEngine {
         void SetGravity(const Vector3& gravity) { m_gravity = gravity; }
         const Vector3& GetGravity() const { return m_gravity; }
         
-        // Rigid body management
+        // Rigid body management. Membership is tracked by an index stored in each body, so adding
+        // and removing are O(1); removal moves the last body into the freed slot.
         void AddRigidBody(RigidBody* rigidBody);
         void RemoveRigidBody(RigidBody* rigidBody);
+        bool ContainsRigidBody(const RigidBody* rigidBody) const;
+        // Bulk registration for scene loads: large batches rebuild the octree top-down once
+        void AddRigidBodies(std::span<RigidBody* const> rigidBodies);
         
         // Static collider management
         void AddStaticCollider(ColliderComponent* collider);
         void RemoveStaticCollider(ColliderComponent* collider);
+        bool ContainsStaticCollider(const ColliderComponent* collider) const;
+        void AddStaticColliders(std::span<ColliderComponent* const> colliders);
+        
+        // Kinematic character controllers, moved after the dynamic bodies every fixed step
+        void AddCharacterController(CharacterController* controller);
+        void RemoveCharacterController(CharacterController* controller);
+        const std::vector<CharacterController*>& GetCharacterControllers() const { return m_characterControllers; }
+        void UpdateCharacterControllers(float deltaTime);
+        
+        // Broadphase overlap query against static colliders and rigid bodies
+        void QueryOverlaps(const AABB& bounds, std::vector<ColliderComponent*>& staticColliders, std::vector<RigidBody*>& bodies) const;
         
         // Collision detection
         void DetectCollisions();
         void ResolveCollisions();
         
+        // Contact/trigger events (begin/stay/end, enter/exit) published once per Update().
+        // The returned buffer stays valid until the next Update() or SwapContactEvents().
+        const std::vector<ContactEvent>& GetContactEvents() const { return m_contactEvents.GetEvents(); }
+        void SwapContactEvents() { m_contactEvents.Swap(); }
+        void SetContactEventsEnabled(bool enabled) { m_contactEventsEnabled = enabled; }
+        bool GetContactEventsEnabled() const { return m_contactEventsEnabled; }
+        const std::vector<CollisionInfo>& GetCollisions() const { return m_collisions; }
+        
         // Integration
         void IntegrateVelocities(float deltaTime);
         void IntegratePositions(float deltaTime);
@@ -51,6 +80,18 @@ namespace GameEngine {
         void SetUseSpatialPartitioning(bool use) { m_useSpatialPartitioning = use; }
         bool GetUseSpatialPartitioning() const { return m_useSpatialPartitioning; }
         
+        // Solver iterations shared by contacts and joints
+        void SetSolverIterations(int iterations) { m_solverIterations = iterations > 0 ? iterations : 1; }
+        int GetSolverIterations() const { return m_solverIterations; }
+        
+        // Joints (distance, ball-socket, hinge, fixed) solved in the contact iteration loop
+        JointSolver* GetJointSolver() const { return m_jointSolver.get(); }
+        
+        // Snapshots: full simulation state in one contiguous buffer. Restore succeeds only
+        // if the same bodies are registered in the same order, and runs in O(bodies).
+        void SaveSnapshot(PhysicsSnapshot& snapshot) const;
+        bool RestoreSnapshot(const PhysicsSnapshot& snapshot);
+        
         // Physics timestep settings
         void SetMaxPhysicsStepsPerFrame(int maxSteps) { m_maxPhysicsStepsPerFrame = maxSteps; }
         int GetMaxPhysicsStepsPerFrame() const { return m_maxPhysicsStepsPerFrame; }
@@ -66,6 +107,11 @@ namespace GameEngine {
         const Octree* GetOctree() const { return m_octree.get(); }
         
     private:
+        // Batches at least this large (or a quarter of the existing objects) rebuild the octree
+        // instead of inserting one object at a time
+        bool ShouldRebuildBroadphase(size_t added, size_t total) const;
+        void ReserveCollisionStorage();
+        
         std::vector<RigidBody*> m_rigidBodies;
         Vector3 m_gravity = Vector3(0.0f, -9.81f, 0.0f);
         
@@ -73,19 +119,32 @@ namespace GameEngine {
         std::vector<CollisionInfo> m_collisions;
         int m_collisionCount = 0;
         
+        // Contact event generation
+        ContactPairTracker m_contactTracker;
+        ContactEventQueue m_contactEvents;
+        bool m_contactEventsEnabled = true;
+        
         // Spatial partitioning
         std::unique_ptr<Octree> m_octree;
         bool m_useSpatialPartitioning = true;
         
+        // Joints
+        std::unique_ptr<JointSolver> m_jointSolver;
+        int m_solverIterations = 8;
+        
         // Static collider management
         std::vector<ColliderComponent*> m_staticColliders;
         
+        // Character controllers (not owned)
+        std::vector<CharacterController*> m_characterControllers;
+        
         // 2D Physics integration
         std::unique_ptr<PhysicsWorld2D> m_physicsWorld2D;
         bool m_enable2DPhysics = true;
         
         // Physics timestep settings
         int m_maxPhysicsStepsPerFrame = 5;
+        float m_accumulator = 0.0f;
         
         bool m_initialized = false;
     };
@@ -129,6 +129,28 @@ void RigidBody::IntegratePosition(float deltaTime) {
     }
 }
 
+void RigidBody::GetSimulationState(SimulationState& state) const {
+    state.position = m_position;
+    state.rotation = m_rotation;
+    state.velocity = m_velocity;
+    state.angularVelocity = m_angularVelocity;
+    state.force = m_force;
+    state.torque = m_torque;
+    state.sleepTimer = m_sleepTimer;
+    state.sleeping = m_sleeping ? 1u : 0u;
+}
+
+void RigidBody::SetSimulationState(const SimulationState& state) {
+    m_position = state.position;
+    m_rotation = state.rotation;
+    m_velocity = state.velocity;
+    m_angularVelocity = state.angularVelocity;
+    m_force = state.force;
+    m_torque = state.torque;
+    m_sleepTimer = state.sleepTimer;
+    m_sleeping = state.sleeping != 0;
+}
+
 Vector3 RigidBody::GetPointVelocity(const Vector3& worldPoint) const {
     Vector3 r = worldPoint - m_position;
     return m_velocity + m_angularVelocity.Cross(r);
@@ -2,6 +2,7 @@
 
 #include "../../Core/Math/Vector3.h"
 #include "../../Core/Math/Quaternion.h"
+#include <cstdint>
 
 namespace GameEngine {
     class PhysicsMaterial;
@@ -24,6 +25,18 @@ namespace GameEngine {
     
     class RigidBody {
     public:
+        // Everything the integrator mutates, packed for physics snapshots
+        struct SimulationState {
+            Vector3 position;
+            Quaternion rotation;
+            Vector3 velocity;
+            Vector3 angularVelocity;
+            Vector3 force;
+            Vector3 torque;
+            float sleepTimer = 0.0f;
+            uint32_t sleeping = 0;
+        };
+        
         RigidBody();
         ~RigidBody();
         
@@ -93,6 +106,10 @@ namespace GameEngine {
         void SetSleeping(bool sleeping) { m_sleeping = sleeping; }
         void WakeUp() { m_sleeping = false; }
         
+        // Snapshot support
+        void GetSimulationState(SimulationState& state) const;
+        void SetSimulationState(const SimulationState& state);
+        
         // Inverse inertia in world space multiply
         Vector3 InvInertiaWorldMultiply(const Vector3& v) const;
 
@@ -113,6 +130,9 @@ namespace GameEngine {
         
         
     private:
+        friend class PhysicsWorld;
+        static constexpr uint32_t InvalidWorldIndex = 0xFFFFFFFFu;
+        
         void RecomputeBodyInertia();
         Vector3 ApplyInvInertiaWorld(const Vector3& angularImpulse) const;
         
@@ -160,5 +180,8 @@ namespace GameEngine {
         Vector3 m_inertiaDiag = Vector3(1.0f, 1.0f, 1.0f);
         Vector3 m_invInertiaDiag = Vector3(1.0f, 1.0f, 1.0f);
         bool m_inertiaDirty = true;
+        
+        // Slot in the owning PhysicsWorld's body list, maintained by the world for O(1) membership
+        uint32_t m_worldIndex = InvalidWorldIndex;
     };
 }
@@ -48,18 +48,9 @@ void OctreeNode::Insert(RigidBody* body) {
             
             auto it = m_objects.begin();
             while (it != m_objects.end()) {
-                bool inserted = false;
-                AABB objAABB = GetBodyAABB(*it);
-                
-                for (int i = 0; i < 8; ++i) {
-                    if (m_children[i] && m_children[i]->GetBounds().Intersects(objAABB)) {
-                        m_children[i]->Insert(*it);
-                        inserted = true;
-                        break;
-                    }
-                }
-                
-                if (inserted) {
+                int child = FindContainingChild(GetBodyAABB(*it));
+                if (child >= 0) {
+                    m_children[child]->Insert(*it);
                     it = m_objects.erase(it);
                 } else {
                     ++it; // Keep object in this node if it doesn't fit in any child
@@ -67,16 +58,10 @@ void OctreeNode::Insert(RigidBody* body) {
             }
         }
     } else {
-        bool inserted = false;
-        for (int i = 0; i < 8; ++i) {
-            if (m_children[i] && m_children[i]->GetBounds().Intersects(bodyAABB)) {
-                m_children[i]->Insert(body);
-                inserted = true;
-                break;
-            }
-        }
-        
-        if (!inserted) {
+        int child = FindContainingChild(bodyAABB);
+        if (child >= 0) {
+            m_children[child]->Insert(body);
+        } else {
             m_objects.push_back(body); // Keep in this node if doesn't fit in children
         }
     }
@@ -100,8 +85,62 @@ void OctreeNode::Remove(RigidBody* body) {
     }
 }
 
+void OctreeNode::Insert(ColliderComponent* collider) {
+    if (!collider) return;
+    
+    AABB colliderAABB = GetColliderAABB(collider);
+    if (!m_bounds.Intersects(colliderAABB) && m_depth > 0) {
+        return;
+    }
+    
+    if (IsLeaf()) {
+        m_colliders.push_back(collider);
+        
+        if (m_colliders.size() > MAX_OBJECTS_PER_NODE && m_depth < m_maxDepth) {
+            Subdivide();
+            
+            auto it = m_colliders.begin();
+            while (it != m_colliders.end()) {
+                int child = FindContainingChild(GetColliderAABB(*it));
+                if (child >= 0) {
+                    m_children[child]->Insert(*it);
+                    it = m_colliders.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    } else {
+        int child = FindContainingChild(colliderAABB);
+        if (child >= 0) {
+            m_children[child]->Insert(collider);
+        } else {
+            m_colliders.push_back(collider);
+        }
+    }
+}
+
+void OctreeNode::Remove(ColliderComponent* collider) {
+    if (!collider) return;
+    
+    auto it = std::find(m_colliders.begin(), m_colliders.end(), collider);
+    if (it != m_colliders.end()) {
+        m_colliders.erase(it);
+        return;
+    }
+    
+    if (!IsLeaf()) {
+        for (int i = 0; i < 8; ++i) {
+            if (m_children[i]) {
+                m_children[i]->Remove(collider);
+            }
+        }
+    }
+}
+
 void OctreeNode::Clear() {
     m_objects.clear();
+    m_colliders.clear();
     
     for (int i = 0; i < 8; ++i) {
         m_children[i].reset();
@@ -155,6 +194,104 @@ void OctreeNode::QuerySphere(const Vector3& center, float radius, std::vector<Ri
     }
 }
 
+void OctreeNode::Query(const AABB& bounds, std::vector<ColliderComponent*>& results) const {
+    if (!m_bounds.Intersects(bounds) && m_depth > 0) {
+        return;
+    }
+    
+    for (ColliderComponent* collider : m_colliders) {
+        if (GetColliderAABB(collider).Intersects(bounds)) {
+            results.push_back(collider);
+        }
+    }
+    
+    if (!IsLeaf()) {
+        for (int i = 0; i < 8; ++i) {
+            if (m_children[i]) {
+                m_children[i]->Query(bounds, results);
+            }
+        }
+    }
+}
+
+void OctreeNode::QuerySphere(const Vector3& center, float radius, std::vector<ColliderComponent*>& results) const {
+    Vector3 radiusVec(radius, radius, radius);
+    Query(AABB(center - radiusVec, center + radiusVec), results);
+}
+
+// Objects descend only into a child that fully contains them, so a query that reaches any
+// overlapping region always visits the node holding the object
+int OctreeNode::FindContainingChild(const AABB& box) const {
+    if (IsLeaf()) return -1;
+    int child = GetChildIndex(box.GetCenter());
+    const AABB& childBounds = m_children[child]->GetBounds();
+    if (childBounds.Contains(box.min) && childBounds.Contains(box.max)) {
+        return child;
+    }
+    return -1;
+}
+
+void OctreeNode::Build(const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& colliders) {
+    Clear();
+    
+    std::vector<BuildItem> items;
+    items.reserve(bodies.size() + colliders.size());
+    for (RigidBody* body : bodies) {
+        if (!body) continue;
+        AABB bounds = GetBodyAABB(body);
+        if (!m_bounds.Intersects(bounds)) continue; // Same rule as Insert
+        items.push_back(BuildItem{bounds, body, nullptr, -1});
+    }
+    for (ColliderComponent* collider : colliders) {
+        if (!collider) continue;
+        items.push_back(BuildItem{GetColliderAABB(collider), nullptr, collider, -1});
+    }
+    BuildRange(items, 0, items.size());
+}
+
+// Top-down build: bucket the items by the child octant that fully contains them, keep the
+// rest here, and recurse. Every AABB is computed once instead of once per level per insert.
+void OctreeNode::BuildRange(std::vector<BuildItem>& items, size_t begin, size_t end) {
+    size_t count = end - begin;
+    size_t bodyCount = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (items[i].body) ++bodyCount;
+    }
+    
+    // Match incremental insertion: bodies and colliders split their node independently
+    bool splitBodies = bodyCount > MAX_OBJECTS_PER_NODE;
+    bool splitColliders = count - bodyCount > MAX_OBJECTS_PER_NODE;
+    if ((!splitBodies && !splitColliders) || m_depth >= m_maxDepth) {
+        for (size_t i = begin; i < end; ++i) {
+            if (items[i].body) m_objects.push_back(items[i].body);
+            else m_colliders.push_back(items[i].collider);
+        }
+        return;
+    }
+    
+    Subdivide();
+    for (size_t i = begin; i < end; ++i) {
+        bool canSplit = items[i].body ? splitBodies : splitColliders;
+        items[i].slot = canSplit ? FindContainingChild(items[i].bounds) : -1;
+    }
+    std::sort(items.begin() + begin, items.begin() + end,
+              [](const BuildItem& a, const BuildItem& b) { return a.slot < b.slot; });
+    
+    size_t i = begin;
+    while (i < end && items[i].slot < 0) {
+        if (items[i].body) m_objects.push_back(items[i].body);
+        else m_colliders.push_back(items[i].collider);
+        ++i;
+    }
+    while (i < end) {
+        int child = items[i].slot;
+        size_t childEnd = i;
+        while (childEnd < end && items[childEnd].slot == child) ++childEnd;
+        m_children[child]->BuildRange(items, i, childEnd);
+        i = childEnd;
+    }
+}
+
 void OctreeNode::Subdivide() {
     if (!IsLeaf()) return;
     
@@ -208,11 +345,43 @@ AABB OctreeNode::GetBodyAABB(RigidBody* body) const {
         return AABB(minWS, maxWS);
     }
 
+    if (colliderComp && colliderComp->HasCollider()) {
+        Vector3 minWS, maxWS;
+        colliderComp->GetColliderShape()->GetAABB(body->GetPosition(), body->GetRotation(), minWS, maxWS);
+        return AABB(minWS, maxWS);
+    }
+
     Vector3 pos = body->GetPosition();
     Vector3 halfSize(0.5f, 0.5f, 0.5f);
     return AABB(pos - halfSize, pos + halfSize);
 }
 
+AABB OctreeNode::GetColliderAABB(ColliderComponent* collider) const {
+    if (!collider || !collider->HasCollider()) {
+        return AABB(Vector3::Zero, Vector3::Zero);
+    }
+
+    TransformComponent* transformComp = collider->GetOwnerTransform();
+    Vector3 worldPos = transformComp ? transformComp->transform.GetWorldPosition() : Vector3::Zero;
+    Quaternion worldRot = transformComp ? transformComp->transform.GetWorldRotation() : Quaternion::Identity();
+
+    Vector3 minWS, maxWS;
+    collider->GetColliderShape()->GetAABB(worldPos, worldRot, minWS, maxWS);
+
+    // Shapes report unscaled bounds; grow them around the center by the largest scale axis
+    if (transformComp) {
+        Vector3 scale = transformComp->transform.GetWorldScale();
+        float maxScale = std::max({std::fabs(scale.x), std::fabs(scale.y), std::fabs(scale.z)});
+        if (maxScale > 1.0f) {
+            Vector3 center = (minWS + maxWS) * 0.5f;
+            Vector3 half = (maxWS - minWS) * (0.5f * maxScale);
+            minWS = center - half;
+            maxWS = center + half;
+        }
+    }
+    return AABB(minWS, maxWS);
+}
+
 Octree::Octree(const AABB& worldBounds) : m_worldBounds(worldBounds) {
     m_root = std::make_unique<OctreeNode>(worldBounds);
     Logger::Info("Octree initialized with bounds: min(" + 
@@ -243,6 +412,29 @@ void Octree::Update(RigidBody* body) {
     Insert(body);
 }
 
+void Octree::Build(const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& colliders) {
+    if (m_root) {
+        m_root->Build(bodies, colliders);
+    }
+}
+
+void Octree::Insert(ColliderComponent* collider) {
+    if (m_root) {
+        m_root->Insert(collider);
+    }
+}
+
+void Octree::Remove(ColliderComponent* collider) {
+    if (m_root) {
+        m_root->Remove(collider);
+    }
+}
+
+void Octree::Update(ColliderComponent* collider) {
+    Remove(collider);
+    Insert(collider);
+}
+
 void Octree::Clear() {
     if (m_root) {
         m_root->Clear();
@@ -261,6 +453,18 @@ void Octree::QuerySphere(const Vector3& center, float radius, std::vector<RigidB
     }
 }
 
+void Octree::Query(const AABB& bounds, std::vector<ColliderComponent*>& results) const {
+    if (m_root) {
+        m_root->Query(bounds, results);
+    }
+}
+
+void Octree::QuerySphere(const Vector3& center, float radius, std::vector<ColliderComponent*>& results) const {
+    if (m_root) {
+        m_root->QuerySphere(center, radius, results);
+    }
+}
+
 void Octree::GetCollisionPairs(std::vector<std::pair<RigidBody*, RigidBody*>>& pairs) const {
     std::vector<RigidBody*> allBodies;
     Query(m_worldBounds, allBodies);
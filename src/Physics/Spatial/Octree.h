@@ -35,6 +35,9 @@ namespace GameEngine {
         void Remove(ColliderComponent* collider);
         void Clear();
         
+        // Replaces the node contents with a top-down build over all objects at once
+        void Build(const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& colliders);
+        
         void Query(const AABB& bounds, std::vector<RigidBody*>& results) const;
         void QuerySphere(const Vector3& center, float radius, std::vector<RigidBody*>& results) const;
         void Query(const AABB& bounds, std::vector<ColliderComponent*>& results) const;
@@ -45,7 +48,16 @@ namespace GameEngine {
         const AABB& GetBounds() const { return m_bounds; }
         
     private:
+        struct BuildItem {
+            AABB bounds;
+            RigidBody* body;
+            ColliderComponent* collider;
+            int slot;
+        };
+        
         void Subdivide();
+        void BuildRange(std::vector<BuildItem>& items, size_t begin, size_t end);
+        int FindContainingChild(const AABB& box) const;
         AABB GetChildBounds(int childIndex) const;
         int GetChildIndex(const Vector3& point) const;
         AABB GetBodyAABB(RigidBody* body) const;
@@ -76,6 +88,9 @@ namespace GameEngine {
         void Update(ColliderComponent* collider);
         void Clear();
         
+        // Bulk (re)build for scene loads; much faster than inserting objects one at a time
+        void Build(const std::vector<RigidBody*>& bodies, const std::vector<ColliderComponent*>& colliders);
+        
         void Query(const AABB& bounds, std::vector<RigidBody*>& results) const;
         void QuerySphere(const Vector3& center, float radius, std::vector<RigidBody*>& results) const;
         void Query(const AABB& bounds, std::vector<ColliderComponent*>& results) const;
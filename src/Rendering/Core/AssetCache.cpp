@@ -0,0 +1,336 @@
+#include "AssetCache.h"
+#include "Texture.h"
+#include "../Meshes/Mesh.h"
+#include "../Loaders/CookedMesh.h"
+#include "../../Core/Logging/Logger.h"
+#include <filesystem>
+#include <future>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr const char* ObjPrefix = "obj:";
+constexpr const char* CookedPrefix = "mesh:";
+constexpr size_t ObjPrefixLength = 4;
+constexpr size_t CookedPrefixLength = 5;
+
+// Completed loads leave the pending map before their promise is fulfilled, so a ready future
+// still in it was broken by AssetStreamer::Shutdown and has to be requested again
+template<typename T>
+bool IsAbandoned(const std::shared_future<T>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool IsFileMeshKey(const std::string& key) {
+    return key.compare(0, ObjPrefixLength, ObjPrefix) == 0 || key.compare(0, CookedPrefixLength, CookedPrefix) == 0;
+}
+
+}
+
+AssetCache& AssetCache::Instance() {
+    static AssetCache instance;
+    return instance;
+}
+
+std::string AssetCache::NormalizePath(const std::string& path) {
+    if (path.empty()) {
+        return path;
+    }
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+std::string AssetCache::NormalizeMeshKey(const std::string& meshType) {
+    if (meshType.compare(0, ObjPrefixLength, ObjPrefix) == 0) {
+        return ObjPrefix + NormalizePath(meshType.substr(ObjPrefixLength));
+    }
+    if (meshType.compare(0, CookedPrefixLength, CookedPrefix) == 0) {
+        return CookedPrefix + NormalizePath(meshType.substr(CookedPrefixLength));
+    }
+    return meshType;
+}
+
+std::shared_ptr<Mesh> AssetCache::CreateMesh(const std::string& meshType) {
+    if (meshType == "cube") {
+        return std::make_shared<Mesh>(Mesh::CreateCube(1.0f));
+    }
+    if (meshType == "sphere") {
+        return std::make_shared<Mesh>(Mesh::CreateSphere(1.0f, 32));
+    }
+    if (meshType == "plane") {
+        return std::make_shared<Mesh>(Mesh::CreatePlane(1.0f, 1.0f));
+    }
+    if (meshType.compare(0, ObjPrefixLength, ObjPrefix) == 0) {
+        // Prefer the cooked copy next to the OBJ when the cooker has been run since it changed
+        std::string path = meshType.substr(ObjPrefixLength);
+        std::shared_ptr<Mesh> mesh;
+        if (CookedMesh::IsUpToDate(path)) {
+            mesh = std::make_shared<Mesh>(CookedMesh::LoadFromFile(CookedMesh::GetCookedPath(path)));
+        }
+        if (!mesh || mesh->GetVertexCount() == 0) {
+            mesh = std::make_shared<Mesh>(Mesh::LoadFromOBJ(path));
+        }
+        if (mesh->GetVertexCount() == 0) {
+            return nullptr;
+        }
+        return mesh;
+    }
+    if (meshType.compare(0, CookedPrefixLength, CookedPrefix) == 0) {
+        auto mesh = std::make_shared<Mesh>(CookedMesh::LoadFromFile(meshType.substr(CookedPrefixLength)));
+        if (mesh->GetVertexCount() == 0) {
+            return nullptr;
+        }
+        return mesh;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<Mesh> AssetCache::GetMesh(const std::string& meshType) {
+    std::string key = NormalizeMeshKey(meshType);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_meshes.find(key);
+        if (it != m_meshes.end()) {
+            if (auto mesh = it->second.asset.lock()) {
+                ++m_hits;
+                return mesh;
+            }
+        }
+    }
+
+    // Build outside the lock so a slow file load does not stall other lookups
+    std::shared_ptr<Mesh> mesh = CreateMesh(key);
+    if (!mesh) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry<Mesh>& entry = m_meshes[key];
+    // Another thread may have created the same asset meanwhile; keep the first one
+    if (auto existing = entry.asset.lock()) {
+        ++m_hits;
+        return existing;
+    }
+    entry.asset = mesh;
+    ++m_misses;
+    Logger::Debug("AssetCache: created mesh '" + key + "'");
+    return mesh;
+}
+
+std::shared_ptr<Texture> AssetCache::GetTexture(const std::string& path) {
+    std::string key = NormalizePath(path);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textures.find(key);
+        if (it != m_textures.end()) {
+            if (auto texture = it->second.asset.lock()) {
+                ++m_hits;
+                return texture;
+            }
+        }
+    }
+
+    auto texture = std::make_shared<Texture>();
+    if (!texture->LoadFromFile(key)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry<Texture>& entry = m_textures[key];
+    if (auto existing = entry.asset.lock()) {
+        ++m_hits;
+        return existing;
+    }
+    entry.asset = texture;
+    ++m_misses;
+    Logger::Debug("AssetCache: loaded texture '" + key + "'");
+    return texture;
+}
+
+template<typename T>
+std::shared_ptr<T> AssetCache::FinishLoad(std::unordered_map<std::string, Entry<T>>& entries, PendingMap<T>& pending,
+                                          const std::string& key, std::shared_ptr<T> asset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pending.erase(key);
+    if (!asset) {
+        return nullptr;
+    }
+    Entry<T>& entry = entries[key];
+    if (auto existing = entry.asset.lock()) {
+        return existing;
+    }
+    entry.asset = asset;
+    return asset;
+}
+
+AssetHandle<Mesh> AssetCache::GetMeshAsync(const std::string& meshType) {
+    std::string key = NormalizeMeshKey(meshType);
+    if (!IsFileMeshKey(key)) {
+        // Primitives are generated in microseconds
+        return AssetHandle<Mesh>::Ready(GetMesh(key));
+    }
+
+    std::shared_ptr<Mesh> placeholder = GetMesh("cube");
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Mesh>>>();
+    std::shared_future<std::shared_ptr<Mesh>> future;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_meshes.find(key);
+        if (it != m_meshes.end()) {
+            if (auto mesh = it->second.asset.lock()) {
+                ++m_hits;
+                return AssetHandle<Mesh>::Ready(mesh);
+            }
+        }
+        auto pendingIt = m_pendingMeshes.find(key);
+        if (pendingIt != m_pendingMeshes.end() && !IsAbandoned(pendingIt->second)) {
+            ++m_hits;
+            return AssetHandle<Mesh>(pendingIt->second, placeholder);
+        }
+        future = promise->get_future().share();
+        m_pendingMeshes[key] = future;
+        ++m_misses;
+    }
+
+    AssetStreamer::Instance().Submit([this, key, promise]() {
+        // File I/O, parsing and LOD data; nothing here touches the GL
+        std::shared_ptr<Mesh> mesh = CreateMesh(key);
+        size_t bytes = 0;
+        if (mesh) {
+            bytes = mesh->GetGPUByteSize();
+            for (const MeshLOD& lod : mesh->GetLODs()) {
+                bytes += lod.mesh->GetGPUByteSize();
+            }
+        }
+        AssetStreamer::Instance().EnqueueUpload(bytes, [this, key, promise, mesh]() {
+            if (mesh) {
+                mesh->Upload();
+                for (const MeshLOD& lod : mesh->GetLODs()) {
+                    lod.mesh->Upload();
+                }
+                Logger::Debug("AssetCache: streamed mesh '" + key + "'");
+            } else {
+                Logger::Error("AssetCache: failed to stream mesh '" + key + "'");
+            }
+            promise->set_value(FinishLoad(m_meshes, m_pendingMeshes, key, mesh));
+        });
+    });
+    return AssetHandle<Mesh>(future, placeholder);
+}
+
+AssetHandle<Texture> AssetCache::GetTextureAsync(const std::string& path) {
+    std::string key = NormalizePath(path);
+    std::shared_ptr<Texture> placeholder = GetPlaceholderTexture();
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Texture>>>();
+    std::shared_future<std::shared_ptr<Texture>> future;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textures.find(key);
+        if (it != m_textures.end()) {
+            if (auto texture = it->second.asset.lock()) {
+                ++m_hits;
+                return AssetHandle<Texture>::Ready(texture);
+            }
+        }
+        auto pendingIt = m_pendingTextures.find(key);
+        if (pendingIt != m_pendingTextures.end() && !IsAbandoned(pendingIt->second)) {
+            ++m_hits;
+            return AssetHandle<Texture>(pendingIt->second, placeholder);
+        }
+        future = promise->get_future().share();
+        m_pendingTextures[key] = future;
+        ++m_misses;
+    }
+
+    AssetStreamer::Instance().Submit([this, key, promise]() {
+        // Decoding, mip filtering and any block compression all happen here on the worker
+        auto chain = std::make_shared<TextureMipChain>();
+        bool decoded = Texture::ReadFile(key, *chain);
+        size_t bytes = decoded ? chain->GetByteSize() : 0;
+        AssetStreamer::Instance().EnqueueUpload(bytes, [this, key, promise, chain, decoded]() {
+            std::shared_ptr<Texture> texture;
+            if (decoded) {
+                texture = std::make_shared<Texture>();
+                if (!texture->LoadMipChain(*chain)) {
+                    texture = nullptr;
+                }
+            }
+            if (!texture) {
+                Logger::Error("AssetCache: failed to stream texture '" + key + "'");
+            }
+            promise->set_value(FinishLoad(m_textures, m_pendingTextures, key, texture));
+        });
+    });
+    return AssetHandle<Texture>(future, placeholder);
+}
+
+std::shared_ptr<Texture> AssetCache::GetPlaceholderTexture() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_placeholderTexture) {
+        const unsigned char white[4] = {255, 255, 255, 255};
+        m_placeholderTexture = std::make_shared<Texture>();
+        m_placeholderTexture->LoadFromMemory(white, 1, 1, 4);
+    }
+    return m_placeholderTexture;
+}
+
+void AssetCache::PinMesh(const std::string& meshType, bool pinned) {
+    std::shared_ptr<Mesh> mesh = pinned ? GetMesh(meshType) : nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_meshes.find(NormalizeMeshKey(meshType));
+    if (it != m_meshes.end()) {
+        it->second.pinned = mesh;
+    }
+}
+
+void AssetCache::PinTexture(const std::string& path, bool pinned) {
+    std::shared_ptr<Texture> texture = pinned ? GetTexture(path) : nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_textures.find(NormalizePath(path));
+    if (it != m_textures.end()) {
+        it->second.pinned = texture;
+    }
+}
+
+size_t AssetCache::CollectUnused() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t removed = 0;
+    for (auto it = m_meshes.begin(); it != m_meshes.end();) {
+        if (it->second.asset.expired()) {
+            it = m_meshes.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_textures.begin(); it != m_textures.end();) {
+        if (it->second.asset.expired()) {
+            it = m_textures.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+void AssetCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_meshes.clear();
+    m_textures.clear();
+    m_pendingMeshes.clear();
+    m_pendingTextures.clear();
+    m_placeholderTexture.reset();
+}
+
+size_t AssetCache::GetMeshCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_meshes.size();
+}
+
+size_t AssetCache::GetTextureCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_textures.size();
+}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../../Core/Streaming/AssetStreamer.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace GameEngine {
+    class Mesh;
+    class Texture;
+
+    // Process-wide cache that hands out one shared instance per unique asset. Meshes are keyed
+    // by the MeshComponent type string ("cube", "sphere", "plane", "obj:<path>" or a cooked
+    // "mesh:<path>"), textures by path; paths are normalized so different spellings of one file
+    // share an entry. "obj:" loads an up-to-date cooked copy instead of parsing when one exists.
+    //
+    // Returned shared_ptrs are the strong handles. The cache itself only keeps a weak reference,
+    // so an asset is freed (CPU data and GPU buffers) once the last user drops it, unless the key
+    // is pinned. Because every user shares the same Mesh, its buffers are uploaded once and
+    // RenderQueue batches all of its draws into instanced calls.
+    class AssetCache {
+    public:
+        static AssetCache& Instance();
+
+        // Existing or newly created mesh; nullptr if the type is unknown or the file fails to load
+        std::shared_ptr<Mesh> GetMesh(const std::string& meshType);
+        // Existing or newly loaded texture; needs a current context on a miss
+        std::shared_ptr<Texture> GetTexture(const std::string& path);
+
+        // Streaming variants, called on the main thread: files are read and decoded on
+        // AssetStreamer workers and uploaded within its per-frame budget. Until then the handle
+        // yields a placeholder, the shared cube or a 1x1 white texture. Built-in primitives and
+        // cached assets resolve immediately; concurrent requests for one key share a load.
+        AssetHandle<Mesh> GetMeshAsync(const std::string& meshType);
+        AssetHandle<Texture> GetTextureAsync(const std::string& path);
+        std::shared_ptr<Texture> GetPlaceholderTexture();
+
+        // Pinned keys keep a strong reference and survive with no users
+        void PinMesh(const std::string& meshType, bool pinned = true);
+        void PinTexture(const std::string& path, bool pinned = true);
+
+        // Drops entries whose assets have been freed; returns how many were removed
+        size_t CollectUnused();
+        // Forgets every entry; assets still referenced elsewhere stay alive
+        void Clear();
+
+        size_t GetMeshCount() const;
+        size_t GetTextureCount() const;
+        uint64_t GetHitCount() const { return m_hits; }
+        uint64_t GetMissCount() const { return m_misses; }
+
+        // Lexically normalized path with forward slashes, e.g. "a/./b/../c.obj" -> "a/c.obj"
+        static std::string NormalizePath(const std::string& path);
+        // Mesh key with the path of an "obj:" or "mesh:" type normalized
+        static std::string NormalizeMeshKey(const std::string& meshType);
+
+    private:
+        AssetCache() = default;
+        ~AssetCache() = default;
+
+        template<typename T>
+        struct Entry {
+            std::weak_ptr<T> asset;
+            std::shared_ptr<T> pinned;
+        };
+
+        template<typename T>
+        using PendingMap = std::unordered_map<std::string, std::shared_future<std::shared_ptr<T>>>;
+
+        static std::shared_ptr<Mesh> CreateMesh(const std::string& meshType);
+        // Main thread, after the upload: registers a streamed asset, deferring to one loaded
+        // synchronously meanwhile
+        template<typename T>
+        std::shared_ptr<T> FinishLoad(std::unordered_map<std::string, Entry<T>>& entries, PendingMap<T>& pending,
+                                      const std::string& key, std::shared_ptr<T> asset);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry<Mesh>> m_meshes;
+        std::unordered_map<std::string, Entry<Texture>> m_textures;
+        PendingMap<Mesh> m_pendingMeshes;
+        PendingMap<Texture> m_pendingTextures;
+        std::shared_ptr<Texture> m_placeholderTexture;
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+    };
+}
@@ -1,6 +1,7 @@
 #include "Buffer.h"
 #include "../../Core/Logging/Logger.h"
 #include "OpenGLHeaders.h"
+#include <algorithm>
 
 namespace GameEngine {
 
@@ -21,13 +22,13 @@ void Buffer::SetData(const void* data, size_t size) {
     m_size = size;
     Bind();
     glBufferData(GetGLBufferType(), size, data, GetGLUsage());
-    Logger::Info("Buffer data set, size: " + std::to_string(size));
+    Logger::Debug("Buffer data set, size: " + std::to_string(size));
 }
 
 void Buffer::SetSubData(const void* data, size_t size, size_t offset) {
     Bind();
     glBufferSubData(GetGLBufferType(), offset, size, data);
-    Logger::Info("Buffer sub-data set");
+    Logger::Debug("Buffer sub-data set");
 }
 
 void Buffer::Bind() const {
@@ -38,11 +39,16 @@ void Buffer::Unbind() const {
     glBindBuffer(GetGLBufferType(), 0);
 }
 
+void Buffer::BindBase(unsigned int bindingPoint) const {
+    glBindBufferBase(GetGLBufferType(), bindingPoint, m_bufferID);
+}
+
 unsigned int Buffer::GetGLBufferType() const {
     switch (m_type) {
         case BufferType::Vertex: return GL_ARRAY_BUFFER;
         case BufferType::Index: return GL_ELEMENT_ARRAY_BUFFER;
         case BufferType::Uniform: return GL_UNIFORM_BUFFER;
+        case BufferType::ShaderStorage: return GL_SHADER_STORAGE_BUFFER;
         default: return GL_ARRAY_BUFFER;
     }
 }
@@ -89,34 +95,46 @@ void VertexArray::Unbind() const {
 }
 
 void VertexArray::AddVertexBuffer(const Buffer& vertexBuffer, const std::vector<unsigned int>& layout) {
-    Bind();
-    vertexBuffer.Bind();
-    
-    m_vertexBufferIndex = 0;
-    
-    size_t offset = 0;
+    std::vector<VertexAttribute> attributes;
     size_t stride = 0;
     for (unsigned int count : layout) {
+        attributes.push_back({static_cast<unsigned int>(attributes.size()), static_cast<int>(count), VertexAttributeType::Float, false, stride});
         stride += count * sizeof(float);
     }
+    AddVertexBuffer(vertexBuffer, attributes, stride);
+}
+
+static GLenum GetGLAttributeType(VertexAttributeType type) {
+    switch (type) {
+        case VertexAttributeType::Float: return GL_FLOAT;
+        case VertexAttributeType::HalfFloat: return GL_HALF_FLOAT;
+        case VertexAttributeType::Byte: return GL_BYTE;
+        case VertexAttributeType::UnsignedByte: return GL_UNSIGNED_BYTE;
+        case VertexAttributeType::Short: return GL_SHORT;
+        case VertexAttributeType::UnsignedShort: return GL_UNSIGNED_SHORT;
+    }
+    return GL_FLOAT;
+}
+
+void VertexArray::AddVertexBuffer(const Buffer& vertexBuffer, const std::vector<VertexAttribute>& attributes, size_t stride) {
+    Bind();
+    vertexBuffer.Bind();
     
-    for (size_t i = 0; i < layout.size(); ++i) {
-        Logger::Info("Setting vertex attribute " + std::to_string(m_vertexBufferIndex) + " with " + std::to_string(layout[i]) + " components, stride=" + std::to_string(stride) + ", offset=" + std::to_string(offset));
-        glVertexAttribPointer(m_vertexBufferIndex, static_cast<GLint>(layout[i]), GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride), (void*)offset);
+    m_vertexBufferIndex = 0;
+    
+    for (const VertexAttribute& attribute : attributes) {
+        glVertexAttribPointer(attribute.location, attribute.components, GetGLAttributeType(attribute.type),
+                              attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(stride),
+                              reinterpret_cast<const void*>(attribute.offset));
+        glEnableVertexAttribArray(attribute.location);
         GLenum error = glGetError();
         if (error != GL_NO_ERROR) {
-            Logger::Error("OpenGL error after glVertexAttribPointer: " + std::to_string(error));
-        }
-        glEnableVertexAttribArray(m_vertexBufferIndex);
-        error = glGetError();
-        if (error != GL_NO_ERROR) {
-            Logger::Error("OpenGL error after glEnableVertexAttribArray: " + std::to_string(error));
+            Logger::Error("OpenGL error setting vertex attribute " + std::to_string(attribute.location) + ": " + std::to_string(error));
         }
-        offset += layout[i] * sizeof(float);
-        m_vertexBufferIndex++;
+        m_vertexBufferIndex = std::max(m_vertexBufferIndex, attribute.location + 1);
     }
     
-    Logger::Info("VertexArray buffer added with " + std::to_string(layout.size()) + " attributes");
+    Logger::Debug("VertexArray buffer added with " + std::to_string(attributes.size()) + " attributes, stride=" + std::to_string(stride));
 }
 
 void VertexArray::SetIndexBuffer(const Buffer& indexBuffer) {
@@ -7,7 +7,8 @@ namespace GameEngine {
     enum class BufferType {
         Vertex,
         Index,
-        Uniform
+        Uniform,
+        ShaderStorage
     };
 
     enum class BufferUsage {
@@ -26,6 +27,8 @@ namespace GameEngine {
         
         void Bind() const;
         void Unbind() const;
+        // Binds a Uniform or ShaderStorage buffer to an indexed binding point
+        void BindBase(unsigned int bindingPoint) const;
         
         unsigned int GetID() const { return m_bufferID; }
         size_t GetSize() const { return m_size; }
@@ -41,6 +44,25 @@ namespace GameEngine {
         unsigned int GetGLUsage() const;
     };
 
+    enum class VertexAttributeType {
+        Float,
+        HalfFloat,
+        Byte,
+        UnsignedByte,
+        Short,
+        UnsignedShort
+    };
+
+    // One attribute of an interleaved vertex buffer. Normalized integer types reach the shader
+    // as floats in [0, 1] (unsigned) or [-1, 1] (signed).
+    struct VertexAttribute {
+        unsigned int location;
+        int components;
+        VertexAttributeType type;
+        bool normalized;
+        size_t offset;
+    };
+
     class VertexArray {
     public:
         VertexArray();
@@ -49,7 +71,9 @@ namespace GameEngine {
         void Bind() const;
         void Unbind() const;
         
+        // Tightly packed float attributes at consecutive locations, one entry per component count
         void AddVertexBuffer(const Buffer& vertexBuffer, const std::vector<unsigned int>& layout);
+        void AddVertexBuffer(const Buffer& vertexBuffer, const std::vector<VertexAttribute>& attributes, size_t stride);
         void SetIndexBuffer(const Buffer& indexBuffer);
         
         unsigned int GetID() const { return m_arrayID; }
@@ -0,0 +1,299 @@
+#include "MipGenerator.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Math/SIMD.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr float Pi = 3.14159265358979f;
+constexpr float KaiserAlpha = 4.0f;
+constexpr float KaiserRadius = 2.0f;            // In destination pixels
+constexpr size_t MinPixelsPerThread = 32768;    // Below this a thread spawn costs more than it saves
+
+// Linear RGBA, premultiplied for color images
+struct FloatImage {
+    std::vector<float> pixels;
+    int width = 0;
+    int height = 0;
+};
+
+// Source pixels [first, first + count) contributing to one destination pixel
+struct FilterTaps {
+    int first = 0;
+    int count = 0;
+    size_t weightOffset = 0;
+};
+
+struct FilterTable {
+    std::vector<FilterTaps> taps;
+    std::vector<float> weights;
+};
+
+float BesselI0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    const float halfSquared = x * x * 0.25f;
+    for (int k = 1; k < 32 && term > sum * 1e-8f; ++k) {
+        term *= halfSquared / float(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+float Sinc(float x) {
+    if (std::fabs(x) < 1e-5f) {
+        return 1.0f;
+    }
+    return std::sin(Pi * x) / (Pi * x);
+}
+
+float KaiserWeight(float t) {
+    float x = t / KaiserRadius;
+    if (std::fabs(x) >= 1.0f) {
+        return 0.0f;
+    }
+    static const float normalization = 1.0f / BesselI0(KaiserAlpha);
+    return Sinc(t) * BesselI0(KaiserAlpha * std::sqrt(1.0f - x * x)) * normalization;
+}
+
+// Weights along one axis; out-of-range taps fold onto the edge pixel (clamp addressing)
+FilterTable BuildFilterTable(int sourceSize, int destSize, MipFilter filter) {
+    FilterTable table;
+    table.taps.resize(destSize);
+    const float scale = float(sourceSize) / float(destSize);
+
+    for (int i = 0; i < destSize; ++i) {
+        FilterTaps& taps = table.taps[i];
+        taps.weightOffset = table.weights.size();
+        if (sourceSize == destSize) {
+            taps.first = i;
+            taps.count = 1;
+            table.weights.push_back(1.0f);
+            continue;
+        }
+
+        const float start = float(i) * scale;
+        const float end = start + scale;
+        const float center = start + scale * 0.5f;
+        const float reach = filter == MipFilter::Box ? scale * 0.5f : KaiserRadius * scale;
+        const int low = static_cast<int>(std::floor(center - reach));
+        const int high = static_cast<int>(std::ceil(center + reach));
+        taps.first = std::max(0, low);
+        taps.count = std::min(sourceSize - 1, high) - taps.first + 1;
+        table.weights.resize(taps.weightOffset + taps.count, 0.0f);
+        float* weights = table.weights.data() + taps.weightOffset;
+
+        float total = 0.0f;
+        for (int j = low; j <= high; ++j) {
+            float weight;
+            if (filter == MipFilter::Box) {
+                weight = std::max(0.0f, std::min(end, float(j + 1)) - std::max(start, float(j)));
+            } else {
+                weight = KaiserWeight((float(j) + 0.5f - center) / scale);
+            }
+            weights[std::clamp(j, 0, sourceSize - 1) - taps.first] += weight;
+            total += weight;
+        }
+        for (int k = 0; k < taps.count; ++k) {
+            weights[k] /= total;
+        }
+    }
+    return table;
+}
+
+// Runs work(begin, end) over rows, split across threads when there is enough of it
+template<typename F>
+void ParallelRows(int rowCount, int rowPixels, F&& work) {
+    const size_t totalPixels = size_t(rowCount) * size_t(std::max(1, rowPixels));
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min({threads, size_t(rowCount), std::max<size_t>(1, totalPixels / MinPixelsPerThread)});
+    if (threads <= 1) {
+        work(0, rowCount);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    const int rowsPerThread = static_cast<int>((size_t(rowCount) + threads - 1) / threads);
+    for (size_t t = 1; t < threads; ++t) {
+        int begin = static_cast<int>(t) * rowsPerThread;
+        int end = std::min(rowCount, begin + rowsPerThread);
+        if (begin < end) {
+            workers.emplace_back([&work, begin, end]() { work(begin, end); });
+        }
+    }
+    work(0, std::min(rowCount, rowsPerThread));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Weighted sum of count RGBA pixels spaced stride floats apart
+inline void AccumulatePixels(const float* source, size_t stride, const float* weights, int count, float* out) {
+#ifdef GE_SSE2
+    __m128 sum = _mm_setzero_ps();
+    for (int k = 0; k < count; ++k) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(source + k * stride)));
+    }
+    _mm_storeu_ps(out, sum);
+#else
+    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int k = 0; k < count; ++k) {
+        for (int c = 0; c < 4; ++c) {
+            sum[c] += weights[k] * source[k * stride + c];
+        }
+    }
+    for (int c = 0; c < 4; ++c) {
+        out[c] = sum[c];
+    }
+#endif
+}
+
+// Separable resample: horizontal pass into a temporary, then vertical
+FloatImage Downsample(const FloatImage& source, int width, int height, MipFilter filter) {
+    const FilterTable horizontal = BuildFilterTable(source.width, width, filter);
+    const FilterTable vertical = BuildFilterTable(source.height, height, filter);
+
+    std::vector<float> rows(size_t(width) * source.height * 4);
+    ParallelRows(source.height, width, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const float* sourceRow = source.pixels.data() + size_t(y) * source.width * 4;
+            float* destRow = rows.data() + size_t(y) * width * 4;
+            for (int x = 0; x < width; ++x) {
+                const FilterTaps& taps = horizontal.taps[x];
+                AccumulatePixels(sourceRow + size_t(taps.first) * 4, 4, horizontal.weights.data() + taps.weightOffset,
+                                 taps.count, destRow + size_t(x) * 4);
+            }
+        }
+    });
+
+    FloatImage result;
+    result.width = width;
+    result.height = height;
+    result.pixels.resize(size_t(width) * height * 4);
+    const size_t rowStride = size_t(width) * 4;
+    ParallelRows(height, width, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const FilterTaps& taps = vertical.taps[y];
+            const float* weights = vertical.weights.data() + taps.weightOffset;
+            const float* column = rows.data() + size_t(taps.first) * rowStride;
+            float* destRow = result.pixels.data() + size_t(y) * rowStride;
+            for (int x = 0; x < width; ++x) {
+                AccumulatePixels(column + size_t(x) * 4, rowStride, weights, taps.count, destRow + size_t(x) * 4);
+            }
+        }
+    });
+    return result;
+}
+
+FloatImage ToLinear(const TextureData& image, bool sRGB) {
+    FloatImage result;
+    result.width = image.width;
+    result.height = image.height;
+    result.pixels.resize(size_t(image.width) * image.height * 4);
+    ParallelRows(image.height, image.width, [&](int begin, int end) {
+        for (size_t i = size_t(begin) * image.width; i < size_t(end) * image.width; ++i) {
+            const unsigned char* pixel = image.pixels.data() + i * 4;
+            float* out = result.pixels.data() + i * 4;
+            const float alpha = pixel[3] / 255.0f;
+            for (int c = 0; c < 3; ++c) {
+                out[c] = sRGB ? MipGenerator::SRGBToLinear(pixel[c]) * alpha : pixel[c] / 255.0f;
+            }
+            out[3] = alpha;
+        }
+    });
+    return result;
+}
+
+TextureData ToBytes(const FloatImage& image, bool sRGB) {
+    TextureData result;
+    result.width = image.width;
+    result.height = image.height;
+    result.channels = 4;
+    result.pixels.resize(size_t(image.width) * image.height * 4);
+    ParallelRows(image.height, image.width, [&](int begin, int end) {
+        for (size_t i = size_t(begin) * image.width; i < size_t(end) * image.width; ++i) {
+            const float* pixel = image.pixels.data() + i * 4;
+            unsigned char* out = result.pixels.data() + i * 4;
+            // Negative lobes of the Kaiser filter can overshoot either way
+            const float alpha = std::clamp(pixel[3], 0.0f, 1.0f);
+            for (int c = 0; c < 3; ++c) {
+                if (sRGB) {
+                    out[c] = alpha > 0.0f ? MipGenerator::LinearToSRGB(pixel[c] / alpha) : 0;
+                } else {
+                    out[c] = static_cast<unsigned char>(std::clamp(pixel[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+            }
+            out[3] = static_cast<unsigned char>(alpha * 255.0f + 0.5f);
+        }
+    });
+    return result;
+}
+
+float DecodeSRGB(float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+}
+
+float MipGenerator::SRGBToLinear(uint8_t value) {
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> result{};
+        for (int i = 0; i < 256; ++i) {
+            result[i] = DecodeSRGB(i / 255.0f);
+        }
+        return result;
+    }();
+    return table[value];
+}
+
+uint8_t MipGenerator::LinearToSRGB(float value) {
+    // Linear values halfway between consecutive sRGB codes; the code is how many lie below
+    static const std::array<float, 255> thresholds = []() {
+        std::array<float, 255> result{};
+        for (int i = 0; i < 255; ++i) {
+            result[i] = DecodeSRGB((i + 0.5f) / 255.0f);
+        }
+        return result;
+    }();
+    return static_cast<uint8_t>(std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin());
+}
+
+int MipGenerator::GetLevelCount(int width, int height) {
+    int levels = 1;
+    for (int size = std::max(width, height); size > 1; size >>= 1) {
+        ++levels;
+    }
+    return levels;
+}
+
+std::vector<TextureData> MipGenerator::Generate(const TextureData& source, const MipSettings& settings) {
+    PROFILE_SCOPE("MipGenerator::Generate");
+    std::vector<TextureData> levels;
+    if (source.width <= 0 || source.height <= 0 || source.channels != 4 ||
+        source.pixels.size() < size_t(source.width) * source.height * 4) {
+        Logger::Error("MipGenerator: source must be a non-empty RGBA8 image");
+        return levels;
+    }
+
+    int levelCount = GetLevelCount(source.width, source.height);
+    if (settings.maxLevels > 0) {
+        levelCount = std::min(levelCount, settings.maxLevels);
+    }
+    levels.reserve(levelCount);
+    levels.push_back(source);
+
+    FloatImage current = ToLinear(source, settings.sRGB);
+    for (int level = 1; level < levelCount; ++level) {
+        current = Downsample(current, std::max(1, current.width / 2), std::max(1, current.height / 2), settings.filter);
+        levels.push_back(ToBytes(current, settings.sRGB));
+    }
+    return levels;
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Texture.h"
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+    enum class MipFilter {
+        Box,        // Area average; cheap and soft
+        Kaiser      // Kaiser-windowed sinc; keeps detail in lower levels without ringing
+    };
+
+    struct MipSettings {
+        MipFilter filter = MipFilter::Kaiser;
+        // Color with coverage alpha. Off for normal maps and masks, whose channels are filtered
+        // as stored and independently of alpha.
+        bool sRGB = true;
+        int maxLevels = 0;          // 0 = full chain down to 1x1
+    };
+
+    // CPU mip chain generation for RGBA8 images. Color images are filtered in linear light on
+    // premultiplied alpha, so lower levels neither darken nor grow halos around cut-outs. Each
+    // level is filtered from the previous one in float, so rounding does not accumulate. Rows
+    // are split across threads; each pixel is one SSE vector where available.
+    class MipGenerator {
+    public:
+        // Level 0 is the source itself; source must have 4 channels
+        static std::vector<TextureData> Generate(const TextureData& source, const MipSettings& settings = MipSettings());
+
+        static int GetLevelCount(int width, int height);
+
+        static float SRGBToLinear(uint8_t value);
+        static uint8_t LinearToSRGB(float value);
+    };
+}
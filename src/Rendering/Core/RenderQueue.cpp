@@ -0,0 +1,202 @@
+#include "RenderQueue.h"
+#include "../Meshes/Mesh.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace GameEngine {
+
+static_assert(sizeof(Matrix4) == 16 * sizeof(float), "Instance matrices are streamed as raw mat4 columns");
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Instance UV transforms are streamed as raw vec4s");
+
+namespace {
+
+// Field positions; transparent keys move depth up under the pass (see RenderQueue.h)
+struct KeyLayout {
+    int depthShift;
+    int shaderShift;
+    int materialShift;
+    int meshShift;
+};
+constexpr KeyLayout StateFirstLayout{0, 48, 32, 16};
+constexpr KeyLayout DepthFirstLayout{44, 32, 16, 0};
+
+const KeyLayout& GetKeyLayout(RenderPass pass) {
+    return pass == RenderPass::Transparent ? DepthFirstLayout : StateFirstLayout;
+}
+
+RenderPass GetKeyPass(uint64_t key) {
+    return static_cast<RenderPass>(key >> 60);
+}
+
+// The key without its depth field; draws with equal state can share an instanced call
+uint64_t GetKeyState(uint64_t key) {
+    return key & ~(uint64_t(0xFFFF) << GetKeyLayout(GetKeyPass(key)).depthShift);
+}
+
+uint16_t QuantizeDepth(float depth) {
+    // The top bits of a positive float are monotonic in its value, so no depth range is needed
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+}
+
+uint64_t RenderQueue::MakeKey(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth) {
+    uint16_t depthBits = QuantizeDepth(depth);
+    if (pass == RenderPass::Transparent) {
+        depthBits = static_cast<uint16_t>(0xFFFFu - depthBits);
+    }
+    const KeyLayout& layout = GetKeyLayout(pass);
+    return (static_cast<uint64_t>(static_cast<uint8_t>(pass) & 0xFu) << 60) |
+           (static_cast<uint64_t>(shader & 0xFFFu) << layout.shaderShift) |
+           (static_cast<uint64_t>(material) << layout.materialShift) |
+           (static_cast<uint64_t>(mesh) << layout.meshShift) |
+           (static_cast<uint64_t>(depthBits) << layout.depthShift);
+}
+
+uint16_t RenderQueue::MakeMaterialKey(float a, float b) {
+    auto quantize = [](float v) { return static_cast<uint16_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return static_cast<uint16_t>((quantize(a) << 8) | quantize(b));
+}
+
+uint16_t RenderQueue::GetMaterialID(const void* texture, uint16_t parameters) {
+    auto textureIt = m_materialTextures.emplace(texture, static_cast<uint32_t>(m_materialTextures.size())).first;
+    uint64_t material = (static_cast<uint64_t>(textureIt->second) << 16) | parameters;
+    // Sequential IDs keep the 16-bit key field collision-free for the first 65536 materials
+    auto it = m_materialIds.emplace(material, static_cast<uint16_t>(m_materialIds.size())).first;
+    return it->second;
+}
+
+void RenderQueue::Clear() {
+    m_keys.clear();
+    m_draws.clear();
+    m_meshIds.clear();
+    m_materialIds.clear();
+    m_materialTextures.clear();
+    m_batches.clear();
+    m_instanceMatrices.clear();
+    m_instanceUVTransforms.clear();
+    m_hasUVTransforms = false;
+}
+
+uint16_t RenderQueue::GetMeshID(const Mesh* mesh) {
+    auto it = m_meshIds.find(mesh);
+    if (it != m_meshIds.end()) {
+        return it->second;
+    }
+    // IDs only order the sort; batches also compare the mesh pointer, so wrapping is harmless
+    uint16_t id = static_cast<uint16_t>(m_meshIds.size());
+    m_meshIds.emplace(mesh, id);
+    return id;
+}
+
+void RenderQueue::Submit(RenderPass pass, uint16_t shader, uint16_t material, Mesh* mesh, const Matrix4& model, float depth,
+                         uint32_t userData, const Vector4& uvTransform) {
+    if (!mesh) {
+        return;
+    }
+    m_keys.push_back(MakeKey(pass, shader, material, GetMeshID(mesh), depth));
+    m_draws.push_back({mesh, model, uvTransform, userData});
+    m_hasUVTransforms = m_hasUVTransforms || uvTransform.x != 1.0f || uvTransform.y != 1.0f ||
+                        uvTransform.z != 0.0f || uvTransform.w != 0.0f;
+}
+
+void RenderQueue::Sort() {
+    PROFILE_SCOPE("RenderQueue::Sort");
+    size_t count = m_keys.size();
+    m_order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_order[i] = static_cast<uint32_t>(i);
+    }
+
+    // LSD radix sort on bytes; passes where every key shares the byte are skipped, which is
+    // most of them since pass/shader/material take few distinct values
+    m_keyScratch.resize(count);
+    m_orderScratch.resize(count);
+    for (int shift = 0; shift < 64 && count > 1; shift += 8) {
+        size_t histogram[256] = {};
+        for (uint64_t key : m_keys) {
+            ++histogram[(key >> shift) & 0xFF];
+        }
+        if (histogram[(m_keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            size_t destination = histogram[(m_keys[i] >> shift) & 0xFF]++;
+            m_keyScratch[destination] = m_keys[i];
+            m_orderScratch[destination] = m_order[i];
+        }
+        m_keys.swap(m_keyScratch);
+        m_order.swap(m_orderScratch);
+    }
+
+    m_batches.clear();
+    m_instanceMatrices.resize(count);
+    m_instanceUVTransforms.resize(m_hasUVTransforms ? count : 0);
+    for (size_t i = 0; i < count; ++i) {
+        const Draw& draw = m_draws[m_order[i]];
+        m_instanceMatrices[i] = draw.model;
+        if (m_hasUVTransforms) {
+            m_instanceUVTransforms[i] = draw.uvTransform;
+        }
+
+        uint64_t state = GetKeyState(m_keys[i]);
+        if (!m_batches.empty()) {
+            RenderBatch& last = m_batches.back();
+            uint64_t lastState = GetKeyState(m_keys[i - 1]);
+            if (lastState == state && last.mesh == draw.mesh) {
+                ++last.instanceCount;
+                continue;
+            }
+        }
+        RenderBatch batch;
+        batch.pass = GetKeyPass(m_keys[i]);
+        const KeyLayout& layout = GetKeyLayout(batch.pass);
+        batch.shader = static_cast<uint16_t>((m_keys[i] >> layout.shaderShift) & 0xFFFu);
+        batch.material = static_cast<uint16_t>((m_keys[i] >> layout.materialShift) & 0xFFFFu);
+        batch.mesh = draw.mesh;
+        batch.firstInstance = static_cast<uint32_t>(i);
+        batch.instanceCount = 1;
+        batch.userData = draw.userData;
+        m_batches.push_back(batch);
+    }
+}
+
+void RenderQueue::Upload() {
+    if (m_instanceMatrices.empty()) {
+        return;
+    }
+    if (!m_instanceBuffer) {
+        m_instanceBuffer = std::make_unique<Buffer>(BufferType::Vertex, BufferUsage::Stream);
+    }
+    // Re-specifying the whole store lets the driver orphan the previous frame's copy
+    m_instanceBuffer->SetData(m_instanceMatrices.data(), m_instanceMatrices.size() * sizeof(Matrix4));
+    if (!m_instanceUVTransforms.empty()) {
+        if (!m_uvTransformBuffer) {
+            m_uvTransformBuffer = std::make_unique<Buffer>(BufferType::Vertex, BufferUsage::Stream);
+        }
+        m_uvTransformBuffer->SetData(m_instanceUVTransforms.data(), m_instanceUVTransforms.size() * sizeof(Vector4));
+    }
+}
+
+void RenderQueue::DrawBatch(const RenderBatch& batch) const {
+    if (!batch.mesh || !m_instanceBuffer || batch.instanceCount == 0) {
+        return;
+    }
+    const Buffer* uvTransforms = m_instanceUVTransforms.empty() ? nullptr : m_uvTransformBuffer.get();
+    batch.mesh->DrawInstanced(*m_instanceBuffer, static_cast<size_t>(batch.firstInstance) * sizeof(Matrix4), batch.instanceCount,
+                              uvTransforms, static_cast<size_t>(batch.firstInstance) * sizeof(Vector4));
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Buffer.h"
+#include "../../Core/Math/Matrix4.h"
+#include "../../Core/Math/Vector4.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+namespace GameEngine {
+    class Mesh;
+
+    enum class RenderPass : uint8_t {
+        Shadow = 0,
+        Opaque = 1,
+        Transparent = 2
+    };
+
+    // A run of sorted draws sharing pass, shader, material and mesh, drawn as one instanced call
+    struct RenderBatch {
+        RenderPass pass = RenderPass::Opaque;
+        uint16_t shader = 0;
+        uint16_t material = 0;
+        Mesh* mesh = nullptr;
+        uint32_t firstInstance = 0;     // Offset into the instance matrix and UV streams
+        uint32_t instanceCount = 0;
+        uint32_t userData = 0;          // userData of the first draw in the run
+    };
+
+    // Collects draws for a pass, sorts them by a 64-bit key with an LSD radix sort, merges
+    // adjacent draws with identical state and streams their model matrices into one instance
+    // buffer. Shadow and opaque keys minimize state changes and sort front to back within a run:
+    //   pass:4 | shader:12 | material:16 | mesh:16 | depth:16
+    // Transparent draws must blend back to front across materials and meshes, so their
+    // inverted depth sits directly under the pass:
+    //   pass:4 | depth:16 | shader:12 | material:16 | mesh:16
+    // Draws may carry a UV scale/offset, e.g. their region of a TextureAtlas; it is per
+    // instance, so props sharing an atlas still merge.
+    class RenderQueue {
+    public:
+        void Clear();
+        void Submit(RenderPass pass, uint16_t shader, uint16_t material, Mesh* mesh, const Matrix4& model, float depth,
+                    uint32_t userData = 0, const Vector4& uvTransform = Vector4(1.0f, 1.0f, 0.0f, 0.0f));
+
+        // Sorts and builds batches; CPU only
+        void Sort();
+        // Streams the instance matrices to the GPU; call after Sort with a context current
+        void Upload();
+        void DrawBatch(const RenderBatch& batch) const;
+
+        const std::vector<RenderBatch>& GetBatches() const { return m_batches; }
+        size_t GetDrawCount() const { return m_keys.size(); }
+        const std::vector<Matrix4>& GetInstanceMatrices() const { return m_instanceMatrices; }
+        const std::vector<Vector4>& GetInstanceUVTransforms() const { return m_instanceUVTransforms; }
+
+        static uint64_t MakeKey(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth);
+        // Packs two [0, 1] material parameters into a material key
+        static uint16_t MakeMaterialKey(float a, float b);
+        // Material key for a texture plus packed parameters, numbered in order of first use
+        // since the last Clear. Draws with equal keys merge, so keep the pair unique per material.
+        uint16_t GetMaterialID(const void* texture, uint16_t parameters);
+
+    private:
+        struct Draw {
+            Mesh* mesh;
+            Matrix4 model;
+            Vector4 uvTransform;
+            uint32_t userData;
+        };
+
+        uint16_t GetMeshID(const Mesh* mesh);
+
+        std::vector<uint64_t> m_keys;
+        std::vector<uint32_t> m_order;
+        std::vector<Draw> m_draws;
+        std::unordered_map<const Mesh*, uint16_t> m_meshIds;
+        std::unordered_map<uint64_t, uint16_t> m_materialIds;
+        std::unordered_map<const void*, uint32_t> m_materialTextures;
+
+        // Radix sort scratch, kept to avoid per-frame allocations
+        std::vector<uint64_t> m_keyScratch;
+        std::vector<uint32_t> m_orderScratch;
+
+        std::vector<RenderBatch> m_batches;
+        std::vector<Matrix4> m_instanceMatrices;
+        std::vector<Vector4> m_instanceUVTransforms;
+        bool m_hasUVTransforms = false;     // Otherwise DrawBatch leaves the identity default
+        std::unique_ptr<Buffer> m_instanceBuffer;
+        std::unique_ptr<Buffer> m_uvTransformBuffer;
+    };
+}
@@ -1,44 +1,31 @@
 #include "Texture.h"
+#include "../Loaders/CookedTexture.h"
+#include "../Loaders/ImageLoader.h"
 #include "../../Core/Logging/Logger.h"
 #include "OpenGLHeaders.h"
-#include <fstream>
+#include <algorithm>
 #include <vector>
 #include <cmath>
 
+// S3TC is an extension; not every loader's headers declare it
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
 namespace {
-    struct ImageData {
-        unsigned char* data = nullptr;
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        
-        ~ImageData() {
-            if (data) delete[] data;
-        }
-    };
-    
-    bool LoadBMP(const std::string& path, ImageData& image) {
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) return false;
-        
-        image.width = 256;
-        image.height = 256;
-        image.channels = 4;
-        image.data = new unsigned char[image.width * image.height * image.channels];
-        
-        for (int y = 0; y < image.height; ++y) {
-            for (int x = 0; x < image.width; ++x) {
-                int index = (y * image.width + x) * image.channels;
-                bool checker = ((x / 32) + (y / 32)) % 2 == 0;
-                
-                image.data[index + 0] = checker ? 255 : 128; // R
-                image.data[index + 1] = checker ? 255 : 128; // G
-                image.data[index + 2] = checker ? 255 : 128; // B
-                image.data[index + 3] = 255; // A
-            }
+    GLenum GetGLCompressedFormat(GameEngine::TextureCompression compression) {
+        switch (compression) {
+            case GameEngine::TextureCompression::DXT1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case GameEngine::TextureCompression::DXT3: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case GameEngine::TextureCompression::DXT5: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case GameEngine::TextureCompression::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            default: return GL_RGBA8;
         }
-        
-        return true;
     }
 }
 
@@ -60,15 +47,76 @@ Texture::~Texture() {
 bool Texture::LoadFromFile(const std::string& path) {
     Logger::Info("Loading texture from file: " + path);
     
-    ImageData image;
-    if (!LoadBMP(path, image)) {
+    TextureMipChain chain;
+    if (!ReadFile(path, chain, m_compression)) {
         Logger::Warning("Failed to load texture from file: " + path + ". Creating default texture.");
         CreateEmpty(256, 256, TextureFormat::RGBA8);
         return false;
     }
     
+    return LoadMipChain(chain);
+}
+
+bool Texture::ReadFile(const std::string& path, TextureMipChain& chain, TextureCompression compression) {
+    if (CookedTexture::IsUpToDate(path) && CookedTexture::LoadFromFile(CookedTexture::GetCookedPath(path), chain)) {
+        return true;
+    }
+    
+    TextureData image;
+    if (!DecodeFile(path, image)) {
+        return false;
+    }
+    // Uncooked images are treated as color; the cooker handles linear data such as normal maps
+    CookedTexture::CookOptions options;
+    options.compression = compression;
+    return CookedTexture::BuildMipChain(image, options, chain);
+}
+
+bool Texture::DecodeFile(const std::string& path, TextureData& data) {
+    return ImageLoader::LoadFromFile(path, data);
+}
+
+bool Texture::LoadMipChain(const TextureMipChain& chain) {
+    if (chain.levels.empty() || chain.width <= 0 || chain.height <= 0) {
+        Logger::Error("Invalid mip chain provided to LoadMipChain");
+        return false;
+    }
+    
+    const int levelCount = static_cast<int>(chain.levels.size());
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int level = 0; level < levelCount; ++level) {
+        const int width = std::max(1, chain.width >> level);
+        const int height = std::max(1, chain.height >> level);
+        const auto& data = chain.levels[level];
+        if (chain.compression == TextureCompression::None) {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, GetGLCompressedFormat(chain.compression), width, height, 0,
+                                   static_cast<GLsizei>(data.size()), data.data());
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    m_width = chain.width;
+    m_height = chain.height;
+    m_format = TextureFormat::RGBA8;
+    m_compression = chain.compression;
+    m_mipmapLevels = levelCount;
+    
+    Logger::Info("Texture loaded with " + std::to_string(levelCount) + " mip levels: " + std::to_string(m_width) + "x" +
+                std::to_string(m_height) + ", " + std::to_string(chain.GetByteSize()) + " bytes, ID: " + std::to_string(m_textureID));
     
-    return LoadFromMemory(image.data, image.width, image.height, image.channels);
+    return true;
 }
 
 bool Texture::LoadFromMemory(const unsigned char* data, int width, int height, int channels) {
@@ -132,6 +180,18 @@ void Texture::CreateEmpty(int width, int height, TextureFormat format) {
     
     Logger::Info("Texture created empty: " + std::to_string(width) + "x" + std::to_string(height) + " with ID: " + std::to_string(m_textureID));
 }
+void Texture::UpdateRegion(int x, int y, int width, int height, const void* data) {
+    if (!data || width <= 0 || height <= 0 || m_isCube) {
+        return;
+    }
+    
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GetGLFormat(m_format), GetGLType(m_format), data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void Texture::CreateEmptyCubeDepth(int size, TextureFormat format) {
     m_width = size;
     m_height = size;
@@ -281,16 +341,16 @@ void Texture::SetCompression(TextureCompression compression) {
             Logger::Debug("Texture compression set to None");
             break;
         case TextureCompression::DXT1:
-            Logger::Debug("Texture compression set to DXT1 (placeholder)");
+            Logger::Debug("Texture compression set to DXT1 (BC1)");
             break;
         case TextureCompression::DXT3:
-            Logger::Debug("Texture compression set to DXT3 (placeholder)");
+            Logger::Debug("Texture compression set to DXT3 (BC2)");
             break;
         case TextureCompression::DXT5:
-            Logger::Debug("Texture compression set to DXT5 (placeholder)");
+            Logger::Debug("Texture compression set to DXT5 (BC3)");
             break;
         case TextureCompression::BC7:
-            Logger::Debug("Texture compression set to BC7 (placeholder)");
+            Logger::Debug("Texture compression set to BC7");
             break;
     }
 }
@@ -310,10 +370,10 @@ Texture::AtlasRegion Texture::AddToAtlas(const std::string& texturePath, int x,
         return AtlasRegion{};
     }
     
-    ImageData image;
+    TextureData image;
     AtlasRegion region{};
     
-    if (LoadBMP(texturePath, image)) {
+    if (DecodeFile(texturePath, image)) {
         region.u1 = static_cast<float>(x) / m_width;
         region.v1 = static_cast<float>(y) / m_height;
         region.u2 = static_cast<float>(x + image.width) / m_width;
@@ -323,7 +383,7 @@ Texture::AtlasRegion Texture::AddToAtlas(const std::string& texturePath, int x,
         
         glBindTexture(GL_TEXTURE_2D, m_textureID);
         glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, image.width, image.height, 
-                       GetGLFormat(m_format), GetGLType(m_format), image.data);
+                       GetGLFormat(m_format), GetGLType(m_format), image.pixels.data());
         glBindTexture(GL_TEXTURE_2D, 0);
         
         m_atlasRegions[texturePath] = region;
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <cstddef>
 
 namespace GameEngine {
     enum class TextureFormat {
@@ -26,12 +28,39 @@ namespace GameEngine {
         ClampToBorder
     };
 
+    // Stored in cooked textures; keep the values stable
     enum class TextureCompression {
-        None,
-        DXT1,
-        DXT3,
-        DXT5,
-        BC7
+        None = 0,
+        DXT1 = 1,       // BC1, opaque
+        DXT3 = 2,       // BC2, explicit 4-bit alpha
+        DXT5 = 3,       // BC3, interpolated alpha
+        BC7 = 4
+    };
+
+    // Decoded pixels, tightly packed rows of width * channels bytes
+    struct TextureData {
+        std::vector<unsigned char> pixels;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+    };
+
+    // Every level of a texture ready for upload, finest first. Uncompressed levels are RGBA8
+    // rows; compressed levels are 4x4 blocks in row-major order.
+    struct TextureMipChain {
+        TextureCompression compression = TextureCompression::None;
+        bool sRGB = true;               // Levels were filtered as sRGB color
+        int width = 0;
+        int height = 0;
+        std::vector<std::vector<unsigned char>> levels;
+
+        size_t GetByteSize() const {
+            size_t bytes = 0;
+            for (const auto& level : levels) {
+                bytes += level.size();
+            }
+            return bytes;
+        }
     };
 
     class Texture {
@@ -40,15 +69,26 @@ namespace GameEngine {
         ~Texture();
         void CreateEmptyCubeDepth(int size, TextureFormat format);
 
+        // Uses the cooked sibling (CookedTexture) when it is up to date, otherwise decodes the
+        // image and builds mips on the CPU, compressed if SetCompression asked for it
         bool LoadFromFile(const std::string& path);
+        // CPU half of LoadFromFile; touches no GL state, so asset streaming runs it on workers
+        static bool ReadFile(const std::string& path, TextureMipChain& chain,
+                             TextureCompression compression = TextureCompression::None);
+        // Level 0 only, as RGBA8 (PNG, TGA or BMP)
+        static bool DecodeFile(const std::string& path, TextureData& data);
+        bool LoadMipChain(const TextureMipChain& chain);
+        bool LoadFromData(const TextureData& data) { return LoadFromMemory(data.pixels.data(), data.width, data.height, data.channels); }
         bool LoadFromMemory(const unsigned char* data, int width, int height, int channels);
         void CreateEmpty(int width, int height, TextureFormat format);
+        // Overwrites a region of mip 0; data is tightly packed in the texture's format
+        void UpdateRegion(int x, int y, int width, int height, const void* data);
         
         // Mipmap support
         void GenerateMipmaps();
         void SetMipmapLevels(int levels);
         
-        // Compression support
+        // Format LoadFromFile encodes uncooked images to; cooked files keep their own
         void SetCompression(TextureCompression compression);
         TextureCompression GetCompression() const { return m_compression; }
         
@@ -64,7 +104,7 @@ namespace GameEngine {
         TextureFormat GetFormat() const { return m_format; }
         int GetMipmapLevels() const { return m_mipmapLevels; }
         
-        // Texture atlas support
+        // Manually placed atlas; TextureAtlas packs a batch of images automatically
         struct AtlasRegion {
             float u1, v1, u2, v2; // UV coordinates
             int width, height;     // Region dimensions
@@ -0,0 +1,473 @@
+#include "TextureAtlas.h"
+#include "MipGenerator.h"
+#include "../Loaders/CookedTexture.h"
+#include "../Loaders/ImageLoader.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <unordered_set>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr int TableVersion = 1;
+
+struct Rect {
+    int x, y, width, height;
+
+    bool Contains(const Rect& other) const {
+        return other.x >= x && other.y >= y && other.x + other.width <= x + width && other.y + other.height <= y + height;
+    }
+    bool Intersects(const Rect& other) const {
+        return other.x < x + width && x < other.x + other.width && other.y < y + height && y < other.y + other.height;
+    }
+};
+
+// Maximal free rectangles: every empty area is covered by the largest rectangles that fit in
+// it, overlapping each other, so a placement can use any corner of the remaining space
+class MaxRectsBin {
+public:
+    MaxRectsBin(int width, int height) {
+        m_free.push_back({0, 0, width, height});
+    }
+
+    bool Insert(int width, int height, int& x, int& y) {
+        // Best short side fit: the free rectangle leaving the thinnest sliver
+        const Rect* best = nullptr;
+        int bestShort = INT_MAX;
+        int bestLong = INT_MAX;
+        for (const Rect& free : m_free) {
+            if (free.width < width || free.height < height) {
+                continue;
+            }
+            int leftoverX = free.width - width;
+            int leftoverY = free.height - height;
+            int shortSide = std::min(leftoverX, leftoverY);
+            int longSide = std::max(leftoverX, leftoverY);
+            if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+                best = &free;
+                bestShort = shortSide;
+                bestLong = longSide;
+            }
+        }
+        if (!best) {
+            return false;
+        }
+        x = best->x;
+        y = best->y;
+        Place({x, y, width, height});
+        return true;
+    }
+
+private:
+    void Place(const Rect& used) {
+        m_split.clear();
+        for (const Rect& free : m_free) {
+            if (!free.Intersects(used)) {
+                m_split.push_back(free);
+                continue;
+            }
+            // Up to four maximal pieces of free around used
+            if (used.x > free.x) {
+                m_split.push_back({free.x, free.y, used.x - free.x, free.height});
+            }
+            if (used.x + used.width < free.x + free.width) {
+                m_split.push_back({used.x + used.width, free.y, free.x + free.width - used.x - used.width, free.height});
+            }
+            if (used.y > free.y) {
+                m_split.push_back({free.x, free.y, free.width, used.y - free.y});
+            }
+            if (used.y + used.height < free.y + free.height) {
+                m_split.push_back({free.x, used.y + used.height, free.width, free.y + free.height - used.y - used.height});
+            }
+        }
+
+        // Drop rectangles inside another one; of two equal ones the first is kept
+        m_free.clear();
+        for (size_t i = 0; i < m_split.size(); ++i) {
+            bool contained = false;
+            for (size_t j = 0; j < m_split.size() && !contained; ++j) {
+                if (i != j && m_split[j].Contains(m_split[i])) {
+                    contained = !m_split[i].Contains(m_split[j]) || j < i;
+                }
+            }
+            if (!contained) {
+                m_free.push_back(m_split[i]);
+            }
+        }
+    }
+
+    std::vector<Rect> m_free;
+    std::vector<Rect> m_split;
+};
+
+int NextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+int AlignUp(int value, int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool IsValidImage(const TextureData& image) {
+    return image.width > 0 && image.height > 0 && image.channels >= 1 && image.channels <= 4 &&
+           image.pixels.size() >= size_t(image.width) * size_t(image.height) * size_t(image.channels);
+}
+
+void ReadRGBA(const TextureData& image, int x, int y, unsigned char* rgba) {
+    const unsigned char* pixel = &image.pixels[(size_t(y) * size_t(image.width) + size_t(x)) * size_t(image.channels)];
+    switch (image.channels) {
+        case 1:
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = 255;
+            break;
+        case 2:
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = pixel[1];
+            break;
+        case 3:
+            rgba[0] = pixel[0];
+            rgba[1] = pixel[1];
+            rgba[2] = pixel[2];
+            rgba[3] = 255;
+            break;
+        default:
+            rgba[0] = pixel[0];
+            rgba[1] = pixel[1];
+            rgba[2] = pixel[2];
+            rgba[3] = pixel[3];
+            break;
+    }
+}
+
+Vector4 ComputeUVTransform(const TextureAtlas::Region& region, int width, int height) {
+    return Vector4(float(region.width) / float(width), float(region.height) / float(height),
+                   float(region.x) / float(width), float(region.y) / float(height));
+}
+
+}
+
+bool TextureAtlas::Pack(const std::vector<std::pair<int, int>>& sizes, int alignment, int maxSize,
+                        std::vector<std::pair<int, int>>& positions, int& width, int& height) {
+    positions.assign(sizes.size(), {0, 0});
+    width = height = 0;
+    if (sizes.empty()) {
+        return false;
+    }
+    // Power-of-two bins keep the placements on the grid as long as the grid is one too
+    alignment = NextPowerOfTwo(std::max(1, alignment));
+
+    std::vector<std::pair<int, int>> slots(sizes.size());
+    int widest = alignment, tallest = alignment;
+    uint64_t area = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i].first <= 0 || sizes[i].second <= 0) {
+            return false;
+        }
+        slots[i] = {AlignUp(sizes[i].first, alignment), AlignUp(sizes[i].second, alignment)};
+        widest = std::max(widest, slots[i].first);
+        tallest = std::max(tallest, slots[i].second);
+        area += uint64_t(slots[i].first) * uint64_t(slots[i].second);
+    }
+    if (widest > maxSize || tallest > maxSize) {
+        return false;
+    }
+
+    // Large and long slots first; they are the hard ones to fit late
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        int sideA = std::max(slots[a].first, slots[a].second);
+        int sideB = std::max(slots[b].first, slots[b].second);
+        if (sideA != sideB) {
+            return sideA > sideB;
+        }
+        return slots[a].first * slots[a].second > slots[b].first * slots[b].second;
+    });
+
+    int binWidth = NextPowerOfTwo(widest);
+    int binHeight = NextPowerOfTwo(tallest);
+    auto grow = [&]() {
+        if (binWidth <= binHeight && binWidth < maxSize) {
+            binWidth *= 2;
+        } else if (binHeight < maxSize) {
+            binHeight *= 2;
+        } else if (binWidth < maxSize) {
+            binWidth *= 2;
+        } else {
+            return false;
+        }
+        return true;
+    };
+    while (uint64_t(binWidth) * uint64_t(binHeight) < area) {
+        if (!grow()) {
+            return false;
+        }
+    }
+
+    while (true) {
+        MaxRectsBin bin(binWidth, binHeight);
+        bool packed = true;
+        for (size_t index : order) {
+            if (!bin.Insert(slots[index].first, slots[index].second, positions[index].first, positions[index].second)) {
+                packed = false;
+                break;
+            }
+        }
+        if (packed) {
+            width = binWidth;
+            height = binHeight;
+            return true;
+        }
+        if (!grow()) {
+            return false;
+        }
+    }
+}
+
+bool TextureAtlas::Build(const std::vector<std::string>& names, const std::vector<TextureData>& images,
+                         const AtlasSettings& settings) {
+    PROFILE_SCOPE("TextureAtlas::Build");
+    m_settings = settings;
+    m_settings.padding = std::max(0, settings.padding);
+    m_width = m_height = 0;
+    m_image = TextureData();
+    m_regions.clear();
+    m_texture.reset();
+
+    if (names.empty() || names.size() != images.size()) {
+        Logger::Error("TextureAtlas: needs one name per image");
+        return false;
+    }
+    std::unordered_set<std::string> unique;
+    std::vector<std::pair<int, int>> sizes(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!IsValidImage(images[i])) {
+            Logger::Error("TextureAtlas: image " + names[i] + " is empty or malformed");
+            return false;
+        }
+        if (!unique.insert(names[i]).second) {
+            Logger::Error("TextureAtlas: image " + names[i] + " appears twice");
+            return false;
+        }
+        sizes[i] = {images[i].width + 2 * m_settings.padding, images[i].height + 2 * m_settings.padding};
+    }
+
+    std::vector<std::pair<int, int>> positions;
+    if (!Pack(sizes, m_settings.alignment, m_settings.maxSize, positions, m_width, m_height)) {
+        Logger::Error("TextureAtlas: " + std::to_string(images.size()) + " images do not fit in " +
+                      std::to_string(m_settings.maxSize) + "x" + std::to_string(m_settings.maxSize));
+        m_width = m_height = 0;
+        return false;
+    }
+
+    m_image.width = m_width;
+    m_image.height = m_height;
+    m_image.channels = 4;
+    m_image.pixels.assign(size_t(m_width) * size_t(m_height) * 4, 0);
+    const int alignment = NextPowerOfTwo(std::max(1, m_settings.alignment));
+    uint64_t usedArea = 0;
+    for (size_t i = 0; i < images.size(); ++i) {
+        const TextureData& image = images[i];
+        Region region;
+        region.x = positions[i].first + m_settings.padding;
+        region.y = positions[i].second + m_settings.padding;
+        region.width = image.width;
+        region.height = image.height;
+        region.uvTransform = ComputeUVTransform(region, m_width, m_height);
+        usedArea += uint64_t(image.width) * uint64_t(image.height);
+
+        // The whole aligned slot is filled, gutter texels repeating the nearest edge texel
+        const int slotWidth = AlignUp(sizes[i].first, alignment);
+        const int slotHeight = AlignUp(sizes[i].second, alignment);
+        for (int row = 0; row < slotHeight; ++row) {
+            const int y = positions[i].second + row;
+            const int sourceY = std::clamp(y - region.y, 0, image.height - 1);
+            unsigned char* destination = &m_image.pixels[(size_t(y) * size_t(m_width) + size_t(positions[i].first)) * 4];
+            for (int column = 0; column < slotWidth; ++column) {
+                const int sourceX = std::clamp(positions[i].first + column - region.x, 0, image.width - 1);
+                ReadRGBA(image, sourceX, sourceY, destination + size_t(column) * 4);
+            }
+        }
+        m_regions.emplace(names[i], region);
+    }
+
+    Logger::Info("TextureAtlas: packed " + std::to_string(images.size()) + " images into " + std::to_string(m_width) + "x" +
+                 std::to_string(m_height) + ", " + std::to_string(usedArea * 100 / (uint64_t(m_width) * uint64_t(m_height))) +
+                 "% used");
+    return true;
+}
+
+bool TextureAtlas::BuildFromFiles(const std::vector<std::string>& paths, const AtlasSettings& settings) {
+    std::vector<TextureData> images(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!ImageLoader::LoadFromFile(paths[i], images[i])) {
+            Logger::Error("TextureAtlas: failed to load " + paths[i]);
+            return false;
+        }
+    }
+    return Build(paths, images, settings);
+}
+
+int TextureAtlas::GetMipLevels() const {
+    int levels = m_settings.mipLevels;
+    if (levels <= 0) {
+        // Level n shrinks the gutter to padding >> n texels
+        levels = 1;
+        while ((m_settings.padding >> levels) > 0) {
+            ++levels;
+        }
+    }
+    return std::min(levels, MipGenerator::GetLevelCount(m_width, m_height));
+}
+
+bool TextureAtlas::Upload(TextureCompression compression) {
+    if (m_image.pixels.empty()) {
+        Logger::Error("TextureAtlas: nothing to upload, build the atlas first");
+        return false;
+    }
+    CookedTexture::CookOptions options;
+    options.compression = compression;
+    options.mips.maxLevels = GetMipLevels();
+    TextureMipChain chain;
+    if (!CookedTexture::BuildMipChain(m_image, options, chain)) {
+        return false;
+    }
+    auto texture = std::make_shared<Texture>();
+    if (!texture->LoadMipChain(chain)) {
+        return false;
+    }
+    m_texture = texture;
+    return true;
+}
+
+bool TextureAtlas::WriteToFile(const std::string& path, TextureCompression compression) const {
+    if (m_image.pixels.empty()) {
+        Logger::Error("TextureAtlas: nothing to write, build the atlas first");
+        return false;
+    }
+    CookedTexture::CookOptions options;
+    options.compression = compression;
+    options.mips.maxLevels = GetMipLevels();
+    TextureMipChain chain;
+    if (!CookedTexture::BuildMipChain(m_image, options, chain) ||
+        !CookedTexture::WriteToFile(CookedTexture::GetCookedPath(path), chain)) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::Error("TextureAtlas: cannot create " + path);
+        return false;
+    }
+    // Sorted so re-cooking the same inputs gives the same file
+    std::vector<const std::pair<const std::string, Region>*> entries;
+    for (const auto& entry : m_regions) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    file << "# x y width height name; pixels from the bottom-left of " << CookedTexture::GetCookedPath(path) << "\n";
+    file << "atlas " << TableVersion << " " << m_width << " " << m_height << " " << m_settings.padding << "\n";
+    for (const auto* entry : entries) {
+        const Region& region = entry->second;
+        file << "region " << region.x << " " << region.y << " " << region.width << " " << region.height << " " << entry->first << "\n";
+    }
+    if (!file.good()) {
+        Logger::Error("TextureAtlas: write failed for " + path);
+        return false;
+    }
+    Logger::Info("Wrote texture atlas " + path + " with " + std::to_string(entries.size()) + " regions");
+    return true;
+}
+
+bool TextureAtlas::ReadTable(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        Logger::Error("TextureAtlas: cannot open " + path);
+        return false;
+    }
+    bool haveHeader = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream stream(line);
+        std::string tag;
+        stream >> tag;
+        if (tag == "atlas") {
+            int version = 0;
+            stream >> version >> m_width >> m_height >> m_settings.padding;
+            if (!stream || version != TableVersion || m_width <= 0 || m_height <= 0 || m_settings.padding < 0) {
+                Logger::Error("TextureAtlas: " + path + " has an invalid header");
+                return false;
+            }
+            haveHeader = true;
+        } else if (tag == "region" && haveHeader) {
+            Region region;
+            std::string name;
+            stream >> region.x >> region.y >> region.width >> region.height >> std::ws;
+            std::getline(stream, name);
+            if (name.empty() || region.x < 0 || region.y < 0 || region.width <= 0 || region.height <= 0 ||
+                region.x + region.width > m_width || region.y + region.height > m_height) {
+                Logger::Error("TextureAtlas: " + path + " has an invalid region: " + line);
+                return false;
+            }
+            region.uvTransform = ComputeUVTransform(region, m_width, m_height);
+            m_regions[name] = region;
+        } else {
+            Logger::Error("TextureAtlas: unexpected line in " + path + ": " + line);
+            return false;
+        }
+    }
+    return haveHeader;
+}
+
+bool TextureAtlas::LoadFromFile(const std::string& path) {
+    PROFILE_SCOPE("TextureAtlas::LoadFromFile");
+    m_settings = AtlasSettings();
+    m_width = m_height = 0;
+    m_image = TextureData();
+    m_regions.clear();
+    m_texture.reset();
+
+    TextureMipChain chain;
+    if (!ReadTable(path) || !CookedTexture::LoadFromFile(CookedTexture::GetCookedPath(path), chain)) {
+        m_regions.clear();
+        return false;
+    }
+    if (chain.width != m_width || chain.height != m_height) {
+        Logger::Error("TextureAtlas: " + path + " does not match its cooked texture");
+        m_regions.clear();
+        return false;
+    }
+    auto texture = std::make_shared<Texture>();
+    if (!texture->LoadMipChain(chain)) {
+        m_regions.clear();
+        return false;
+    }
+    m_texture = texture;
+    Logger::Debug("Loaded texture atlas " + path + ": " + std::to_string(m_regions.size()) + " regions");
+    return true;
+}
+
+const TextureAtlas::Region* TextureAtlas::GetRegion(const std::string& name) const {
+    auto it = m_regions.find(name);
+    return it != m_regions.end() ? &it->second : nullptr;
+}
+
+Vector4 TextureAtlas::GetUVTransform(const std::string& name) const {
+    const Region* region = GetRegion(name);
+    return region ? region->uvTransform : Vector4(1.0f, 1.0f, 0.0f, 0.0f);
+}
+
+}
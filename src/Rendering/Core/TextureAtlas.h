@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Texture.h"
+#include "../../Core/Math/Vector2.h"
+#include "../../Core/Math/Vector4.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace GameEngine {
+    struct AtlasSettings {
+        // Gutter around every image, filled by extruding its edge texels so bilinear taps and
+        // lower mips stay inside the image's own colors
+        int padding = 4;
+        // Slots start and end on this grid; 4 keeps BC blocks from straddling two images
+        int alignment = 4;
+        int maxSize = 4096;
+        // 0 = the deepest level whose gutter is still a whole texel, log2(padding) + 1
+        int mipLevels = 0;
+    };
+
+    // Packs a batch of images into one RGBA8 texture with MaxRects (best short side fit) and
+    // keeps a UV remap table, so props with small textures can share a texture and one
+    // instanced draw. A mesh's [0, 1] UVs map into its region as uv * scale + offset; tiling
+    // UVs outside [0, 1] would sample the neighbours. Built at load time from images, or
+    // offline by the texture cooker into "<name>.atlas" (the table) and "<name>.atlas.gtex".
+    class TextureAtlas {
+    public:
+        struct Region {
+            int x = 0, y = 0;           // Pixels from the bottom-left, excluding the gutter
+            int width = 0, height = 0;
+            Vector4 uvTransform = Vector4(1.0f, 1.0f, 0.0f, 0.0f);     // xy scale, zw offset
+        };
+
+        // Places slots of the given sizes (gutters included) in a power-of-two bin no larger
+        // than maxSize, growing from the smallest that could fit their area. Positions are
+        // written in input order; false if they do not fit.
+        static bool Pack(const std::vector<std::pair<int, int>>& sizes, int alignment, int maxSize,
+                         std::vector<std::pair<int, int>>& positions, int& width, int& height);
+
+        // CPU only; images may have 1 to 4 channels and are stored as RGBA8
+        bool Build(const std::vector<std::string>& names, const std::vector<TextureData>& images,
+                   const AtlasSettings& settings = AtlasSettings());
+        // Names regions by their path
+        bool BuildFromFiles(const std::vector<std::string>& paths, const AtlasSettings& settings = AtlasSettings());
+
+        // Creates the GPU texture from the built image
+        bool Upload(TextureCompression compression = TextureCompression::None);
+        // Writes the remap table to path and the cooked texture next to it
+        bool WriteToFile(const std::string& path, TextureCompression compression = TextureCompression::BC7) const;
+        // Reads both and uploads the texture
+        bool LoadFromFile(const std::string& path);
+
+        const Region* GetRegion(const std::string& name) const;
+        // Identity for unknown names
+        Vector4 GetUVTransform(const std::string& name) const;
+        static Vector2 RemapUV(const Vector4& uvTransform, const Vector2& uv) {
+            return Vector2(uv.x * uvTransform.x + uvTransform.z, uv.y * uvTransform.y + uvTransform.w);
+        }
+
+        std::shared_ptr<Texture> GetTexture() const { return m_texture; }
+        const TextureData& GetImage() const { return m_image; }
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        size_t GetRegionCount() const { return m_regions.size(); }
+        const std::unordered_map<std::string, Region>& GetRegions() const { return m_regions; }
+
+    private:
+        int GetMipLevels() const;
+        bool ReadTable(const std::string& path);
+
+        AtlasSettings m_settings;
+        int m_width = 0;
+        int m_height = 0;
+        TextureData m_image;
+        std::unordered_map<std::string, Region> m_regions;
+        std::shared_ptr<Texture> m_texture;
+    };
+}
@@ -0,0 +1,680 @@
+#include "TextureCompressor.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr size_t MinBlocksPerThread = 1024;     // Below this a thread spawn costs more than it saves
+constexpr int BC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// ---- Shared fitting ------------------------------------------------------------------------
+
+// Mean and dominant eigenvector of the channel covariance, by power iteration. The axis is
+// zero for a block of one color.
+void ComputePrincipalAxis(const float (*pixels)[4], int channels, float* mean, float* axis) {
+    for (int c = 0; c < channels; ++c) {
+        mean[c] = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            mean[c] += pixels[i][c];
+        }
+        mean[c] /= 16.0f;
+    }
+
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; ++i) {
+        float delta[4];
+        for (int c = 0; c < channels; ++c) {
+            delta[c] = pixels[i][c] - mean[c];
+        }
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                covariance[a][b] += delta[a] * delta[b];
+            }
+        }
+    }
+
+    // Start from the row of the widest channel so the iteration cannot begin orthogonal to it
+    int widest = 0;
+    for (int c = 1; c < channels; ++c) {
+        if (covariance[c][c] > covariance[widest][widest]) {
+            widest = c;
+        }
+    }
+    for (int c = 0; c < channels; ++c) {
+        axis[c] = covariance[widest][c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {};
+        float length = 0.0f;
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length += next[a] * next[a];
+        }
+        length = std::sqrt(length);
+        for (int c = 0; c < channels; ++c) {
+            axis[c] = length > 1e-6f ? next[c] / length : 0.0f;
+        }
+    }
+}
+
+// Endpoints spanning the projections of the pixels onto the principal axis
+void FitEndpoints(const float (*pixels)[4], int channels, float* start, float* end) {
+    float mean[4];
+    float axis[4];
+    ComputePrincipalAxis(pixels, channels, mean, axis);
+    float low = std::numeric_limits<float>::max();
+    float high = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 16; ++i) {
+        float projection = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+            projection += (pixels[i][c] - mean[c]) * axis[c];
+        }
+        low = std::min(low, projection);
+        high = std::max(high, projection);
+    }
+    for (int c = 0; c < channels; ++c) {
+        start[c] = mean[c] + axis[c] * high;
+        end[c] = mean[c] + axis[c] * low;
+    }
+}
+
+// Least-squares endpoints for fixed interpolation weights: pixel i ~ (1 - t[i]) start + t[i] end
+bool SolveEndpoints(const float (*pixels)[4], int channels, const float* t, float* start, float* end) {
+    float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+    float alphaX[4] = {}, betaX[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float alpha = 1.0f - t[i];
+        const float beta = t[i];
+        alpha2 += alpha * alpha;
+        beta2 += beta * beta;
+        alphaBeta += alpha * beta;
+        for (int c = 0; c < channels; ++c) {
+            alphaX[c] += alpha * pixels[i][c];
+            betaX[c] += beta * pixels[i][c];
+        }
+    }
+    const float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+    if (std::fabs(determinant) < 1e-6f) {
+        return false;                   // Every pixel on one index
+    }
+    for (int c = 0; c < channels; ++c) {
+        start[c] = (alphaX[c] * beta2 - betaX[c] * alphaBeta) / determinant;
+        end[c] = (betaX[c] * alpha2 - alphaX[c] * alphaBeta) / determinant;
+    }
+    return true;
+}
+
+void LoadPixels(const uint8_t* rgba, float (*pixels)[4]) {
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            pixels[i][c] = rgba[i * 4 + c];
+        }
+    }
+}
+
+// ---- BC1 color block -------------------------------------------------------------------------
+
+uint16_t Pack565(const float* color) {
+    int r = std::clamp(static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+    int g = std::clamp(static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+    int b = std::clamp(static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void Unpack565(uint16_t value, int* color) {
+    int r = (value >> 11) & 31;
+    int g = (value >> 5) & 63;
+    int b = value & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+void BuildColorPalette(uint16_t color0, uint16_t color1, bool fourColor, int (*palette)[4]) {
+    Unpack565(color0, palette[0]);
+    Unpack565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+}
+
+struct ColorFit {
+    uint16_t color0 = 0;
+    uint16_t color1 = 0;
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+// Four-color mode needs color0 > color1; equal endpoints put every pixel on index 0, which
+// decodes the same in either mode
+ColorFit EvaluateColorEndpoints(const float (*pixels)[4], uint16_t color0, uint16_t color1) {
+    ColorFit fit;
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+    fit.color0 = color0;
+    fit.color1 = color1;
+    int palette[4][4];
+    BuildColorPalette(color0, color1, true, palette);
+    const int entries = color0 == color1 ? 1 : 4;
+    fit.error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float bestError = std::numeric_limits<float>::max();
+        for (int entry = 0; entry < entries; ++entry) {
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                float delta = pixels[i][c] - palette[entry][c];
+                error += delta * delta;
+            }
+            if (error < bestError) {
+                bestError = error;
+                fit.indices[i] = static_cast<uint8_t>(entry);
+            }
+        }
+        fit.error += bestError;
+    }
+    return fit;
+}
+
+void EncodeColorBlock(const uint8_t* rgba, uint8_t* block) {
+    float pixels[16][4];
+    LoadPixels(rgba, pixels);
+
+    float start[4];
+    float end[4];
+    FitEndpoints(pixels, 3, start, end);
+    ColorFit best = EvaluateColorEndpoints(pixels, Pack565(start), Pack565(end));
+
+    // Palette positions of indices 0..3 as a fraction of the way from color0 to color1
+    static constexpr float IndexWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration) {
+        float t[16];
+        for (int i = 0; i < 16; ++i) {
+            t[i] = IndexWeights[best.indices[i]];
+        }
+        if (!SolveEndpoints(pixels, 3, t, start, end)) {
+            break;
+        }
+        ColorFit refined = EvaluateColorEndpoints(pixels, Pack565(start), Pack565(end));
+        if (refined.error >= best.error) {
+            break;
+        }
+        best = refined;
+    }
+
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        indices |= uint32_t(best.indices[i]) << (i * 2);
+    }
+    block[0] = static_cast<uint8_t>(best.color0);
+    block[1] = static_cast<uint8_t>(best.color0 >> 8);
+    block[2] = static_cast<uint8_t>(best.color1);
+    block[3] = static_cast<uint8_t>(best.color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        block[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+}
+
+// BC2 and BC3 always decode their color block in four-color mode
+void DecodeColorBlock(const uint8_t* block, uint8_t* rgba, bool forceFourColor) {
+    uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    int palette[4][4];
+    BuildColorPalette(color0, color1, forceFourColor || color0 > color1, palette);
+    uint32_t indices = uint32_t(block[4]) | (uint32_t(block[5]) << 8) | (uint32_t(block[6]) << 16) | (uint32_t(block[7]) << 24);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(indices >> (i * 2)) & 3];
+        for (int c = 0; c < 4; ++c) {
+            rgba[i * 4 + c] = static_cast<uint8_t>(color[c]);
+        }
+    }
+}
+
+// ---- BC3 alpha block -------------------------------------------------------------------------
+
+void BuildAlphaPalette(int alpha0, int alpha1, int* palette) {
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+        }
+    } else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+int FitAlphaIndices(const uint8_t* rgba, int alpha0, int alpha1, uint8_t* indices) {
+    int palette[8];
+    BuildAlphaPalette(alpha0, alpha1, palette);
+    int totalError = 0;
+    for (int i = 0; i < 16; ++i) {
+        int bestError = std::numeric_limits<int>::max();
+        for (int entry = 0; entry < 8; ++entry) {
+            int delta = rgba[i * 4 + 3] - palette[entry];
+            if (delta * delta < bestError) {
+                bestError = delta * delta;
+                indices[i] = static_cast<uint8_t>(entry);
+            }
+        }
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+// Tries the eight-value ramp over the full range, and the six-value ramp over the values
+// strictly between 0 and 255, which those two then hit exactly
+void EncodeAlphaBlock(const uint8_t* rgba, uint8_t* block) {
+    int low = 255, high = 0, innerLow = 255, innerHigh = 0;
+    for (int i = 0; i < 16; ++i) {
+        int alpha = rgba[i * 4 + 3];
+        low = std::min(low, alpha);
+        high = std::max(high, alpha);
+        if (alpha != 0 && alpha != 255) {
+            innerLow = std::min(innerLow, alpha);
+            innerHigh = std::max(innerHigh, alpha);
+        }
+    }
+    if (innerLow > innerHigh) {
+        innerLow = innerHigh = 0;
+    }
+
+    uint8_t indices[16];
+    uint8_t sixIndices[16];
+    int alpha0 = high, alpha1 = low;
+    int error = FitAlphaIndices(rgba, alpha0, alpha1, indices);
+    if (error > 0 && FitAlphaIndices(rgba, innerLow, innerHigh, sixIndices) < error) {
+        alpha0 = innerLow;
+        alpha1 = innerHigh;
+        std::memcpy(indices, sixIndices, sizeof(indices));
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= uint64_t(indices[i]) << (i * 3);
+    }
+    block[0] = static_cast<uint8_t>(alpha0);
+    block[1] = static_cast<uint8_t>(alpha1);
+    for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
+
+void DecodeAlphaBlock(const uint8_t* block, uint8_t* rgba) {
+    int palette[8];
+    BuildAlphaPalette(block[0], block[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= uint64_t(block[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + 3] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+    }
+}
+
+// ---- BC7 mode 6 ------------------------------------------------------------------------------
+// One subset, RGBA endpoints of 7 bits plus a shared low bit per endpoint, 4-bit indices
+
+struct BC7Fit {
+    int endpoints[2][4] = {};           // 7-bit values
+    int pBits[2] = {};
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+uint8_t InterpolateBC7(int start, int end, int weight) {
+    return static_cast<uint8_t>(((64 - weight) * start + weight * end + 32) >> 6);
+}
+
+void EvaluateBC7Endpoints(const float (*pixels)[4], const float* start, const float* end, BC7Fit& best) {
+    // Nearest 4-bit index for a position along the ramp in 64ths
+    static const auto nearestIndex = []() {
+        std::array<uint8_t, 65> table{};
+        for (int t = 0; t <= 64; ++t) {
+            int nearest = 0;
+            for (int i = 1; i < 16; ++i) {
+                if (std::abs(BC7Weights[i] - t) < std::abs(BC7Weights[nearest] - t)) {
+                    nearest = i;
+                }
+            }
+            table[t] = static_cast<uint8_t>(nearest);
+        }
+        return table;
+    }();
+
+    const float* source[2] = {start, end};
+    for (int pCombination = 0; pCombination < 4; ++pCombination) {
+        BC7Fit fit;
+        int decoded[2][4];
+        for (int e = 0; e < 2; ++e) {
+            fit.pBits[e] = (pCombination >> e) & 1;
+            for (int c = 0; c < 4; ++c) {
+                fit.endpoints[e][c] = std::clamp(static_cast<int>(std::lround((source[e][c] - fit.pBits[e]) * 0.5f)), 0, 127);
+                decoded[e][c] = (fit.endpoints[e][c] << 1) | fit.pBits[e];
+            }
+        }
+
+        float direction[4];
+        float length2 = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            direction[c] = float(decoded[1][c] - decoded[0][c]);
+            length2 += direction[c] * direction[c];
+        }
+        uint8_t palette[16][4];
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                palette[i][c] = InterpolateBC7(decoded[0][c], decoded[1][c], BC7Weights[i]);
+            }
+        }
+
+        // Project onto the ramp, then settle rounding against the neighbouring entries
+        fit.error = 0.0f;
+        for (int i = 0; i < 16 && fit.error < best.error; ++i) {
+            float projection = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                projection += (pixels[i][c] - decoded[0][c]) * direction[c];
+            }
+            int t = length2 > 0.0f ? std::clamp(static_cast<int>(projection / length2 * 64.0f + 0.5f), 0, 64) : 0;
+            int guess = nearestIndex[t];
+            float bestError = std::numeric_limits<float>::max();
+            for (int index = std::max(0, guess - 1); index <= std::min(15, guess + 1); ++index) {
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c) {
+                    float delta = pixels[i][c] - palette[index][c];
+                    error += delta * delta;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    fit.indices[i] = static_cast<uint8_t>(index);
+                }
+            }
+            fit.error += bestError;
+        }
+        if (fit.error < best.error) {
+            best = fit;
+        }
+    }
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* block) : m_block(block) { std::memset(block, 0, 16); }
+    void Write(uint32_t value, int count) {
+        for (int i = 0; i < count; ++i, ++m_position) {
+            m_block[m_position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (m_position & 7));
+        }
+    }
+
+private:
+    uint8_t* m_block;
+    int m_position = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* block) : m_block(block) {}
+    uint32_t Read(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; ++i, ++m_position) {
+            value |= uint32_t((m_block[m_position >> 3] >> (m_position & 7)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_block;
+    int m_position = 0;
+};
+
+// ---- Image level ------------------------------------------------------------------------------
+
+// Runs work(begin, end) over block rows, split across threads when there is enough of it
+template<typename F>
+void ParallelBlockRows(int rowCount, int rowBlocks, F&& work) {
+    const size_t totalBlocks = size_t(rowCount) * size_t(rowBlocks);
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min({threads, size_t(rowCount), std::max<size_t>(1, totalBlocks / MinBlocksPerThread)});
+    if (threads <= 1) {
+        work(0, rowCount);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    const int rowsPerThread = static_cast<int>((size_t(rowCount) + threads - 1) / threads);
+    for (size_t t = 1; t < threads; ++t) {
+        int begin = static_cast<int>(t) * rowsPerThread;
+        int end = std::min(rowCount, begin + rowsPerThread);
+        if (begin < end) {
+            workers.emplace_back([&work, begin, end]() { work(begin, end); });
+        }
+    }
+    work(0, std::min(rowCount, rowsPerThread));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+}
+
+void TextureCompressor::EncodeBC1Block(const uint8_t* rgba, uint8_t* block) {
+    EncodeColorBlock(rgba, block);
+}
+
+void TextureCompressor::EncodeBC2Block(const uint8_t* rgba, uint8_t* block) {
+    uint64_t alpha = 0;
+    for (int i = 0; i < 16; ++i) {
+        alpha |= uint64_t((rgba[i * 4 + 3] * 15 + 127) / 255) << (i * 4);
+    }
+    for (int i = 0; i < 8; ++i) {
+        block[i] = static_cast<uint8_t>(alpha >> (i * 8));
+    }
+    EncodeColorBlock(rgba, block + 8);
+}
+
+void TextureCompressor::EncodeBC3Block(const uint8_t* rgba, uint8_t* block) {
+    EncodeAlphaBlock(rgba, block);
+    EncodeColorBlock(rgba, block + 8);
+}
+
+void TextureCompressor::EncodeBC7Block(const uint8_t* rgba, uint8_t* block) {
+    float pixels[16][4];
+    LoadPixels(rgba, pixels);
+
+    float start[4];
+    float end[4];
+    FitEndpoints(pixels, 4, start, end);
+    BC7Fit best;
+    EvaluateBC7Endpoints(pixels, start, end, best);
+
+    for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration) {
+        float t[16];
+        for (int i = 0; i < 16; ++i) {
+            t[i] = BC7Weights[best.indices[i]] / 64.0f;
+        }
+        if (!SolveEndpoints(pixels, 4, t, start, end)) {
+            break;
+        }
+        const float previousError = best.error;
+        EvaluateBC7Endpoints(pixels, start, end, best);
+        if (best.error >= previousError) {
+            break;
+        }
+    }
+
+    // The first index is stored without its high bit, so it must be below 8
+    if (best.indices[0] >= 8) {
+        std::swap(best.endpoints[0], best.endpoints[1]);
+        std::swap(best.pBits[0], best.pBits[1]);
+        for (auto& index : best.indices) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    BitWriter writer(block);
+    writer.Write(1u << 6, 7);           // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(best.endpoints[0][c]), 7);
+        writer.Write(static_cast<uint32_t>(best.endpoints[1][c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(best.pBits[0]), 1);
+    writer.Write(static_cast<uint32_t>(best.pBits[1]), 1);
+    for (int i = 0; i < 16; ++i) {
+        writer.Write(best.indices[i], i == 0 ? 3 : 4);
+    }
+}
+
+void TextureCompressor::DecodeBC1Block(const uint8_t* block, uint8_t* rgba) {
+    DecodeColorBlock(block, rgba, false);
+}
+
+void TextureCompressor::DecodeBC2Block(const uint8_t* block, uint8_t* rgba) {
+    DecodeColorBlock(block + 8, rgba, true);
+    for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + 3] = static_cast<uint8_t>(((block[i / 2] >> ((i & 1) * 4)) & 15) * 17);
+    }
+}
+
+void TextureCompressor::DecodeBC3Block(const uint8_t* block, uint8_t* rgba) {
+    DecodeColorBlock(block + 8, rgba, true);
+    DecodeAlphaBlock(block, rgba);
+}
+
+bool TextureCompressor::DecodeBC7Block(const uint8_t* block, uint8_t* rgba) {
+    if ((block[0] & 0x7F) != 0x40) {
+        for (int i = 0; i < 16; ++i) {
+            rgba[i * 4] = 255;
+            rgba[i * 4 + 1] = 0;
+            rgba[i * 4 + 2] = 255;
+            rgba[i * 4 + 3] = 255;
+        }
+        return false;
+    }
+    BitReader reader(block);
+    reader.Read(7);
+    int endpoints[2][4];
+    for (int c = 0; c < 4; ++c) {
+        endpoints[0][c] = static_cast<int>(reader.Read(7));
+        endpoints[1][c] = static_cast<int>(reader.Read(7));
+    }
+    const int pBits[2] = {static_cast<int>(reader.Read(1)), static_cast<int>(reader.Read(1))};
+    for (int e = 0; e < 2; ++e) {
+        for (int c = 0; c < 4; ++c) {
+            endpoints[e][c] = (endpoints[e][c] << 1) | pBits[e];
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        const int weight = BC7Weights[reader.Read(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c) {
+            rgba[i * 4 + c] = InterpolateBC7(endpoints[0][c], endpoints[1][c], weight);
+        }
+    }
+    return true;
+}
+
+size_t TextureCompressor::GetBlockSize(TextureCompression format) {
+    switch (format) {
+        case TextureCompression::DXT1: return 8;
+        case TextureCompression::DXT3:
+        case TextureCompression::DXT5:
+        case TextureCompression::BC7: return 16;
+        default: return 0;
+    }
+}
+
+size_t TextureCompressor::GetCompressedSize(int width, int height, TextureCompression format) {
+    return size_t((width + 3) / 4) * size_t((height + 3) / 4) * GetBlockSize(format);
+}
+
+std::vector<uint8_t> TextureCompressor::Compress(const TextureData& image, TextureCompression format) {
+    PROFILE_SCOPE("TextureCompressor::Compress");
+    std::vector<uint8_t> output;
+    const size_t blockSize = GetBlockSize(format);
+    if (blockSize == 0 || image.width <= 0 || image.height <= 0 || image.channels != 4 ||
+        image.pixels.size() < size_t(image.width) * image.height * 4) {
+        return output;
+    }
+
+    const int blocksX = (image.width + 3) / 4;
+    const int blocksY = (image.height + 3) / 4;
+    output.resize(size_t(blocksX) * blocksY * blockSize);
+    ParallelBlockRows(blocksY, blocksX, [&](int begin, int end) {
+        uint8_t pixels[64];
+        for (int by = begin; by < end; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                for (int y = 0; y < 4; ++y) {
+                    const int sourceY = std::min(by * 4 + y, image.height - 1);
+                    for (int x = 0; x < 4; ++x) {
+                        const int sourceX = std::min(bx * 4 + x, image.width - 1);
+                        std::memcpy(pixels + (y * 4 + x) * 4, image.pixels.data() + (size_t(sourceY) * image.width + sourceX) * 4, 4);
+                    }
+                }
+                uint8_t* block = output.data() + (size_t(by) * blocksX + bx) * blockSize;
+                switch (format) {
+                    case TextureCompression::DXT1: EncodeBC1Block(pixels, block); break;
+                    case TextureCompression::DXT3: EncodeBC2Block(pixels, block); break;
+                    case TextureCompression::DXT5: EncodeBC3Block(pixels, block); break;
+                    default: EncodeBC7Block(pixels, block); break;
+                }
+            }
+        }
+    });
+    return output;
+}
+
+bool TextureCompressor::Decompress(const uint8_t* data, size_t size, int width, int height, TextureCompression format,
+                                   TextureData& image) {
+    const size_t blockSize = GetBlockSize(format);
+    if (!data || blockSize == 0 || width <= 0 || height <= 0 || size < GetCompressedSize(width, height, format)) {
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.assign(size_t(width) * height * 4, 0);
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    bool supported = true;
+    uint8_t pixels[64];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            const uint8_t* block = data + (size_t(by) * blocksX + bx) * blockSize;
+            switch (format) {
+                case TextureCompression::DXT1: DecodeBC1Block(block, pixels); break;
+                case TextureCompression::DXT3: DecodeBC2Block(block, pixels); break;
+                case TextureCompression::DXT5: DecodeBC3Block(block, pixels); break;
+                default: supported = DecodeBC7Block(block, pixels) && supported; break;
+            }
+            for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    std::memcpy(image.pixels.data() + (size_t(by * 4 + y) * width + bx * 4 + x) * 4, pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return supported;
+}
+
+}
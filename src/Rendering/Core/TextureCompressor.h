@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Texture.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine {
+    // Block compression for RGBA8 images: BC1 (DXT1, opaque), BC2 (DXT3), BC3 (DXT5) and BC7
+    // (mode 6). Each 4x4 block is fitted along the principal axis of its colors and refined by
+    // least squares against the chosen indices. The decoders exist so cooked data can be
+    // checked without a GPU; none of this touches GL.
+    class TextureCompressor {
+    public:
+        // Blocks in row-major order, the layout glCompressedTexImage2D takes. Partial blocks at
+        // the right and top edges repeat the last row and column. Empty for None.
+        static std::vector<uint8_t> Compress(const TextureData& image, TextureCompression format);
+        static bool Decompress(const uint8_t* data, size_t size, int width, int height, TextureCompression format,
+                               TextureData& image);
+
+        // rgba holds the 16 pixels of one block, row by row
+        static void EncodeBC1Block(const uint8_t* rgba, uint8_t* block);
+        static void EncodeBC2Block(const uint8_t* rgba, uint8_t* block);
+        static void EncodeBC3Block(const uint8_t* rgba, uint8_t* block);
+        static void EncodeBC7Block(const uint8_t* rgba, uint8_t* block);
+
+        static void DecodeBC1Block(const uint8_t* block, uint8_t* rgba);
+        static void DecodeBC2Block(const uint8_t* block, uint8_t* rgba);
+        static void DecodeBC3Block(const uint8_t* block, uint8_t* rgba);
+        // Only mode 6 is implemented; other modes decode to opaque magenta and return false
+        static bool DecodeBC7Block(const uint8_t* block, uint8_t* rgba);
+
+        // Bytes per 4x4 block, 0 for None
+        static size_t GetBlockSize(TextureCompression format);
+        static size_t GetCompressedSize(int width, int height, TextureCompression format);
+    };
+}
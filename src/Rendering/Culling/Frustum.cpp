@@ -0,0 +1,56 @@
+#include "Frustum.h"
+#include <cmath>
+
+namespace GameEngine {
+
+Frustum Frustum::FromMatrix(const Matrix4& viewProjection) {
+    Frustum frustum;
+    const auto& m = viewProjection.m;
+    // Row i of the column-major matrix is (m[i], m[4 + i], m[8 + i], m[12 + i]); clip space is
+    // -w..w on every axis, so each plane is row 3 plus or minus one of the other rows
+    const int rows[PlaneCount] = {0, 0, 1, 1, 2, 2};
+    const float signs[PlaneCount] = {1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+    for (int p = 0; p < PlaneCount; ++p) {
+        int r = rows[p];
+        float a = m[3] + signs[p] * m[r];
+        float b = m[7] + signs[p] * m[4 + r];
+        float c = m[11] + signs[p] * m[8 + r];
+        float d = m[15] + signs[p] * m[12 + r];
+        float length = std::sqrt(a * a + b * b + c * c);
+        float inv = length > 0.0f ? 1.0f / length : 0.0f;
+        frustum.normalX[p] = a * inv;
+        frustum.normalY[p] = b * inv;
+        frustum.normalZ[p] = c * inv;
+        frustum.distance[p] = d * inv;
+    }
+    // Padding planes accept everything
+    for (int p = PlaneCount; p < 8; ++p) {
+        frustum.distance[p] = 1e30f;
+    }
+    return frustum;
+}
+
+bool Frustum::IntersectsSphere(const Vector3& center, float radius) const {
+    for (int p = 0; p < PlaneCount; ++p) {
+        float d = normalX[p] * center.x + normalY[p] * center.y + normalZ[p] * center.z + distance[p];
+        if (d < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tests the box corner furthest along each plane normal; conservative near frustum edges
+bool Frustum::IntersectsAABB(const Vector3& min, const Vector3& max) const {
+    for (int p = 0; p < PlaneCount; ++p) {
+        float x = normalX[p] >= 0.0f ? max.x : min.x;
+        float y = normalY[p] >= 0.0f ? max.y : min.y;
+        float z = normalZ[p] >= 0.0f ? max.z : min.z;
+        if (normalX[p] * x + normalY[p] * y + normalZ[p] * z + distance[p] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
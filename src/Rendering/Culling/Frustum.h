@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include "../../Core/Math/Matrix4.h"
+
+namespace GameEngine {
+    // Six clip planes extracted from a view-projection matrix (Gribb/Hartmann), normals pointing
+    // inwards. Planes are stored per component and padded to eight so four-wide tests need no
+    // tail handling.
+    struct Frustum {
+        static constexpr int PlaneCount = 6;
+
+        alignas(16) float normalX[8] = {};
+        alignas(16) float normalY[8] = {};
+        alignas(16) float normalZ[8] = {};
+        alignas(16) float distance[8] = {};
+
+        static Frustum FromMatrix(const Matrix4& viewProjection);
+
+        bool IntersectsSphere(const Vector3& center, float radius) const;
+        bool IntersectsAABB(const Vector3& min, const Vector3& max) const;
+    };
+}
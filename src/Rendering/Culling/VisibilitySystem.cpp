@@ -0,0 +1,250 @@
+#include "VisibilitySystem.h"
+#include "../Meshes/Mesh.h"
+#include "../../Core/ECS/World.h"
+#include "../../Core/Components/MeshComponent.h"
+#include "../../Core/Components/TransformComponent.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Math/SIMD.h"
+#include "../../Core/Threading/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr size_t ParallelCullThreshold = 8192;  // Below this waking the pool costs more than it saves
+constexpr size_t MinRenderablesPerChunk = 1024;
+
+}
+
+void VisibilitySystem::Update(World* world) {
+    PROFILE_SCOPE("VisibilitySystem::Update");
+    m_renderables.clear();
+    m_renderableCache.clear();
+    m_changedBounds.clear();
+    m_boundsUpdates = 0;
+    ++m_frame;
+    if (!world) {
+        for (const auto& [id, cached] : m_cache) {
+            m_changedBounds.push_back({cached.worldMin, cached.worldMax});
+        }
+        m_cache.clear();
+        m_centerX.clear(); m_centerY.clear(); m_centerZ.clear(); m_radius.clear();
+        return;
+    }
+
+    for (const auto& entity : world->GetEntities()) {
+        auto* meshComp = world->GetComponent<MeshComponent>(entity);
+        auto* transformComp = world->GetComponent<TransformComponent>(entity);
+        if (!meshComp || !transformComp || !meshComp->HasMesh() || !meshComp->IsVisible()) {
+            continue;
+        }
+
+        Mesh* mesh = meshComp->GetMesh().get();
+        const Transform& transform = transformComp->transform;
+        CachedBounds& cached = m_cache[entity.GetID()];
+        Vector3 localMin, localMax;
+        mesh->GetBoundingBox(localMin, localMax);
+
+        uint64_t version = transform.GetHierarchyVersion();
+        bool stale = cached.lastSeenFrame == 0 || cached.transformVersion != version || cached.mesh != mesh ||
+                     (cached.localMin - localMin).LengthSquared() > 0.0f || (cached.localMax - localMax).LengthSquared() > 0.0f;
+        if (stale) {
+            if (cached.lastSeenFrame != 0) {
+                m_changedBounds.push_back({cached.worldMin, cached.worldMax});
+            }
+            if (cached.mesh != mesh) {
+                cached.lod = 0;
+            }
+            cached.transformVersion = version;
+            cached.mesh = mesh;
+            cached.localMin = localMin;
+            cached.localMax = localMax;
+            cached.model = transform.GetLocalToWorldMatrix();
+
+            // Transformed box = transformed center +/- extent projected through |M|
+            const auto& m = cached.model.m;
+            Vector3 center = cached.model * ((localMin + localMax) * 0.5f);
+            Vector3 extent = (localMax - localMin) * 0.5f;
+            Vector3 worldExtent(
+                std::abs(m[0]) * extent.x + std::abs(m[4]) * extent.y + std::abs(m[8]) * extent.z,
+                std::abs(m[1]) * extent.x + std::abs(m[5]) * extent.y + std::abs(m[9]) * extent.z,
+                std::abs(m[2]) * extent.x + std::abs(m[6]) * extent.y + std::abs(m[10]) * extent.z);
+            cached.worldMin = center - worldExtent;
+            cached.worldMax = center + worldExtent;
+            m_changedBounds.push_back({cached.worldMin, cached.worldMax});
+            ++m_boundsUpdates;
+        }
+        cached.lastSeenFrame = m_frame;
+
+        Renderable renderable;
+        renderable.entity = entity;
+        renderable.meshComponent = meshComp;
+        renderable.mesh = mesh->GetLOD(cached.lod);
+        renderable.lod = cached.lod;
+        renderable.model = cached.model;
+        renderable.boundsMin = cached.worldMin;
+        renderable.boundsMax = cached.worldMax;
+        m_renderables.push_back(renderable);
+        m_renderableCache.push_back(&cached);
+    }
+
+    // Forget entities that were destroyed or stopped being renderable
+    if (m_cache.size() > m_renderables.size()) {
+        for (auto it = m_cache.begin(); it != m_cache.end();) {
+            if (it->second.lastSeenFrame != m_frame) {
+                m_changedBounds.push_back({it->second.worldMin, it->second.worldMax});
+                it = m_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    size_t padded = (m_renderables.size() + 3) & ~size_t(3);
+    m_centerX.assign(padded, 0.0f);
+    m_centerY.assign(padded, 0.0f);
+    m_centerZ.assign(padded, 0.0f);
+    m_radius.assign(padded, -1e30f);  // Padding spheres are outside every plane
+    for (size_t i = 0; i < m_renderables.size(); ++i) {
+        const Renderable& renderable = m_renderables[i];
+        Vector3 center = (renderable.boundsMin + renderable.boundsMax) * 0.5f;
+        m_centerX[i] = center.x;
+        m_centerY[i] = center.y;
+        m_centerZ[i] = center.z;
+        m_radius[i] = (renderable.boundsMax - center).Length();
+    }
+}
+
+void VisibilitySystem::SelectLODs(const Matrix4& view, const Matrix4& projection) {
+    PROFILE_SCOPE("VisibilitySystem::SelectLODs");
+    m_lodSwitches = 0;
+
+    // Camera position of a rigid view matrix: -R^T t
+    const auto& v = view.m;
+    Vector3 camera(-(v[0] * v[12] + v[1] * v[13] + v[2] * v[14]),
+                   -(v[4] * v[12] + v[5] * v[13] + v[6] * v[14]),
+                   -(v[8] * v[12] + v[9] * v[13] + v[10] * v[14]));
+    // Projected diameter / screen height = radius * P[1][1] / distance, or radius * P[1][1]
+    // for orthographic projections
+    const float scale = projection.m[5] * m_lodBias;
+    const bool perspective = projection.m[15] == 0.0f;
+
+    for (size_t i = 0; i < m_renderables.size(); ++i) {
+        Renderable& renderable = m_renderables[i];
+        Mesh* mesh = renderable.meshComponent->GetMesh().get();
+        const auto& lods = mesh->GetLODs();
+        if (lods.empty()) {
+            continue;
+        }
+
+        float size = m_radius[i] * scale;
+        if (perspective) {
+            float dx = m_centerX[i] - camera.x, dy = m_centerY[i] - camera.y, dz = m_centerZ[i] - camera.z;
+            float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            size = distance > m_radius[i] ? size / distance : std::numeric_limits<float>::max();
+        }
+
+        // The level for a size is the number of thresholds above it. Widening the size by the
+        // hysteresis either way gives the range of levels the current one may stay within.
+        size_t minLevel = 0, maxLevel = 0;
+        for (const MeshLOD& lod : lods) {
+            minLevel += size * (1.0f + m_lodHysteresis) < lod.screenSize ? 1 : 0;
+            maxLevel += size * (1.0f - m_lodHysteresis) < lod.screenSize ? 1 : 0;
+        }
+        CachedBounds& cached = *m_renderableCache[i];
+        size_t level = std::clamp<size_t>(cached.lod, minLevel, maxLevel);
+        if (level != cached.lod) {
+            cached.lod = static_cast<uint8_t>(level);
+            m_changedBounds.push_back({renderable.boundsMin, renderable.boundsMax});
+            ++m_lodSwitches;
+        }
+        renderable.lod = cached.lod;
+        renderable.mesh = mesh->GetLOD(level);
+    }
+}
+
+void VisibilitySystem::Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+    PROFILE_SCOPE("VisibilitySystem::Cull");
+    visible.clear();
+    size_t count = m_renderables.size();
+    WorkerPool& pool = WorkerPool::Instance();
+    if (count < ParallelCullThreshold || pool.GetThreadCount() <= 1) {
+        CullRange(frustum, 0, count, visible);
+        return;
+    }
+
+    // A few chunks per thread balance the load; chunks start on a group of four
+    const size_t threadCount = pool.GetThreadCount();
+    size_t chunk = std::max(MinRenderablesPerChunk, (count + threadCount * 4 - 1) / (threadCount * 4));
+    chunk = (chunk + 3) & ~size_t(3);
+    const size_t chunkCount = (count + chunk - 1) / chunk;
+
+    // Each thread appends to its own list and records where every chunk landed, so the
+    // chunks can be stitched back together in index order
+    struct ChunkSpan {
+        size_t thread, begin, end;
+    };
+    std::vector<std::vector<uint32_t>> partial(threadCount);
+    std::vector<ChunkSpan> spans(chunkCount);
+    pool.ParallelFor(chunkCount, [&](size_t item, size_t thread) {
+        std::vector<uint32_t>& list = partial[thread];
+        size_t start = list.size();
+        size_t begin = item * chunk;
+        CullRange(frustum, begin, std::min(count, begin + chunk), list);
+        spans[item] = {thread, start, list.size()};
+    });
+
+    size_t total = 0;
+    for (const auto& list : partial) {
+        total += list.size();
+    }
+    visible.reserve(total);
+    for (const ChunkSpan& span : spans) {
+        const std::vector<uint32_t>& list = partial[span.thread];
+        visible.insert(visible.end(), list.begin() + span.begin, list.begin() + span.end);
+    }
+}
+
+// begin must be a multiple of four; the sphere test runs on whole groups and the padding never passes
+void VisibilitySystem::CullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& visible) const {
+    visible.reserve(visible.size() + (end - begin));
+    for (size_t i = begin; i < end; i += 4) {
+#ifdef GE_SSE2
+        __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+        __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+        __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&m_radius[i]));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(frustum.normalX[p])), _mm_mul_ps(cy, _mm_set1_ps(frustum.normalY[p]))),
+                _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(frustum.normalZ[p])), _mm_set1_ps(frustum.distance[p])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+        }
+        int mask = _mm_movemask_ps(inside);
+#else
+        int mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            if (frustum.IntersectsSphere(Vector3(m_centerX[i + k], m_centerY[i + k], m_centerZ[i + k]), m_radius[i + k])) {
+                mask |= 1 << k;
+            }
+        }
+#endif
+        while (mask) {
+            int k = 0;
+            while (!(mask & (1 << k))) ++k;
+            mask &= ~(1 << k);
+            size_t index = i + static_cast<size_t>(k);
+            if (index >= end) break;
+            const Renderable& renderable = m_renderables[index];
+            if (frustum.IntersectsAABB(renderable.boundsMin, renderable.boundsMax)) {
+                visible.push_back(static_cast<uint32_t>(index));
+            }
+        }
+    }
+}
+
+}
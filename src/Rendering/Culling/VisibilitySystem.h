@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Frustum.h"
+#include "../../Core/ECS/Entity.h"
+#include "../../Core/Math/Matrix4.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace GameEngine {
+    class World;
+    class Mesh;
+    class MeshComponent;
+
+    // One visible-flagged entity with a mesh, valid until the next Update
+    struct Renderable {
+        Entity entity;
+        MeshComponent* meshComponent = nullptr;
+        Mesh* mesh = nullptr;   // The selected LOD of the component's mesh
+        uint8_t lod = 0;
+        Matrix4 model;
+        Vector3 boundsMin;      // World-space AABB
+        Vector3 boundsMax;
+    };
+
+    struct WorldBounds {
+        Vector3 min;
+        Vector3 max;
+    };
+
+    // Keeps world-space bounds for every renderable in the World and culls them against camera
+    // and shadow frustums. Bounds are recomputed only for entities whose transform or mesh
+    // changed; culling tests four bounding spheres per SIMD step, then refines with the AABB.
+    class VisibilitySystem {
+    public:
+        void Update(World* world);
+
+        // Writes indices into GetRenderables() of everything intersecting the frustum, in order.
+        // Safe to call concurrently; large lists are split across the WorkerPool.
+        void Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+        void Cull(const Matrix4& viewProjection, std::vector<uint32_t>& visible) const {
+            Cull(Frustum::FromMatrix(viewProjection), visible);
+        }
+
+        // Picks each renderable's LOD from the projected diameter of its bounding sphere, as a
+        // fraction of screen height, against the mesh's LOD screen sizes. Call after Update; the
+        // choice is kept for shadow passes too. A level only changes once the size crosses a
+        // threshold by the hysteresis fraction, so objects near a threshold do not flicker.
+        void SelectLODs(const Matrix4& view, const Matrix4& projection);
+        // Scales projected sizes; above 1 keeps finer levels for longer
+        void SetLODBias(float bias) { m_lodBias = bias; }
+        void SetLODHysteresis(float fraction) { m_lodHysteresis = fraction; }
+        size_t GetLODSwitchCount() const { return m_lodSwitches; }
+
+        const std::vector<Renderable>& GetRenderables() const { return m_renderables; }
+        size_t GetBoundsUpdateCount() const { return m_boundsUpdates; }
+        // World boxes touched by the last Update: old and new bounds of moved entities, bounds of
+        // entities that appeared, of those that were removed or hidden, and of LOD switches
+        const std::vector<WorldBounds>& GetChangedBounds() const { return m_changedBounds; }
+
+    private:
+        struct CachedBounds {
+            uint64_t transformVersion = 0;
+            const Mesh* mesh = nullptr;
+            Vector3 localMin, localMax;
+            Matrix4 model;
+            Vector3 worldMin, worldMax;
+            uint64_t lastSeenFrame = 0;
+            uint8_t lod = 0;
+        };
+
+        void CullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& visible) const;
+
+        std::unordered_map<EntityID, CachedBounds> m_cache;
+        std::vector<Renderable> m_renderables;
+        std::vector<CachedBounds*> m_renderableCache;   // Parallel to m_renderables
+        std::vector<WorldBounds> m_changedBounds;
+        // Bounding spheres in SoA form, padded to a multiple of four with empty spheres
+        std::vector<float> m_centerX, m_centerY, m_centerZ, m_radius;
+        uint64_t m_frame = 0;
+        size_t m_boundsUpdates = 0;
+        float m_lodBias = 1.0f;
+        float m_lodHysteresis = 0.1f;
+        size_t m_lodSwitches = 0;
+    };
+}
@@ -0,0 +1,377 @@
+#include "LightClusters.h"
+#include "../Core/Buffer.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Threading/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr size_t MinCandidatesPerThread = 512;  // Light/slice pairs; below this waking the pool costs more than it saves
+constexpr int ClustersPerSlice = LightClusterGrid::GridX * LightClusterGrid::GridY;
+
+bool SphereIntersectsBox(const float* box, float x, float y, float z, float radius) {
+    float dx = std::max(std::max(box[0] - x, 0.0f), x - box[3]);
+    float dy = std::max(std::max(box[1] - y, 0.0f), y - box[4]);
+    float dz = std::max(std::max(box[2] - z, 0.0f), z - box[5]);
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+void SetBox(float* box, float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+    box[0] = minX; box[1] = minY; box[2] = minZ;
+    box[3] = maxX; box[4] = maxY; box[5] = maxZ;
+}
+
+const char* const ShaderDeclarations = R"(
+struct ClusterLight {
+    vec4 positionRange;
+    vec4 colorIntensity;
+    vec4 directionType;
+    vec4 spotSource;
+};
+layout(std430, binding = 5) readonly buffer ClusterLights { ClusterLight clusterLights[]; };
+layout(std430, binding = 6) readonly buffer ClusterRanges { uvec2 clusterRanges[]; };
+layout(std430, binding = 7) readonly buffer ClusterLightIndices { uint clusterLightIndices[]; };
+uniform ivec4 clusterGrid;      // Cluster counts in x, y, z; w is the number of directional lights
+uniform vec4 clusterParams;     // Slice scale, slice bias, tiles per pixel in x and y
+uniform int clusterLogDepth;
+
+// Offset into clusterLightIndices and light count of the cluster holding worldPos
+uvec2 ClusterLightRange(vec3 worldPos) {
+    float depth = -(view * vec4(worldPos, 1.0)).z;
+    float d = clusterLogDepth != 0 ? log(max(depth, 1e-6)) : depth;
+    int slice = int(floor(d * clusterParams.x + clusterParams.y));
+    if (slice < 0 || slice >= clusterGrid.z) return uvec2(0u);
+    ivec2 tile = clamp(ivec2(gl_FragCoord.xy * clusterParams.zw), ivec2(0), clusterGrid.xy - 1);
+    return clusterRanges[(slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x];
+}
+)";
+
+template<typename T>
+void UploadStorage(std::unique_ptr<Buffer>& buffer, const std::vector<T>& data, unsigned int binding) {
+    if (!buffer) {
+        buffer = std::make_unique<Buffer>(BufferType::ShaderStorage, BufferUsage::Stream);
+    }
+    // Zero-sized storage buffers cannot be bound, so empty lists upload one zeroed element
+    static const T empty = {};
+    buffer->SetData(data.empty() ? &empty : data.data(), sizeof(T) * std::max<size_t>(data.size(), 1));
+    buffer->BindBase(binding);
+}
+
+}
+
+LightClusterGrid::LightClusterGrid() = default;
+LightClusterGrid::~LightClusterGrid() = default;
+
+void LightClusterGrid::Build(const std::vector<LightManager::ShaderLightData>& lights, const Matrix4& view, const Matrix4& projection) {
+    PROFILE_SCOPE("LightClusterGrid::Build");
+    if (!m_boundsValid || projection.m != m_boundsProjection.m) {
+        ExtractFrustum(projection);
+        ComputeClusterBounds();
+        m_boundsProjection = projection;
+        m_boundsValid = true;
+    }
+
+    m_records.clear();
+    m_localLights.clear();
+    auto makeRecord = [](const LightManager::ShaderLightData& light, size_t source) {
+        ClusterLightRecord record = {};
+        record.positionRange[0] = light.position.x;
+        record.positionRange[1] = light.position.y;
+        record.positionRange[2] = light.position.z;
+        record.positionRange[3] = light.range;
+        record.colorIntensity[0] = light.color.x;
+        record.colorIntensity[1] = light.color.y;
+        record.colorIntensity[2] = light.color.z;
+        record.colorIntensity[3] = light.intensity;
+        record.directionType[0] = light.direction.x;
+        record.directionType[1] = light.direction.y;
+        record.directionType[2] = light.direction.z;
+        record.directionType[3] = static_cast<float>(light.type);
+        record.spotSource[0] = std::cos(light.innerConeAngle * 3.14159265f / 180.0f);
+        record.spotSource[1] = std::cos(light.outerConeAngle * 3.14159265f / 180.0f);
+        record.spotSource[3] = static_cast<float>(source);
+        return record;
+    };
+
+    for (size_t i = 0; i < lights.size(); ++i) {
+        if (lights[i].type == 0) {
+            m_records.push_back(makeRecord(lights[i], i));
+        }
+    }
+    m_globalLightCount = static_cast<int>(m_records.size());
+
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const LightManager::ShaderLightData& light = lights[i];
+        if (light.type == 0 || light.range <= 0.0f) {
+            continue;
+        }
+        Vector3 center = view * light.position;
+        float depth = -center.z;
+        if (depth + light.range < m_near || depth - light.range >= m_far) {
+            continue;
+        }
+
+        LocalLight local;
+        local.x = center.x;
+        local.y = center.y;
+        local.z = center.z;
+        local.radius = light.range;
+        local.brightness = light.intensity * std::max({light.color.x, light.color.y, light.color.z});
+        local.sliceMin = SliceForDepth(std::max(depth - light.range, m_near));
+        local.sliceMax = SliceForDepth(std::min(depth + light.range, m_sliceDepths[GridZ]));
+        m_localLights.push_back(local);
+        m_records.push_back(makeRecord(light, i));
+    }
+
+    m_sliceCandidates.resize(GridZ);
+    size_t candidateCount = 0;
+    for (auto& candidates : m_sliceCandidates) {
+        candidates.clear();
+    }
+    for (size_t i = 0; i < m_localLights.size(); ++i) {
+        for (int s = m_localLights[i].sliceMin; s <= m_localLights[i].sliceMax; ++s) {
+            m_sliceCandidates[s].push_back(static_cast<uint32_t>(i));
+        }
+        candidateCount += static_cast<size_t>(m_localLights[i].sliceMax - m_localLights[i].sliceMin + 1);
+    }
+
+    m_clusterRanges.clear();
+    m_lightIndices.clear();
+    m_overflowCount = 0;
+
+    WorkerPool& pool = WorkerPool::Instance();
+    size_t threadCount = std::min<size_t>({pool.GetThreadCount(), static_cast<size_t>(GridZ), candidateCount / MinCandidatesPerThread});
+    if (threadCount <= 1) {
+        BinSlices(0, GridZ, m_clusterRanges, m_lightIndices, m_overflowCount);
+    } else {
+        // One item per slice into reused per-slice lists, stitched together in slice order
+        m_sliceOutputs.resize(GridZ);
+        pool.ParallelFor(GridZ, threadCount, [this](size_t z, size_t) {
+            SliceOutput& output = m_sliceOutputs[z];
+            output.ranges.clear();
+            output.indices.clear();
+            output.overflow = 0;
+            BinSlices(static_cast<int>(z), static_cast<int>(z) + 1, output.ranges, output.indices, output.overflow);
+        });
+        for (const SliceOutput& output : m_sliceOutputs) {
+            uint32_t base = static_cast<uint32_t>(m_lightIndices.size());
+            for (size_t r = 0; r < output.ranges.size(); r += 2) {
+                m_clusterRanges.push_back(output.ranges[r] + base);
+                m_clusterRanges.push_back(output.ranges[r + 1]);
+            }
+            m_lightIndices.insert(m_lightIndices.end(), output.indices.begin(), output.indices.end());
+            m_overflowCount += output.overflow;
+        }
+    }
+
+    if (m_overflowCount > 0) {
+        Logger::Debug("LightClusterGrid: " + std::to_string(m_overflowCount) + " light assignments dropped by the per-cluster limit");
+    }
+}
+
+// Appends ranges (offsets relative to indices) and light indices for slices [sliceBegin, sliceEnd)
+void LightClusterGrid::BinSlices(int sliceBegin, int sliceEnd, std::vector<uint32_t>& ranges, std::vector<uint32_t>& indices, size_t& overflow) const {
+    std::vector<uint32_t> sliceLights;
+    std::vector<uint16_t> sliceClusters;
+    std::vector<uint32_t> sorted;
+    std::vector<std::pair<float, uint32_t>> ranked;
+    uint32_t counts[ClustersPerSlice];
+
+    for (int z = sliceBegin; z < sliceEnd; ++z) {
+        sliceLights.clear();
+        sliceClusters.clear();
+        std::fill(std::begin(counts), std::end(counts), 0u);
+
+        for (uint32_t localIndex : m_sliceCandidates[z]) {
+            const LocalLight& light = m_localLights[localIndex];
+
+            // Columns and rows each cover the whole slice along the other axis, so the tiles the
+            // sphere can touch are bounded by the first and last column and row it reaches
+            int x0 = GridX, x1 = -1, y0 = GridY, y1 = -1;
+            for (int x = 0; x < GridX; ++x) {
+                if (SphereIntersectsBox(&m_columnBounds[(z * GridX + x) * 6], light.x, light.y, light.z, light.radius)) {
+                    x0 = std::min(x0, x);
+                    x1 = x;
+                }
+            }
+            if (x1 < 0) continue;
+            for (int y = 0; y < GridY; ++y) {
+                if (SphereIntersectsBox(&m_rowBounds[(z * GridY + y) * 6], light.x, light.y, light.z, light.radius)) {
+                    y0 = std::min(y0, y);
+                    y1 = y;
+                }
+            }
+
+            uint32_t recordIndex = static_cast<uint32_t>(m_globalLightCount) + localIndex;
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    int cluster = GetClusterIndex(x, y, z);
+                    if (!SphereIntersectsBox(&m_clusterBounds[cluster * 6], light.x, light.y, light.z, light.radius)) {
+                        continue;
+                    }
+                    int local = y * GridX + x;
+                    ++counts[local];
+                    sliceLights.push_back(recordIndex);
+                    sliceClusters.push_back(static_cast<uint16_t>(local));
+                }
+            }
+        }
+
+        // Counting sort of the slice's (cluster, light) pairs into per-cluster runs
+        uint32_t offsets[ClustersPerSlice];
+        uint32_t running = 0;
+        for (int c = 0; c < ClustersPerSlice; ++c) {
+            offsets[c] = running;
+            running += counts[c];
+        }
+        sorted.resize(running);
+        for (size_t i = 0; i < sliceLights.size(); ++i) {
+            sorted[offsets[sliceClusters[i]]++] = sliceLights[i];
+        }
+
+        uint32_t* run = sorted.data();
+        for (int c = 0; c < ClustersPerSlice; ++c) {
+            uint32_t count = counts[c];
+            if (count > static_cast<uint32_t>(MaxLightsPerCluster)) {
+                KeepBrightest(&m_clusterBounds[(z * ClustersPerSlice + c) * 6], run, count, ranked);
+                overflow += count - MaxLightsPerCluster;
+                count = MaxLightsPerCluster;
+            }
+            ranges.push_back(static_cast<uint32_t>(indices.size()));
+            ranges.push_back(count);
+            indices.insert(indices.end(), run, run + count);
+            run += counts[c];
+        }
+    }
+}
+
+// Moves the MaxLightsPerCluster records with the largest inverse-square contribution at the
+// cluster's nearest point to the front of lights, so a near, bright light is never dropped for
+// far, dim ones that happen to come first
+void LightClusterGrid::KeepBrightest(const float* box, uint32_t* lights, uint32_t count,
+                                     std::vector<std::pair<float, uint32_t>>& ranked) const {
+    ranked.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const LocalLight& light = m_localLights[lights[i] - static_cast<uint32_t>(m_globalLightCount)];
+        float dx = std::max(std::max(box[0] - light.x, 0.0f), light.x - box[3]);
+        float dy = std::max(std::max(box[1] - light.y, 0.0f), light.y - box[4]);
+        float dz = std::max(std::max(box[2] - light.z, 0.0f), light.z - box[5]);
+        ranked.emplace_back(light.brightness / std::max(dx * dx + dy * dy + dz * dz, 1e-4f), lights[i]);
+    }
+    std::partial_sort(ranked.begin(), ranked.begin() + MaxLightsPerCluster, ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (int i = 0; i < MaxLightsPerCluster; ++i) {
+        lights[i] = ranked[i].second;
+    }
+}
+
+const char* LightClusterGrid::GetShaderDeclarations() {
+    return ShaderDeclarations;
+}
+
+void LightClusterGrid::Upload() {
+    UploadStorage(m_recordBuffer, m_records, LightRecordBinding);
+    UploadStorage(m_rangeBuffer, m_clusterRanges, ClusterRangeBinding);
+    UploadStorage(m_indexBuffer, m_lightIndices, LightIndexBinding);
+}
+
+int LightClusterGrid::FindCluster(float ndcX, float ndcY, float viewDepth) const {
+    if (viewDepth < m_near || viewDepth >= m_sliceDepths[GridZ]) {
+        return -1;
+    }
+    int x = std::clamp(static_cast<int>((ndcX * 0.5f + 0.5f) * GridX), 0, GridX - 1);
+    int y = std::clamp(static_cast<int>((ndcY * 0.5f + 0.5f) * GridY), 0, GridY - 1);
+    return GetClusterIndex(x, y, SliceForDepth(viewDepth));
+}
+
+int LightClusterGrid::SliceForDepth(float depth) const {
+    float d = m_perspective ? std::log(std::max(depth, 1e-6f)) : depth;
+    int slice = static_cast<int>(std::floor(d * m_depthScale + m_depthBias));
+    return std::clamp(slice, 0, GridZ - 1);
+}
+
+void LightClusterGrid::ExtractFrustum(const Matrix4& projection) {
+    const auto& m = projection.m;
+    m_perspective = m[11] != 0.0f;
+    m_scaleX = m[0];
+    m_scaleY = m[5];
+    if (m_perspective) {
+        m_near = m[14] / (m[10] - 1.0f);
+        m_far = m[14] / (m[10] + 1.0f);
+        m_offsetX = m[8];
+        m_offsetY = m[9];
+    } else {
+        m_near = (m[14] + 1.0f) / m[10];
+        m_far = (m[14] - 1.0f) / m[10];
+        m_offsetX = m[12];
+        m_offsetY = m[13];
+    }
+    if (!(m_near > 1e-4f)) m_near = 1e-4f;
+    if (!(m_far > m_near * 1.001f)) m_far = m_near * 1000.0f;
+
+    m_sliceDepths.resize(GridZ + 1);
+    if (m_perspective) {
+        float logRatio = std::log(m_far / m_near);
+        m_depthScale = GridZ / logRatio;
+        m_depthBias = -GridZ * std::log(m_near) / logRatio;
+        for (int z = 0; z <= GridZ; ++z) {
+            m_sliceDepths[z] = m_near * std::pow(m_far / m_near, static_cast<float>(z) / GridZ);
+        }
+    } else {
+        m_depthScale = GridZ / (m_far - m_near);
+        m_depthBias = -m_near * m_depthScale;
+        for (int z = 0; z <= GridZ; ++z) {
+            m_sliceDepths[z] = m_near + (m_far - m_near) * static_cast<float>(z) / GridZ;
+        }
+    }
+}
+
+void LightClusterGrid::ComputeClusterBounds() {
+    m_clusterBounds.resize(static_cast<size_t>(ClusterCount) * 6);
+    m_columnBounds.resize(static_cast<size_t>(GridZ * GridX) * 6);
+    m_rowBounds.resize(static_cast<size_t>(GridZ * GridY) * 6);
+
+    // View-space coordinate of an NDC tile edge at a given depth
+    auto edgeX = [this](float ndc, float depth) {
+        return m_perspective ? depth * (ndc + m_offsetX) / m_scaleX : (ndc - m_offsetX) / m_scaleX;
+    };
+    auto edgeY = [this](float ndc, float depth) {
+        return m_perspective ? depth * (ndc + m_offsetY) / m_scaleY : (ndc - m_offsetY) / m_scaleY;
+    };
+
+    for (int z = 0; z < GridZ; ++z) {
+        float d0 = m_sliceDepths[z];
+        float d1 = m_sliceDepths[z + 1];
+        float sliceMinX = std::min({edgeX(-1.0f, d0), edgeX(-1.0f, d1), edgeX(1.0f, d0), edgeX(1.0f, d1)});
+        float sliceMaxX = std::max({edgeX(-1.0f, d0), edgeX(-1.0f, d1), edgeX(1.0f, d0), edgeX(1.0f, d1)});
+        float sliceMinY = std::min({edgeY(-1.0f, d0), edgeY(-1.0f, d1), edgeY(1.0f, d0), edgeY(1.0f, d1)});
+        float sliceMaxY = std::max({edgeY(-1.0f, d0), edgeY(-1.0f, d1), edgeY(1.0f, d0), edgeY(1.0f, d1)});
+
+        float tileMinX[GridX], tileMaxX[GridX], tileMinY[GridY], tileMaxY[GridY];
+        for (int x = 0; x < GridX; ++x) {
+            float n0 = -1.0f + 2.0f * x / GridX;
+            float n1 = -1.0f + 2.0f * (x + 1) / GridX;
+            tileMinX[x] = std::min({edgeX(n0, d0), edgeX(n0, d1), edgeX(n1, d0), edgeX(n1, d1)});
+            tileMaxX[x] = std::max({edgeX(n0, d0), edgeX(n0, d1), edgeX(n1, d0), edgeX(n1, d1)});
+            SetBox(&m_columnBounds[(z * GridX + x) * 6], tileMinX[x], sliceMinY, -d1, tileMaxX[x], sliceMaxY, -d0);
+        }
+        for (int y = 0; y < GridY; ++y) {
+            float n0 = -1.0f + 2.0f * y / GridY;
+            float n1 = -1.0f + 2.0f * (y + 1) / GridY;
+            tileMinY[y] = std::min({edgeY(n0, d0), edgeY(n0, d1), edgeY(n1, d0), edgeY(n1, d1)});
+            tileMaxY[y] = std::max({edgeY(n0, d0), edgeY(n0, d1), edgeY(n1, d0), edgeY(n1, d1)});
+            SetBox(&m_rowBounds[(z * GridY + y) * 6], sliceMinX, tileMinY[y], -d1, sliceMaxX, tileMaxY[y], -d0);
+        }
+        for (int y = 0; y < GridY; ++y) {
+            for (int x = 0; x < GridX; ++x) {
+                SetBox(&m_clusterBounds[GetClusterIndex(x, y, z) * 6], tileMinX[x], tileMinY[y], -d1, tileMaxX[x], tileMaxY[y], -d0);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "LightManager.h"
+#include "../../Core/Math/Matrix4.h"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+namespace GameEngine {
+
+class Buffer;
+
+// Light as stored in the clustered light SSBO (std430, 64 bytes)
+struct ClusterLightRecord {
+    float positionRange[4];     // World position (direction for directional lights), w range
+    float colorIntensity[4];    // rgb color, w intensity
+    float directionType[4];     // Spot direction, w light type
+    float spotSource[4];        // cos inner, cos outer, unused, index of the source light
+};
+static_assert(sizeof(ClusterLightRecord) == 64, "ClusterLightRecord must match the std430 ClusterLight layout");
+
+// CPU light binning for clustered forward shading. The view frustum is split into a
+// GridX x GridY screen tiles by GridZ depth slices (exponential for perspective projections);
+// every point/spot light's range sphere is tested against the view-space bounds of the
+// clusters it can reach, and each cluster gets a compact list of light indices. Directional
+// lights reach everything and are stored once at the front of the record list instead.
+// Build() only touches CPU memory, so it runs without a GL context.
+class LightClusterGrid {
+public:
+    static constexpr int GridX = 16;
+    static constexpr int GridY = 9;
+    static constexpr int GridZ = 24;
+    static constexpr int ClusterCount = GridX * GridY * GridZ;
+    static constexpr int MaxLightsPerCluster = 64;      // Bounds per-fragment shading cost; the brightest stay
+    static constexpr size_t MaxLights = 65536;          // Source indices must stay exact as floats
+
+    // SSBO binding points used by Upload()
+    static constexpr unsigned int LightRecordBinding = 5;
+    static constexpr unsigned int ClusterRangeBinding = 6;
+    static constexpr unsigned int LightIndexBinding = 7;
+
+    LightClusterGrid();
+    ~LightClusterGrid();
+
+    void Build(const std::vector<LightManager::ShaderLightData>& lights, const Matrix4& view, const Matrix4& projection);
+
+    // Uploads records, ranges and indices and binds them; needs a current context
+    void Upload();
+
+    // GLSL storage blocks, uniforms and ClusterLightRange(); needs the CameraData block before it
+    static const char* GetShaderDeclarations();
+
+    static int GetClusterIndex(int x, int y, int z) { return (z * GridY + y) * GridX + x; }
+    // Cluster containing a view-space point with depth > 0 at the given NDC position, or -1
+    int FindCluster(float ndcX, float ndcY, float viewDepth) const;
+
+    const std::vector<ClusterLightRecord>& GetRecords() const { return m_records; }
+    // Two entries per cluster: offset into GetLightIndices() and count
+    const std::vector<uint32_t>& GetClusterRanges() const { return m_clusterRanges; }
+    const std::vector<uint32_t>& GetLightIndices() const { return m_lightIndices; }
+    int GetGlobalLightCount() const { return m_globalLightCount; }
+
+    // Shader slice mapping: slice = depth * scale + bias, on log(depth) when logarithmic
+    float GetDepthScale() const { return m_depthScale; }
+    float GetDepthBias() const { return m_depthBias; }
+    bool IsLogarithmic() const { return m_perspective; }
+
+    size_t GetOverflowCount() const { return m_overflowCount; }
+
+private:
+    struct LocalLight {
+        float x, y, z;          // View space
+        float radius;
+        float brightness;       // Intensity times the brightest color channel
+        int sliceMin, sliceMax;
+    };
+    struct SliceOutput {
+        std::vector<uint32_t> ranges;
+        std::vector<uint32_t> indices;
+        size_t overflow = 0;
+    };
+
+    void ExtractFrustum(const Matrix4& projection);
+    void ComputeClusterBounds();
+    void BinSlices(int sliceBegin, int sliceEnd, std::vector<uint32_t>& ranges, std::vector<uint32_t>& indices, size_t& overflow) const;
+    void KeepBrightest(const float* box, uint32_t* lights, uint32_t count, std::vector<std::pair<float, uint32_t>>& ranked) const;
+    int SliceForDepth(float depth) const;
+
+    // Projection parameters
+    bool m_perspective = true;
+    float m_near = 0.1f;
+    float m_far = 1000.0f;
+    float m_scaleX = 1.0f, m_scaleY = 1.0f;     // m[0], m[5]
+    float m_offsetX = 0.0f, m_offsetY = 0.0f;   // m[8], m[9] for perspective, m[12], m[13] for orthographic
+    float m_depthScale = 1.0f;
+    float m_depthBias = 0.0f;
+    std::vector<float> m_sliceDepths;           // GridZ + 1 boundaries
+
+    // View-space cluster AABBs, ClusterCount * 6 floats (min xyz, max xyz)
+    std::vector<float> m_clusterBounds;
+    // Column (x) and row (y) bounds per slice used to narrow the tiles a light can touch
+    std::vector<float> m_columnBounds;
+    std::vector<float> m_rowBounds;
+    Matrix4 m_boundsProjection;
+    bool m_boundsValid = false;
+
+    std::vector<ClusterLightRecord> m_records;
+    std::vector<LocalLight> m_localLights;      // Parallel to the punctual records
+    std::vector<std::vector<uint32_t>> m_sliceCandidates;
+    int m_globalLightCount = 0;
+
+    std::vector<uint32_t> m_clusterRanges;
+    std::vector<uint32_t> m_lightIndices;
+    size_t m_overflowCount = 0;
+    std::vector<SliceOutput> m_sliceOutputs;    // Per-slice results of a parallel Build
+
+    std::unique_ptr<Buffer> m_recordBuffer;
+    std::unique_ptr<Buffer> m_rangeBuffer;
+    std::unique_ptr<Buffer> m_indexBuffer;
+};
+
+}
@@ -46,10 +46,10 @@ void LightManager::CollectLights(World* world) {
             
             light->SetPosition(transformComponent->transform.GetPosition());
             
-            if (m_activeLights.size() < MAX_LIGHTS) {
+            if (m_activeLights.size() < m_lightLimit) {
                 m_activeLights.push_back(light);
             } else {
-                Logger::Warning("Maximum number of lights (" + std::to_string(MAX_LIGHTS) + ") reached. Skipping additional lights.");
+                Logger::Warning("Maximum number of lights (" + std::to_string(m_lightLimit) + ") reached. Skipping additional lights.");
                 break;
             }
         }
@@ -19,6 +19,9 @@ public:
     // Light collection and management
     void CollectLights(World* world);
     const std::vector<Light*>& GetActiveLights() const { return m_activeLights; }
+    // Most lights CollectLights keeps; MAX_LIGHTS by default, raised by clustered shading
+    void SetLightLimit(size_t limit) { m_lightLimit = limit; }
+    size_t GetLightLimit() const { return m_lightLimit; }
     
     // Brightness calculation and hardware limits
     float CalculateTotalBrightness() const;
@@ -57,6 +60,7 @@ public:
     
 private:
     std::vector<Light*> m_activeLights;
+    size_t m_lightLimit = MAX_LIGHTS;
     float m_totalBrightness = 0.0f;
     LightOcclusion m_lightOcclusion;
     
@@ -11,18 +11,61 @@
 #include "../Meshes/Mesh.h"
 #include "../../Core/Components/RigidBodyComponent.h"
 #include "../../Physics/Collision/ContinuousCollisionDetection.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Math/SIMD.h"
+#include "../../Core/Threading/WorkerPool.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace GameEngine {
 
 LightOcclusion::SoftShadowMode LightOcclusion::s_defaultSoftShadowMode = LightOcclusion::SoftShadowMode::Fixed;
 int LightOcclusion::s_defaultFixedSampleCount = 6;
 
-static inline unsigned long long EdgeKey(unsigned int a, unsigned int b) {
+namespace {
+
+// Silhouette work below this many triangles, or polygon building below this many boundary
+// vertices, is cheaper than waking a pool worker
+constexpr size_t MinTrianglesPerThread = 16384;
+constexpr size_t MinBoundaryVerticesPerThread = 4096;
+// Faces count as lit when the cosine to the light exceeds this
+constexpr float FacingEpsilon = 1e-4f;
+
+inline uint64_t EdgeKey(unsigned int a, unsigned int b) {
     unsigned int x = a < b ? a : b;
     unsigned int y = a < b ? b : a;
-    return (static_cast<unsigned long long>(x) << 32) | static_cast<unsigned long long>(y);
+    return (static_cast<uint64_t>(x) << 32) | static_cast<uint64_t>(y);
+}
+
+inline void HashCombine(uint64_t& seed, uint64_t value) {
+    seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+}
+
+inline void HashCombine(uint64_t& seed, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    HashCombine(seed, static_cast<uint64_t>(bits));
+}
+
+inline void HashCombine(uint64_t& seed, const Vector3& value) {
+    HashCombine(seed, value.x);
+    HashCombine(seed, value.y);
+    HashCombine(seed, value.z);
+}
+
+// Directional lights test the face normal against the direction towards the light; point and
+// spot lights test it against the direction from the light to the face's first vertex
+inline bool IsFacing(float nx, float ny, float nz, float vx, float vy, float vz, bool directional) {
+    float d = nx * vx + ny * vy + nz * vz;
+    float nn = nx * nx + ny * ny + nz * nz;
+    if (directional) {
+        return d > FacingEpsilon * std::sqrt(nn);
+    }
+    float vv = vx * vx + vy * vy + vz * vz;
+    return vv > 1e-6f && d > FacingEpsilon * std::sqrt(nn * vv);
+}
+
 }
 
 LightOcclusion::LightOcclusion() {
@@ -269,69 +312,176 @@ std::vector<Vector3> LightOcclusion::GenerateSamplePoints(const Vector3& lightPo
     return samplePoints;
 }
 
-const LightOcclusion::MeshAdjacency& LightOcclusion::GetOrBuildAdjacency(const Mesh* mesh) {
-    auto it = m_adjacencyCache.find(mesh);
-    if (it != m_adjacencyCache.end() && it->second.built) return it->second;
+const LightOcclusion::MeshAdjacency& LightOcclusion::GetOrBuildAdjacency(const std::shared_ptr<Mesh>& mesh) {
+    auto it = m_adjacencyCache.find(mesh.get());
+    if (it != m_adjacencyCache.end() && it->second.mesh.lock() == mesh &&
+        it->second.geometryVersion == mesh->GetGeometryVersion()) {
+        return it->second;
+    }
     MeshAdjacency adj;
-    const auto& verts = mesh->GetVertices();
-    adj.positions.reserve(verts.size());
-    for (const auto& v : verts) adj.positions.push_back(v.position);
+    adj.mesh = mesh;
+    adj.geometryVersion = mesh->GetGeometryVersion();
+    // Decoded for this build only, so packed meshes keep no float copy
+    mesh->GetVertexPositions(adj.positions);
     adj.indices = mesh->GetIndices();
-    for (size_t tri = 0; tri + 2 < adj.indices.size(); tri += 3) {
-        unsigned int i0 = adj.indices[tri];
-        unsigned int i1 = adj.indices[tri + 1];
-        unsigned int i2 = adj.indices[tri + 2];
-        unsigned long long e01 = EdgeKey(i0, i1);
-        unsigned long long e12 = EdgeKey(i1, i2);
-        unsigned long long e20 = EdgeKey(i2, i0);
-        adj.edgeFaceCount[e01] += 1;
-        adj.edgeFaceCount[e12] += 1;
-        adj.edgeFaceCount[e20] += 1;
-        adj.edgeToTris[e01].push_back((unsigned int)tri);
-        adj.edgeToTris[e12].push_back((unsigned int)tri);
-        adj.edgeToTris[e20].push_back((unsigned int)tri);
-    }
-    adj.built = true;
-    auto ins = m_adjacencyCache.emplace(mesh, std::move(adj));
-    return ins.first->second;
+    adj.indices.resize(adj.indices.size() - adj.indices.size() % 3);
+    if (std::any_of(adj.indices.begin(), adj.indices.end(), [&](unsigned int i) { return i >= adj.positions.size(); })) {
+        Logger::Warning("LightOcclusion: mesh has out-of-range indices, it will cast no shadow volume");
+        adj.indices.clear();
+    }
+
+    const size_t triangleCount = adj.indices.size() / 3;
+    adj.halfEdges.reserve(triangleCount * 3);
+    for (size_t tri = 0; tri < triangleCount; ++tri) {
+        const unsigned int* t = &adj.indices[tri * 3];
+        for (int e = 0; e < 3; ++e) {
+            unsigned int a = t[e], b = t[(e + 1) % 3];
+            adj.halfEdges.push_back({EdgeKey(a, b), a, b, static_cast<unsigned int>(tri)});
+        }
+    }
+    std::sort(adj.halfEdges.begin(), adj.halfEdges.end(), [](const HalfEdge& a, const HalfEdge& b) {
+        return a.key != b.key ? a.key < b.key : a.triangle < b.triangle;
+    });
+    for (size_t i = 0; i < adj.halfEdges.size(); ++i) {
+        if (i == 0 || adj.halfEdges[i].key != adj.halfEdges[i - 1].key) adj.edgeRuns.push_back(static_cast<uint32_t>(i));
+    }
+    adj.edgeRuns.push_back(static_cast<uint32_t>(adj.halfEdges.size()));
+    MeshAdjacency& entry = m_adjacencyCache[mesh.get()];
+    entry = std::move(adj);
+    return entry;
 }
 
-void LightOcclusion::CollectBoundaryVerticesForLight(const Light* light, World* world, std::vector<ShadowVertex>& out) {
-    out.clear();
-    if (!light || !world) return;
-
-    Vector3 lightPos = light->GetPosition();
-    Vector3 lightDir = light->GetDirection().Normalized();
-    
-    auto entities = world->GetEntities();
-    auto workerCount = std::max(1u, std::thread::hardware_concurrency());
-    
-    if (workerCount <= 1 || entities.size() < 10) {
-        ProcessEntitiesForShadowVertices(entities.begin(), entities.end(), light, world, lightPos, lightDir, out);
-        return;
+uint64_t LightOcclusion::CollectOccluders(World* world, std::vector<OccluderInstance>& occluders) {
+    occluders.clear();
+    uint64_t signature = 0;
+    // Drop adjacency of meshes that no longer exist before taking pointers into the cache
+    for (auto it = m_adjacencyCache.begin(); it != m_adjacencyCache.end();) {
+        if (it->second.mesh.expired()) {
+            it = m_adjacencyCache.erase(it);
+        } else {
+            ++it;
+        }
     }
-    
-    std::mutex resultMutex;
-    std::vector<std::thread> threads;
-    size_t entitiesPerThread = std::max<size_t>(1, entities.size() / workerCount);
-    
-    for (unsigned t = 0; t < workerCount; ++t) {
-        auto start = entities.begin() + (t * entitiesPerThread);
-        auto end = (t == workerCount - 1) ? entities.end() : start + entitiesPerThread;
-        
-        if (start >= entities.end()) break;
-        
-        threads.emplace_back([&, start, end]() {
-            std::vector<ShadowVertex> localResults;
-            ProcessEntitiesForShadowVertices(start, end, light, world, lightPos, lightDir, localResults);
-            
-            std::lock_guard<std::mutex> lock(resultMutex);
-            out.insert(out.end(), localResults.begin(), localResults.end());
-        });
+    for (const auto& e : world->GetEntities()) {
+        auto* tc = world->GetComponent<TransformComponent>(e);
+        auto* mc = world->GetComponent<MeshComponent>(e);
+        if (!tc || !mc || !mc->HasMesh()) continue;
+        std::shared_ptr<Mesh> mesh = mc->GetMesh();
+        const MeshAdjacency& adj = GetOrBuildAdjacency(mesh);
+        if (adj.halfEdges.empty()) continue;
+        occluders.push_back({&adj, tc->transform.GetLocalToWorldMatrix()});
+        HashCombine(signature, static_cast<uint64_t>(e.GetID()));
+        HashCombine(signature, tc->transform.GetHierarchyVersion());
+        HashCombine(signature, mesh->GetGeometryVersion());
+    }
+    return signature;
+}
+
+void LightOcclusion::ExtractSilhouette(const OccluderInstance& occluder, const Light* light, SilhouetteWorker& worker) {
+    const MeshAdjacency& adj = *occluder.adjacency;
+    const bool directional = light->GetType() == LightType::Directional;
+    const Vector3 lightPos = light->GetPosition();
+    const Vector3 lightDir = light->GetDirection().Normalized();
+
+    // Each vertex is transformed once, into SoA arrays the facing test gathers from
+    const size_t vertexCount = adj.positions.size();
+    worker.x.resize(vertexCount);
+    worker.y.resize(vertexCount);
+    worker.z.resize(vertexCount);
+    const float* m = occluder.model.m.data();
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const Vector3& p = adj.positions[i];
+        worker.x[i] = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+        worker.y[i] = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+        worker.z[i] = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14];
+    }
+    const float* xs = worker.x.data();
+    const float* ys = worker.y.data();
+    const float* zs = worker.z.data();
+
+    const unsigned int* idx = adj.indices.data();
+    const size_t triangleCount = adj.indices.size() / 3;
+    worker.facing.resize(triangleCount);
+    uint8_t* facing = worker.facing.data();
+    // Directional lights compare against the direction to the light, others against the
+    // vector from the light position to the first vertex
+    const Vector3 reference = directional ? -lightDir : lightPos;
+    size_t tri = 0;
+#ifdef GE_SSE2
+    const __m128 epsilon = _mm_set1_ps(FacingEpsilon);
+    const __m128 minLengthSq = _mm_set1_ps(1e-6f);
+    const __m128 rx = _mm_set1_ps(reference.x);
+    const __m128 ry = _mm_set1_ps(reference.y);
+    const __m128 rz = _mm_set1_ps(reference.z);
+    for (; tri + 4 <= triangleCount; tri += 4) {
+        const unsigned int* t = idx + tri * 3;
+        __m128 ax = _mm_setr_ps(xs[t[0]], xs[t[3]], xs[t[6]], xs[t[9]]);
+        __m128 ay = _mm_setr_ps(ys[t[0]], ys[t[3]], ys[t[6]], ys[t[9]]);
+        __m128 az = _mm_setr_ps(zs[t[0]], zs[t[3]], zs[t[6]], zs[t[9]]);
+        __m128 e1x = _mm_sub_ps(_mm_setr_ps(xs[t[1]], xs[t[4]], xs[t[7]], xs[t[10]]), ax);
+        __m128 e1y = _mm_sub_ps(_mm_setr_ps(ys[t[1]], ys[t[4]], ys[t[7]], ys[t[10]]), ay);
+        __m128 e1z = _mm_sub_ps(_mm_setr_ps(zs[t[1]], zs[t[4]], zs[t[7]], zs[t[10]]), az);
+        __m128 e2x = _mm_sub_ps(_mm_setr_ps(xs[t[2]], xs[t[5]], xs[t[8]], xs[t[11]]), ax);
+        __m128 e2y = _mm_sub_ps(_mm_setr_ps(ys[t[2]], ys[t[5]], ys[t[8]], ys[t[11]]), ay);
+        __m128 e2z = _mm_sub_ps(_mm_setr_ps(zs[t[2]], zs[t[5]], zs[t[8]], zs[t[11]]), az);
+        __m128 nx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y));
+        __m128 ny = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z));
+        __m128 nz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x));
+        __m128 nn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+        __m128 mask;
+        if (directional) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, rx), _mm_mul_ps(ny, ry)), _mm_mul_ps(nz, rz));
+            mask = _mm_cmpgt_ps(d, _mm_mul_ps(epsilon, _mm_sqrt_ps(nn)));
+        } else {
+            __m128 vx = _mm_sub_ps(ax, rx);
+            __m128 vy = _mm_sub_ps(ay, ry);
+            __m128 vz = _mm_sub_ps(az, rz);
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, vx), _mm_mul_ps(ny, vy)), _mm_mul_ps(nz, vz));
+            __m128 vv = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+            mask = _mm_and_ps(_mm_cmpgt_ps(vv, minLengthSq),
+                              _mm_cmpgt_ps(d, _mm_mul_ps(epsilon, _mm_sqrt_ps(_mm_mul_ps(nn, vv)))));
+        }
+        int bits = _mm_movemask_ps(mask);
+        facing[tri] = static_cast<uint8_t>(bits & 1);
+        facing[tri + 1] = static_cast<uint8_t>((bits >> 1) & 1);
+        facing[tri + 2] = static_cast<uint8_t>((bits >> 2) & 1);
+        facing[tri + 3] = static_cast<uint8_t>((bits >> 3) & 1);
+    }
+#endif
+    for (; tri < triangleCount; ++tri) {
+        const unsigned int* t = idx + tri * 3;
+        float e1x = xs[t[1]] - xs[t[0]], e1y = ys[t[1]] - ys[t[0]], e1z = zs[t[1]] - zs[t[0]];
+        float e2x = xs[t[2]] - xs[t[0]], e2y = ys[t[2]] - ys[t[0]], e2z = zs[t[2]] - zs[t[0]];
+        float nx = e1y * e2z - e1z * e2y;
+        float ny = e1z * e2x - e1x * e2z;
+        float nz = e1x * e2y - e1y * e2x;
+        if (directional) {
+            facing[tri] = IsFacing(nx, ny, nz, reference.x, reference.y, reference.z, true);
+        } else {
+            facing[tri] = IsFacing(nx, ny, nz, xs[t[0]] - reference.x, ys[t[0]] - reference.y, zs[t[0]] - reference.z, false);
+        }
     }
-    
-    for (auto& thread : threads) {
-        thread.join();
+
+    auto emit = [&](unsigned int v) {
+        ShadowVertex sv;
+        sv.positionWS = Vector3(xs[v], ys[v], zs[v]);
+        sv.dirFromLight = directional ? -lightDir : (sv.positionWS - lightPos).Normalized();
+        worker.vertices.push_back(sv);
+    };
+    // An edge is on the silhouette if it is open or its faces disagree; it is emitted once per
+    // lit face, in that face's winding
+    for (size_t run = 0; run + 1 < adj.edgeRuns.size(); ++run) {
+        const HalfEdge* first = adj.halfEdges.data() + adj.edgeRuns[run];
+        const HalfEdge* last = adj.halfEdges.data() + adj.edgeRuns[run + 1];
+        bool open = last - first == 1;
+        bool anyUnlit = false;
+        for (const HalfEdge* h = first; h != last && !open; ++h) anyUnlit = anyUnlit || !facing[h->triangle];
+        if (!open && !anyUnlit) continue;
+        for (const HalfEdge* h = first; h != last; ++h) {
+            if (!facing[h->triangle]) continue;
+            emit(h->from);
+            emit(h->to);
+        }
     }
 }
 
@@ -381,27 +531,82 @@ void LightOcclusion::ExtrudeAreasToVolumes(const Light* light, const std::vector
     }
 }
 
-void LightOcclusion::BuildShadowVolumesForLight(const Light* light, World* world, int lightIndex, float dirFar) {
-    if (!light || !world) return;
-    
-    if (!ShouldRebuildShadowVolumes(light, world)) {
-        return;
+void LightOcclusion::BuildShadowVolumes(const std::vector<ShadowVolumeRequest>& requests, World* world) {
+    if (!world || requests.empty()) return;
+    PROFILE_SCOPE("LightOcclusion::BuildShadowVolumes");
+
+    std::vector<OccluderInstance> occluders;
+    const uint64_t sceneSignature = CollectOccluders(world, occluders);
+
+    std::vector<std::pair<const ShadowVolumeRequest*, uint64_t>> rebuilds;
+    for (const auto& request : requests) {
+        const Light* light = request.light;
+        if (!light) continue;
+        uint64_t signature = sceneSignature;
+        HashCombine(signature, static_cast<uint64_t>(light->GetType()));
+        HashCombine(signature, light->GetPosition());
+        HashCombine(signature, light->GetDirection());
+        HashCombine(signature, light->GetRange());
+        HashCombine(signature, light->GetOuterConeAngle());
+        HashCombine(signature, request.dirFar);
+        HashCombine(signature, static_cast<uint64_t>(static_cast<int64_t>(request.lightIndex)));
+        if (ShouldRebuildShadowVolumes(light, signature)) rebuilds.push_back({&request, signature});
+    }
+    if (rebuilds.empty()) return;
+
+    WorkerPool& pool = WorkerPool::Instance();
+    const size_t hardwareThreads = pool.GetThreadCount();
+
+    // Job j extracts occluder j % occluders.size() for light j / occluders.size()
+    const size_t jobCount = rebuilds.size() * occluders.size();
+    size_t triangles = 0;
+    for (const auto& occluder : occluders) triangles += occluder.adjacency->indices.size() / 3;
+    size_t threadCount = std::min({hardwareThreads, jobCount, triangles * rebuilds.size() / MinTrianglesPerThread});
+    threadCount = std::max<size_t>(1, threadCount);
+    if (m_silhouetteWorkers.size() < threadCount) m_silhouetteWorkers.resize(threadCount);
+    for (size_t t = 0; t < threadCount; ++t) {
+        m_silhouetteWorkers[t].vertices.clear();
+        m_silhouetteWorkers[t].jobs.clear();
+    }
+    pool.ParallelFor(jobCount, threadCount, [&](size_t job, size_t thread) {
+        SilhouetteWorker& worker = m_silhouetteWorkers[thread];
+        size_t begin = worker.vertices.size();
+        ExtractSilhouette(occluders[job % occluders.size()], rebuilds[job / occluders.size()].first->light, worker);
+        if (worker.vertices.size() > begin) worker.jobs.push_back({job, begin, worker.vertices.size()});
+    });
+
+    // Each light's boundary is gathered in occluder order, whichever thread produced it
+    std::vector<std::pair<const ShadowVertex*, const ShadowVertex*>> slices(jobCount, {nullptr, nullptr});
+    size_t boundaryVertices = 0;
+    for (size_t t = 0; t < threadCount; ++t) {
+        const SilhouetteWorker& worker = m_silhouetteWorkers[t];
+        for (const SilhouetteJob& job : worker.jobs) {
+            slices[job.job] = {worker.vertices.data() + job.begin, worker.vertices.data() + job.end};
+        }
+        boundaryVertices += worker.vertices.size();
     }
-    
-    if (m_useGPUCompute && m_shadowVolumeGenShader && m_shadowVolumeExtrudeShader) {
-        BuildShadowVolumesGPU(light, world, lightIndex, dirFar);
-    } else {
+
+    // Ordering the boundary into polygons dominates once extraction is parallel; lights are
+    // independent, so they fan out as well
+    std::vector<std::vector<ShadowVolume>> volumes(rebuilds.size());
+    size_t polygonThreads = std::min({hardwareThreads, rebuilds.size(), boundaryVertices / MinBoundaryVerticesPerThread});
+    pool.ParallelFor(rebuilds.size(), std::max<size_t>(1, polygonThreads), [&](size_t r, size_t) {
+        const ShadowVolumeRequest& request = *rebuilds[r].first;
         std::vector<ShadowVertex> boundary;
-        CollectBoundaryVerticesForLight(light, world, boundary);
+        for (size_t o = 0; o < occluders.size(); ++o) {
+            const auto& slice = slices[r * occluders.size() + o];
+            boundary.insert(boundary.end(), slice.first, slice.second);
+        }
         std::vector<ShadowArea> areas;
-        BuildAreasFromBoundaryVertices(light, boundary, areas);
-        std::vector<ShadowVolume> vols;
-        ExtrudeAreasToVolumes(light, areas, vols, dirFar);
-        for (auto& v : vols) v.lightIndex = lightIndex;
-        m_lightVolumes[light] = std::move(vols);
+        BuildAreasFromBoundaryVertices(request.light, boundary, areas);
+        ExtrudeAreasToVolumes(request.light, areas, volumes[r], request.dirFar);
+        for (auto& v : volumes[r]) v.lightIndex = request.lightIndex;
+    });
+
+    for (size_t r = 0; r < rebuilds.size(); ++r) {
+        m_lightVolumes[rebuilds[r].first->light] = std::move(volumes[r]);
+        m_lightSignatures[rebuilds[r].first->light] = rebuilds[r].second;
     }
-    
-    m_lightVersions[light] = ++m_worldVersion;
 }
 
 const std::vector<ShadowVolume>* LightOcclusion::GetVolumesForLight(const Light* light) const {
@@ -437,90 +642,6 @@ std::vector<RigidBody*> LightOcclusion::GetOccludingBodiesForSegment(const Vecto
     return result;
 }
 
-template<typename Iterator>
-void LightOcclusion::ProcessEntitiesForShadowVertices(Iterator start, Iterator end, const Light* light, World* world, 
-                                                    const Vector3& lightPos, const Vector3& lightDir, std::vector<ShadowVertex>& out) {
-    for (auto it = start; it != end; ++it) {
-        const auto& e = *it;
-        auto* tc = world->GetComponent<TransformComponent>(e);
-        auto* mc = world->GetComponent<MeshComponent>(e);
-        if (!tc || !mc || !mc->HasMesh()) continue;
-
-        const Mesh* mesh = mc->GetMesh().get();
-        const auto& adj = GetOrBuildAdjacency(mesh);
-        const auto& idx = adj.indices;
-        const auto& pos = adj.positions;
-
-        Matrix4 model = tc->transform.GetLocalToWorldMatrix();
-
-        auto faceFacing = [&](unsigned int triStart)->float {
-            unsigned int i0 = idx[triStart], i1 = idx[triStart + 1], i2 = idx[triStart + 2];
-            Vector3 p0 = model * pos[i0];
-            Vector3 p1 = model * pos[i1];
-            Vector3 p2 = model * pos[i2];
-            Vector3 n = (p1 - p0).Cross(p2 - p0).Normalized();
-            if (light->GetType() == LightType::Directional) {
-                return n.Dot(-lightDir.Normalized());
-            } else {
-                Vector3 lightToVertex = (p0 - lightPos);
-                if (lightToVertex.LengthSquared() > 1e-6f) {
-                    return n.Dot(lightToVertex.Normalized());
-                }
-                return 0.0f;
-            }
-        };
-
-        auto emitEdge = [&](const Vector3& a, const Vector3& b) {
-            ShadowVertex svA; svA.positionWS = a;
-            svA.dirFromLight = (light->GetType() == LightType::Directional) ? -lightDir : (a - lightPos).Normalized();
-            ShadowVertex svB; svB.positionWS = b;
-            svB.dirFromLight = (light->GetType() == LightType::Directional) ? -lightDir : (b - lightPos).Normalized();
-            out.push_back(svA);
-            out.push_back(svB);
-        };
-
-        for (size_t tri = 0; tri + 2 < idx.size(); tri += 3) {
-            unsigned int i0 = idx[tri], i1 = idx[tri + 1], i2 = idx[tri + 2];
-            float fThis = faceFacing((unsigned int)tri);
-            if (fThis <= 1e-4f) continue;
-
-            Vector3 p0 = model * pos[i0];
-            Vector3 p1 = model * pos[i1];
-            Vector3 p2 = model * pos[i2];
-
-            auto handleEdge = [&](unsigned int a, unsigned int b, const Vector3& pa, const Vector3& pb) {
-                unsigned long long ek = EdgeKey(a, b);
-                auto fcIt = adj.edgeFaceCount.find(ek);
-                int count = (fcIt != adj.edgeFaceCount.end()) ? fcIt->second : 0;
-                bool boundary = count <= 1;
-
-                bool opposite = false;
-                if (!boundary) {
-                    auto adjIt = adj.edgeToTris.find(ek);
-                    if (adjIt != adj.edgeToTris.end()) {
-                        for (unsigned int triIdx : adjIt->second) {
-                            if (triIdx == tri) continue;
-                            float fOther = faceFacing(triIdx);
-                            if ((fThis > 1e-4f) != (fOther > 1e-4f)) {
-                                opposite = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (boundary || opposite) {
-                    emitEdge(pa, pb);
-                }
-            };
-
-            handleEdge(i0, i1, p0, p1);
-            handleEdge(i1, i2, p1, p2);
-            handleEdge(i2, i0, p2, p0);
-        }
-    }
-}
-
 void LightOcclusion::InitializeComputeShaders() {
     if (!m_shadowVolumeGenShader) {
         m_shadowVolumeGenShader = std::make_shared<Shader>();
@@ -543,33 +664,13 @@ void LightOcclusion::InitializeComputeShaders() {
     Logger::Info("Shadow volume compute shaders initialized successfully");
 }
 
-void LightOcclusion::BuildShadowVolumesGPU(const Light* light, World* world, int lightIndex, float dirFar) {
-    Logger::Info("Building shadow volumes using GPU compute shaders (simplified implementation)");
-    
-    std::vector<ShadowVertex> boundary;
-    CollectBoundaryVerticesForLight(light, world, boundary);
-    std::vector<ShadowArea> areas;
-    BuildAreasFromBoundaryVertices(light, boundary, areas);
-    std::vector<ShadowVolume> vols;
-    ExtrudeAreasToVolumes(light, areas, vols, dirFar);
-    for (auto& v : vols) v.lightIndex = lightIndex;
-    m_lightVolumes[light] = std::move(vols);
-}
-
-bool LightOcclusion::ShouldRebuildShadowVolumes(const Light* light, World* world) const {
-    (void)world; // Mark parameter as intentionally unused for now
-    
-    auto it = m_lightVersions.find(light);
-    if (it == m_lightVersions.end()) {
-        return true;
-    }
-    
-    return it->second != m_worldVersion;
+bool LightOcclusion::ShouldRebuildShadowVolumes(const Light* light, uint64_t signature) const {
+    auto it = m_lightSignatures.find(light);
+    return it == m_lightSignatures.end() || it->second != signature;
 }
 
 void LightOcclusion::MarkShadowVolumesDirty(const Light* light) {
-    m_lightVersions.erase(light);
-    ++m_worldVersion;
+    m_lightSignatures.erase(light);
 }
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Core/Math/Vector3.h"
+#include "../../Core/Math/Matrix4.h"
 #include "../../Physics/PhysicsWorld.h"
 #include "../../Physics/RigidBody/RigidBody.h"
 #include <vector>
@@ -9,6 +10,7 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 
 namespace GameEngine {
 
@@ -40,6 +42,12 @@ struct ShadowVolume {
     int lightIndex = -1;
 };
 
+struct ShadowVolumeRequest {
+    const Light* light = nullptr;
+    int lightIndex = -1;
+    float dirFar = 0.0f;        // Extrusion length for directional lights
+};
+
 class LightOcclusion {
 public:
     enum class SoftShadowMode { Off = 0, Fixed = 1, Adaptive = 2 };
@@ -73,22 +81,58 @@ public:
     static int GetDefaultFixedSampleCount() { return s_defaultFixedSampleCount; }
     
 public:
-    void BuildShadowVolumesForLight(const Light* light, World* world, int lightIndex, float dirFar);
+    // Rebuilds the volumes of the requested lights whose light or occluders changed since their
+    // last build. Silhouettes of every such light are extracted in one pass fanned out over
+    // (light, mesh instance) jobs on the WorkerPool, each thread writing to its own buffer.
+    void BuildShadowVolumes(const std::vector<ShadowVolumeRequest>& requests, World* world);
+    void BuildShadowVolumesForLight(const Light* light, World* world, int lightIndex, float dirFar) {
+        BuildShadowVolumes({{light, lightIndex, dirFar}}, world);
+    }
     const std::vector<ShadowVolume>* GetVolumesForLight(const Light* light) const;
     std::vector<RigidBody*> GetOccludingBodiesForSegment(const Vector3& start, const Vector3& end);
 private:
+    // One per triangle edge in the triangle's winding, sorted by the undirected vertex pair
+    // so all faces sharing an edge form one run
+    struct HalfEdge {
+        uint64_t key;               // Smaller vertex << 32 | larger vertex
+        unsigned int from;
+        unsigned int to;
+        unsigned int triangle;
+    };
+    // Built once per mesh geometry; mesh and geometryVersion tell a live, unchanged mesh from
+    // one that was edited or freed and replaced by another at the same address
     struct MeshAdjacency {
-        bool built = false;
+        std::weak_ptr<const Mesh> mesh;
+        uint64_t geometryVersion = 0;
         std::vector<unsigned int> indices;
         std::vector<Vector3> positions;
-        std::unordered_map<unsigned long long, int> edgeFaceCount;
-        std::unordered_map<unsigned long long, std::vector<unsigned int>> edgeToTris;
+        std::vector<HalfEdge> halfEdges;
+        std::vector<uint32_t> edgeRuns;     // First half-edge of each edge, then halfEdges.size()
+    };
+    struct OccluderInstance {
+        const MeshAdjacency* adjacency;
+        Matrix4 model;
+    };
+    struct SilhouetteJob {
+        size_t job;
+        size_t begin;
+        size_t end;
+    };
+    // Reused between rebuilds
+    struct SilhouetteWorker {
+        std::vector<float> x, y, z;         // World-space positions of the current mesh
+        std::vector<uint8_t> facing;        // Per triangle
+        std::vector<ShadowVertex> vertices;
+        std::vector<SilhouetteJob> jobs;
     };
     std::unordered_map<const Mesh*, MeshAdjacency> m_adjacencyCache;
     std::unordered_map<const Light*, std::vector<ShadowVolume>> m_lightVolumes;
+    std::vector<SilhouetteWorker> m_silhouetteWorkers;
 
-    const MeshAdjacency& GetOrBuildAdjacency(const Mesh* mesh);
-    void CollectBoundaryVerticesForLight(const Light* light, World* world, std::vector<ShadowVertex>& out);
+    const MeshAdjacency& GetOrBuildAdjacency(const std::shared_ptr<Mesh>& mesh);
+    // Main thread only: resolves meshes, builds missing adjacency and world matrices
+    uint64_t CollectOccluders(World* world, std::vector<OccluderInstance>& occluders);
+    static void ExtractSilhouette(const OccluderInstance& occluder, const Light* light, SilhouetteWorker& worker);
     void BuildAreasFromBoundaryVertices(const Light* light, const std::vector<ShadowVertex>& seeds, std::vector<ShadowArea>& areas);
     void ExtrudeAreasToVolumes(const Light* light, const std::vector<ShadowArea>& areas, std::vector<ShadowVolume>& volumes, float dirFar);
 
@@ -100,7 +144,6 @@ private:
     std::vector<Vector3> GenerateSamplePoints(const Vector3& lightPos, const Vector3& targetPoint, int sampleCount);
     
     void InitializeComputeShaders();
-    void BuildShadowVolumesGPU(const Light* light, World* world, int lightIndex, float dirFar);
     bool m_useGPUCompute = false;
     std::shared_ptr<class Shader> m_shadowVolumeGenShader;
     std::shared_ptr<class Shader> m_shadowVolumeExtrudeShader;
@@ -112,14 +155,10 @@ private:
     unsigned int m_shadowDirectionsSSBO = 0;
     unsigned int m_outputCountersSSBO = 0;
     
-    template<typename Iterator>
-    void ProcessEntitiesForShadowVertices(Iterator start, Iterator end, const Light* light, World* world, 
-                                        const Vector3& lightPos, const Vector3& lightDir, std::vector<ShadowVertex>& out);
-    
-    bool ShouldRebuildShadowVolumes(const Light* light, World* world) const;
+    // Signatures hash the light's parameters and every occluder's mesh and transform version
+    bool ShouldRebuildShadowVolumes(const Light* light, uint64_t signature) const;
     void MarkShadowVolumesDirty(const Light* light);
-    mutable std::unordered_map<const Light*, uint64_t> m_lightVersions;
-    mutable uint64_t m_worldVersion = 0;
+    std::unordered_map<const Light*, uint64_t> m_lightSignatures;
 
     PhysicsWorld* m_physicsWorld = nullptr;
     bool m_occlusionEnabled = true;
@@ -0,0 +1,49 @@
+#include "ShadowCache.h"
+#include "../Culling/Frustum.h"
+
+namespace GameEngine {
+
+void ShadowCache::BeginFrame(const std::vector<WorldBounds>& changedBounds) {
+    m_changedBounds = &changedBounds;
+    ++m_frame;
+    m_renderedFaces = 0;
+    m_cachedFaces = 0;
+}
+
+bool ShadowCache::NeedsUpdate(const void* key, int face, const Matrix4& lightSpace) {
+    Entry& entry = m_entries[key];
+    entry.lastUsedFrame = m_frame;
+
+    bool dirty = !entry.valid[face] || entry.lightSpace[face].m != lightSpace.m;
+    if (!dirty && m_changedBounds && !m_changedBounds->empty()) {
+        Frustum frustum = Frustum::FromMatrix(lightSpace);
+        for (const WorldBounds& bounds : *m_changedBounds) {
+            if (frustum.IntersectsAABB(bounds.min, bounds.max)) {
+                dirty = true;
+                break;
+            }
+        }
+    }
+
+    if (dirty) {
+        entry.lightSpace[face] = lightSpace;
+        entry.valid[face] = true;
+        ++m_renderedFaces;
+    } else {
+        ++m_cachedFaces;
+    }
+    return dirty;
+}
+
+void ShadowCache::EndFrame() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.lastUsedFrame != m_frame) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_changedBounds = nullptr;
+}
+
+}
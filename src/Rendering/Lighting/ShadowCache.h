@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../Culling/VisibilitySystem.h"
+#include "../../Core/Math/Matrix4.h"
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+
+// Tracks which shadow map faces still hold valid depth. A face is re-rendered only when it
+// has never been drawn, its light-space matrix changed (the light moved or was retargeted),
+// or a caster whose bounds changed this frame overlaps its frustum. Untouched faces keep the
+// depth from the frame they were last drawn in.
+class ShadowCache {
+public:
+    static constexpr int MaxFaces = 6;
+
+    // Starts a frame with the world boxes that changed since the previous one
+    void BeginFrame(const std::vector<WorldBounds>& changedBounds);
+    // True if the face must be redrawn; the face is then considered valid for lightSpace.
+    // key identifies the shadow map (its texture), so a recreated map starts invalid.
+    bool NeedsUpdate(const void* key, int face, const Matrix4& lightSpace);
+    // Drops maps that were not used this frame
+    void EndFrame();
+    void Invalidate() { m_entries.clear(); }
+
+    size_t GetRenderedFaceCount() const { return m_renderedFaces; }
+    size_t GetCachedFaceCount() const { return m_cachedFaces; }
+
+private:
+    struct Entry {
+        Matrix4 lightSpace[MaxFaces];
+        bool valid[MaxFaces] = {};
+        uint64_t lastUsedFrame = 0;
+    };
+
+    std::unordered_map<const void*, Entry> m_entries;
+    const std::vector<WorldBounds>* m_changedBounds = nullptr;
+    uint64_t m_frame = 0;
+    size_t m_renderedFaces = 0;
+    size_t m_cachedFaces = 0;
+};
+
+}
@@ -0,0 +1,347 @@
+#include "CookedMesh.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Platform/MappedFile.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../Meshes/MeshSimplifier.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr char Magic[4] = {'G', 'E', 'M', 'S'};
+constexpr uint64_t ChunkAlignment = 16;
+constexpr uint32_t ChunkTypeLimit = 10;      // One past the last CookedChunkType
+
+uint64_t AlignUp(uint64_t value) {
+    return (value + ChunkAlignment - 1) & ~(ChunkAlignment - 1);
+}
+
+struct PendingChunk {
+    CookedChunkType type;
+    uint32_t stride;
+    uint64_t count;
+    const void* data;
+};
+
+// Welds triangle positions by exact value so colliders see a closed surface
+void BuildCollisionMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& sourceIndices,
+                        std::vector<Vector3>& positions, std::vector<unsigned int>& indices) {
+    struct PositionHash {
+        size_t operator()(const Vector3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+    struct PositionEqual {
+        bool operator()(const Vector3& a, const Vector3& b) const {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+    };
+    std::unordered_map<Vector3, unsigned int, PositionHash, PositionEqual> lookup;
+    lookup.reserve(vertices.size());
+    std::vector<unsigned int> remap(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        auto [it, inserted] = lookup.emplace(vertices[i].position, static_cast<unsigned int>(positions.size()));
+        if (inserted) {
+            positions.push_back(vertices[i].position);
+        }
+        remap[i] = it->second;
+    }
+    indices.reserve(sourceIndices.size());
+    for (unsigned int index : sourceIndices) {
+        indices.push_back(remap[index]);
+    }
+}
+
+}
+
+bool CookedMesh::WriteToFile(const std::string& path, const Mesh& mesh, const CookOptions& options) {
+    const auto& indices = mesh.GetIndices();
+    if (mesh.GetVertices().empty() || indices.empty()) {
+        Logger::Error("CookedMesh: nothing to write for " + path + " (needs indexed vertices)");
+        return false;
+    }
+    for (unsigned int index : indices) {
+        if (index >= mesh.GetVertices().size()) {
+            Logger::Error("CookedMesh: index out of range, not writing " + path);
+            return false;
+        }
+    }
+
+    if (!VertexPacking::IsValid(static_cast<uint32_t>(options.vertexFormat))) {
+        Logger::Error("CookedMesh: unknown vertex format, not writing " + path);
+        return false;
+    }
+    Vector3 boundsMin, boundsMax;
+    mesh.GetBoundingBox(boundsMin, boundsMax);
+    const VertexFormat format = options.vertexFormat;
+    std::vector<uint8_t> packedVertices = VertexPacking::Pack(mesh.GetVertices(), format, boundsMin, boundsMax);
+    // The baked data must match what a load of this file produces
+    std::vector<Vertex> decodedVertices;
+    if (format != VertexFormat::Float) {
+        decodedVertices = VertexPacking::Unpack(packedVertices.data(), mesh.GetVertices().size(), format, boundsMin, boundsMax);
+    }
+    const std::vector<Vertex>& vertices = format == VertexFormat::Float ? mesh.GetVertices() : decodedVertices;
+
+    std::vector<PendingChunk> chunks;
+    chunks.push_back({CookedChunkType::Vertices, static_cast<uint32_t>(VertexPacking::GetStride(format)), vertices.size(),
+                      packedVertices.data()});
+    chunks.push_back({CookedChunkType::Indices, sizeof(unsigned int), indices.size(), indices.data()});
+
+    TriangleBVH bvh;
+    if (options.bakeBVH) {
+        // Same triangles, in the same order, as RaytracingScene builds from the index buffer
+        std::vector<Triangle> triangles;
+        triangles.reserve(indices.size() / 3);
+        const Vector3 white(1.0f, 1.0f, 1.0f);
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            triangles.emplace_back(vertices[indices[i]].position, vertices[indices[i + 1]].position,
+                                   vertices[indices[i + 2]].position, white);
+        }
+        bvh.Build(triangles);
+        chunks.push_back({CookedChunkType::BVHNodes, sizeof(BVHNode), bvh.GetNodes().size(), bvh.GetNodes().data()});
+        chunks.push_back({CookedChunkType::BVHTriangleIndices, sizeof(int), bvh.GetTriangleIndices().size(),
+                          bvh.GetTriangleIndices().data()});
+    }
+
+    std::vector<Vector3> collisionPositions;
+    std::vector<unsigned int> collisionIndices;
+    if (options.bakeCollision) {
+        BuildCollisionMesh(vertices, indices, collisionPositions, collisionIndices);
+        chunks.push_back({CookedChunkType::CollisionPositions, sizeof(Vector3), collisionPositions.size(), collisionPositions.data()});
+        chunks.push_back({CookedChunkType::CollisionIndices, sizeof(unsigned int), collisionIndices.size(), collisionIndices.data()});
+    }
+
+    std::vector<CookedMeshLOD> lodTable;
+    std::vector<uint8_t> lodVertices;
+    std::vector<unsigned int> lodIndices;
+    if (options.lodLevels > 0) {
+        MeshSimplifier::LODSettings settings;
+        settings.maxLevels = options.lodLevels;
+        for (const auto& level : MeshSimplifier::BuildLODChain(vertices, indices, settings)) {
+            CookedMeshLOD entry{};
+            entry.vertexOffset = static_cast<uint32_t>(lodVertices.size() / VertexPacking::GetStride(format));
+            entry.vertexCount = static_cast<uint32_t>(level.vertices.size());
+            entry.indexOffset = static_cast<uint32_t>(lodIndices.size());
+            entry.indexCount = static_cast<uint32_t>(level.indices.size());
+            entry.screenSize = level.screenSize;
+            entry.error = level.error;
+            lodTable.push_back(entry);
+            std::vector<uint8_t> packed = VertexPacking::Pack(level.vertices, format, boundsMin, boundsMax);
+            lodVertices.insert(lodVertices.end(), packed.begin(), packed.end());
+            lodIndices.insert(lodIndices.end(), level.indices.begin(), level.indices.end());
+        }
+    }
+    if (!lodTable.empty()) {
+        chunks.push_back({CookedChunkType::LODTable, sizeof(CookedMeshLOD), lodTable.size(), lodTable.data()});
+        chunks.push_back({CookedChunkType::LODVertices, static_cast<uint32_t>(VertexPacking::GetStride(format)),
+                          lodVertices.size() / VertexPacking::GetStride(format), lodVertices.data()});
+        chunks.push_back({CookedChunkType::LODIndices, sizeof(unsigned int), lodIndices.size(), lodIndices.data()});
+    }
+
+    CookedMeshHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.chunkCount = static_cast<uint32_t>(chunks.size());
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    header.boundsMin[0] = boundsMin.x; header.boundsMin[1] = boundsMin.y; header.boundsMin[2] = boundsMin.z;
+    header.boundsMax[0] = boundsMax.x; header.boundsMax[1] = boundsMax.y; header.boundsMax[2] = boundsMax.z;
+    header.vertexFormat = static_cast<uint32_t>(format);
+
+    std::vector<CookedMeshChunk> table(chunks.size());
+    uint64_t offset = AlignUp(sizeof(CookedMeshHeader) + sizeof(CookedMeshChunk) * chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        table[i].type = static_cast<uint32_t>(chunks[i].type);
+        table[i].stride = chunks[i].stride;
+        table[i].offset = offset;
+        table[i].count = chunks[i].count;
+        offset = AlignUp(offset + chunks[i].count * chunks[i].stride);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::Error("CookedMesh: cannot create " + path);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(CookedMeshChunk) * table.size()));
+    const char padding[ChunkAlignment] = {};
+    uint64_t written = sizeof(header) + sizeof(CookedMeshChunk) * table.size();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        file.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+        uint64_t size = chunks[i].count * chunks[i].stride;
+        file.write(static_cast<const char*>(chunks[i].data), static_cast<std::streamsize>(size));
+        written = table[i].offset + size;
+    }
+    if (!file.good()) {
+        Logger::Error("CookedMesh: write failed for " + path);
+        return false;
+    }
+    Logger::Info("Cooked mesh " + path + ": " + std::to_string(vertices.size()) + " vertices, " +
+                 std::to_string(indices.size()) + " indices, " + std::to_string(chunks.size()) + " chunks, " +
+                 std::to_string(written) + " bytes");
+    return true;
+}
+
+Mesh CookedMesh::LoadFromFile(const std::string& path) {
+    PROFILE_SCOPE("CookedMesh::LoadFromFile");
+    MappedFile file;
+    if (!file.Open(path)) {
+        return Mesh();
+    }
+    const char* data = file.GetData();
+    const uint64_t size = file.GetSize();
+
+    CookedMeshHeader header;
+    if (size < sizeof(header)) {
+        Logger::Error("CookedMesh: " + path + " is truncated");
+        return Mesh();
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        Logger::Error("CookedMesh: " + path + " is not a version " + std::to_string(Version) + " cooked mesh");
+        return Mesh();
+    }
+    if (sizeof(header) + uint64_t(header.chunkCount) * sizeof(CookedMeshChunk) > size) {
+        Logger::Error("CookedMesh: " + path + " has a truncated chunk table");
+        return Mesh();
+    }
+    if (!VertexPacking::IsValid(header.vertexFormat)) {
+        Logger::Error("CookedMesh: " + path + " has an unknown vertex format " + std::to_string(header.vertexFormat));
+        return Mesh();
+    }
+    const auto format = static_cast<VertexFormat>(header.vertexFormat);
+
+    // Locate each stream; strides are checked so a format change cannot be misread
+    const void* streams[ChunkTypeLimit] = {};
+    uint64_t counts[ChunkTypeLimit] = {};
+    const uint32_t vertexStride = static_cast<uint32_t>(VertexPacking::GetStride(format));
+    const uint32_t strides[ChunkTypeLimit] = {0, vertexStride, sizeof(unsigned int), sizeof(BVHNode), sizeof(int), sizeof(Vector3),
+                                              sizeof(unsigned int), sizeof(CookedMeshLOD), vertexStride, sizeof(unsigned int)};
+    for (uint32_t i = 0; i < header.chunkCount; ++i) {
+        CookedMeshChunk chunk;
+        std::memcpy(&chunk, data + sizeof(header) + i * sizeof(CookedMeshChunk), sizeof(chunk));
+        if (chunk.type == 0 || chunk.type >= ChunkTypeLimit) {
+            continue;       // Unknown chunks from newer cookers are skipped
+        }
+        if (chunk.stride != strides[chunk.type] || chunk.offset > size || chunk.count > (size - chunk.offset) / chunk.stride) {
+            Logger::Error("CookedMesh: " + path + " has an invalid chunk " + std::to_string(chunk.type));
+            return Mesh();
+        }
+        streams[chunk.type] = data + chunk.offset;
+        counts[chunk.type] = chunk.count;
+    }
+
+    const auto vertexType = static_cast<uint32_t>(CookedChunkType::Vertices);
+    const auto indexType = static_cast<uint32_t>(CookedChunkType::Indices);
+    if (!streams[vertexType] || !streams[indexType] || counts[vertexType] != header.vertexCount ||
+        counts[indexType] != header.indexCount) {
+        Logger::Error("CookedMesh: " + path + " is missing its vertex or index stream");
+        return Mesh();
+    }
+
+    Vector3 boundsMin(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    Vector3 boundsMax(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    std::vector<uint8_t> vertices(uint64_t(header.vertexCount) * vertexStride);
+    if (!vertices.empty()) {
+        std::memcpy(vertices.data(), streams[vertexType], vertices.size());
+    }
+    std::vector<unsigned int> indices(header.indexCount);
+    std::memcpy(indices.data(), streams[indexType], indices.size() * sizeof(unsigned int));
+    if (!indices.empty() && *std::max_element(indices.begin(), indices.end()) >= header.vertexCount) {
+        Logger::Error("CookedMesh: " + path + " has out-of-range indices");
+        return Mesh();
+    }
+
+    Mesh mesh;
+    mesh.SetPackedVertices(std::move(vertices), format, boundsMin, boundsMax);
+    mesh.SetIndices(std::move(indices));
+
+    auto copyStream = [&](CookedChunkType type, auto& out) {
+        using Element = typename std::decay_t<decltype(out)>::value_type;
+        const auto index = static_cast<uint32_t>(type);
+        out.resize(counts[index]);
+        if (!out.empty()) {
+            std::memcpy(out.data(), streams[index], out.size() * sizeof(Element));
+        }
+    };
+    if (streams[static_cast<uint32_t>(CookedChunkType::BVHNodes)]) {
+        std::vector<BVHNode> nodes;
+        std::vector<int> triangleIndices;
+        copyStream(CookedChunkType::BVHNodes, nodes);
+        copyStream(CookedChunkType::BVHTriangleIndices, triangleIndices);
+        mesh.SetBakedBVH(std::move(nodes), std::move(triangleIndices));
+    }
+    if (streams[static_cast<uint32_t>(CookedChunkType::CollisionPositions)]) {
+        std::vector<Vector3> positions;
+        std::vector<unsigned int> collisionIndices;
+        copyStream(CookedChunkType::CollisionPositions, positions);
+        copyStream(CookedChunkType::CollisionIndices, collisionIndices);
+        bool valid = std::all_of(collisionIndices.begin(), collisionIndices.end(),
+                                 [&](unsigned int index) { return index < positions.size(); });
+        if (valid) {
+            mesh.SetCollisionMesh(std::move(positions), std::move(collisionIndices));
+        }
+    }
+
+    const auto lodTableType = static_cast<uint32_t>(CookedChunkType::LODTable);
+    const auto lodVertexType = static_cast<uint32_t>(CookedChunkType::LODVertices);
+    const auto lodIndexType = static_cast<uint32_t>(CookedChunkType::LODIndices);
+    if (streams[lodTableType] && streams[lodVertexType] && streams[lodIndexType]) {
+        std::vector<CookedMeshLOD> table;
+        copyStream(CookedChunkType::LODTable, table);
+        std::vector<MeshLOD> lods;
+        for (const CookedMeshLOD& entry : table) {
+            if (uint64_t(entry.vertexOffset) + entry.vertexCount > counts[lodVertexType] ||
+                uint64_t(entry.indexOffset) + entry.indexCount > counts[lodIndexType]) {
+                Logger::Warning("CookedMesh: " + path + " has an invalid LOD table, LODs ignored");
+                lods.clear();
+                break;
+            }
+            const auto* first = static_cast<const char*>(streams[lodVertexType]) + uint64_t(entry.vertexOffset) * vertexStride;
+            std::vector<uint8_t> lodVertices(first, first + uint64_t(entry.vertexCount) * vertexStride);
+            std::vector<unsigned int> lodIndices(entry.indexCount);
+            if (!lodIndices.empty()) {
+                std::memcpy(lodIndices.data(), static_cast<const unsigned int*>(streams[lodIndexType]) + entry.indexOffset,
+                            lodIndices.size() * sizeof(unsigned int));
+            }
+            if (std::any_of(lodIndices.begin(), lodIndices.end(), [&](unsigned int index) { return index >= entry.vertexCount; })) {
+                Logger::Warning("CookedMesh: " + path + " has out-of-range LOD indices, LODs ignored");
+                lods.clear();
+                break;
+            }
+            auto lodMesh = std::make_shared<Mesh>();
+            lodMesh->SetPackedVertices(std::move(lodVertices), format, boundsMin, boundsMax);
+            lodMesh->SetIndices(std::move(lodIndices));
+            lods.push_back({lodMesh, entry.screenSize, entry.error});
+        }
+        mesh.SetLODs(std::move(lods));
+    }
+
+    Logger::Debug("Loaded cooked mesh " + path + ": " + std::to_string(header.vertexCount) + " vertices, " +
+                  std::to_string(header.indexCount) + " indices, " + std::to_string(mesh.GetLODs().size()) + " LODs");
+    return mesh;
+}
+
+std::string CookedMesh::GetCookedPath(const std::string& sourcePath) {
+    return sourcePath + Extension;
+}
+
+bool CookedMesh::IsUpToDate(const std::string& sourcePath) {
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(GetCookedPath(sourcePath), error);
+    if (error) {
+        return false;
+    }
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    return error || cookedTime >= sourceTime;
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Meshes/Mesh.h"
+#include <string>
+#include <cstdint>
+
+namespace GameEngine {
+    // Binary container written by the mesh cooker (tools/mesh_cooker). Layout, little-endian:
+    //   CookedMeshHeader
+    //   CookedMeshChunk[chunkCount]
+    //   chunk payloads, each starting on a 16-byte boundary
+    // Loading maps the file and copies each stream out with a single memcpy; nothing is parsed.
+    struct CookedMeshHeader {
+        char magic[4];                  // "GEMS"
+        uint32_t version;
+        uint32_t chunkCount;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        float boundsMin[3];
+        float boundsMax[3];
+        uint32_t vertexFormat;          // VertexFormat of the vertex stream
+    };
+    static_assert(sizeof(CookedMeshHeader) == 48, "CookedMeshHeader is part of the file format");
+
+    enum class CookedChunkType : uint32_t {
+        Vertices = 1,                   // vertexCount vertices in the header's VertexFormat
+        Indices = 2,                    // uint32[indexCount]
+        BVHNodes = 3,                   // BVHNode[], binary BVH over the index buffer's triangles
+        BVHTriangleIndices = 4,         // int32[], leaf ranges of BVHNodes
+        CollisionPositions = 5,         // Vector3[], positions welded for colliders
+        CollisionIndices = 6,           // uint32[], triangles over CollisionPositions
+        LODTable = 7,                   // CookedMeshLOD[], finest level first
+        LODVertices = 8,                // Every level's vertices, in the header's VertexFormat
+        LODIndices = 9                  // Every level's indices, relative to its first vertex
+    };
+
+    struct CookedMeshChunk {
+        uint32_t type;                  // CookedChunkType
+        uint32_t stride;                // Bytes per element
+        uint64_t offset;                // From the start of the file
+        uint64_t count;                 // Elements
+    };
+    static_assert(sizeof(CookedMeshChunk) == 24, "CookedMeshChunk is part of the file format");
+
+    // One simplified level; vertices are quantized against the full mesh's bounds
+    struct CookedMeshLOD {
+        uint32_t vertexOffset;          // Into LODVertices
+        uint32_t vertexCount;
+        uint32_t indexOffset;           // Into LODIndices
+        uint32_t indexCount;
+        float screenSize;               // MeshLOD::screenSize
+        float error;                    // MeshLOD::error
+        uint32_t reserved[2];
+    };
+    static_assert(sizeof(CookedMeshLOD) == 32, "CookedMeshLOD is part of the file format");
+
+    class CookedMesh {
+    public:
+        static constexpr uint32_t Version = 1;
+        static constexpr const char* Extension = ".gmesh";
+
+        struct CookOptions {
+            bool bakeBVH = true;
+            bool bakeCollision = true;
+            // Quantized formats are decoded on load and the baked data is built from the
+            // decoded positions, so raytracing, collision and rendering see the same surface
+            VertexFormat vertexFormat = VertexFormat::Packed;
+            // Simplified levels generated with MeshSimplifier; 0 disables
+            int lodLevels = 3;
+        };
+
+        // Writes the mesh's vertices, indices and bounds, plus the optional baked data
+        static bool WriteToFile(const std::string& path, const Mesh& mesh, const CookOptions& options);
+        // Returns an empty Mesh if the file is missing, truncated or from another version
+        static Mesh LoadFromFile(const std::string& path);
+
+        // The cooked file that belongs next to a source asset, e.g. "rock.obj" -> "rock.obj.gmesh"
+        static std::string GetCookedPath(const std::string& sourcePath);
+        // True if the cooked file exists and is at least as new as the source
+        static bool IsUpToDate(const std::string& sourcePath);
+    };
+}
@@ -0,0 +1,181 @@
+#include "CookedTexture.h"
+#include "../Core/TextureCompressor.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Platform/MappedFile.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr char Magic[4] = {'G', 'E', 'T', 'X'};
+constexpr uint64_t LevelAlignment = 16;
+
+uint64_t AlignUp(uint64_t value) {
+    return (value + LevelAlignment - 1) & ~(LevelAlignment - 1);
+}
+
+bool IsValidCompression(uint32_t compression) {
+    return compression <= static_cast<uint32_t>(TextureCompression::BC7);
+}
+
+// Bytes a level of the given size must hold
+uint64_t GetLevelSize(int width, int height, TextureCompression compression) {
+    if (compression == TextureCompression::None) {
+        return uint64_t(width) * uint64_t(height) * 4;
+    }
+    return TextureCompressor::GetCompressedSize(width, height, compression);
+}
+
+}
+
+bool CookedTexture::BuildMipChain(const TextureData& image, const CookOptions& options, TextureMipChain& chain) {
+    PROFILE_SCOPE("CookedTexture::BuildMipChain");
+    chain = TextureMipChain();
+    std::vector<TextureData> levels = MipGenerator::Generate(image, options.mips);
+    if (levels.empty()) {
+        return false;
+    }
+
+    chain.compression = options.compression;
+    chain.sRGB = options.mips.sRGB;
+    chain.width = image.width;
+    chain.height = image.height;
+    chain.levels.resize(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (options.compression == TextureCompression::None) {
+            chain.levels[i] = std::move(levels[i].pixels);
+        } else {
+            chain.levels[i] = TextureCompressor::Compress(levels[i], options.compression);
+        }
+    }
+    return true;
+}
+
+bool CookedTexture::WriteToFile(const std::string& path, const TextureMipChain& chain) {
+    if (chain.levels.empty() || chain.width <= 0 || chain.height <= 0) {
+        Logger::Error("CookedTexture: nothing to write for " + path);
+        return false;
+    }
+
+    CookedTextureHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.width = static_cast<uint32_t>(chain.width);
+    header.height = static_cast<uint32_t>(chain.height);
+    header.levelCount = static_cast<uint32_t>(chain.levels.size());
+    header.compression = static_cast<uint32_t>(chain.compression);
+    header.flags = chain.sRGB ? FlagSRGB : 0;
+
+    std::vector<CookedTextureLevel> table(chain.levels.size());
+    uint64_t offset = AlignUp(sizeof(CookedTextureHeader) + sizeof(CookedTextureLevel) * table.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i].width = static_cast<uint32_t>(std::max(1, chain.width >> i));
+        table[i].height = static_cast<uint32_t>(std::max(1, chain.height >> i));
+        table[i].offset = offset;
+        table[i].size = chain.levels[i].size();
+        if (table[i].size != GetLevelSize(table[i].width, table[i].height, chain.compression)) {
+            Logger::Error("CookedTexture: level " + std::to_string(i) + " has the wrong size, not writing " + path);
+            return false;
+        }
+        offset = AlignUp(offset + table[i].size);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::Error("CookedTexture: cannot create " + path);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(CookedTextureLevel) * table.size()));
+    const char padding[LevelAlignment] = {};
+    uint64_t written = sizeof(header) + sizeof(CookedTextureLevel) * table.size();
+    for (size_t i = 0; i < table.size(); ++i) {
+        file.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+        file.write(reinterpret_cast<const char*>(chain.levels[i].data()), static_cast<std::streamsize>(table[i].size));
+        written = table[i].offset + table[i].size;
+    }
+    if (!file.good()) {
+        Logger::Error("CookedTexture: write failed for " + path);
+        return false;
+    }
+    Logger::Info("Cooked texture " + path + ": " + std::to_string(chain.width) + "x" + std::to_string(chain.height) + ", " +
+                 std::to_string(table.size()) + " levels, " + std::to_string(written) + " bytes");
+    return true;
+}
+
+bool CookedTexture::LoadFromFile(const std::string& path, TextureMipChain& chain) {
+    PROFILE_SCOPE("CookedTexture::LoadFromFile");
+    chain = TextureMipChain();
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    const char* data = file.GetData();
+    const uint64_t size = file.GetSize();
+
+    CookedTextureHeader header;
+    if (size < sizeof(header)) {
+        Logger::Error("CookedTexture: " + path + " is truncated");
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        Logger::Error("CookedTexture: " + path + " is not a version " + std::to_string(Version) + " cooked texture");
+        return false;
+    }
+    if (header.width == 0 || header.height == 0 || header.width > 65536 || header.height > 65536 ||
+        !IsValidCompression(header.compression) || header.levelCount == 0 ||
+        header.levelCount > static_cast<uint32_t>(MipGenerator::GetLevelCount(header.width, header.height))) {
+        Logger::Error("CookedTexture: " + path + " has an invalid header");
+        return false;
+    }
+    if (sizeof(header) + uint64_t(header.levelCount) * sizeof(CookedTextureLevel) > size) {
+        Logger::Error("CookedTexture: " + path + " has a truncated level table");
+        return false;
+    }
+
+    const auto compression = static_cast<TextureCompression>(header.compression);
+    chain.compression = compression;
+    chain.sRGB = (header.flags & FlagSRGB) != 0;
+    chain.width = static_cast<int>(header.width);
+    chain.height = static_cast<int>(header.height);
+    chain.levels.resize(header.levelCount);
+    for (uint32_t i = 0; i < header.levelCount; ++i) {
+        CookedTextureLevel level;
+        std::memcpy(&level, data + sizeof(header) + i * sizeof(CookedTextureLevel), sizeof(level));
+        const int width = std::max(1, chain.width >> i);
+        const int height = std::max(1, chain.height >> i);
+        if (level.width != uint32_t(width) || level.height != uint32_t(height) ||
+            level.size != GetLevelSize(width, height, compression) || level.offset > size || level.size > size - level.offset) {
+            Logger::Error("CookedTexture: " + path + " has an invalid level " + std::to_string(i));
+            chain = TextureMipChain();
+            return false;
+        }
+        chain.levels[i].assign(data + level.offset, data + level.offset + level.size);
+    }
+
+    Logger::Debug("Loaded cooked texture " + path + ": " + std::to_string(chain.width) + "x" + std::to_string(chain.height) +
+                  ", " + std::to_string(header.levelCount) + " levels");
+    return true;
+}
+
+std::string CookedTexture::GetCookedPath(const std::string& sourcePath) {
+    return sourcePath + Extension;
+}
+
+bool CookedTexture::IsUpToDate(const std::string& sourcePath) {
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(GetCookedPath(sourcePath), error);
+    if (error) {
+        return false;
+    }
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    return error || cookedTime >= sourceTime;
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../Core/Texture.h"
+#include "../Core/MipGenerator.h"
+#include <string>
+#include <cstdint>
+
+namespace GameEngine {
+    // Binary container written by the texture cooker (tools/texture_cooker). Layout, little-endian:
+    //   CookedTextureHeader
+    //   CookedTextureLevel[levelCount], finest first
+    //   level payloads, each starting on a 16-byte boundary
+    // Payloads are what glTexImage2D / glCompressedTexImage2D take for that level, so loading
+    // is a validated copy out of the mapped file.
+    struct CookedTextureHeader {
+        char magic[4];                  // "GETX"
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t levelCount;
+        uint32_t compression;           // TextureCompression; None stores RGBA8
+        uint32_t flags;                 // CookedTexture::FlagSRGB
+        uint32_t reserved;
+    };
+    static_assert(sizeof(CookedTextureHeader) == 32, "CookedTextureHeader is part of the file format");
+
+    struct CookedTextureLevel {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;                // From the start of the file
+        uint64_t size;                  // Bytes
+    };
+    static_assert(sizeof(CookedTextureLevel) == 24, "CookedTextureLevel is part of the file format");
+
+    class CookedTexture {
+    public:
+        static constexpr uint32_t Version = 1;
+        static constexpr uint32_t FlagSRGB = 1;     // Mips were filtered as sRGB color
+        static constexpr const char* Extension = ".gtex";
+
+        struct CookOptions {
+            TextureCompression compression = TextureCompression::BC7;
+            MipSettings mips;           // maxLevels = 1 stores the source level only
+        };
+
+        // Filters the mip chain and block-compresses every level; image must be RGBA8
+        static bool BuildMipChain(const TextureData& image, const CookOptions& options, TextureMipChain& chain);
+
+        static bool WriteToFile(const std::string& path, const TextureMipChain& chain);
+        // Fails if the file is missing, truncated, from another version or has inconsistent levels
+        static bool LoadFromFile(const std::string& path, TextureMipChain& chain);
+
+        // The cooked file that belongs next to a source image, e.g. "wall.png" -> "wall.png.gtex"
+        static std::string GetCookedPath(const std::string& sourcePath);
+        // True if the cooked file exists and is at least as new as the source
+        static bool IsUpToDate(const std::string& sourcePath);
+    };
+}
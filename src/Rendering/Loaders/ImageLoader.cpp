@@ -0,0 +1,863 @@
+#include "ImageLoader.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Platform/MappedFile.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+
+namespace GameEngine {
+
+namespace {
+
+// ---- Inflate ----------------------------------------------------------------------------
+
+// LSB-first bit stream over the deflate data with a 64-bit refill buffer
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    void Refill() {
+        while (m_bitCount <= 56) {
+            uint64_t byte = m_position < m_size ? m_data[m_position] : 0;
+            ++m_position;
+            m_bits |= byte << m_bitCount;
+            m_bitCount += 8;
+        }
+    }
+    uint32_t Peek(int count) {
+        if (m_bitCount < count) {
+            Refill();
+        }
+        return static_cast<uint32_t>(m_bits & ((uint64_t(1) << count) - 1));
+    }
+    void Consume(int count) {
+        m_bits >>= count;
+        m_bitCount -= count;
+    }
+    uint32_t Read(int count) {
+        if (count == 0) {
+            return 0;
+        }
+        uint32_t value = Peek(count);
+        Consume(count);
+        return value;
+    }
+    void AlignToByte() {
+        Consume(m_bitCount & 7);
+    }
+    // Bytes handed out so far, counting the ones still in the bit buffer as unread
+    size_t GetBytePosition() const { return m_position - static_cast<size_t>(m_bitCount / 8); }
+    bool IsOverrun() const { return GetBytePosition() > m_size; }
+
+    // Stored blocks copy whole bytes; the buffer is empty after AlignToByte and a rewind
+    void Rewind() {
+        m_position = GetBytePosition();
+        m_bits = 0;
+        m_bitCount = 0;
+    }
+    const uint8_t* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    void Skip(size_t bytes) { m_position += bytes; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position = 0;
+    uint64_t m_bits = 0;
+    int m_bitCount = 0;
+};
+
+// Canonical Huffman decoder: codes up to FastBits long resolve with one table lookup, longer
+// ones walk the per-length counts
+class Huffman {
+public:
+    static constexpr int FastBits = 10;
+    static constexpr int MaxBits = 15;
+
+    bool Build(const uint8_t* lengths, int count) {
+        std::memset(m_counts, 0, sizeof(m_counts));
+        std::memset(m_fast, 0, sizeof(m_fast));
+        for (int i = 0; i < count; ++i) {
+            ++m_counts[lengths[i]];
+        }
+        m_counts[0] = 0;
+
+        int left = 1;
+        for (int length = 1; length <= MaxBits; ++length) {
+            left = (left << 1) - m_counts[length];
+            if (left < 0) {
+                return false;           // Over-subscribed
+            }
+        }
+
+        int offsets[MaxBits + 2] = {};
+        for (int length = 1; length <= MaxBits; ++length) {
+            offsets[length + 1] = offsets[length] + m_counts[length];
+        }
+        for (int i = 0; i < count; ++i) {
+            if (lengths[i] != 0) {
+                m_symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+            }
+        }
+
+        // Deflate packs codes MSB first into an LSB-first stream, so table indices are reversed
+        int code = 0;
+        int index = 0;
+        for (int length = 1; length <= FastBits; ++length) {
+            for (int i = 0; i < m_counts[length]; ++i, ++index, ++code) {
+                int reversed = 0;
+                for (int bit = 0; bit < length; ++bit) {
+                    reversed |= ((code >> bit) & 1) << (length - 1 - bit);
+                }
+                uint16_t entry = static_cast<uint16_t>((m_symbols[index] << 4) | length);
+                for (int slot = reversed; slot < (1 << FastBits); slot += 1 << length) {
+                    m_fast[slot] = entry;
+                }
+            }
+            code <<= 1;
+        }
+        return true;
+    }
+
+    int Decode(BitReader& reader) const {
+        uint32_t bits = reader.Peek(MaxBits);
+        uint16_t entry = m_fast[bits & ((1u << FastBits) - 1)];
+        if (entry != 0) {
+            reader.Consume(entry & 15);
+            return entry >> 4;
+        }
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int length = 1; length <= MaxBits; ++length) {
+            code |= (bits >> (length - 1)) & 1;
+            int count = m_counts[length];
+            if (code - first < count) {
+                reader.Consume(length);
+                return m_symbols[index + code - first];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+private:
+    uint16_t m_fast[1 << FastBits];
+    uint16_t m_counts[MaxBits + 1];
+    uint16_t m_symbols[288];
+};
+
+constexpr uint16_t LengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                     35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t DistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+                                       513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t DistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Fails rather than growing out past maxSize. Past the end of the input the reader yields zero
+// bits, which a dynamic table can map to a literal, so the overrun check must run per symbol.
+bool InflateBlock(BitReader& reader, const Huffman& literals, const Huffman& distances, std::vector<uint8_t>& out,
+                  size_t maxSize) {
+    while (true) {
+        int symbol = literals.Decode(reader);
+        if (symbol < 0 || reader.IsOverrun()) {
+            return false;
+        }
+        if (symbol < 256) {
+            if (out.size() >= maxSize) {
+                return false;
+            }
+            out.push_back(static_cast<uint8_t>(symbol));
+            continue;
+        }
+        if (symbol == 256) {
+            return !reader.IsOverrun();
+        }
+        symbol -= 257;
+        if (symbol >= 29) {
+            return false;
+        }
+        size_t length = LengthBase[symbol] + reader.Read(LengthExtra[symbol]);
+        int distanceSymbol = distances.Decode(reader);
+        if (distanceSymbol < 0 || distanceSymbol >= 30) {
+            return false;
+        }
+        size_t distance = DistanceBase[distanceSymbol] + reader.Read(DistanceExtra[distanceSymbol]);
+        if (distance > out.size() || length > maxSize - out.size() || reader.IsOverrun()) {
+            return false;
+        }
+        // Overlapping copies repeat the tail, so copy byte by byte
+        size_t from = out.size() - distance;
+        for (size_t i = 0; i < length; ++i) {
+            out.push_back(out[from + i]);
+        }
+    }
+}
+
+bool InflateDynamicTables(BitReader& reader, Huffman& literals, Huffman& distances) {
+    static constexpr uint8_t CodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    int literalCount = static_cast<int>(reader.Read(5)) + 257;
+    int distanceCount = static_cast<int>(reader.Read(5)) + 1;
+    int codeLengthCount = static_cast<int>(reader.Read(4)) + 4;
+    if (literalCount > 286 || distanceCount > 30) {
+        return false;
+    }
+
+    uint8_t codeLengths[19] = {};
+    for (int i = 0; i < codeLengthCount; ++i) {
+        codeLengths[CodeLengthOrder[i]] = static_cast<uint8_t>(reader.Read(3));
+    }
+    Huffman codeLengthCode;
+    if (!codeLengthCode.Build(codeLengths, 19)) {
+        return false;
+    }
+
+    uint8_t lengths[286 + 30] = {};
+    int count = 0;
+    while (count < literalCount + distanceCount) {
+        int symbol = codeLengthCode.Decode(reader);
+        if (symbol < 0) {
+            return false;
+        }
+        if (symbol < 16) {
+            lengths[count++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+        uint8_t value = 0;
+        int repeat = 0;
+        if (symbol == 16) {
+            if (count == 0) {
+                return false;
+            }
+            value = lengths[count - 1];
+            repeat = 3 + static_cast<int>(reader.Read(2));
+        } else if (symbol == 17) {
+            repeat = 3 + static_cast<int>(reader.Read(3));
+        } else {
+            repeat = 11 + static_cast<int>(reader.Read(7));
+        }
+        if (count + repeat > literalCount + distanceCount) {
+            return false;
+        }
+        std::memset(lengths + count, value, static_cast<size_t>(repeat));
+        count += repeat;
+    }
+    if (lengths[256] == 0) {
+        return false;                   // No end-of-block code
+    }
+    return literals.Build(lengths, literalCount) && distances.Build(lengths + literalCount, distanceCount) &&
+           !reader.IsOverrun();
+}
+
+// ---- PNG --------------------------------------------------------------------------------
+
+uint32_t ReadBigEndian32(const uint8_t* bytes) {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+uint16_t ReadLittleEndian16(const uint8_t* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t ReadLittleEndian32(const uint8_t* bytes) {
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+uint8_t Paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return static_cast<uint8_t>(a);
+    }
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+// Reverses the per-row filters in place; rows are [filter byte][stride bytes]
+bool Unfilter(uint8_t* data, size_t rowCount, size_t stride, size_t bytesPerPixel) {
+    const uint8_t* previous = nullptr;
+    for (size_t y = 0; y < rowCount; ++y) {
+        uint8_t* row = data + y * (stride + 1);
+        uint8_t filter = row[0];
+        uint8_t* pixels = row + 1;
+        switch (filter) {
+            case 0:
+                break;
+            case 1:
+                for (size_t i = bytesPerPixel; i < stride; ++i) {
+                    pixels[i] = static_cast<uint8_t>(pixels[i] + pixels[i - bytesPerPixel]);
+                }
+                break;
+            case 2:
+                if (previous) {
+                    for (size_t i = 0; i < stride; ++i) {
+                        pixels[i] = static_cast<uint8_t>(pixels[i] + previous[i]);
+                    }
+                }
+                break;
+            case 3:
+                for (size_t i = 0; i < stride; ++i) {
+                    int left = i >= bytesPerPixel ? pixels[i - bytesPerPixel] : 0;
+                    int up = previous ? previous[i] : 0;
+                    pixels[i] = static_cast<uint8_t>(pixels[i] + ((left + up) >> 1));
+                }
+                break;
+            case 4:
+                for (size_t i = 0; i < stride; ++i) {
+                    int left = i >= bytesPerPixel ? pixels[i - bytesPerPixel] : 0;
+                    int up = previous ? previous[i] : 0;
+                    int upLeft = previous && i >= bytesPerPixel ? previous[i - bytesPerPixel] : 0;
+                    pixels[i] = static_cast<uint8_t>(pixels[i] + Paeth(left, up, upLeft));
+                }
+                break;
+            default:
+                return false;
+        }
+        previous = pixels;
+    }
+    return true;
+}
+
+struct PNGInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int bitDepth = 0;
+    int colorType = 0;
+    int channels = 0;
+    bool interlaced = false;
+    uint8_t palette[256][4] = {};
+    int paletteSize = 0;
+    bool hasColorKey = false;
+    uint16_t colorKey[3] = {};
+};
+
+// Sample x of a row at the image's bit depth, as a raw value
+uint16_t ReadSample(const uint8_t* row, size_t index, int bitDepth) {
+    switch (bitDepth) {
+        case 16: return static_cast<uint16_t>((row[index * 2] << 8) | row[index * 2 + 1]);
+        case 8: return row[index];
+        default: {
+            size_t bit = index * static_cast<size_t>(bitDepth);
+            int shift = 8 - bitDepth - static_cast<int>(bit & 7);
+            return static_cast<uint16_t>((row[bit >> 3] >> shift) & ((1 << bitDepth) - 1));
+        }
+    }
+}
+
+// Expands one unfiltered row into RGBA8 pixels at x = startX + i * stepX of output row y
+void ExpandRow(const PNGInfo& info, const uint8_t* row, uint32_t pixelCount, TextureData& image,
+               uint32_t y, uint32_t startX, uint32_t stepX) {
+    const int maxValue = (1 << info.bitDepth) - 1;
+    // Stored bottom row first
+    uint8_t* out = image.pixels.data() + (size_t(image.height - 1 - y) * image.width) * 4;
+    auto toByte = [&](uint16_t value) -> uint8_t {
+        if (info.bitDepth == 16) {
+            return static_cast<uint8_t>(value >> 8);
+        }
+        return static_cast<uint8_t>((value * 255 + maxValue / 2) / maxValue);
+    };
+
+    for (uint32_t i = 0; i < pixelCount; ++i) {
+        uint8_t* pixel = out + size_t(startX + i * stepX) * 4;
+        const size_t sample = size_t(i) * info.channels;
+        switch (info.colorType) {
+            case 0: {
+                uint16_t gray = ReadSample(row, sample, info.bitDepth);
+                pixel[0] = pixel[1] = pixel[2] = toByte(gray);
+                pixel[3] = info.hasColorKey && gray == info.colorKey[0] ? 0 : 255;
+                break;
+            }
+            case 2: {
+                uint16_t r = ReadSample(row, sample, info.bitDepth);
+                uint16_t g = ReadSample(row, sample + 1, info.bitDepth);
+                uint16_t b = ReadSample(row, sample + 2, info.bitDepth);
+                pixel[0] = toByte(r);
+                pixel[1] = toByte(g);
+                pixel[2] = toByte(b);
+                pixel[3] = info.hasColorKey && r == info.colorKey[0] && g == info.colorKey[1] && b == info.colorKey[2] ? 0 : 255;
+                break;
+            }
+            case 3: {
+                uint16_t index = ReadSample(row, sample, info.bitDepth);
+                std::memcpy(pixel, info.palette[index], 4);
+                break;
+            }
+            case 4:
+                pixel[0] = pixel[1] = pixel[2] = toByte(ReadSample(row, sample, info.bitDepth));
+                pixel[3] = toByte(ReadSample(row, sample + 1, info.bitDepth));
+                break;
+            default:
+                for (int c = 0; c < 4; ++c) {
+                    pixel[c] = toByte(ReadSample(row, sample + c, info.bitDepth));
+                }
+                break;
+        }
+    }
+}
+
+// ---- TGA ---------------------------------------------------------------------------------
+
+// One TGA pixel of bytesPerPixel bytes (BGR order) into RGBA
+void ReadTGAPixel(const uint8_t* source, int bytesPerPixel, bool grayscale, bool hasAlpha, uint8_t* pixel) {
+    switch (bytesPerPixel) {
+        case 1:
+            pixel[0] = pixel[1] = pixel[2] = source[0];
+            pixel[3] = 255;
+            break;
+        case 2: {
+            if (grayscale) {
+                pixel[0] = pixel[1] = pixel[2] = source[0];
+                pixel[3] = source[1];
+                break;
+            }
+            uint16_t value = ReadLittleEndian16(source);
+            pixel[0] = static_cast<uint8_t>(((value >> 10) & 31) * 255 / 31);
+            pixel[1] = static_cast<uint8_t>(((value >> 5) & 31) * 255 / 31);
+            pixel[2] = static_cast<uint8_t>((value & 31) * 255 / 31);
+            pixel[3] = !hasAlpha || (value & 0x8000) ? 255 : 0;
+            break;
+        }
+        case 3:
+            pixel[0] = source[2];
+            pixel[1] = source[1];
+            pixel[2] = source[0];
+            pixel[3] = 255;
+            break;
+        default:
+            pixel[0] = source[2];
+            pixel[1] = source[1];
+            pixel[2] = source[0];
+            pixel[3] = hasAlpha ? source[3] : 255;
+            break;
+    }
+}
+
+bool CheckDimensions(int64_t width, int64_t height) {
+    return width > 0 && height > 0 && width <= ImageLoader::MaxDimension && height <= ImageLoader::MaxDimension;
+}
+
+void AllocateImage(TextureData& image, int width, int height) {
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.assign(size_t(width) * height * 4, 0);
+}
+
+}
+
+bool ImageLoader::Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out, size_t expectedSize) {
+    out.clear();
+    out.reserve(expectedSize);
+    const size_t maxSize = expectedSize > 0 ? expectedSize : std::numeric_limits<size_t>::max();
+    if (size < 2) {
+        return false;
+    }
+    // zlib header: deflate method, window <= 32K, check bits, no preset dictionary
+    if ((data[0] & 15) != 8 || (data[0] >> 4) > 7 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20)) {
+        return false;
+    }
+
+    BitReader reader(data + 2, size - 2);
+    Huffman literals;
+    Huffman distances;
+    bool last = false;
+    while (!last) {
+        last = reader.Read(1) != 0;
+        uint32_t type = reader.Read(2);
+        if (type == 0) {
+            reader.AlignToByte();
+            reader.Rewind();
+            const size_t position = reader.GetBytePosition();
+            if (position + 4 > reader.GetSize()) {
+                return false;
+            }
+            const uint8_t* header = reader.GetData() + position;
+            uint16_t length = ReadLittleEndian16(header);
+            uint16_t inverse = ReadLittleEndian16(header + 2);
+            if (static_cast<uint16_t>(~inverse) != length || position + 4 + length > reader.GetSize() ||
+                length > maxSize - out.size()) {
+                return false;
+            }
+            out.insert(out.end(), header + 4, header + 4 + length);
+            reader.Skip(4 + size_t(length));
+        } else if (type == 1) {
+            uint8_t lengths[288 + 32];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            std::memset(lengths + 288, 5, 32);
+            if (!literals.Build(lengths, 288) || !distances.Build(lengths + 288, 30) ||
+                !InflateBlock(reader, literals, distances, out, maxSize)) {
+                return false;
+            }
+        } else if (type == 2) {
+            if (!InflateDynamicTables(reader, literals, distances) || !InflateBlock(reader, literals, distances, out, maxSize)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return !reader.IsOverrun();
+}
+
+bool ImageLoader::DecodePNG(const uint8_t* data, size_t size, TextureData& image) {
+    static constexpr uint8_t Signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    if (size < 8 || std::memcmp(data, Signature, 8) != 0) {
+        return false;
+    }
+
+    PNGInfo info;
+    std::vector<uint8_t> compressed;
+    bool haveHeader = false;
+    size_t position = 8;
+    while (position + 12 <= size) {
+        uint32_t length = ReadBigEndian32(data + position);
+        const uint8_t* type = data + position + 4;
+        const uint8_t* payload = data + position + 8;
+        if (length > size - position - 12) {
+            return false;
+        }
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13) {
+                return false;
+            }
+            info.width = ReadBigEndian32(payload);
+            info.height = ReadBigEndian32(payload + 4);
+            info.bitDepth = payload[8];
+            info.colorType = payload[9];
+            info.interlaced = payload[12] == 1;
+            static constexpr int ChannelCounts[7] = {1, 0, 3, 1, 2, 0, 4};
+            info.channels = info.colorType <= 6 ? ChannelCounts[info.colorType] : 0;
+            bool validDepth = info.bitDepth == 8 || info.bitDepth == 16 ||
+                              ((info.colorType == 0 || info.colorType == 3) && (info.bitDepth == 1 || info.bitDepth == 2 || info.bitDepth == 4));
+            if (info.channels == 0 || !validDepth || (info.colorType == 3 && info.bitDepth == 16) ||
+                payload[10] != 0 || payload[11] != 0 || payload[12] > 1 || !CheckDimensions(info.width, info.height)) {
+                return false;
+            }
+            haveHeader = true;
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            info.paletteSize = static_cast<int>(std::min<uint32_t>(length / 3, 256));
+            for (int i = 0; i < info.paletteSize; ++i) {
+                info.palette[i][0] = payload[i * 3];
+                info.palette[i][1] = payload[i * 3 + 1];
+                info.palette[i][2] = payload[i * 3 + 2];
+                info.palette[i][3] = 255;
+            }
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (info.colorType == 3) {
+                for (uint32_t i = 0; i < length && i < 256; ++i) {
+                    info.palette[i][3] = payload[i];
+                }
+            } else if (info.colorType == 0 && length >= 2) {
+                info.hasColorKey = true;
+                info.colorKey[0] = static_cast<uint16_t>((payload[0] << 8) | payload[1]);
+            } else if (info.colorType == 2 && length >= 6) {
+                info.hasColorKey = true;
+                for (int c = 0; c < 3; ++c) {
+                    info.colorKey[c] = static_cast<uint16_t>((payload[c * 2] << 8) | payload[c * 2 + 1]);
+                }
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), payload, payload + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        } else if (!(type[0] & 0x20)) {
+            return false;               // Unknown critical chunk
+        }
+        position += size_t(length) + 12;
+    }
+    if (!haveHeader || compressed.empty() || (info.colorType == 3 && info.paletteSize == 0)) {
+        return false;
+    }
+
+    // Adam7 passes as (x start, y start, x step, y step); a plain image is one full pass
+    static constexpr uint32_t Adam7[7][4] = {{0, 0, 8, 8}, {4, 0, 8, 8}, {0, 4, 4, 8}, {2, 0, 4, 4},
+                                             {0, 2, 2, 4}, {1, 0, 2, 2}, {0, 1, 1, 2}};
+    static constexpr uint32_t FullPass[1][4] = {{0, 0, 1, 1}};
+    const auto* passes = info.interlaced ? Adam7 : FullPass;
+    const int passCount = info.interlaced ? 7 : 1;
+
+    const size_t bitsPerPixel = size_t(info.channels) * info.bitDepth;
+    const size_t bytesPerPixel = std::max<size_t>(1, bitsPerPixel / 8);
+    size_t expected = 0;
+    for (int p = 0; p < passCount; ++p) {
+        uint32_t columns = (info.width + passes[p][2] - 1 - passes[p][0]) / passes[p][2];
+        uint32_t rows = (info.height + passes[p][3] - 1 - passes[p][1]) / passes[p][3];
+        if (info.width > passes[p][0] && info.height > passes[p][1]) {
+            expected += size_t(rows) * ((columns * bitsPerPixel + 7) / 8 + 1);
+        }
+    }
+
+    std::vector<uint8_t> raw;
+    if (!Inflate(compressed.data(), compressed.size(), raw, expected) || raw.size() < expected) {
+        return false;
+    }
+
+    AllocateImage(image, static_cast<int>(info.width), static_cast<int>(info.height));
+    size_t offset = 0;
+    for (int p = 0; p < passCount; ++p) {
+        if (info.width <= passes[p][0] || info.height <= passes[p][1]) {
+            continue;                   // Empty pass of a small image
+        }
+        uint32_t columns = (info.width + passes[p][2] - 1 - passes[p][0]) / passes[p][2];
+        uint32_t rows = (info.height + passes[p][3] - 1 - passes[p][1]) / passes[p][3];
+        size_t stride = (columns * bitsPerPixel + 7) / 8;
+        if (!Unfilter(raw.data() + offset, rows, stride, bytesPerPixel)) {
+            return false;
+        }
+        for (uint32_t row = 0; row < rows; ++row) {
+            ExpandRow(info, raw.data() + offset + row * (stride + 1) + 1, columns, image,
+                      passes[p][1] + row * passes[p][3], passes[p][0], passes[p][2]);
+        }
+        offset += rows * (stride + 1);
+    }
+    return true;
+}
+
+bool ImageLoader::DecodeTGA(const uint8_t* data, size_t size, TextureData& image) {
+    if (size < 18) {
+        return false;
+    }
+    const int idLength = data[0];
+    const int colorMapType = data[1];
+    const int imageType = data[2];
+    const int mapFirst = ReadLittleEndian16(data + 3);
+    const int mapLength = ReadLittleEndian16(data + 5);
+    const int mapEntryBits = data[7];
+    const int width = ReadLittleEndian16(data + 12);
+    const int height = ReadLittleEndian16(data + 14);
+    const int pixelBits = data[16];
+    const int descriptor = data[17];
+    const bool rle = imageType >= 9;
+    const int baseType = rle ? imageType - 8 : imageType;
+    const bool hasAlpha = (descriptor & 15) != 0;
+
+    if ((baseType != 1 && baseType != 2 && baseType != 3) || colorMapType > 1 || !CheckDimensions(width, height)) {
+        return false;
+    }
+    const int bytesPerPixel = (pixelBits + 7) / 8;
+    if (bytesPerPixel < 1 || bytesPerPixel > 4 || (baseType == 1 && bytesPerPixel != 1)) {
+        return false;
+    }
+
+    size_t position = 18 + size_t(idLength);
+    std::vector<uint8_t> palette;
+    if (colorMapType == 1) {
+        const int entryBytes = (mapEntryBits + 7) / 8;
+        const size_t mapSize = size_t(mapLength) * entryBytes;
+        if (entryBytes < 2 || entryBytes > 4 || position + mapSize > size) {
+            return false;
+        }
+        palette.resize(size_t(mapFirst + mapLength) * 4, 0);
+        for (int i = 0; i < mapLength; ++i) {
+            ReadTGAPixel(data + position + size_t(i) * entryBytes, entryBytes, false, mapEntryBits == 32 || hasAlpha,
+                         palette.data() + size_t(mapFirst + i) * 4);
+        }
+        position += mapSize;
+    } else if (baseType == 1) {
+        return false;
+    }
+
+    AllocateImage(image, width, height);
+    const bool topDown = (descriptor & 0x20) != 0;
+    const bool rightToLeft = (descriptor & 0x10) != 0;
+    const size_t pixelCount = size_t(width) * height;
+    auto store = [&](size_t index, const uint8_t* source) {
+        size_t x = index % width;
+        size_t y = index / width;
+        if (rightToLeft) {
+            x = width - 1 - x;
+        }
+        if (topDown) {
+            y = height - 1 - y;         // Output is bottom row first, TGA's default order
+        }
+        uint8_t* pixel = image.pixels.data() + (y * width + x) * 4;
+        if (baseType == 1) {
+            size_t entry = source[0];
+            if (entry * 4 + 4 <= palette.size()) {
+                std::memcpy(pixel, palette.data() + entry * 4, 4);
+            }
+        } else {
+            ReadTGAPixel(source, bytesPerPixel, baseType == 3, hasAlpha, pixel);
+        }
+    };
+
+    size_t index = 0;
+    while (index < pixelCount) {
+        if (!rle) {
+            if (position + pixelCount * bytesPerPixel > size) {
+                return false;
+            }
+            for (; index < pixelCount; ++index) {
+                store(index, data + position + index * bytesPerPixel);
+            }
+            break;
+        }
+        if (position >= size) {
+            return false;
+        }
+        const uint8_t packet = data[position++];
+        const size_t count = std::min<size_t>((packet & 127) + 1, pixelCount - index);
+        if (packet & 128) {
+            if (position + bytesPerPixel > size) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                store(index++, data + position);
+            }
+            position += bytesPerPixel;
+        } else {
+            if (position + count * bytesPerPixel > size) {
+                return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                store(index++, data + position);
+                position += bytesPerPixel;
+            }
+        }
+    }
+    return true;
+}
+
+bool ImageLoader::DecodeBMP(const uint8_t* data, size_t size, TextureData& image) {
+    if (size < 54 || data[0] != 'B' || data[1] != 'M') {
+        return false;
+    }
+    const uint32_t pixelOffset = ReadLittleEndian32(data + 10);
+    const uint32_t headerSize = ReadLittleEndian32(data + 14);
+    const int32_t width = static_cast<int32_t>(ReadLittleEndian32(data + 18));
+    const int32_t rawHeight = static_cast<int32_t>(ReadLittleEndian32(data + 22));
+    const int bitCount = ReadLittleEndian16(data + 28);
+    const uint32_t compression = ReadLittleEndian32(data + 30);
+    const bool topDown = rawHeight < 0;
+    const int64_t height = topDown ? -int64_t(rawHeight) : rawHeight;
+
+    // BI_RGB, or BI_BITFIELDS with 32-bit pixels
+    if (headerSize < 40 || !CheckDimensions(width, height) || !(compression == 0 || (compression == 3 && bitCount == 32)) ||
+        !(bitCount == 8 || bitCount == 24 || bitCount == 32)) {
+        return false;
+    }
+
+    uint32_t masks[4] = {0x00FF0000u, 0x0000FF00u, 0x000000FFu, 0xFF000000u};
+    if (compression == 3) {
+        if (14 + size_t(headerSize) > size || (headerSize < 56 && 14 + 40 + 12 > size)) {
+            return false;
+        }
+        for (int c = 0; c < 3; ++c) {
+            masks[c] = ReadLittleEndian32(data + 54 + c * 4);
+        }
+        masks[3] = headerSize >= 56 ? ReadLittleEndian32(data + 66) : 0;
+    }
+
+    std::vector<uint8_t> palette;
+    if (bitCount == 8) {
+        uint32_t colors = ReadLittleEndian32(data + 46);
+        colors = colors == 0 ? 256 : std::min(colors, 256u);
+        const size_t paletteOffset = 14 + size_t(headerSize);
+        if (paletteOffset + size_t(colors) * 4 > size) {
+            return false;
+        }
+        palette.assign(256 * 4, 0);
+        for (uint32_t i = 0; i < colors; ++i) {
+            const uint8_t* entry = data + paletteOffset + i * 4;
+            palette[i * 4] = entry[2];
+            palette[i * 4 + 1] = entry[1];
+            palette[i * 4 + 2] = entry[0];
+            palette[i * 4 + 3] = 255;
+        }
+    }
+
+    const size_t stride = ((size_t(width) * bitCount + 31) / 32) * 4;
+    if (pixelOffset > size || stride * height > size - pixelOffset) {
+        return false;
+    }
+
+    auto extract = [](uint32_t value, uint32_t mask) -> uint8_t {
+        if (mask == 0) {
+            return 255;
+        }
+        int shift = 0;
+        while (((mask >> shift) & 1) == 0) {
+            ++shift;
+        }
+        uint32_t maximum = mask >> shift;
+        return static_cast<uint8_t>(((value & mask) >> shift) * 255 / maximum);
+    };
+
+    AllocateImage(image, width, static_cast<int>(height));
+    bool anyAlpha = false;
+    for (int64_t row = 0; row < height; ++row) {
+        const uint8_t* source = data + pixelOffset + size_t(row) * stride;
+        // BMP rows are bottom-up unless the height is negative
+        const int64_t y = topDown ? height - 1 - row : row;
+        uint8_t* out = image.pixels.data() + size_t(y) * width * 4;
+        for (int32_t x = 0; x < width; ++x) {
+            uint8_t* pixel = out + size_t(x) * 4;
+            if (bitCount == 8) {
+                std::memcpy(pixel, palette.data() + size_t(source[x]) * 4, 4);
+            } else if (bitCount == 24) {
+                pixel[0] = source[x * 3 + 2];
+                pixel[1] = source[x * 3 + 1];
+                pixel[2] = source[x * 3];
+                pixel[3] = 255;
+            } else {
+                uint32_t value = ReadLittleEndian32(source + size_t(x) * 4);
+                for (int c = 0; c < 3; ++c) {
+                    pixel[c] = extract(value, masks[c]);
+                }
+                pixel[3] = masks[3] ? extract(value, masks[3]) : 255;
+                anyAlpha = anyAlpha || pixel[3] != 0;
+            }
+        }
+    }
+    // Many writers leave the alpha byte of 32-bit BMPs at zero; treat those as opaque
+    if (bitCount == 32 && masks[3] != 0 && !anyAlpha) {
+        for (size_t i = 3; i < image.pixels.size(); i += 4) {
+            image.pixels[i] = 255;
+        }
+    }
+    return true;
+}
+
+bool ImageLoader::LoadFromMemory(const uint8_t* data, size_t size, TextureData& image) {
+    image = TextureData();
+    if (!data || size < 4) {
+        return false;
+    }
+    bool decoded = false;
+    if (data[0] == 137 && data[1] == 'P' && data[2] == 'N' && data[3] == 'G') {
+        decoded = DecodePNG(data, size, image);
+    } else if (data[0] == 'B' && data[1] == 'M') {
+        decoded = DecodeBMP(data, size, image);
+    } else {
+        // TGA has no signature; its header is validated instead
+        decoded = DecodeTGA(data, size, image);
+    }
+    if (!decoded) {
+        image = TextureData();
+    }
+    return decoded;
+}
+
+bool ImageLoader::LoadFromFile(const std::string& path, TextureData& image) {
+    PROFILE_SCOPE("ImageLoader::LoadFromFile");
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    if (!LoadFromMemory(reinterpret_cast<const uint8_t*>(file.GetData()), file.GetSize(), image)) {
+        Logger::Error("ImageLoader: " + path + " is not a supported PNG, TGA or BMP image");
+        return false;
+    }
+    Logger::Debug("Decoded image " + path + ": " + std::to_string(image.width) + "x" + std::to_string(image.height));
+    return true;
+}
+
+}
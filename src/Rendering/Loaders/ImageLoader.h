@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../Core/Texture.h"
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine {
+    // Decodes PNG (all bit depths, palettes, tRNS and Adam7), TGA (true color, gray and
+    // color-mapped, raw or RLE) and uncompressed BMP into RGBA8. The format is detected from
+    // the file contents, not the extension. Rows are stored bottom row first, the order
+    // glTexImage2D expects for OBJ-style texture coordinates. No GL calls, so any thread may
+    // decode.
+    class ImageLoader {
+    public:
+        static bool LoadFromFile(const std::string& path, TextureData& image);
+        static bool LoadFromMemory(const uint8_t* data, size_t size, TextureData& image);
+
+        static bool DecodePNG(const uint8_t* data, size_t size, TextureData& image);
+        static bool DecodeTGA(const uint8_t* data, size_t size, TextureData& image);
+        static bool DecodeBMP(const uint8_t* data, size_t size, TextureData& image);
+
+        // zlib stream (RFC 1950/1951) into out. A non-zero expectedSize is reserved and is also a
+        // hard cap: streams that would decode to more fail instead of growing out.
+        static bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out, size_t expectedSize = 0);
+
+        // Largest width or height accepted, which bounds the allocation a corrupt header can cause
+        static constexpr int MaxDimension = 16384;
+    };
+}
@@ -1,14 +1,82 @@
 #include "OBJLoader.h"
 #include "../../Core/Logging/Logger.h"
+#include "../../Core/Platform/MappedFile.h"
+#include "../Meshes/MeshOptimizer.h"
+#include "../../Core/Profiling/Profiler.h"
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <algorithm>
 #include <unordered_map>
 #include <filesystem>
+#include <charconv>
+#include <cstring>
+#include <numeric>
+#include <thread>
 
 namespace GameEngine {
-    Mesh OBJLoader::LoadFromFile(const std::string& filepath) {
+    namespace {
+        constexpr size_t MinBytesPerChunk = 4 * 1024 * 1024;   // Smaller files parse faster on one thread
+        
+        inline bool IsSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+        
+        inline const char* SkipSpaces(const char* p, const char* end) {
+            while (p < end && IsSpace(*p)) {
+                ++p;
+            }
+            return p;
+        }
+        
+        inline const char* SkipToken(const char* p, const char* end) {
+            while (p < end && !IsSpace(*p)) {
+                ++p;
+            }
+            return p;
+        }
+        
+        // Next whitespace-separated float; a missing or malformed value reads as 0
+        inline const char* ParseFloat(const char* p, const char* end, float& value) {
+            p = SkipSpaces(p, end);
+            const char* start = (p < end && *p == '+') ? p + 1 : p;
+            auto result = std::from_chars(start, end, value);
+            if (result.ec != std::errc()) {
+                value = 0.0f;
+                return SkipToken(p, end);
+            }
+            return result.ptr;
+        }
+        
+        // Integer up to the next '/' or whitespace; an empty field reads as 0 (absent)
+        inline const char* ParseIndex(const char* p, const char* end, int32_t& value) {
+            const char* start = (p < end && *p == '+') ? p + 1 : p;
+            auto result = std::from_chars(start, end, value);
+            if (result.ec != std::errc()) {
+                value = 0;
+                while (p < end && *p != '/' && !IsSpace(*p)) {
+                    ++p;
+                }
+                return p;
+            }
+            return result.ptr;
+        }
+        
+        inline bool IsKeyword(const char* p, const char* tokenEnd, const char* keyword, size_t length) {
+            return static_cast<size_t>(tokenEnd - p) == length && std::memcmp(p, keyword, length) == 0;
+        }
+        
+        // Rest of the line with surrounding whitespace removed
+        inline std::string RestOfLine(const char* p, const char* lineEnd) {
+            p = SkipSpaces(p, lineEnd);
+            while (lineEnd > p && IsSpace(lineEnd[-1])) {
+                --lineEnd;
+            }
+            return std::string(p, lineEnd);
+        }
+    }
+    
+    Mesh OBJLoader::LoadFromFile(const std::string& filepath, bool parallel) {
         Logger::Info("Loading OBJ file: " + filepath);
         
         if (!std::filesystem::exists(filepath)) {
@@ -17,15 +85,8 @@ namespace GameEngine {
             return Mesh();
         }
         
-        try {
-            auto fileSize = std::filesystem::file_size(filepath);
-            Logger::Debug("OBJ file size: " + std::to_string(fileSize) + " bytes");
-        } catch (const std::exception& e) {
-            Logger::Warning("Could not get file size for: " + filepath + " - " + e.what());
-        }
-        
         OBJData data;
-        if (!ParseOBJFile(filepath, data)) {
+        if (!ParseOBJFile(filepath, data, parallel)) {
             Logger::Error("Failed to parse OBJ file: " + filepath);
             return Mesh();
         }
@@ -45,171 +106,256 @@ namespace GameEngine {
         return CreateMeshFromOBJData(data);
     }
     
-    bool OBJLoader::ParseOBJFile(const std::string& filepath, OBJData& data) {
-        std::ifstream file(filepath, std::ios::in);
-        if (!file.is_open()) {
+    bool OBJLoader::ParseOBJFile(const std::string& filepath, OBJData& data, bool parallel) {
+        PROFILE_SCOPE("OBJLoader::ParseOBJFile");
+        MappedFile file;
+        if (!file.Open(filepath)) {
             Logger::Error("Cannot open OBJ file: " + filepath);
             Logger::Error("Current working directory or file permissions may be incorrect");
             return false;
         }
+        const char* begin = file.GetData();
+        const char* end = begin + file.GetSize();
+        Logger::Debug("OBJ file size: " + std::to_string(file.GetSize()) + " bytes");
         
-        std::string line;
-        int lineNumber = 0;
+        // Split at line boundaries so every chunk starts on a fresh statement
+        size_t chunkCount = 1;
+        if (parallel) {
+            size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            chunkCount = std::max<size_t>(1, std::min(threads, file.GetSize() / MinBytesPerChunk));
+        }
+        std::vector<const char*> bounds(chunkCount + 1, end);
+        bounds[0] = begin;
+        for (size_t c = 1; c < chunkCount; ++c) {
+            const char* split = std::max(bounds[c - 1], begin + file.GetSize() * c / chunkCount);
+            const char* newline = static_cast<const char*>(std::memchr(split, '\n', static_cast<size_t>(end - split)));
+            bounds[c] = newline ? newline + 1 : end;
+        }
         
-        while (std::getline(file, line)) {
-            lineNumber++;
-            line = TrimString(line);
-            
-            if (line.empty() || line[0] == '#') {
-                continue;
+        std::vector<ChunkData> chunks(chunkCount);
+        auto runChunks = [chunkCount](auto&& work) {
+            std::vector<std::thread> workers;
+            workers.reserve(chunkCount - 1);
+            for (size_t c = 1; c < chunkCount; ++c) {
+                workers.emplace_back(work, c);
+            }
+            work(0);
+            for (auto& worker : workers) {
+                worker.join();
             }
+        };
+        runChunks([&](size_t c) { ParseChunk(bounds[c], bounds[c + 1], chunks[c]); });
+        
+        // Merge attributes and sequential state in file order
+        std::vector<uint32_t> positionBase(chunkCount), texCoordBase(chunkCount), normalBase(chunkCount);
+        std::vector<size_t> triangleBase(chunkCount);
+        size_t positionTotal = 0, texCoordTotal = 0, normalTotal = 0, triangleTotal = 0, skipped = 0;
+        for (size_t c = 0; c < chunkCount; ++c) {
+            positionBase[c] = static_cast<uint32_t>(positionTotal);
+            texCoordBase[c] = static_cast<uint32_t>(texCoordTotal);
+            normalBase[c] = static_cast<uint32_t>(normalTotal);
+            triangleBase[c] = triangleTotal;
+            positionTotal += chunks[c].positions.size();
+            texCoordTotal += chunks[c].texCoords.size();
+            normalTotal += chunks[c].normals.size();
+            triangleTotal += chunks[c].triangleCount;
+            skipped += chunks[c].skippedLines;
+        }
+        data.positions.reserve(positionTotal);
+        data.texCoords.reserve(texCoordTotal);
+        data.normals.reserve(normalTotal);
+        std::vector<std::string> chunkStartMaterial(chunkCount);
+        for (size_t c = 0; c < chunkCount; ++c) {
+            ChunkData& chunk = chunks[c];
+            data.positions.insert(data.positions.end(), chunk.positions.begin(), chunk.positions.end());
+            data.texCoords.insert(data.texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+            data.normals.insert(data.normals.end(), chunk.normals.begin(), chunk.normals.end());
             
-            try {
-                if (StartsWith(line, "v ")) {
-                    Vector3 position = ParseVector3(line.substr(2));
-                    data.positions.push_back(position);
-                }
-                else if (StartsWith(line, "vn ")) {
-                    Vector3 normal = ParseVector3(line.substr(3));
-                    data.normals.push_back(normal);
-                }
-                else if (StartsWith(line, "vt ")) {
-                    std::vector<std::string> comps = SplitString(TrimString(line.substr(3)), ' ');
-                    float u = 0.0f, v = 0.0f, w = 0.0f;
-                    if (comps.size() >= 1 && IsValidFloat(comps[0])) u = std::stof(comps[0]);
-                    if (comps.size() >= 2 && IsValidFloat(comps[1])) v = std::stof(comps[1]);
-                    if (comps.size() >= 3 && IsValidFloat(comps[2])) w = std::stof(comps[2]);
-                    data.texCoords.push_back(Vector3(u, v, w));
-                }
-                else if (StartsWith(line, "f ")) {
-                    ParseFace(line.substr(2), data);
-                }
-                else if (StartsWith(line, "o ") || StartsWith(line, "g ")) {
-                    data.currentGroup = TrimString(line.substr(2));
-                }
-                else if (StartsWith(line, "mtllib ")) {
-                    std::string lib = TrimString(line.substr(7));
-                    data.materialLibs[lib] = lib;
+            chunkStartMaterial[c] = data.currentMaterial;
+            if (!chunk.materialNames.empty()) {
+                data.currentMaterial = chunk.materialNames.back();
+            }
+            if (!chunk.group.empty()) {
+                data.currentGroup = chunk.group;
+            }
+            if (chunk.smoothing >= 0) {
+                data.smoothing = chunk.smoothing != 0;
+            }
+            for (const std::string& lib : chunk.materialLibs) {
+                if (data.materialLibs.emplace(lib, lib).second) {
                     try {
-                        std::filesystem::path objPath(filepath);
-                        std::string objDir = objPath.parent_path().string();
+                        std::string objDir = std::filesystem::path(filepath).parent_path().string();
                         LoadMTL(objDir, lib, data.materials);
                     } catch (...) {}
                 }
-                else if (StartsWith(line, "usemtl ")) {
-                    data.currentMaterial = TrimString(line.substr(7));
-                }
-                else if (StartsWith(line, "s ")) {
-                    std::string s = TrimString(line.substr(2));
-                    data.smoothing = (s != "off" && s != "0");
-                }
             }
-            catch (const std::exception& e) {
-                Logger::Warning("Error parsing line " + std::to_string(lineNumber) + 
-                               " in OBJ file " + filepath + ": " + e.what());
+        }
+        if (skipped > 0) {
+            Logger::Warning("Skipped " + std::to_string(skipped) + " faces with fewer than 3 vertices in OBJ file " + filepath);
+        }
+        
+        auto colorOf = [&data](const std::string& material) {
+            auto it = material.empty() ? data.materials.end() : data.materials.find(material);
+            return it != data.materials.end() ? it->second.Kd : Vector3(1.0f, 1.0f, 1.0f);
+        };
+        std::vector<Vector3> startColors(chunkCount);
+        std::vector<std::vector<Vector3>> materialColors(chunkCount);
+        for (size_t c = 0; c < chunkCount; ++c) {
+            startColors[c] = colorOf(chunkStartMaterial[c]);
+            for (const std::string& material : chunks[c].materialNames) {
+                materialColors[c].push_back(colorOf(material));
             }
         }
         
-        file.close();
+        // Resolve faces into the unindexed triangle list; chunks write disjoint ranges
+        data.vertices.resize(triangleTotal * 3);
+        runChunks([&](size_t c) {
+            EmitChunkTriangles(chunks[c], data, startColors[c], materialColors[c], positionBase[c], texCoordBase[c],
+                               normalBase[c], data.vertices.data() + triangleBase[c] * 3);
+        });
+        data.indices.resize(data.vertices.size());
+        std::iota(data.indices.begin(), data.indices.end(), 0u);
         
         Logger::Debug("Parsed OBJ file: " + std::to_string(data.positions.size()) + " positions, " +
                      std::to_string(data.normals.size()) + " normals, " +
                      std::to_string(data.texCoords.size()) + " texture coordinates, " +
-                     std::to_string(data.vertices.size()) + " vertices");
+                     std::to_string(data.vertices.size()) + " vertices in " + std::to_string(chunkCount) + " chunks");
         
         return !data.positions.empty();
     }
     
-    Vector3 OBJLoader::ParseVector3(const std::string& line) {
-        std::vector<std::string> components = SplitString(TrimString(line), ' ');
-        
-        if (components.size() < 1) {
-            throw std::runtime_error("Invalid vector format");
-        }
-        
-        float x = 0.0f, y = 0.0f, z = 0.0f;
-        
-        if (components.size() >= 1 && IsValidFloat(components[0])) {
-            x = std::stof(components[0]);
-        }
-        if (components.size() >= 2 && IsValidFloat(components[1])) {
-            y = std::stof(components[1]);
-        }
-        if (components.size() >= 3 && IsValidFloat(components[2])) {
-            z = std::stof(components[2]);
-        }
-        
-        return Vector3(x, y, z);
-    }
-    
-    void OBJLoader::ParseFace(const std::string& line, OBJData& data) {
-        std::vector<std::string> faceVertices = SplitString(TrimString(line), ' ');
-        
-        if (faceVertices.size() < 3) {
-            throw std::runtime_error("Face must have at least 3 vertices");
-        }
-        
-        std::vector<Vertex> faceVertexData;
-        faceVertexData.reserve(faceVertices.size());
-        
-        for (const std::string& vertexStr : faceVertices) {
-            std::vector<std::string> indices = SplitString(vertexStr, '/');
-            if (indices.empty()) continue;
-            
-            Vertex vertex;
-            vertex.position = Vector3::Zero;
-            vertex.normal = Vector3(0.0f, 1.0f, 0.0f);
-            vertex.color = Vector3(1.0f, 1.0f, 1.0f);
-            vertex.texCoords = Vector3::Zero;
-            
-            if (!indices[0].empty()) {
-                int posIndex = std::stoi(indices[0]);
-                posIndex = ResolveIndex(posIndex, static_cast<int>(data.positions.size()));
-                if (posIndex >= 0 && posIndex < static_cast<int>(data.positions.size())) {
-                    vertex.position = data.positions[posIndex];
-                }
+    void OBJLoader::ParseChunk(const char* begin, const char* end, ChunkData& chunk) {
+        const char* p = begin;
+        while (p < end) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!lineEnd) {
+                lineEnd = end;
             }
+            const char* next = lineEnd < end ? lineEnd + 1 : end;
             
-            if (indices.size() > 1 && !indices[1].empty()) {
-                int texIndex = std::stoi(indices[1]);
-                texIndex = ResolveIndex(texIndex, static_cast<int>(data.texCoords.size()));
-                if (texIndex >= 0 && texIndex < static_cast<int>(data.texCoords.size())) {
-                    vertex.texCoords = data.texCoords[texIndex];
-                }
+            p = SkipSpaces(p, lineEnd);
+            if (p == lineEnd || *p == '#') {
+                p = next;
+                continue;
             }
+            const char* tokenEnd = SkipToken(p, lineEnd);
             
-            if (indices.size() > 2 && !indices[2].empty()) {
-                int normalIndex = std::stoi(indices[2]);
-                normalIndex = ResolveIndex(normalIndex, static_cast<int>(data.normals.size()));
-                if (normalIndex >= 0 && normalIndex < static_cast<int>(data.normals.size())) {
-                    vertex.normal = data.normals[normalIndex];
+            if (IsKeyword(p, tokenEnd, "v", 1) || IsKeyword(p, tokenEnd, "vn", 2) || IsKeyword(p, tokenEnd, "vt", 2)) {
+                Vector3 value;
+                const char* q = ParseFloat(tokenEnd, lineEnd, value.x);
+                q = ParseFloat(q, lineEnd, value.y);
+                ParseFloat(q, lineEnd, value.z);
+                if (tokenEnd - p == 1) {
+                    chunk.positions.push_back(value);
+                } else if (p[1] == 'n') {
+                    chunk.normals.push_back(value);
+                } else {
+                    chunk.texCoords.push_back(value);
                 }
             }
-            
-            if (!data.currentMaterial.empty()) {
-                auto it = data.materials.find(data.currentMaterial);
-                if (it != data.materials.end()) {
-                    vertex.color = it->second.Kd;
+            else if (IsKeyword(p, tokenEnd, "f", 1)) {
+                FaceRecord face;
+                face.firstCorner = static_cast<uint32_t>(chunk.corners.size() / 3);
+                face.material = chunk.materialNames.empty() ? -1 : static_cast<int32_t>(chunk.materialNames.size() - 1);
+                face.positionCount = static_cast<uint32_t>(chunk.positions.size());
+                face.texCoordCount = static_cast<uint32_t>(chunk.texCoords.size());
+                face.normalCount = static_cast<uint32_t>(chunk.normals.size());
+                
+                const char* q = SkipSpaces(tokenEnd, lineEnd);
+                while (q < lineEnd) {
+                    int32_t indices[3] = {0, 0, 0};
+                    for (int field = 0; field < 3 && q < lineEnd && !IsSpace(*q); ++field) {
+                        q = ParseIndex(q, lineEnd, indices[field]);
+                        if (q < lineEnd && *q == '/') {
+                            ++q;
+                        } else {
+                            break;
+                        }
+                    }
+                    q = SkipToken(q, lineEnd);
+                    chunk.corners.insert(chunk.corners.end(), indices, indices + 3);
+                    ++face.cornerCount;
+                    q = SkipSpaces(q, lineEnd);
+                }
+                
+                if (face.cornerCount < 3) {
+                    chunk.corners.resize(face.firstCorner * 3);
+                    ++chunk.skippedLines;
+                } else {
+                    chunk.triangleCount += face.cornerCount - 2;
+                    chunk.faces.push_back(face);
                 }
             }
-            faceVertexData.push_back(vertex);
+            else if (IsKeyword(p, tokenEnd, "o", 1) || IsKeyword(p, tokenEnd, "g", 1)) {
+                chunk.group = RestOfLine(tokenEnd, lineEnd);
+            }
+            else if (IsKeyword(p, tokenEnd, "usemtl", 6)) {
+                chunk.materialNames.push_back(RestOfLine(tokenEnd, lineEnd));
+            }
+            else if (IsKeyword(p, tokenEnd, "mtllib", 6)) {
+                chunk.materialLibs.push_back(RestOfLine(tokenEnd, lineEnd));
+            }
+            else if (IsKeyword(p, tokenEnd, "s", 1)) {
+                std::string value = RestOfLine(tokenEnd, lineEnd);
+                chunk.smoothing = (value != "off" && value != "0") ? 1 : 0;
+            }
+            p = next;
         }
-        
-        for (size_t i = 1; i < faceVertexData.size() - 1; ++i) {
-            data.vertices.push_back(faceVertexData[0]);
-            data.vertices.push_back(faceVertexData[i]);
-            data.vertices.push_back(faceVertexData[i + 1]);
+    }
+    
+    void OBJLoader::EmitChunkTriangles(const ChunkData& chunk, const OBJData& data, const Vector3& startColor,
+                                       const std::vector<Vector3>& materialColors, uint32_t positionBase,
+                                       uint32_t texCoordBase, uint32_t normalBase, Vertex* out) {
+        Vertex corners[3];
+        for (const FaceRecord& face : chunk.faces) {
+            const Vector3& color = face.material >= 0 ? materialColors[face.material] : startColor;
+            int positionCount = static_cast<int>(positionBase + face.positionCount);
+            int texCoordCount = static_cast<int>(texCoordBase + face.texCoordCount);
+            int normalCount = static_cast<int>(normalBase + face.normalCount);
+            
+            auto makeVertex = [&](uint32_t corner, Vertex& vertex) {
+                const int32_t* indices = &chunk.corners[(face.firstCorner + corner) * 3];
+                vertex.position = Vector3::Zero;
+                vertex.normal = Vector3(0.0f, 1.0f, 0.0f);
+                vertex.color = color;
+                vertex.texCoords = Vector3::Zero;
+                
+                int index = ResolveIndex(indices[0], positionCount);
+                if (index >= 0 && index < positionCount) {
+                    vertex.position = data.positions[index];
+                }
+                index = ResolveIndex(indices[1], texCoordCount);
+                if (index >= 0 && index < texCoordCount) {
+                    vertex.texCoords = data.texCoords[index];
+                }
+                index = ResolveIndex(indices[2], normalCount);
+                if (index >= 0 && index < normalCount) {
+                    vertex.normal = data.normals[index];
+                }
+            };
             
-            unsigned int baseIndex = static_cast<unsigned int>(data.vertices.size() - 3);
-            data.indices.push_back(baseIndex);
-            data.indices.push_back(baseIndex + 1);
-            data.indices.push_back(baseIndex + 2);
+            // Triangle fan around the first corner
+            makeVertex(0, corners[0]);
+            makeVertex(1, corners[1]);
+            for (uint32_t i = 2; i < face.cornerCount; ++i) {
+                makeVertex(i, corners[2]);
+                *out++ = corners[0];
+                *out++ = corners[1];
+                *out++ = corners[2];
+                corners[1] = corners[2];
+            }
         }
     }
     
-    Mesh OBJLoader::CreateMeshFromOBJData(const OBJData& data) {
+    Mesh OBJLoader::CreateMeshFromOBJData(OBJData& data) {
         Mesh mesh;
         
+        // The parser emits three fresh vertices per triangle; weld and reorder for the GPU caches
+        size_t importedVertices = data.vertices.size();
+        MeshOptimizer::Optimize(data.vertices, data.indices);
+        Logger::Debug("Optimized OBJ mesh: " + std::to_string(importedVertices) + " -> " + std::to_string(data.vertices.size()) +
+                     " vertices, ACMR " + std::to_string(MeshOptimizer::ComputeACMR(data.indices, data.vertices.size())));
+        
         if (!data.vertices.empty()) {
             mesh.SetVertices(data.vertices);
         }
@@ -217,9 +363,10 @@ namespace GameEngine {
         if (!data.indices.empty()) {
             mesh.SetIndices(data.indices);
         }
+        // Imported meshes are the large ones; halve their vertex buffer unless tiled UVs need floats
+        mesh.SetVertexFormat(VertexPacking::FitsHalfUVs(data.vertices) ? VertexFormat::Packed : VertexFormat::Float);
         
-        mesh.Upload();
-        
+        // Upload is left to the first draw so meshes can be loaded without a context
         Logger::Debug("Created mesh from OBJ data with " + std::to_string(data.vertices.size()) + 
                      " vertices and " + std::to_string(data.indices.size()) + " indices");
         
@@ -304,16 +451,6 @@ namespace GameEngine {
         return str.substr(start, end - start + 1);
     }
     
-    bool OBJLoader::IsValidFloat(const std::string& str) {
-        if (str.empty()) return false;
-        try {
-            (void)std::stof(str);
-            return true;
-        } catch (const std::exception&) {
-            return false;
-        }
-    }
-    
     bool OBJLoader::StartsWith(const std::string& s, const char* prefix) {
         size_t n = std::char_traits<char>::length(prefix);
         return s.size() >= n && std::equal(prefix, prefix + n, s.begin());
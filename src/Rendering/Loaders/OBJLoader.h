@@ -4,11 +4,15 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 namespace GameEngine {
+    // Parses Wavefront OBJ straight out of a memory-mapped file with std::from_chars; no
+    // per-line allocations. Large files are split at line boundaries and parsed in parallel,
+    // then the chunks are merged and face indices resolved against the merged attributes.
     class OBJLoader {
     public:
-        static Mesh LoadFromFile(const std::string& filepath);
+        static Mesh LoadFromFile(const std::string& filepath, bool parallel = true);
         
     private:
         struct MaterialDesc {
@@ -30,17 +34,44 @@ namespace GameEngine {
             std::unordered_map<std::string, MaterialDesc> materials;
         };
         
-        static bool ParseOBJFile(const std::string& filepath, OBJData& data);
-        static Vector3 ParseVector3(const std::string& line);
-        static void ParseFace(const std::string& line, OBJData& data);
-        static Mesh CreateMeshFromOBJData(const OBJData& data);
+        // A face as read from one chunk. Attribute counts are those seen earlier in the same
+        // chunk, so relative and forward indices resolve exactly as a sequential parse would.
+        struct FaceRecord {
+            uint32_t firstCorner = 0;       // Into ChunkData::corners, three ints per corner
+            uint32_t cornerCount = 0;
+            int32_t material = -1;          // Into ChunkData::materialNames, -1 = the one active at chunk start
+            uint32_t positionCount = 0;
+            uint32_t texCoordCount = 0;
+            uint32_t normalCount = 0;
+        };
+        struct ChunkData {
+            std::vector<Vector3> positions;
+            std::vector<Vector3> normals;
+            std::vector<Vector3> texCoords;
+            std::vector<int32_t> corners;   // Raw OBJ v/vt/vn indices, 0 when absent
+            std::vector<FaceRecord> faces;
+            std::vector<std::string> materialNames;
+            std::vector<std::string> materialLibs;
+            std::string group;
+            int smoothing = -1;             // -1 = no "s" statement in this chunk
+            size_t triangleCount = 0;
+            size_t skippedLines = 0;
+        };
+        
+        static bool ParseOBJFile(const std::string& filepath, OBJData& data, bool parallel);
+        static void ParseChunk(const char* begin, const char* end, ChunkData& chunk);
+        // Writes the chunk's fan-triangulated faces; materialColors is parallel to chunk.materialNames
+        static void EmitChunkTriangles(const ChunkData& chunk, const OBJData& data, const Vector3& startColor,
+                                       const std::vector<Vector3>& materialColors, uint32_t positionBase,
+                                       uint32_t texCoordBase, uint32_t normalBase, Vertex* out);
+        // Welds and cache-orders the imported triangles, then builds the Mesh
+        static Mesh CreateMeshFromOBJData(OBJData& data);
         
         static bool LoadMTL(const std::string& objDir, const std::string& mtlFile, std::unordered_map<std::string, MaterialDesc>& out);
         
         // Helper functions
         static std::vector<std::string> SplitString(const std::string& str, char delimiter);
         static std::string TrimString(const std::string& str);
-        static bool IsValidFloat(const std::string& str);
         static bool StartsWith(const std::string& s, const char* prefix);
         static int ResolveIndex(int idx, int size);
         static void ComputeMissingNormals(OBJData& data);
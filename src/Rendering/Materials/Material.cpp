@@ -3,6 +3,7 @@
 #include "../../Core/Math/Vector2.h"
 #include "../../Core/Math/Vector4.h"
 #include "../Core/OpenGLHeaders.h"
+#include "../Core/TextureAtlas.h"
 
 namespace GameEngine {
 
@@ -48,6 +49,18 @@ void Material::RemoveTexture(const std::string& name) {
     }
 }
 
+bool Material::SetAlbedoAtlasRegion(const TextureAtlas& atlas, const std::string& regionName) {
+    const TextureAtlas::Region* region = atlas.GetRegion(regionName);
+    if (!region || !atlas.GetTexture()) {
+        Logger::Warning("Material " + m_name + ": atlas has no uploaded region " + regionName);
+        return false;
+    }
+    SetAlbedoTexture(atlas.GetTexture());
+    m_properties.mainTextureScale = Vector2(region->uvTransform.x, region->uvTransform.y);
+    m_properties.mainTextureOffset = Vector2(region->uvTransform.z, region->uvTransform.w);
+    return true;
+}
+
 void Material::Bind() const {
     if (!m_shader) {
         Logger::Warning("No shader set for material: " + m_name);
@@ -11,6 +11,8 @@
 
 namespace GameEngine {
 
+class TextureAtlas;
+
 enum class MaterialType {
     Standard,
     Unlit,
@@ -90,6 +92,9 @@ public:
     void SetOcclusionTexture(std::shared_ptr<Texture> texture) { SetTexture("_OcclusionMap", texture); }
     void SetEmissionTexture(std::shared_ptr<Texture> texture) { SetTexture("_EmissionMap", texture); }
     
+    // Albedo from one region of a shared atlas; sets _MainTex and the UV scale/offset
+    bool SetAlbedoAtlasRegion(const TextureAtlas& atlas, const std::string& regionName);
+    
     // Common texture getters
     std::shared_ptr<Texture> GetAlbedoTexture() const { return GetTexture("_MainTex"); }
     std::shared_ptr<Texture> GetNormalTexture() const { return GetTexture("_BumpMap"); }
@@ -4,9 +4,18 @@
 #include "../Core/OpenGLHeaders.h"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 
 namespace GameEngine {
 
+namespace {
+std::atomic<uint64_t> s_geometryVersionCounter{0};
+}
+
+uint64_t Mesh::NextGeometryVersion() {
+    return s_geometryVersionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 Mesh::Mesh() = default;
 
 Mesh::~Mesh() {
@@ -15,38 +24,126 @@ Mesh::~Mesh() {
 
 void Mesh::SetVertices(const std::vector<Vertex>& vertices) {
     m_vertices = vertices;
+    m_packedVertices.clear();
+    m_decodedVertices.reset();
     m_uploaded = false;
+    ClearBakedData();
+    
+    m_boundsMin = m_boundsMax = m_vertices.empty() ? Vector3::Zero : m_vertices[0].position;
+    for (const auto& vertex : m_vertices) {
+        m_boundsMin = Vector3::Min(m_boundsMin, vertex.position);
+        m_boundsMax = Vector3::Max(m_boundsMax, vertex.position);
+    }
 }
 
 void Mesh::SetIndices(const std::vector<unsigned int>& indices) {
     m_indices = indices;
     m_uploaded = false;
+    ClearBakedData();
+}
+
+void Mesh::SetVertices(std::vector<Vertex>&& vertices, const Vector3& boundsMin, const Vector3& boundsMax) {
+    m_vertices = std::move(vertices);
+    m_packedVertices.clear();
+    m_decodedVertices.reset();
+    m_boundsMin = boundsMin;
+    m_boundsMax = boundsMax;
+    m_uploaded = false;
+    ClearBakedData();
+}
+
+void Mesh::SetPackedVertices(std::vector<uint8_t>&& packed, VertexFormat format, const Vector3& boundsMin, const Vector3& boundsMax) {
+    m_packedVertices = std::move(packed);
+    m_packedFormat = format;
+    m_vertexFormat = format;
+    m_vertices.clear();
+    m_decodedVertices = std::make_unique<DecodedVertices>();
+    m_boundsMin = boundsMin;
+    m_boundsMax = boundsMax;
+    m_uploaded = false;
+    ClearBakedData();
+}
+
+const std::vector<Vertex>& Mesh::GetVertices() const {
+    if (!m_decodedVertices) {
+        return m_vertices;
+    }
+    // Shared meshes can be read from several threads; only the first caller decodes
+    std::call_once(m_decodedVertices->once, [this]() {
+        m_decodedVertices->vertices = VertexPacking::Unpack(m_packedVertices.data(), GetVertexCount(), m_packedFormat, m_boundsMin, m_boundsMax);
+    });
+    return m_decodedVertices->vertices;
+}
+
+size_t Mesh::GetVertexCount() const {
+    return m_packedVertices.empty() ? m_vertices.size() : m_packedVertices.size() / VertexPacking::GetStride(m_packedFormat);
+}
+
+void Mesh::SetIndices(std::vector<unsigned int>&& indices) {
+    m_indices = std::move(indices);
+    m_uploaded = false;
+    ClearBakedData();
+}
+
+void Mesh::SetVertexFormat(VertexFormat format) {
+    if (format != m_vertexFormat) {
+        m_vertexFormat = format;
+        m_uploaded = false;
+    }
+    for (auto& lod : m_lods) {
+        lod.mesh->SetVertexFormat(format);
+    }
+}
+
+void Mesh::SetLODs(std::vector<MeshLOD> lods) {
+    m_lods = std::move(lods);
+    for (auto& lod : m_lods) {
+        lod.mesh->SetVertexFormat(m_vertexFormat);
+    }
+}
+
+void Mesh::SetBakedBVH(std::vector<BVHNode> nodes, std::vector<int> triangleIndices) {
+    m_bakedBVHNodes = std::move(nodes);
+    m_bakedBVHTriangleIndices = std::move(triangleIndices);
+}
+
+void Mesh::SetCollisionMesh(std::vector<Vector3> positions, std::vector<unsigned int> indices) {
+    m_collisionPositions = std::move(positions);
+    m_collisionIndices = std::move(indices);
+}
+
+void Mesh::ClearBakedData() {
+    // Every geometry setter ends up here
+    m_geometryVersion = NextGeometryVersion();
+    m_bakedBVHNodes.clear();
+    m_bakedBVHTriangleIndices.clear();
+    m_collisionPositions.clear();
+    m_collisionIndices.clear();
+    m_lods.clear();
 }
 
 void Mesh::Upload() {
-    if (m_uploaded || m_vertices.empty()) {
-        Logger::Debug("Mesh upload skipped - uploaded: " + std::to_string(m_uploaded) + ", vertices empty: " + std::to_string(m_vertices.empty()));
+    const size_t vertexCount = GetVertexCount();
+    if (m_uploaded || vertexCount == 0) {
+        Logger::Debug("Mesh upload skipped - uploaded: " + std::to_string(m_uploaded) + ", vertices empty: " + std::to_string(vertexCount == 0));
         return;
     }
     
-    Logger::Debug("Starting mesh upload with " + std::to_string(m_vertices.size()) + " vertices");
-    Logger::Debug("First vertex - pos: (" + std::to_string(m_vertices[0].position.x) + ", " + std::to_string(m_vertices[0].position.y) + ", " + std::to_string(m_vertices[0].position.z) + ")");
-    Logger::Debug("First vertex - color: (" + std::to_string(m_vertices[0].color.x) + ", " + std::to_string(m_vertices[0].color.y) + ", " + std::to_string(m_vertices[0].color.z) + ")");
+    Logger::Debug("Starting mesh upload with " + std::to_string(vertexCount) + " vertices");
     
     m_vertexArray = std::make_unique<VertexArray>();
     m_vertexBuffer = std::make_unique<Buffer>(BufferType::Vertex);
     
-    m_vertexBuffer->SetData(m_vertices.data(), m_vertices.size() * sizeof(Vertex));
-    
-    m_vertexArray->Bind();
-    m_vertexBuffer->Bind();
-    for (GLuint i = 3; i < 8; ++i) { glDisableVertexAttribArray(i); }
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(sizeof(Vertex)), (void*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(sizeof(Vertex)), (void*)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(sizeof(Vertex)), (void*)offsetof(Vertex, color));
+    if (!m_packedVertices.empty() && m_packedFormat == m_vertexFormat) {
+        m_vertexBuffer->SetData(m_packedVertices.data(), m_packedVertices.size());
+    } else if (m_vertexFormat == VertexFormat::Float) {
+        const std::vector<Vertex>& vertices = GetVertices();
+        m_vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
+    } else {
+        std::vector<uint8_t> packed = VertexPacking::Pack(GetVertices(), m_vertexFormat, m_boundsMin, m_boundsMax);
+        m_vertexBuffer->SetData(packed.data(), packed.size());
+    }
+    m_vertexArray->AddVertexBuffer(*m_vertexBuffer, VertexPacking::GetAttributes(m_vertexFormat), VertexPacking::GetStride(m_vertexFormat));
     
     if (!m_indices.empty()) {
         m_indexBuffer = std::make_unique<Buffer>(BufferType::Index);
@@ -79,6 +176,7 @@ void Mesh::Draw() const {
     Logger::Debug("Mesh::Draw() - Starting draw call");
 
     Bind();
+    ApplyVertexDecode();
  
     GLenum error = glGetError();
     if (error != GL_NO_ERROR) {
@@ -119,7 +217,7 @@ void Mesh::Draw() const {
         if (error != GL_NO_ERROR) {
             Logger::Error("OpenGL error after glDrawElements: " + std::to_string(error));
             Logger::Warning("Falling back to glDrawArrays due to glDrawElements failure");
-            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(GetVertexCount()));
             GLenum error2 = glGetError();
             if (error2 != GL_NO_ERROR) {
                 Logger::Error("OpenGL error after fallback glDrawArrays: " + std::to_string(error2));
@@ -129,9 +227,9 @@ void Mesh::Draw() const {
         } else {
             Logger::Debug("glDrawElements completed successfully");
         }
-    } else if (!m_vertices.empty()) {
-        Logger::Debug("Drawing mesh with " + std::to_string(m_vertices.size()) + " vertices using glDrawArrays");
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+    } else if (GetVertexCount() > 0) {
+        Logger::Debug("Drawing mesh with " + std::to_string(GetVertexCount()) + " vertices using glDrawArrays");
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(GetVertexCount()));
         
         error = glGetError();
         if (error != GL_NO_ERROR) {
@@ -144,6 +242,53 @@ void Mesh::Draw() const {
     Logger::Debug("Mesh::Draw() - Draw call completed");
 }
 
+void Mesh::DrawInstanced(const Buffer& instanceBuffer, size_t byteOffset, unsigned int instanceCount,
+                         const Buffer* uvTransformBuffer, size_t uvTransformOffset) const {
+    if (!m_uploaded) {
+        const_cast<Mesh*>(this)->Upload();
+    }
+    if (!m_uploaded || !m_vertexArray || instanceCount == 0) {
+        return;
+    }
+
+    glBindVertexArray(m_vertexArray->GetID());
+    ApplyVertexDecode();
+    instanceBuffer.Bind();
+    const GLsizei stride = static_cast<GLsizei>(16 * sizeof(float));
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint attribute = InstanceMatrixAttribute + column;
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<const void*>(byteOffset + column * 4 * sizeof(float)));
+        glVertexAttribDivisor(attribute, 1);
+    }
+    if (uvTransformBuffer) {
+        uvTransformBuffer->Bind();
+        glEnableVertexAttribArray(InstanceUVTransformAttribute);
+        glVertexAttribPointer(InstanceUVTransformAttribute, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(4 * sizeof(float)),
+                              reinterpret_cast<const void*>(uvTransformOffset));
+        glVertexAttribDivisor(InstanceUVTransformAttribute, 1);
+    } else {
+        glDisableVertexAttribArray(InstanceUVTransformAttribute);
+        glVertexAttrib4f(InstanceUVTransformAttribute, 1.0f, 1.0f, 0.0f, 0.0f);
+    }
+
+    if (m_indexBuffer && !m_indices.empty()) {
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, nullptr,
+                                static_cast<GLsizei>(instanceCount));
+    } else {
+        glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(GetVertexCount()), static_cast<GLsizei>(instanceCount));
+    }
+}
+
+void Mesh::ApplyVertexDecode() const {
+    // Current generic attribute values are context state, so they are set for every draw
+    float scale[4], offset[4];
+    VertexPacking::GetDecodeConstants(m_vertexFormat, m_boundsMin, m_boundsMax, scale, offset);
+    glVertexAttrib4fv(VertexPacking::DecodeScaleAttribute, scale);
+    glVertexAttrib4fv(VertexPacking::DecodeOffsetAttribute, offset);
+}
+
 void Mesh::Unbind() const {
     if (m_vertexArray) {
         m_vertexArray->Unbind();
@@ -246,25 +391,15 @@ Mesh Mesh::LoadFromOBJ(const std::string& filepath) {
 }
 
 void Mesh::GetBoundingBox(Vector3& min, Vector3& max) const {
-    if (m_vertices.empty()) {
-        min = max = Vector3::Zero;
-        return;
-    }
-    
-    min = max = m_vertices[0].position;
-    
-    for (const auto& vertex : m_vertices) {
-        min.x = std::min(min.x, vertex.position.x);
-        min.y = std::min(min.y, vertex.position.y);
-        min.z = std::min(min.z, vertex.position.z);
-        
-        max.x = std::max(max.x, vertex.position.x);
-        max.y = std::max(max.y, vertex.position.y);
-        max.z = std::max(max.z, vertex.position.z);
-    }
+    min = m_boundsMin;
+    max = m_boundsMax;
 }
 
 void Mesh::GetVertexPositions(std::vector<Vector3>& positions) const {
+    if (!m_packedVertices.empty()) {
+        positions = VertexPacking::UnpackPositions(m_packedVertices.data(), GetVertexCount(), m_packedFormat, m_boundsMin, m_boundsMax);
+        return;
+    }
     positions.clear();
     positions.reserve(m_vertices.size());
     
@@ -274,28 +409,32 @@ void Mesh::GetVertexPositions(std::vector<Vector3>& positions) const {
 }
 
 Vector3 Mesh::GetCenterOfMass() const {
-    if (m_vertices.empty()) {
+    std::vector<Vector3> positions;
+    GetVertexPositions(positions);
+    if (positions.empty()) {
         return Vector3::Zero;
     }
     
     Vector3 center = Vector3::Zero;
-    for (const auto& vertex : m_vertices) {
-        center = center + vertex.position;
+    for (const auto& position : positions) {
+        center = center + position;
     }
     
-    return center / static_cast<float>(m_vertices.size());
+    return center / static_cast<float>(positions.size());
 }
 
 float Mesh::GetBoundingSphereRadius() const {
-    if (m_vertices.empty()) {
+    std::vector<Vector3> positions;
+    GetVertexPositions(positions);
+    if (positions.empty()) {
         return 0.0f;
     }
     
     Vector3 center = GetCenterOfMass();
     float maxDistanceSquared = 0.0f;
     
-    for (const auto& vertex : m_vertices) {
-        Vector3 diff = vertex.position - center;
+    for (const auto& position : positions) {
+        Vector3 diff = position - center;
         float distanceSquared = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
         maxDistanceSquared = std::max(maxDistanceSquared, distanceSquared);
     }
@@ -2,22 +2,25 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <algorithm>
 #include "../../Core/Math/Vector3.h"
 #include "../Core/Buffer.h"
+#include "../Raytracing/TriangleBVH.h"
+#include "VertexFormat.h"
 
 namespace GameEngine {
-    struct Vertex {
-        Vector3 position;
-        Vector3 normal;
-        Vector3 color; // Using Vector3 for RGB color data
-        Vector3 texCoords; // UV texture coordinates (using Vector3 for consistency, z component unused)
-        
-        Vertex() = default;
-        Vertex(const Vector3& pos, const Vector3& norm = Vector3::Up, const Vector3& col = Vector3::Zero, const Vector3& tex = Vector3::Zero)
-            : position(pos), normal(norm), color(col), texCoords(tex) {}
+    class Mesh;
+
+    // A coarser version of a mesh, used once its projected bounding sphere diameter falls below
+    // screenSize (a fraction of the screen height)
+    struct MeshLOD {
+        std::shared_ptr<Mesh> mesh;
+        float screenSize = 0.0f;
+        float error = 0.0f;                 // Maximum quadric error per collapse (MeshSimplifier::Simplify)
     };
-    
+
     class Mesh {
     public:
         Mesh();
@@ -31,25 +34,70 @@ namespace GameEngine {
         Mesh(Mesh&&) = default;
         Mesh& operator=(Mesh&&) = default;
         
+        // Setting geometry drops any baked BVH, collision data and LODs, which would be stale
         void SetVertices(const std::vector<Vertex>& vertices);
         void SetIndices(const std::vector<unsigned int>& indices);
+        // Takes ownership of vertex data whose bounds are already known, e.g. from a cooked file
+        void SetVertices(std::vector<Vertex>&& vertices, const Vector3& boundsMin, const Vector3& boundsMax);
+        void SetIndices(std::vector<unsigned int>&& indices);
+        // Takes ownership of a vertex stream already packed in format, e.g. mapped from a cooked
+        // file; Upload() sends it as is and the float copy is only decoded if GetVertices() is called
+        void SetPackedVertices(std::vector<uint8_t>&& packed, VertexFormat format, const Vector3& boundsMin, const Vector3& boundsMax);
+        
+        // GPU vertex layout; the CPU copy stays float. Takes effect at the next upload.
+        void SetVertexFormat(VertexFormat format);     // Applies to the LODs as well
+        VertexFormat GetVertexFormat() const { return m_vertexFormat; }
         
         void Upload();
         void Bind() const;
         void Unbind() const;
         void Draw() const;
+        // Draws instanceCount copies reading mat4 model matrices from instanceBuffer at byteOffset
+        // through attributes InstanceMatrixAttribute..+3; lean path without per-draw GL queries.
+        // uvTransformBuffer optionally holds a vec4 UV scale/offset per instance for
+        // InstanceUVTransformAttribute; without it every instance reads (1, 1, 0, 0).
+        void DrawInstanced(const Buffer& instanceBuffer, size_t byteOffset, unsigned int instanceCount,
+                           const Buffer* uvTransformBuffer = nullptr, size_t uvTransformOffset = 0) const;
+        static constexpr unsigned int InstanceMatrixAttribute = 3;
+        static constexpr unsigned int InstanceUVTransformAttribute = 10;
         unsigned int GetIndexCount() const;
         bool IsUploaded() const { return m_uploaded; }
+        // Bytes Upload() transfers: vertices in the GPU format plus indices, LODs excluded
+        size_t GetGPUByteSize() const { return GetVertexCount() * VertexPacking::GetStride(m_vertexFormat) + m_indices.size() * sizeof(unsigned int); }
         
-        const std::vector<Vertex>& GetVertices() const { return m_vertices; }
+        // Decodes a packed stream on first use and keeps the float copy; safe to call from
+        // several threads. Callers that only need positions should use GetVertexPositions().
+        const std::vector<Vertex>& GetVertices() const;
+        size_t GetVertexCount() const;
         const std::vector<unsigned int>& GetIndices() const { return m_indices; }
+        // Changes whenever vertices or indices are set. Values come from a counter shared by all
+        // meshes, so caches keyed by mesh address can tell a new mesh from a freed one.
+        uint64_t GetGeometryVersion() const { return m_geometryVersion; }
         
-        // Collision generation helpers
+        // Collision generation helpers; the bounding box is cached when vertices are set.
+        // Positions of a packed stream are decoded into the caller's vector without keeping
+        // a float copy of the mesh.
         void GetBoundingBox(Vector3& min, Vector3& max) const;
         void GetVertexPositions(std::vector<Vector3>& positions) const;
         Vector3 GetCenterOfMass() const;
         float GetBoundingSphereRadius() const;
         
+        // Optional data baked offline by the mesh cooker. The BVH is a binary BVH over the index
+        // buffer's triangles that the raytracer adopts instead of building its own; the collision
+        // mesh is the triangle list welded by position only, for convex hull and mesh colliders.
+        void SetBakedBVH(std::vector<BVHNode> nodes, std::vector<int> triangleIndices);
+        const std::vector<BVHNode>& GetBakedBVHNodes() const { return m_bakedBVHNodes; }
+        const std::vector<int>& GetBakedBVHTriangleIndices() const { return m_bakedBVHTriangleIndices; }
+        void SetCollisionMesh(std::vector<Vector3> positions, std::vector<unsigned int> indices);
+        const std::vector<Vector3>& GetCollisionPositions() const { return m_collisionPositions; }
+        const std::vector<unsigned int>& GetCollisionIndices() const { return m_collisionIndices; }
+        
+        // LOD chain, finest first with decreasing screen sizes; level 0 is this mesh
+        void SetLODs(std::vector<MeshLOD> lods);
+        const std::vector<MeshLOD>& GetLODs() const { return m_lods; }
+        size_t GetLODCount() const { return m_lods.size() + 1; }
+        Mesh* GetLOD(size_t level) { return level == 0 || m_lods.empty() ? this : m_lods[std::min(level, m_lods.size()) - 1].mesh.get(); }
+        
         // Static mesh creation helpers
         static Mesh CreateCube(float size = 1.0f);
         static Mesh CreateSphere(float radius = 1.0f, int segments = 32);
@@ -59,10 +107,33 @@ namespace GameEngine {
         static Mesh LoadFromOBJ(const std::string& filepath);
         
     private:
+        static uint64_t NextGeometryVersion();
         void CleanupBuffers();
+        void ClearBakedData();
+        // Sets the constant attributes VertexPacking's shader declarations decode with
+        void ApplyVertexDecode() const;
+        
+        // Float copy of a packed stream, decoded once by the first GetVertices()
+        struct DecodedVertices {
+            std::once_flag once;
+            std::vector<Vertex> vertices;
+        };
         
         std::vector<Vertex> m_vertices;
+        std::vector<uint8_t> m_packedVertices;     // Set by SetPackedVertices, empty otherwise
+        std::unique_ptr<DecodedVertices> m_decodedVertices;
+        VertexFormat m_packedFormat = VertexFormat::Float;
         std::vector<unsigned int> m_indices;
+        Vector3 m_boundsMin = Vector3::Zero;
+        Vector3 m_boundsMax = Vector3::Zero;
+        VertexFormat m_vertexFormat = VertexFormat::Float;
+        uint64_t m_geometryVersion = NextGeometryVersion();
+        
+        std::vector<BVHNode> m_bakedBVHNodes;
+        std::vector<int> m_bakedBVHTriangleIndices;
+        std::vector<Vector3> m_collisionPositions;
+        std::vector<unsigned int> m_collisionIndices;
+        std::vector<MeshLOD> m_lods;
         
         std::unique_ptr<VertexArray> m_vertexArray;
         std::unique_ptr<Buffer> m_vertexBuffer;
@@ -0,0 +1,267 @@
+#include "MeshOptimizer.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+static_assert(sizeof(Vertex) == 12 * sizeof(float), "Vertex welding hashes Vertex as 12 packed floats");
+
+constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+// Forsyth's published tuning
+constexpr float CacheDecayPower = 1.5f;
+constexpr float LastTriangleScore = 0.75f;
+constexpr float ValenceBoostScale = 2.0f;
+constexpr float ValenceBoostPower = 0.5f;
+constexpr int MaxValenceTable = 32;
+
+uint32_t HashVertex(const Vertex& vertex) {
+    uint32_t words[12];
+    std::memcpy(words, &vertex, sizeof(words));
+    uint32_t hash = 2166136261u;
+    for (uint32_t word : words) {
+        hash = (hash ^ word) * 16777619u;
+        hash ^= hash >> 15;
+    }
+    return hash;
+}
+
+// Folds -0 into +0 so both spellings of a zero weld together
+void CanonicalizeZeros(Vertex& vertex) {
+    float* values = reinterpret_cast<float*>(&vertex);
+    for (int i = 0; i < 12; ++i) {
+        values[i] += 0.0f;
+    }
+}
+
+}
+
+void MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    PROFILE_SCOPE("MeshOptimizer::Optimize");
+    WeldVertices(vertices, indices);
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeVertexFetch(vertices, indices);
+}
+
+void MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    if (vertices.empty()) {
+        return;
+    }
+
+    // Open addressing over indices of already-kept vertices, at most half full
+    size_t tableSize = 1;
+    while (tableSize < vertices.size() * 2) {
+        tableSize <<= 1;
+    }
+    std::vector<uint32_t> table(tableSize, InvalidIndex);
+    std::vector<uint32_t> remap(vertices.size());
+    size_t kept = 0;
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        Vertex vertex = vertices[i];
+        CanonicalizeZeros(vertex);
+        size_t slot = HashVertex(vertex) & (tableSize - 1);
+        while (table[slot] != InvalidIndex && std::memcmp(&vertices[table[slot]], &vertex, sizeof(Vertex)) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == InvalidIndex) {
+            // Compacting in place is safe: kept <= i, and the kept slots are never read as input again
+            vertices[kept] = vertex;
+            table[slot] = static_cast<uint32_t>(kept++);
+        }
+        remap[i] = table[slot];
+    }
+    vertices.resize(kept);
+
+    for (unsigned int& index : indices) {
+        index = remap[index];
+    }
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0) {
+        return;
+    }
+
+    float cacheScores[VertexCacheSize];
+    for (int i = 0; i < VertexCacheSize; ++i) {
+        if (i < 3) {
+            cacheScores[i] = LastTriangleScore;
+        } else {
+            float scaler = 1.0f / static_cast<float>(VertexCacheSize - 3);
+            cacheScores[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, CacheDecayPower);
+        }
+    }
+    float valenceScores[MaxValenceTable];
+    for (int i = 1; i < MaxValenceTable; ++i) {
+        valenceScores[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+    }
+    valenceScores[0] = 0.0f;
+
+    auto vertexScore = [&](int cachePosition, uint32_t remaining) {
+        if (remaining == 0) {
+            return -1.0f;
+        }
+        float score = cachePosition >= 0 && cachePosition < VertexCacheSize ? cacheScores[cachePosition] : 0.0f;
+        score += remaining < MaxValenceTable ? valenceScores[remaining]
+                                             : ValenceBoostScale * std::pow(static_cast<float>(remaining), -ValenceBoostPower);
+        return score;
+    };
+
+    // Vertex -> triangle adjacency; the first remaining[v] entries of each range are not yet emitted
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (unsigned int index : indices) {
+        ++remaining[index];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> scores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        scores[v] = vertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = scores[indices[t * 3]] + scores[indices[t * 3 + 1]] + scores[indices[t * 3 + 2]];
+    }
+
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    // Three extra entries hold vertices pushed out by the triangle being added
+    uint32_t cache[VertexCacheSize + 3];
+    int cacheCount = 0;
+    uint32_t newCache[VertexCacheSize + 3];
+
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t) {
+        if (triangleScores[t] > triangleScores[best]) {
+            best = t;
+        }
+    }
+    size_t scanCursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        emitted[best] = 1;
+        const unsigned int* triangle = &indices[best * 3];
+        output.insert(output.end(), triangle, triangle + 3);
+
+        // Drop the triangle from its vertices' remaining lists
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = triangle[k];
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+            std::swap(*it, end[-1]);
+            --remaining[v];
+        }
+
+        // Move the triangle's vertices to the front of the LRU cache
+        int newCount = 0;
+        for (int k = 0; k < 3; ++k) {
+            newCache[newCount++] = triangle[k];
+        }
+        for (int i = 0; i < cacheCount; ++i) {
+            uint32_t v = cache[i];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                newCache[newCount++] = v;
+            }
+        }
+        for (int i = VertexCacheSize; i < newCount; ++i) {
+            cachePosition[newCache[i]] = -1;
+        }
+        cacheCount = std::min(newCount, VertexCacheSize);
+        std::copy(newCache, newCache + newCount, cache);
+
+        // Rescore vertices whose cache position or valence changed and propagate to triangles
+        for (int i = 0; i < newCount; ++i) {
+            uint32_t v = cache[i];
+            if (i < VertexCacheSize) {
+                cachePosition[v] = i;
+            }
+            float score = vertexScore(cachePosition[v], remaining[v]);
+            float delta = score - scores[v];
+            scores[v] = score;
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                triangleScores[adjacency[a]] += delta;
+            }
+        }
+
+        // Next triangle: the best one touching the cache, else the best anywhere
+        float bestScore = -1.0f;
+        bool found = false;
+        for (int i = 0; i < cacheCount; ++i) {
+            uint32_t v = cache[i];
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                uint32_t t = adjacency[a];
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    best = t;
+                    found = true;
+                }
+            }
+        }
+        if (!found) {
+            // Disconnected piece: continue from the next unemitted triangle in input order
+            while (scanCursor < triangleCount && emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            if (scanCursor == triangleCount) {
+                break;
+            }
+            best = scanCursor;
+        }
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (unsigned int& index : indices) {
+        if (remap[index] == InvalidIndex) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+float MeshOptimizer::ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    // A vertex is cached while fewer than cacheSize misses happened since it was loaded
+    std::vector<uint64_t> loadedAt(vertexCount, 0);
+    uint64_t misses = 0;
+    for (unsigned int index : indices) {
+        if (loadedAt[index] == 0 || misses - loadedAt[index] >= static_cast<uint64_t>(cacheSize)) {
+            ++misses;
+            loadedAt[index] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Mesh.h"
+#include <vector>
+#include <cstddef>
+
+namespace GameEngine {
+    // Post-import stages for indexed triangle lists. All of them keep the rendered result
+    // identical; they only change how much data there is and the order the GPU reads it in.
+    class MeshOptimizer {
+    public:
+        static constexpr int VertexCacheSize = 32;
+
+        // Welds, reorders triangles for the post-transform cache, then vertices for fetch
+        static void Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // Merges bit-identical vertices (position, normal, color, uv) and remaps the indices
+        static void WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // Forsyth's linear-speed vertex cache optimization: greedily emits the triangle whose
+        // vertices score highest under a simulated LRU cache and low remaining valence
+        static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+        // Renumbers vertices in first-use order of the index buffer; unused vertices are dropped
+        static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // Average cache miss ratio (transformed vertices per triangle) under a FIFO cache
+        static float ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, int cacheSize = VertexCacheSize);
+    };
+}
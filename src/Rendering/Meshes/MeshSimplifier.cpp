@@ -0,0 +1,417 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr double BorderWeight = 10.0;       // Keeps open edges from shrinking inwards
+constexpr float MinFlipCosine = 0.25f;       // A collapse may not turn a face further than ~75 degrees
+
+// Symmetric 4x4 plane quadric plus the area it was accumulated from
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+    double weight = 0;
+
+    void AddPlane(double a, double b, double c, double d, double w) {
+        a2 += w * a * a; ab += w * a * b; ac += w * a * c; ad += w * a * d;
+        b2 += w * b * b; bc += w * b * c; bd += w * b * d;
+        c2 += w * c * c; cd += w * c * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    void Add(const Quadric& q) {
+        a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+        b2 += q.b2; bc += q.bc; bd += q.bd;
+        c2 += q.c2; cd += q.cd;
+        d2 += q.d2;
+        weight += q.weight;
+    }
+
+    // Weighted sum of squared distances from p to the planes
+    double Evaluate(const Vector3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x +
+               b2 * y * y + 2 * bc * y * z + 2 * bd * y +
+               c2 * z * z + 2 * cd * z + d2;
+    }
+};
+
+struct Collapse {
+    float cost;         // Mean squared distance
+    uint32_t from, to;
+    uint32_t fromVersion, toVersion;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+struct PositionHash {
+    size_t operator()(const Vector3& p) const {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+struct PositionEqual {
+    bool operator()(const Vector3& a, const Vector3& b) const {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+};
+
+float AttributeDistance(const Vertex& a, const Vertex& b) {
+    return (a.normal - b.normal).LengthSquared() + (a.color - b.color).LengthSquared() +
+           (a.texCoords - b.texCoords).LengthSquared();
+}
+
+class Simplifier {
+public:
+    Simplifier(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+        : m_vertices(vertices), m_corners(indices) {}
+
+    float Run(size_t targetIndexCount, float maxError) {
+        WeldPositions();
+        BuildQuadrics();
+
+        const double maxCost = static_cast<double>(maxError) * maxError;
+        size_t liveTriangles = m_corners.size() / 3;
+        double reachedCost = 0.0;
+        while (liveTriangles * 3 > targetIndexCount && !m_queue.empty()) {
+            Collapse collapse = m_queue.top();
+            m_queue.pop();
+            if (!m_alive[collapse.from] || !m_alive[collapse.to] ||
+                m_version[collapse.from] != collapse.fromVersion || m_version[collapse.to] != collapse.toVersion) {
+                continue;
+            }
+            if (collapse.cost > maxCost) {
+                break;
+            }
+            if (!IsCollapseValid(collapse.from, collapse.to)) {
+                continue;
+            }
+            liveTriangles -= ApplyCollapse(collapse.from, collapse.to);
+            reachedCost = std::max(reachedCost, static_cast<double>(collapse.cost));
+        }
+
+        std::vector<unsigned int> result;
+        result.reserve(liveTriangles * 3);
+        for (size_t t = 0; t < m_triangleAlive.size(); ++t) {
+            if (m_triangleAlive[t]) {
+                result.insert(result.end(), m_corners.begin() + t * 3, m_corners.begin() + t * 3 + 3);
+            }
+        }
+        m_corners.swap(result);
+        return static_cast<float>(std::sqrt(reachedCost));
+    }
+
+private:
+    void WeldPositions() {
+        std::unordered_map<Vector3, uint32_t, PositionHash, PositionEqual> lookup;
+        lookup.reserve(m_vertices.size());
+        m_positionOf.resize(m_vertices.size());
+        for (size_t i = 0; i < m_vertices.size(); ++i) {
+            auto [it, inserted] = lookup.emplace(m_vertices[i].position, static_cast<uint32_t>(m_positions.size()));
+            if (inserted) {
+                m_positions.push_back(m_vertices[i].position);
+            }
+            m_positionOf[i] = it->second;
+        }
+
+        // Vertices sharing each position, as offsets into one array
+        size_t positionCount = m_positions.size();
+        m_vertexStart.assign(positionCount + 1, 0);
+        for (uint32_t position : m_positionOf) {
+            ++m_vertexStart[position + 1];
+        }
+        for (size_t p = 0; p < positionCount; ++p) {
+            m_vertexStart[p + 1] += m_vertexStart[p];
+        }
+        m_vertexList.resize(m_vertices.size());
+        std::vector<uint32_t> fill(m_vertexStart.begin(), m_vertexStart.end() - 1);
+        for (size_t i = 0; i < m_vertices.size(); ++i) {
+            m_vertexList[fill[m_positionOf[i]]++] = static_cast<uint32_t>(i);
+        }
+
+        m_alive.assign(positionCount, 1);
+        m_version.assign(positionCount, 0);
+        m_triangles.assign(positionCount, {});
+        m_triangleAlive.assign(m_corners.size() / 3, 1);
+        for (size_t t = 0; t < m_triangleAlive.size(); ++t) {
+            const uint32_t* corners = &m_corners[t * 3];
+            uint32_t a = m_positionOf[corners[0]], b = m_positionOf[corners[1]], c = m_positionOf[corners[2]];
+            if (a == b || b == c || a == c) {
+                m_triangleAlive[t] = 0;     // Already degenerate
+                continue;
+            }
+            m_triangles[a].push_back(static_cast<uint32_t>(t));
+            m_triangles[b].push_back(static_cast<uint32_t>(t));
+            m_triangles[c].push_back(static_cast<uint32_t>(t));
+        }
+    }
+
+    void BuildQuadrics() {
+        m_quadrics.assign(m_positions.size(), Quadric());
+        std::unordered_map<uint64_t, int> edgeUse;
+        edgeUse.reserve(m_corners.size());
+        auto edgeKey = [](uint32_t a, uint32_t b) {
+            return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+        };
+
+        for (size_t t = 0; t < m_triangleAlive.size(); ++t) {
+            if (!m_triangleAlive[t]) {
+                continue;
+            }
+            uint32_t p[3] = {Position(t, 0), Position(t, 1), Position(t, 2)};
+            Vector3 normal = (m_positions[p[1]] - m_positions[p[0]]).Cross(m_positions[p[2]] - m_positions[p[0]]);
+            float length = normal.Length();
+            if (length > 0.0f) {
+                Vector3 n = normal / length;
+                double area = 0.5 * length;
+                double d = -n.Dot(m_positions[p[0]]);
+                for (uint32_t position : p) {
+                    m_quadrics[position].AddPlane(n.x, n.y, n.z, d, area);
+                }
+            }
+            for (int k = 0; k < 3; ++k) {
+                ++edgeUse[edgeKey(p[k], p[(k + 1) % 3])];
+            }
+        }
+
+        // Border edges get a plane through the edge, perpendicular to the face
+        for (size_t t = 0; t < m_triangleAlive.size(); ++t) {
+            if (!m_triangleAlive[t]) {
+                continue;
+            }
+            uint32_t p[3] = {Position(t, 0), Position(t, 1), Position(t, 2)};
+            Vector3 normal = (m_positions[p[1]] - m_positions[p[0]]).Cross(m_positions[p[2]] - m_positions[p[0]]);
+            for (int k = 0; k < 3; ++k) {
+                uint32_t a = p[k], b = p[(k + 1) % 3];
+                if (edgeUse[edgeKey(a, b)] != 1) {
+                    continue;
+                }
+                Vector3 edge = m_positions[b] - m_positions[a];
+                Vector3 perpendicular = edge.Cross(normal);
+                float length = perpendicular.Length();
+                if (length <= 0.0f) {
+                    continue;
+                }
+                Vector3 n = perpendicular / length;
+                double d = -n.Dot(m_positions[a]);
+                double weight = BorderWeight * edge.LengthSquared();
+                m_quadrics[a].AddPlane(n.x, n.y, n.z, d, weight);
+                m_quadrics[b].AddPlane(n.x, n.y, n.z, d, weight);
+            }
+        }
+
+        for (const auto& [key, uses] : edgeUse) {
+            PushCandidate(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFFu));
+        }
+    }
+
+    uint32_t Position(size_t triangle, int corner) const {
+        return m_positionOf[m_corners[triangle * 3 + corner]];
+    }
+
+    void PushCandidate(uint32_t a, uint32_t b) {
+        Quadric q = m_quadrics[a];
+        q.Add(m_quadrics[b]);
+        double weight = std::max(q.weight, 1e-20);
+        double costAB = std::max(0.0, q.Evaluate(m_positions[b])) / weight;     // a merged into b
+        double costBA = std::max(0.0, q.Evaluate(m_positions[a])) / weight;
+        if (costAB <= costBA) {
+            m_queue.push({static_cast<float>(costAB), a, b, m_version[a], m_version[b]});
+        } else {
+            m_queue.push({static_cast<float>(costBA), b, a, m_version[b], m_version[a]});
+        }
+    }
+
+    bool IsCollapseValid(uint32_t from, uint32_t to) const {
+        for (uint32_t t : m_triangles[from]) {
+            if (!m_triangleAlive[t]) {
+                continue;
+            }
+            uint32_t p[3] = {Position(t, 0), Position(t, 1), Position(t, 2)};
+            if (p[0] == to || p[1] == to || p[2] == to) {
+                continue;       // Removed by the collapse
+            }
+            Vector3 before = (m_positions[p[1]] - m_positions[p[0]]).Cross(m_positions[p[2]] - m_positions[p[0]]);
+            for (uint32_t& position : p) {
+                if (position == from) {
+                    position = to;
+                }
+            }
+            Vector3 after = (m_positions[p[1]] - m_positions[p[0]]).Cross(m_positions[p[2]] - m_positions[p[0]]);
+            float scale = before.Length() * after.Length();
+            if (scale <= 0.0f || before.Dot(after) < MinFlipCosine * scale) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the number of triangles removed
+    size_t ApplyCollapse(uint32_t from, uint32_t to) {
+        size_t removed = 0;
+        for (uint32_t t : m_triangles[from]) {
+            if (!m_triangleAlive[t]) {
+                continue;
+            }
+            uint32_t* corners = &m_corners[t * 3];
+            if (m_positionOf[corners[0]] == to || m_positionOf[corners[1]] == to || m_positionOf[corners[2]] == to) {
+                m_triangleAlive[t] = 0;
+                ++removed;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                if (m_positionOf[corners[k]] == from) {
+                    corners[k] = ClosestVertexAt(to, m_vertices[corners[k]]);
+                }
+            }
+            m_triangles[to].push_back(t);
+        }
+        m_triangles[from].clear();
+        m_triangles[from].shrink_to_fit();
+        m_quadrics[to].Add(m_quadrics[from]);
+        m_alive[from] = 0;
+        ++m_version[from];
+        ++m_version[to];
+
+        // Drop dead triangles from the survivor and requeue its edges
+        auto& triangles = m_triangles[to];
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                       [this](uint32_t t) { return !m_triangleAlive[t]; }), triangles.end());
+        m_neighbours.clear();
+        for (uint32_t t : triangles) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t position = Position(t, k);
+                if (position != to) {
+                    m_neighbours.push_back(position);
+                }
+            }
+        }
+        std::sort(m_neighbours.begin(), m_neighbours.end());
+        m_neighbours.erase(std::unique(m_neighbours.begin(), m_neighbours.end()), m_neighbours.end());
+        for (uint32_t neighbour : m_neighbours) {
+            PushCandidate(to, neighbour);
+        }
+        return removed;
+    }
+
+    uint32_t ClosestVertexAt(uint32_t position, const Vertex& like) const {
+        uint32_t best = m_vertexList[m_vertexStart[position]];
+        float bestDistance = std::numeric_limits<float>::max();
+        for (uint32_t i = m_vertexStart[position]; i < m_vertexStart[position + 1]; ++i) {
+            float distance = AttributeDistance(m_vertices[m_vertexList[i]], like);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = m_vertexList[i];
+            }
+        }
+        return best;
+    }
+
+    const std::vector<Vertex>& m_vertices;
+    std::vector<unsigned int>& m_corners;
+
+    std::vector<Vector3> m_positions;
+    std::vector<uint32_t> m_positionOf;         // Vertex -> welded position
+    std::vector<uint32_t> m_vertexStart;        // Position -> range in m_vertexList
+    std::vector<uint32_t> m_vertexList;
+    std::vector<uint8_t> m_alive;
+    std::vector<uint32_t> m_version;
+    std::vector<Quadric> m_quadrics;
+    std::vector<std::vector<uint32_t>> m_triangles;     // Position -> incident triangles
+    std::vector<uint8_t> m_triangleAlive;
+    std::vector<uint32_t> m_neighbours;
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> m_queue;
+};
+
+}
+
+float MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                               size_t targetIndexCount, float maxError) {
+    PROFILE_SCOPE("MeshSimplifier::Simplify");
+    if (indices.size() <= targetIndexCount || indices.size() % 3 != 0) {
+        return 0.0f;
+    }
+    Simplifier simplifier(vertices, indices);
+    return simplifier.Run(targetIndexCount, maxError);
+}
+
+std::vector<MeshSimplifier::LODLevel> MeshSimplifier::BuildLODChain(const std::vector<Vertex>& vertices,
+                                                                    const std::vector<unsigned int>& indices,
+                                                                    const LODSettings& settings) {
+    std::vector<LODLevel> levels;
+    if (vertices.empty() || indices.empty()) {
+        return levels;
+    }
+
+    Vector3 boundsMin = vertices[0].position, boundsMax = vertices[0].position;
+    for (const Vertex& vertex : vertices) {
+        boundsMin = Vector3::Min(boundsMin, vertex.position);
+        boundsMax = Vector3::Max(boundsMax, vertex.position);
+    }
+    const float radius = (boundsMax - boundsMin).Length() * 0.5f;
+    if (radius <= 0.0f) {
+        return levels;
+    }
+
+    size_t previousCount = indices.size();
+    float previousScreenSize = std::numeric_limits<float>::max();
+    for (int level = 1; level <= settings.maxLevels; ++level) {
+        size_t target = static_cast<size_t>(static_cast<float>(previousCount / 3) * settings.reduction) * 3;
+        if (target < settings.minTriangles * 3) {
+            break;
+        }
+        // Each level starts from the full mesh so its error is measured against the original
+        LODLevel lod;
+        lod.indices = indices;
+        lod.error = Simplify(vertices, lod.indices, target, settings.maxRelativeError * radius);
+        if (lod.indices.empty() || lod.indices.size() * 10 > previousCount * 9) {
+            break;      // Blocked by the error bound or the topology
+        }
+
+        // Projected error = error / (2 * radius) * screen size; keep it under screenError
+        float screenSize = lod.error > 0.0f ? 2.0f * radius * settings.screenError / lod.error : previousScreenSize;
+        lod.screenSize = std::min(screenSize, previousScreenSize);
+
+        lod.vertices = vertices;
+        MeshOptimizer::OptimizeVertexCache(lod.indices, lod.vertices.size());
+        MeshOptimizer::OptimizeVertexFetch(lod.vertices, lod.indices);
+
+        previousCount = lod.indices.size();
+        previousScreenSize = lod.screenSize;
+        levels.push_back(std::move(lod));
+    }
+    return levels;
+}
+
+size_t MeshSimplifier::GenerateLODs(Mesh& mesh, const LODSettings& settings) {
+    PROFILE_SCOPE("MeshSimplifier::GenerateLODs");
+    std::vector<LODLevel> levels = BuildLODChain(mesh.GetVertices(), mesh.GetIndices(), settings);
+    Vector3 boundsMin, boundsMax;
+    mesh.GetBoundingBox(boundsMin, boundsMax);
+
+    std::vector<MeshLOD> lods;
+    for (LODLevel& level : levels) {
+        // LODs keep the full mesh's bounds so culling and quantized positions agree across levels
+        auto lodMesh = std::make_shared<Mesh>();
+        lodMesh->SetVertices(std::move(level.vertices), boundsMin, boundsMax);
+        lodMesh->SetIndices(std::move(level.indices));
+        lods.push_back({lodMesh, level.screenSize, level.error});
+    }
+    size_t count = lods.size();
+    mesh.SetLODs(std::move(lods));
+    return count;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Mesh.h"
+#include <vector>
+#include <cstddef>
+
+namespace GameEngine {
+    // Quadric error metric simplification (Garland-Heckbert) with half-edge collapses: a vertex
+    // is merged into a neighbour, so no new vertices are created and every simplified mesh uses
+    // a subset of the source vertices. Corners whose vertex moves pick the neighbour's vertex with
+    // the closest normal, color and uv, which keeps hard edges and uv seams mostly intact.
+    class MeshSimplifier {
+    public:
+        struct LODSettings {
+            int maxLevels = 3;
+            float reduction = 0.5f;             // Triangle ratio between consecutive levels
+            size_t minTriangles = 64;           // No level goes below this
+            float maxRelativeError = 0.05f;     // Error bound as a fraction of the mesh radius
+            // Allowed error as a fraction of screen height (about one pixel at 1080p); sets the
+            // projected size below which each level is used
+            float screenError = 1.0f / 1080.0f;
+        };
+
+        struct LODLevel {
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            float screenSize = 0.0f;
+            float error = 0.0f;                 // Maximum quadric error per collapse, see Simplify
+        };
+
+        // Collapses edges until at most targetIndexCount indices remain or the next collapse
+        // would cost more than maxError. A collapse costs the area-weighted RMS distance from the
+        // kept vertex to the source planes merged into it. Returns the maximum quadric error per
+        // collapse: the largest cost of any collapse made, not an RMS over the whole surface.
+        static float Simplify(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                              size_t targetIndexCount, float maxError);
+
+        // Coarser levels of the given mesh, each optimized and compacted to its own vertices;
+        // stops early once a level no longer reduces or exceeds the error bound
+        static std::vector<LODLevel> BuildLODChain(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                                   const LODSettings& settings);
+
+        // Builds the chain and attaches it to the mesh; returns the number of levels added
+        static size_t GenerateLODs(Mesh& mesh, const LODSettings& settings);
+    };
+}
@@ -0,0 +1,297 @@
+#include "VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+uint8_t PackUnorm8(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+// Shared tail of PackedVertex and QuantizedVertex
+template<typename T>
+void PackAttributes(const Vertex& vertex, T& packed) {
+    VertexPacking::EncodeOctahedral(vertex.normal, packed.normal);
+    packed.color[0] = PackUnorm8(vertex.color.x);
+    packed.color[1] = PackUnorm8(vertex.color.y);
+    packed.color[2] = PackUnorm8(vertex.color.z);
+    packed.color[3] = 255;
+    packed.texCoords[0] = VertexPacking::FloatToHalf(vertex.texCoords.x);
+    packed.texCoords[1] = VertexPacking::FloatToHalf(vertex.texCoords.y);
+}
+
+template<typename T>
+void UnpackAttributes(const T& packed, Vertex& vertex) {
+    vertex.normal = VertexPacking::DecodeOctahedral(packed.normal);
+    vertex.color = Vector3(packed.color[0] / 255.0f, packed.color[1] / 255.0f, packed.color[2] / 255.0f);
+    vertex.texCoords = Vector3(VertexPacking::HalfToFloat(packed.texCoords[0]), VertexPacking::HalfToFloat(packed.texCoords[1]), 0.0f);
+}
+
+const char* ShaderDeclarations = R"(
+layout (location = 0) in vec3 aPos;                 // Object space, or unorm16 within the mesh bounds
+layout (location = 1) in vec3 aNormal;              // xyz, or octahedral xy when aDecodeScale.w != 0
+layout (location = 2) in vec3 aColor;
+layout (location = 7) in vec2 aTexCoord;
+layout (location = 8) in vec4 aDecodeScale;         // Constant per mesh
+layout (location = 9) in vec4 aDecodeOffset;        // Constant per mesh
+
+vec3 DecodePosition() {
+    return aDecodeOffset.xyz + aPos * aDecodeScale.xyz;
+}
+
+vec3 DecodeNormal() {
+    if (aDecodeScale.w == 0.0) {
+        return aNormal;
+    }
+    vec3 n = vec3(aNormal.xy, 1.0 - abs(aNormal.x) - abs(aNormal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+)";
+
+}
+
+size_t VertexPacking::GetStride(VertexFormat format) {
+    switch (format) {
+        case VertexFormat::Packed: return sizeof(PackedVertex);
+        case VertexFormat::PackedQuantized: return sizeof(QuantizedVertex);
+        case VertexFormat::Float: break;
+    }
+    return sizeof(Vertex);
+}
+
+std::vector<VertexAttribute> VertexPacking::GetAttributes(VertexFormat format) {
+    switch (format) {
+        case VertexFormat::Packed:
+            return {
+                {PositionAttribute, 3, VertexAttributeType::Float, false, offsetof(PackedVertex, position)},
+                {NormalAttribute, 2, VertexAttributeType::Short, true, offsetof(PackedVertex, normal)},
+                {ColorAttribute, 4, VertexAttributeType::UnsignedByte, true, offsetof(PackedVertex, color)},
+                {TexCoordAttribute, 2, VertexAttributeType::HalfFloat, false, offsetof(PackedVertex, texCoords)}
+            };
+        case VertexFormat::PackedQuantized:
+            return {
+                {PositionAttribute, 3, VertexAttributeType::UnsignedShort, true, offsetof(QuantizedVertex, position)},
+                {NormalAttribute, 2, VertexAttributeType::Short, true, offsetof(QuantizedVertex, normal)},
+                {ColorAttribute, 4, VertexAttributeType::UnsignedByte, true, offsetof(QuantizedVertex, color)},
+                {TexCoordAttribute, 2, VertexAttributeType::HalfFloat, false, offsetof(QuantizedVertex, texCoords)}
+            };
+        case VertexFormat::Float:
+            break;
+    }
+    return {
+        {PositionAttribute, 3, VertexAttributeType::Float, false, offsetof(Vertex, position)},
+        {NormalAttribute, 3, VertexAttributeType::Float, false, offsetof(Vertex, normal)},
+        {ColorAttribute, 3, VertexAttributeType::Float, false, offsetof(Vertex, color)},
+        {TexCoordAttribute, 2, VertexAttributeType::Float, false, offsetof(Vertex, texCoords)}
+    };
+}
+
+bool VertexPacking::FitsHalfUVs(const std::vector<Vertex>& vertices) {
+    return std::all_of(vertices.begin(), vertices.end(), [](const Vertex& vertex) {
+        return vertex.texCoords.x >= 0.0f && vertex.texCoords.x <= 1.0f && vertex.texCoords.y >= 0.0f && vertex.texCoords.y <= 1.0f;
+    });
+}
+
+std::vector<uint8_t> VertexPacking::Pack(const std::vector<Vertex>& vertices, VertexFormat format,
+                                         const Vector3& boundsMin, const Vector3& boundsMax) {
+    std::vector<uint8_t> data(vertices.size() * GetStride(format));
+    if (format == VertexFormat::Float) {
+        if (!data.empty()) {
+            std::memcpy(data.data(), vertices.data(), data.size());
+        }
+        return data;
+    }
+
+    if (format == VertexFormat::Packed) {
+        PackedVertex* out = reinterpret_cast<PackedVertex*>(data.data());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            out[i].position[0] = vertices[i].position.x;
+            out[i].position[1] = vertices[i].position.y;
+            out[i].position[2] = vertices[i].position.z;
+            PackAttributes(vertices[i], out[i]);
+        }
+        return data;
+    }
+
+    const float minimum[3] = {boundsMin.x, boundsMin.y, boundsMin.z};
+    const float extent[3] = {boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z};
+    float inverseStep[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        inverseStep[axis] = extent[axis] > 0.0f ? 65535.0f / extent[axis] : 0.0f;
+    }
+    QuantizedVertex* out = reinterpret_cast<QuantizedVertex*>(data.data());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const float position[3] = {vertices[i].position.x, vertices[i].position.y, vertices[i].position.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            float quantized = std::round((position[axis] - minimum[axis]) * inverseStep[axis]);
+            out[i].position[axis] = static_cast<uint16_t>(std::clamp(quantized, 0.0f, 65535.0f));
+        }
+        out[i].position[3] = 0;
+        PackAttributes(vertices[i], out[i]);
+    }
+    return data;
+}
+
+std::vector<Vertex> VertexPacking::Unpack(const void* data, size_t count, VertexFormat format,
+                                          const Vector3& boundsMin, const Vector3& boundsMax) {
+    std::vector<Vertex> vertices(count);
+    if (format == VertexFormat::Float) {
+        if (count > 0) {
+            std::memcpy(vertices.data(), data, count * sizeof(Vertex));
+        }
+        return vertices;
+    }
+
+    if (format == VertexFormat::Packed) {
+        const PackedVertex* in = static_cast<const PackedVertex*>(data);
+        for (size_t i = 0; i < count; ++i) {
+            vertices[i].position = Vector3(in[i].position[0], in[i].position[1], in[i].position[2]);
+            UnpackAttributes(in[i], vertices[i]);
+        }
+        return vertices;
+    }
+
+    // Same arithmetic as DecodePosition() so CPU and GPU agree on the positions
+    const Vector3 step = (boundsMax - boundsMin) * (1.0f / 65535.0f);
+    const QuantizedVertex* in = static_cast<const QuantizedVertex*>(data);
+    for (size_t i = 0; i < count; ++i) {
+        vertices[i].position = Vector3(boundsMin.x + in[i].position[0] * step.x,
+                                       boundsMin.y + in[i].position[1] * step.y,
+                                       boundsMin.z + in[i].position[2] * step.z);
+        UnpackAttributes(in[i], vertices[i]);
+    }
+    return vertices;
+}
+
+std::vector<Vector3> VertexPacking::UnpackPositions(const void* data, size_t count, VertexFormat format,
+                                                    const Vector3& boundsMin, const Vector3& boundsMax) {
+    std::vector<Vector3> positions(count);
+    if (format == VertexFormat::Float) {
+        const Vertex* in = static_cast<const Vertex*>(data);
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = in[i].position;
+        }
+        return positions;
+    }
+
+    if (format == VertexFormat::Packed) {
+        const PackedVertex* in = static_cast<const PackedVertex*>(data);
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = Vector3(in[i].position[0], in[i].position[1], in[i].position[2]);
+        }
+        return positions;
+    }
+
+    // Same arithmetic as Unpack
+    const Vector3 step = (boundsMax - boundsMin) * (1.0f / 65535.0f);
+    const QuantizedVertex* in = static_cast<const QuantizedVertex*>(data);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = Vector3(boundsMin.x + in[i].position[0] * step.x,
+                               boundsMin.y + in[i].position[1] * step.y,
+                               boundsMin.z + in[i].position[2] * step.z);
+    }
+    return positions;
+}
+
+void VertexPacking::GetDecodeConstants(VertexFormat format, const Vector3& boundsMin, const Vector3& boundsMax,
+                                       float scale[4], float offset[4]) {
+    scale[0] = scale[1] = scale[2] = 1.0f;
+    scale[3] = format == VertexFormat::Float ? 0.0f : 1.0f;
+    offset[0] = offset[1] = offset[2] = offset[3] = 0.0f;
+    if (format == VertexFormat::PackedQuantized) {
+        scale[0] = boundsMax.x - boundsMin.x;
+        scale[1] = boundsMax.y - boundsMin.y;
+        scale[2] = boundsMax.z - boundsMin.z;
+        offset[0] = boundsMin.x;
+        offset[1] = boundsMin.y;
+        offset[2] = boundsMin.z;
+    }
+}
+
+const char* VertexPacking::GetShaderDeclarations() {
+    return ShaderDeclarations;
+}
+
+void VertexPacking::EncodeOctahedral(const Vector3& normal, int16_t encoded[2]) {
+    float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (length <= 0.0f) {
+        encoded[0] = encoded[1] = 0;
+        return;
+    }
+    float u = normal.x / length;
+    float v = normal.y / length;
+    if (normal.z < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        float foldedU = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float foldedV = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = foldedU;
+        v = foldedV;
+    }
+    encoded[0] = static_cast<int16_t>(std::lround(std::clamp(u, -1.0f, 1.0f) * 32767.0f));
+    encoded[1] = static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+Vector3 VertexPacking::DecodeOctahedral(const int16_t encoded[2]) {
+    // snorm16 as GL normalizes it
+    float u = std::max(encoded[0] / 32767.0f, -1.0f);
+    float v = std::max(encoded[1] / 32767.0f, -1.0f);
+    Vector3 n(u, v, 1.0f - std::abs(u) - std::abs(v));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return n.Normalized();
+}
+
+uint16_t VertexPacking::FloatToHalf(float value) {
+    // Round to nearest even; overflow goes to infinity and NaN stays NaN
+    constexpr uint32_t FloatInfinity = 255u << 23;
+    constexpr uint32_t HalfOverflow = (127u + 16u) << 23;
+    constexpr uint32_t SubnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+    if (bits >= HalfOverflow) {
+        half = bits > FloatInfinity ? 0x7E00u : 0x7C00u;
+    } else if (bits < (113u << 23)) {
+        // Below the smallest normal half: let float addition do the rounding shift
+        float magnitude, magic;
+        std::memcpy(&magnitude, &bits, sizeof(bits));
+        std::memcpy(&magic, &SubnormalMagic, sizeof(magic));
+        magnitude += magic;
+        std::memcpy(&half, &magnitude, sizeof(half));
+        half -= SubnormalMagic;
+    } else {
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        bits += 0xC8000FFFu;        // Rebias the exponent (15 - 127) and add the rounding bias
+        bits += mantissaOdd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float VertexPacking::HalfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    uint32_t bits = exponent == 31 ? (sign | 0x7F800000u | (mantissa << 13))
+                                   : (sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+}
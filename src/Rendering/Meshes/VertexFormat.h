@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include "../Core/Buffer.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector3 color; // Using Vector3 for RGB color data
+        Vector3 texCoords; // UV texture coordinates (using Vector3 for consistency, z component unused)
+        
+        Vertex() = default;
+        Vertex(const Vector3& pos, const Vector3& norm = Vector3::Up, const Vector3& col = Vector3::Zero, const Vector3& tex = Vector3::Zero)
+            : position(pos), normal(norm), color(col), texCoords(tex) {}
+    };
+
+    // Layout of a mesh's vertex buffer on the GPU (and in cooked files). The CPU copy is always
+    // the float Vertex; packing happens at upload.
+    enum class VertexFormat : uint32_t {
+        Float = 0,              // Vertex as is, 48 bytes
+        Packed = 1,             // PackedVertex, 24 bytes
+        PackedQuantized = 2     // QuantizedVertex, 20 bytes
+    };
+
+    // Float position, octahedral snorm16 normal, RGBA8 color and half-float UV
+    struct PackedVertex {
+        float position[3];
+        int16_t normal[2];
+        uint8_t color[4];
+        uint16_t texCoords[2];
+    };
+    static_assert(sizeof(PackedVertex) == 24, "PackedVertex is part of the cooked mesh format");
+
+    // As PackedVertex with unorm16 positions relative to the mesh bounds; w is padding
+    struct QuantizedVertex {
+        uint16_t position[4];
+        int16_t normal[2];
+        uint8_t color[4];
+        uint16_t texCoords[2];
+    };
+    static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex is part of the cooked mesh format");
+
+    // Encoding and decoding of the vertex formats. Shaders decode through the declarations from
+    // GetShaderDeclarations(), driven by two constant attributes the mesh sets before drawing,
+    // so one program handles every format without per-format variants or extra uniforms.
+    class VertexPacking {
+    public:
+        static constexpr unsigned int PositionAttribute = 0;
+        static constexpr unsigned int NormalAttribute = 1;
+        static constexpr unsigned int ColorAttribute = 2;
+        static constexpr unsigned int TexCoordAttribute = 7;        // After the instance matrix
+        static constexpr unsigned int DecodeScaleAttribute = 8;
+        static constexpr unsigned int DecodeOffsetAttribute = 9;
+
+        static bool IsValid(uint32_t format) { return format <= static_cast<uint32_t>(VertexFormat::PackedQuantized); }
+        static size_t GetStride(VertexFormat format);
+        static std::vector<VertexAttribute> GetAttributes(VertexFormat format);
+
+        // True if every UV lies in [0, 1], where half floats are within about 2^-12; tiled UVs
+        // lose precision quickly beyond that and should stay in VertexFormat::Float
+        static bool FitsHalfUVs(const std::vector<Vertex>& vertices);
+
+        // Bounds are the mesh bounds; they only matter for PackedQuantized
+        static std::vector<uint8_t> Pack(const std::vector<Vertex>& vertices, VertexFormat format,
+                                         const Vector3& boundsMin, const Vector3& boundsMax);
+        static std::vector<Vertex> Unpack(const void* data, size_t count, VertexFormat format,
+                                          const Vector3& boundsMin, const Vector3& boundsMax);
+        // Positions only, for CPU consumers such as BVH and shadow-volume builders
+        static std::vector<Vector3> UnpackPositions(const void* data, size_t count, VertexFormat format,
+                                                    const Vector3& boundsMin, const Vector3& boundsMax);
+
+        // Values of the decode attributes: position = offset.xyz + stored * scale.xyz, and
+        // scale.w != 0 when normals are octahedral
+        static void GetDecodeConstants(VertexFormat format, const Vector3& boundsMin, const Vector3& boundsMax,
+                                       float scale[4], float offset[4]);
+
+        // GLSL vertex inputs plus DecodePosition() and DecodeNormal(); valid from #version 330
+        static const char* GetShaderDeclarations();
+
+        static void EncodeOctahedral(const Vector3& normal, int16_t encoded[2]);
+        static Vector3 DecodeOctahedral(const int16_t encoded[2]);
+        static uint16_t FloatToHalf(float value);
+        static float HalfToFloat(uint16_t value);
+    };
+}
@@ -28,12 +28,7 @@ bool OpenGLRenderer::Initialize() {
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     
-    const std::string vertexSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aNormal;
-        layout (location = 2) in vec3 aColor;
-        
+    const std::string vertexSource = std::string("#version 330 core\n") + VertexPacking::GetShaderDeclarations() + R"(
         uniform mat4 uModel;
         uniform mat4 uView;
         uniform mat4 uProjection;
@@ -43,8 +38,8 @@ bool OpenGLRenderer::Initialize() {
         flat out vec3 VertexColor;
         
         void main() {
-            FragPos = vec3(uModel * vec4(aPos, 1.0));
-            Normal = mat3(transpose(inverse(uModel))) * aNormal;
+            FragPos = vec3(uModel * vec4(DecodePosition(), 1.0));
+            Normal = mat3(transpose(inverse(uModel))) * DecodeNormal();
             VertexColor = aColor;
             
             gl_Position = uProjection * uView * vec4(FragPos, 1.0);
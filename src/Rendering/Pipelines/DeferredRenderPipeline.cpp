@@ -10,6 +10,7 @@
 #include "../Lighting/Light.h"
 #include "../Lighting/LightOcclusion.h"
 #include "../Core/FrameCapture.h"
+#include "../Core/Texture.h"
 
 #include <string>
 #include <cstring>
@@ -18,6 +19,27 @@ namespace GameEngine {
 
 const int DeferredRenderPipeline::SHADOW_MAP_SIZE;
 
+namespace {
+
+// Shader field of the render queue sort keys
+constexpr uint16_t GeometryShaderKey = 1;
+
+constexpr UniformID ViewID("uView");
+constexpr UniformID ProjectionID("uProjection");
+constexpr UniformID MetallicID("uMetallic");
+constexpr UniformID RoughnessID("uRoughness");
+constexpr UniformID AlbedoMapID("uAlbedoMap");
+constexpr UniformID UseAlbedoMapID("uUseAlbedoMap");
+constexpr UniformID NumVolumeHeadersID("numVolumeHeaders");
+constexpr UniformID GAlbedoMetallicID("gAlbedoMetallic");
+constexpr UniformID GNormalRoughnessID("gNormalRoughness");
+constexpr UniformID GPositionID("gPosition");
+constexpr UniformID ShadowMapID("shadowMap");
+constexpr UniformID LightSpaceMatrixID("lightSpaceMatrix");
+constexpr UniformID FinalTextureID("finalTexture");
+
+}
+
 DeferredRenderPipeline::DeferredRenderPipeline() = default;
 DeferredRenderPipeline::~DeferredRenderPipeline() = default;
 
@@ -65,6 +87,11 @@ void DeferredRenderPipeline::BeginFrame(const RenderData& renderData) {
 
 void DeferredRenderPipeline::Render(World* world) {
     PROFILE_GPU("DeferredRenderPipeline::Render");
+    {
+        PROFILE_SCOPE("DeferredPipeline::Visibility");
+        m_visibility.Update(world);
+        m_visibility.SelectLODs(m_renderData.viewMatrix, m_renderData.projectionMatrix);
+    }
     {
         PROFILE_GPU("DeferredPipeline::ShadowPass");
         ShadowPass(world);
@@ -129,24 +156,23 @@ void DeferredRenderPipeline::CreateShaders() {
     m_lightingShader = std::make_unique<Shader>();
     m_compositeShader = std::make_unique<Shader>();
     
-    std::string geometryVertexSource = R"(
-        #version 330 core
-        layout (location = 0) in vec3 aPosition;
-        layout (location = 1) in vec3 aNormal;
-        layout (location = 2) in vec3 aColor;
+    std::string geometryVertexSource = std::string("#version 330 core\n") + VertexPacking::GetShaderDeclarations() + R"(
+        layout (location = 3) in mat4 aInstanceModel;
+        layout (location = 10) in vec4 aInstanceUVTransform;    // Atlas region: xy scale, zw offset
         
-        uniform mat4 uModel;
         uniform mat4 uView;
         uniform mat4 uProjection;
         
         out vec3 FragPos;
         out vec3 Normal;
+        out vec2 TexCoord;
         flat out vec3 VertexColor;
         
         void main() {
-            vec4 worldPos = uModel * vec4(aPosition, 1.0);
+            vec4 worldPos = aInstanceModel * vec4(DecodePosition(), 1.0);
             FragPos = worldPos.xyz;
-            Normal = mat3(transpose(inverse(uModel))) * aNormal;
+            Normal = mat3(transpose(inverse(aInstanceModel))) * DecodeNormal();
+            TexCoord = aTexCoord * aInstanceUVTransform.xy + aInstanceUVTransform.zw;
             VertexColor = aColor;
             
             gl_Position = uProjection * uView * worldPos;
@@ -162,13 +188,20 @@ void DeferredRenderPipeline::CreateShaders() {
         
         in vec3 FragPos;
         in vec3 Normal;
+        in vec2 TexCoord;
         flat in vec3 VertexColor;
         
         uniform float uMetallic = 0.0;
         uniform float uRoughness = 0.5;
+        uniform sampler2D uAlbedoMap;
+        uniform int uUseAlbedoMap = 0;
         
         void main() {
-            gAlbedoMetallic = vec4(VertexColor, uMetallic);
+            vec3 albedo = VertexColor;
+            if (uUseAlbedoMap != 0) {
+                albedo *= texture(uAlbedoMap, TexCoord).rgb;
+            }
+            gAlbedoMetallic = vec4(albedo, uMetallic);
             gNormalRoughness = vec4(normalize(Normal) * 0.5 + 0.5, uRoughness);
             gPosition = vec4(FragPos, gl_FragCoord.z);
             gMotionMaterial = vec4(0.0, 0.0, 1.0, 1.0);
@@ -190,8 +223,7 @@ void DeferredRenderPipeline::CreateShaders() {
         }
     )";
     
-    std::string lightingFragmentSource = R"(
-        #version 330 core
+    std::string lightingFragmentSource = FrameUniforms::ComposeSource("330 core", R"(
         in vec2 TexCoord;
         out vec4 FragColor;
         
@@ -200,13 +232,6 @@ void DeferredRenderPipeline::CreateShaders() {
         uniform sampler2D gPosition;
         uniform sampler2D shadowMap;
         
-        uniform int numLights;
-        uniform vec3 lightPositions[32];
-        uniform vec3 lightColors[32];
-        uniform float lightIntensities[32];
-        uniform int lightTypes[32];
-        uniform float lightRanges[32];
-        uniform vec3 viewPos;
         uniform mat4 lightSpaceMatrix;
 
         struct VolumeHeader { int lightIndex; int vertCount; int baseOffset; int farOffset; };
@@ -264,48 +289,48 @@ void DeferredRenderPipeline::CreateShaders() {
             vec3 albedo = albedoMetallic.rgb;
             vec3 normal = normalize(normalRoughness.rgb * 2.0 - 1.0);
             vec3 fragPos = position.xyz;
-            vec3 viewDir = normalize(viewPos - fragPos);
+            vec3 viewDir = normalize(viewPosition.xyz - fragPos);
             
             vec3 totalLighting = vec3(0.0);
             float totalBrightness = 0.0;
             
-            for(int i = 0; i < numLights && i < 32; i++) {
+            for(int i = 0; i < lightCount.x && i < 32; i++) {
                 vec3 lightContribution = vec3(0.0);
                 if (insideAnyLightVolume(i, fragPos)) { continue; }
                 
-                if(lightTypes[i] == 0) {
-                    vec3 lightDir = normalize(-lightPositions[i]);
+                if(lights[i].typeShadow.x == 0) {
+                    vec3 lightDir = normalize(-lights[i].positionRange.xyz);
                     
                     vec4 fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
                     float shadow = ShadowCalculation(fragPosLightSpace, normal, lightDir);
                     
                     float diff = max(dot(normal, lightDir), 0.0);
-                    vec3 diffuse = diff * lightColors[i] * lightIntensities[i] * albedo;
+                    vec3 diffuse = diff * lights[i].colorIntensity.rgb * lights[i].colorIntensity.w * albedo;
                     
                     vec3 reflectDir = reflect(-lightDir, normal);
                     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-                    vec3 specular = spec * lightColors[i] * lightIntensities[i];
+                    vec3 specular = spec * lights[i].colorIntensity.rgb * lights[i].colorIntensity.w;
                     
                     lightContribution = (diffuse + specular) * (1.0 - shadow);
-                } else if(lightTypes[i] == 1) {
-                    vec3 lightDir = normalize(lightPositions[i] - fragPos);
-                    float distance = length(lightPositions[i] - fragPos);
+                } else if(lights[i].typeShadow.x == 1) {
+                    vec3 lightDir = normalize(lights[i].positionRange.xyz - fragPos);
+                    float distance = length(lights[i].positionRange.xyz - fragPos);
                     
                     float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
-                    if(distance > lightRanges[i]) attenuation = 0.0;
+                    if(distance > lights[i].positionRange.w) attenuation = 0.0;
                     
                     float diff = max(dot(normal, lightDir), 0.0);
-                    vec3 diffuse = diff * lightColors[i] * lightIntensities[i] * attenuation * albedo;
+                    vec3 diffuse = diff * lights[i].colorIntensity.rgb * lights[i].colorIntensity.w * attenuation * albedo;
                     
                     vec3 reflectDir = reflect(-lightDir, normal);
                     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-                    vec3 specular = spec * lightColors[i] * lightIntensities[i] * attenuation;
+                    vec3 specular = spec * lights[i].colorIntensity.rgb * lights[i].colorIntensity.w * attenuation;
                     
                     lightContribution = diffuse + specular;
                 }
                 
                 totalLighting += lightContribution;
-                totalBrightness += lightIntensities[i];
+                totalBrightness += lights[i].colorIntensity.w;
             }
             
             if(totalBrightness > 100.0) {
@@ -317,9 +342,10 @@ void DeferredRenderPipeline::CreateShaders() {
             
             FragColor = vec4(result, 1.0);
         }
-    )";
+    )");
     
     m_lightingShader->LoadFromSource(lightingVertexSource, lightingFragmentSource);
+    FrameUniforms::BindBlocks(*m_lightingShader);
     
     std::string compositeVertexSource = R"(
         #version 330 core
@@ -362,44 +388,49 @@ void DeferredRenderPipeline::ShadowPass(World* world) {
     m_cachedLightManager->CollectLights(world);
     
     auto lights = m_cachedLightManager->GetActiveLights();
+    m_shadowCache.BeginFrame(m_visibility.GetChangedBounds());
     
     m_shadowMapBuffer->Bind();
     glViewport(0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
-    glClear(GL_DEPTH_BUFFER_BIT);
     
+    // Only the first casting light is rendered; its map is kept while nothing it sees changes
+    bool hasCaster = false;
     for (auto* light : lights) {
         if (!light || !light->GetCastShadows()) continue;
         
         light->InitializeShadowMap();
         m_lightSpaceMatrix = light->GetLightSpaceMatrix();
+        hasCaster = true;
+        if (!m_shadowCache.NeedsUpdate(m_shadowMapBuffer.get(), 0, m_lightSpaceMatrix)) {
+            break;
+        }
         
+        glClear(GL_DEPTH_BUFFER_BIT);
         if (m_geometryShader) {
             m_geometryShader->Use();
-            m_geometryShader->SetMatrix4("uView", light->GetViewMatrix());
-            m_geometryShader->SetMatrix4("uProjection", light->GetProjectionMatrix());
-            
-            Vector3 cameraPos = Vector3(m_renderData.viewMatrix.Inverted().m[12], 
-                                       m_renderData.viewMatrix.Inverted().m[13], 
-                                       m_renderData.viewMatrix.Inverted().m[14]);
+            m_geometryShader->SetMatrix4(ViewID, light->GetViewMatrix());
+            m_geometryShader->SetMatrix4(ProjectionID, light->GetProjectionMatrix());
             
-            for (const auto& entity : world->GetEntities()) {
-                if (world->HasComponent<TransformComponent>(entity) && world->HasComponent<MeshComponent>(entity)) {
-                    auto* transformComp = world->GetComponent<TransformComponent>(entity);
-                    auto* meshComp = world->GetComponent<MeshComponent>(entity);
-                    if (transformComp && meshComp && meshComp->HasMesh() && meshComp->IsVisible()) {
-                        float distance = (transformComp->transform.GetPosition() - cameraPos).Length();
-                        if (distance > 100.0f) continue;
-                        
-                        Matrix4 modelMatrix = transformComp->transform.GetLocalToWorldMatrix();
-                        m_geometryShader->SetMatrix4("uModel", modelMatrix);
-                        meshComp->GetMesh()->Draw();
-                    }
-                }
+            m_visibility.Cull(light->GetProjectionMatrix() * light->GetViewMatrix(), m_visibleShadow);
+            m_renderQueue.Clear();
+            for (uint32_t index : m_visibleShadow) {
+                const Renderable& renderable = m_visibility.GetRenderables()[index];
+                m_renderQueue.Submit(RenderPass::Shadow, GeometryShaderKey, 0, renderable.mesh, renderable.model, 0.0f);
+            }
+            m_renderQueue.Sort();
+            m_renderQueue.Upload();
+            for (const RenderBatch& batch : m_renderQueue.GetBatches()) {
+                m_renderQueue.DrawBatch(batch);
             }
         }
         
         break;
     }
+    if (!hasCaster) {
+        glClear(GL_DEPTH_BUFFER_BIT);
+        m_shadowCache.Invalidate();
+    }
+    m_shadowCache.EndFrame();
     
     m_shadowMapBuffer->Unbind();
 }
@@ -409,38 +440,48 @@ void DeferredRenderPipeline::GeometryPass(World* world) {
     
     if (m_geometryShader) {
         m_geometryShader->Use();
-        m_geometryShader->SetMatrix4("uView", m_renderData.viewMatrix);
-        m_geometryShader->SetMatrix4("uProjection", m_renderData.projectionMatrix);
+        m_geometryShader->SetMatrix4(ViewID, m_renderData.viewMatrix);
+        m_geometryShader->SetMatrix4(ProjectionID, m_renderData.projectionMatrix);
+        m_geometryShader->SetInt(AlbedoMapID, 0);
     }
     
     if (world) {
-        Vector3 cameraPos = Vector3(m_renderData.viewMatrix.Inverted().m[12], 
-                                   m_renderData.viewMatrix.Inverted().m[13], 
-                                   m_renderData.viewMatrix.Inverted().m[14]);
+        m_visibility.Cull(m_renderData.projectionMatrix * m_renderData.viewMatrix, m_visibleGeometry);
+        const auto& renderables = m_visibility.GetRenderables();
+        const auto& view = m_renderData.viewMatrix.m;
+        m_renderQueue.Clear();
+        for (uint32_t index : m_visibleGeometry) {
+            const Renderable& renderable = renderables[index];
+            Vector3 center = (renderable.boundsMin + renderable.boundsMax) * 0.5f;
+            float depth = -(view[2] * center.x + view[6] * center.y + view[10] * center.z + view[14]);
+            // Props sharing an atlas share a material, their regions differ only per instance
+            const MeshComponent* meshComp = renderable.meshComponent;
+            std::shared_ptr<Texture> albedo = meshComp->GetAlbedoTexture();
+            uint16_t material = m_renderQueue.GetMaterialID(albedo.get(), RenderQueue::MakeMaterialKey(meshComp->GetMetallic(), meshComp->GetRoughness()));
+            m_renderQueue.Submit(RenderPass::Opaque, GeometryShaderKey, material, renderable.mesh, renderable.model, depth, index,
+                                 meshComp->GetUVTransform());
+        }
+        m_renderQueue.Sort();
+        m_renderQueue.Upload();
         
-        int entityCount = 0;
-        for (const auto& entity : world->GetEntities()) {
-            if (world->HasComponent<TransformComponent>(entity) && world->HasComponent<MeshComponent>(entity)) {
-                auto* transformComp = world->GetComponent<TransformComponent>(entity);
-                auto* meshComp = world->GetComponent<MeshComponent>(entity);
-                if (transformComp && meshComp && meshComp->HasMesh() && meshComp->IsVisible()) {
-                    float distance = (transformComp->transform.GetPosition() - cameraPos).Length();
-                    if (distance > 100.0f) continue;
-                    
-                    Matrix4 modelMatrix = transformComp->transform.GetLocalToWorldMatrix();
-                    
-                    if (m_geometryShader) {
-                        m_geometryShader->SetMatrix4("uModel", modelMatrix);
-                        m_geometryShader->SetFloat("uMetallic", meshComp->GetMetallic());
-                        m_geometryShader->SetFloat("uRoughness", meshComp->GetRoughness());
-                    }
-                    
-                    meshComp->GetMesh()->Draw();
-                    entityCount++;
+        // Batches arrive grouped by material, so material uniforms change once per group
+        int currentMaterial = -1;
+        for (const RenderBatch& batch : m_renderQueue.GetBatches()) {
+            if (m_geometryShader && batch.material != currentMaterial) {
+                const MeshComponent* meshComp = renderables[batch.userData].meshComponent;
+                m_geometryShader->SetFloat(MetallicID, meshComp->GetMetallic());
+                m_geometryShader->SetFloat(RoughnessID, meshComp->GetRoughness());
+                std::shared_ptr<Texture> albedo = meshComp->GetAlbedoTexture();
+                if (albedo) {
+                    albedo->Bind(0);
                 }
+                m_geometryShader->SetInt(UseAlbedoMapID, albedo ? 1 : 0);
+                currentMaterial = batch.material;
             }
+            m_renderQueue.DrawBatch(batch);
         }
-        Logger::Debug("DeferredRenderPipeline: Rendered " + std::to_string(entityCount) + " mesh entities from World");
+        Logger::Debug("DeferredRenderPipeline: Rendered " + std::to_string(m_visibleGeometry.size()) + " mesh entities from World in " +
+                      std::to_string(m_renderQueue.GetBatches().size()) + " instanced draws");
     } else {
         Logger::Warning("DeferredRenderPipeline: World is null; skipping geometry draw");
     }
@@ -468,11 +509,19 @@ void DeferredRenderPipeline::LightingPass(World* world) {
     int totalHeaders = 0;
     int vertFloatOffset = 0;
 
+    // All lights go in one request so their silhouettes are extracted in a single parallel pass
+    std::vector<ShadowVolumeRequest> volumeRequests;
+    for (size_t li = 0; li < lights.size(); ++li) {
+        if (lights[li] && lights[li]->GetCastShadows()) {
+            volumeRequests.push_back({lights[li], static_cast<int>(li), 50.0f});
+        }
+    }
+    m_lightOcclusion->BuildShadowVolumes(volumeRequests, world);
+
     for (size_t li = 0; li < lights.size(); ++li) {
         const Light* light = lights[li];
         if (!light || !light->GetCastShadows()) continue;
 
-        m_lightOcclusion->BuildShadowVolumesForLight(light, world, static_cast<int>(li), 50.0f);
         const auto* vols = m_lightOcclusion->GetVolumesForLight(light);
         if (!vols) continue;
 
@@ -528,7 +577,7 @@ void DeferredRenderPipeline::LightingPass(World* world) {
 
     if (m_lightingShader) {
         m_lightingShader->Use();
-        m_lightingShader->SetInt("numVolumeHeaders", totalHeaders);
+        m_lightingShader->SetInt(NumVolumeHeadersID, totalHeaders);
         
         if (m_gBuffer) {
             auto albedoTexture = m_gBuffer->GetColorTexture(0);
@@ -537,22 +586,22 @@ void DeferredRenderPipeline::LightingPass(World* world) {
             
             if (albedoTexture) {
                 albedoTexture->Bind(0);
-                m_lightingShader->SetInt("gAlbedoMetallic", 0);
+                m_lightingShader->SetInt(GAlbedoMetallicID, 0);
             }
             if (normalTexture) {
                 normalTexture->Bind(1);
-                m_lightingShader->SetInt("gNormalRoughness", 1);
+                m_lightingShader->SetInt(GNormalRoughnessID, 1);
             }
             if (positionTexture) {
                 positionTexture->Bind(2);
-                m_lightingShader->SetInt("gPosition", 2);
+                m_lightingShader->SetInt(GPositionID, 2);
             }
             
             if (m_shadowMapBuffer) {
                 auto shadowTexture = m_shadowMapBuffer->GetDepthTexture();
                 if (shadowTexture) {
                     shadowTexture->Bind(3);
-                    m_lightingShader->SetInt("shadowMap", 3);
+                    m_lightingShader->SetInt(ShadowMapID, 3);
                 }
             }
         }
@@ -566,21 +615,10 @@ void DeferredRenderPipeline::LightingPass(World* world) {
         std::vector<LightManager::ShaderLightData> lightData;
         m_cachedLightManager->GetShaderLightData(lightData);
         
-        m_lightingShader->SetInt("numLights", static_cast<int>(lightData.size()));
-        
-        for (size_t i = 0; i < lightData.size() && i < MAX_LIGHTS; ++i) {
-            std::string indexStr = std::to_string(i);
-            m_lightingShader->SetVector3("lightPositions[" + indexStr + "]", lightData[i].position);
-            m_lightingShader->SetVector3("lightColors[" + indexStr + "]", lightData[i].color);
-            m_lightingShader->SetFloat("lightIntensities[" + indexStr + "]", lightData[i].intensity);
-            m_lightingShader->SetInt("lightTypes[" + indexStr + "]", lightData[i].type);
-            m_lightingShader->SetFloat("lightRanges[" + indexStr + "]", lightData[i].range);
-        }
-        m_lightingShader->SetMatrix4("lightSpaceMatrix", m_lightSpaceMatrix);
-        
-        Matrix4 invViewMatrix = m_renderData.viewMatrix.Inverted();
-        Vector3 cameraPosition = Vector3(invViewMatrix.m[12], invViewMatrix.m[13], invViewMatrix.m[14]);
-        m_lightingShader->SetVector3("viewPos", cameraPosition);
+        m_frameUniforms.SetCamera(m_renderData.viewMatrix, m_renderData.projectionMatrix);
+        m_frameUniforms.SetLights(lightData);
+        m_frameUniforms.Upload();
+        m_lightingShader->SetMatrix4(LightSpaceMatrixID, m_lightSpaceMatrix);
     }
     
     RenderFullscreenQuad();
@@ -601,7 +639,7 @@ void DeferredRenderPipeline::CompositePass() {
         auto finalTexture = m_lightingBuffer->GetColorTexture(0);
         if (finalTexture) {
             finalTexture->Bind(0);
-            m_compositeShader->SetInt("finalTexture", 0);
+            m_compositeShader->SetInt(FinalTextureID, 0);
         }
     }
     
@@ -3,7 +3,11 @@
 #include "RenderPipeline.h"
 #include "../Core/FrameBuffer.h"
 #include "../Shaders/Shader.h"
+#include "../Shaders/FrameUniforms.h"
 #include "../Lighting/LightManager.h"
+#include "../Lighting/ShadowCache.h"
+#include "../Culling/VisibilitySystem.h"
+#include "../Core/RenderQueue.h"
 #include <memory>
 
 namespace GameEngine {
@@ -40,6 +44,13 @@ namespace GameEngine {
         Matrix4 m_lightSpaceMatrix;
         
         std::unique_ptr<LightManager> m_cachedLightManager;
+        
+        VisibilitySystem m_visibility;
+        std::vector<uint32_t> m_visibleGeometry;
+        std::vector<uint32_t> m_visibleShadow;
+        RenderQueue m_renderQueue;
+        FrameUniforms m_frameUniforms;
+        ShadowCache m_shadowCache;
 
         unsigned int m_shadowVolumeHeadersSSBO = 0;
         unsigned int m_shadowVolumeVerticesSSBO = 0;
@@ -10,11 +10,30 @@
 #include "../Lighting/LightManager.h"
 #include "../Lighting/Light.h"
 #include "../Lighting/LightOcclusion.h"
+#include <algorithm>
 #include <string>
 #include <cstring>
 
 namespace GameEngine {
 
+namespace {
+
+// Shader fields of the render queue sort keys
+constexpr uint16_t ForwardShaderKey = 1;
+constexpr uint16_t DepthShaderKey = 2;
+
+constexpr UniformID ShadowMaps2DID("shadowMaps2D");
+constexpr UniformID ShadowMapsCubeID("shadowMapsCube");
+constexpr UniformID NumVolumeHeadersID("numVolumeHeaders");
+constexpr UniformID AlphaID("alpha");
+constexpr UniformID LightSpaceMatrixID("lightSpaceMatrix");
+constexpr UniformID FinalTextureID("finalTexture");
+constexpr UniformID ClusterGridID("clusterGrid");
+constexpr UniformID ClusterParamsID("clusterParams");
+constexpr UniformID ClusterLogDepthID("clusterLogDepth");
+
+}
+
 ForwardRenderPipeline::ForwardRenderPipeline() = default;
 
 ForwardRenderPipeline::~ForwardRenderPipeline() {
@@ -51,56 +70,31 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
     m_transparentShader = std::make_shared<Shader>();
     m_effectsShader = std::make_shared<Shader>();
     
-    std::string vertexShaderSource = R"(
-        #version 430 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aNormal;
-        layout (location = 2) in vec3 aColor;
-        
-        uniform mat4 model;
-        uniform mat4 view;
-        uniform mat4 projection;
+    std::string vertexShaderSource = FrameUniforms::ComposeSource("430 core", VertexPacking::GetShaderDeclarations() + std::string(R"(
+        layout (location = 3) in mat4 aInstanceModel;
         
         out vec3 FragPos;
         out vec3 Normal;
         out vec3 Color;
         
         void main() {
-            FragPos = vec3(model * vec4(aPos, 1.0));
-            Normal = mat3(transpose(inverse(model))) * aNormal;
+            FragPos = vec3(aInstanceModel * vec4(DecodePosition(), 1.0));
+            Normal = mat3(transpose(inverse(aInstanceModel))) * DecodeNormal();
             Color = aColor;
             
             gl_Position = projection * view * vec4(FragPos, 1.0);
         }
-    )";
+    )"));
     
-    std::string fragmentShaderSource = R"(
-        #version 430 core
+    std::string fragmentShaderSource = FrameUniforms::ComposeSource("430 core", LightClusterGrid::GetShaderDeclarations() + std::string(R"(
         out vec4 FragColor;
         
         in vec3 FragPos;
         in vec3 Normal;
         in vec3 Color;
         
-        uniform int numLights;
-        uniform vec3 lightPositions[32];
-        uniform vec3 lightColors[32];
-        uniform float lightIntensities[32];
-        uniform int lightTypes[32];
-        uniform float lightRanges[32];
-        uniform vec3 viewPos;
-
-        uniform int lightHasShadow[32];
-        uniform int shadowType[32];                 // 0 = Directional, 1 = Point, 2 = Spot
         uniform sampler2D shadowMaps2D[8];
         uniform samplerCube shadowMapsCube[8];
-        uniform int shadowSamplerIndex[32];         // index into shadowMaps2D or shadowMapsCube
-        uniform mat4 lightSpaceMatrices[32];        // for dir/spot
-        uniform float shadowBiases[32];
-        uniform float shadowTexelSizes[32];         // 1.0 / mapSize for dir/spot
-        uniform vec3 shadowLightPositions[32];      // for point
-        uniform float shadowNearPlanes[32];         // for point
-        uniform float shadowFarPlanes[32];          // for point
 
         struct VolumeHeader { int lightIndex; int vertCount; int baseOffset; int farOffset; };
         layout(std430, binding = 3) buffer ShadowVolumeHeaders { VolumeHeader headers[]; };
@@ -158,17 +152,17 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
         }
 
         float ComputeShadowDir(int li, vec3 worldPos, vec3 N, vec3 L) {
-            vec4 lsp = lightSpaceMatrices[li] * vec4(worldPos, 1.0);
+            vec4 lsp = lights[li].lightSpace * vec4(worldPos, 1.0);
             vec3 proj = lsp.xyz / max(lsp.w, 1e-5);
             proj = proj * 0.5 + 0.5;
             if (proj.z > 1.0 || proj.x < 0.0 || proj.x > 1.0 || proj.y < 0.0 || proj.y > 1.0) return 0.0;
             float currentDepth = proj.z;
-            float bias = max(shadowBiases[li] * (1.0 - dot(N, L)), shadowBiases[li] * 0.2);
+            float bias = max(lights[li].shadowParams.x * (1.0 - dot(N, L)), lights[li].shadowParams.x * 0.2);
             float shadow = 0.0;
-            int idx = shadowSamplerIndex[li];
+            int idx = lights[li].typeShadow.w;
             for (int x = -1; x <= 1; ++x) {
                 for (int y = -1; y <= 1; ++y) {
-                    vec2 offset = vec2(x, y) * shadowTexelSizes[li];
+                    vec2 offset = vec2(x, y) * lights[li].shadowParams.y;
                     float closestDepth = texture(shadowMaps2D[idx], proj.xy + offset).r;
                     shadow += (currentDepth - bias > closestDepth) ? 1.0 : 0.0;
                 }
@@ -180,10 +174,10 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             return (2.0 * nearP * farP) / (farP + nearP - z * (farP - nearP));
         }
         float ComputeShadowPoint(int li, vec3 worldPos) {
-            vec3 Lvec = worldPos - shadowLightPositions[li];
+            vec3 Lvec = worldPos - lights[li].shadowLightPosition.xyz;
             float dist = length(Lvec);
-            int idx = shadowSamplerIndex[li];
-            float bias = shadowBiases[li];
+            int idx = lights[li].typeShadow.w;
+            float bias = lights[li].shadowParams.x;
             float shadow = 0.0;
             int samples = 4;
             vec3 dir = normalize(Lvec);
@@ -196,53 +190,45 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             for (int i = 0; i < samples; ++i) {
                 vec3 probe = dir + offsets[i] * 0.01;
                 float depthSample = texture(shadowMapsCube[idx], probe).r;
-                float sampleDist = LinearizeDepth(depthSample, shadowNearPlanes[li], shadowFarPlanes[li]);
+                float sampleDist = LinearizeDepth(depthSample, lights[li].shadowParams.z, lights[li].shadowParams.w);
                 shadow += (dist - bias > sampleDist) ? 1.0 : 0.0;
             }
             return shadow / float(samples);
         }
         
-        void main() {
-            vec3 N = normalize(Normal);
-            vec3 V = normalize(viewPos - FragPos);
+        // Contribution of one clustered light record; shadows exist only for lights in LightData
+        vec3 ShadeLight(int recordIndex, vec3 N, vec3 V, vec3 albedo, vec3 F0, float metallic, float roughness) {
+            ClusterLight light = clusterLights[recordIndex];
+            vec3 L;
+            float attenuation = 1.0;
+            if (int(light.directionType.w) == 0) {
+                L = normalize(-light.positionRange.xyz);
+            } else {
+                vec3 lightVec = light.positionRange.xyz - FragPos;
+                float distance = length(lightVec);
+                if (distance > light.positionRange.w) return vec3(0.0);
+                L = lightVec / max(distance, 1e-4);
+                attenuation = 1.0 / max(distance * distance, 1e-4);
+            }
             
-            vec3 albedo = clamp(Color, 0.0, 1.0);
-            float metallic = 0.0;
-            float roughness = 0.5;
-            float ao = 1.0;
+            vec3 H = normalize(V + L);
+            float NDF = DistributionGGX(N, H, roughness);
+            float G   = GeometrySmith(N, V, L, roughness);
+            vec3  F   = FresnelSchlick(max(dot(H, V), 0.0), F0);
             
-            vec3 F0 = mix(vec3(0.04), albedo, metallic);
+            vec3 numerator    = NDF * G * F;
+            float denom       = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 1e-4;
+            vec3 specular     = numerator / denom;
             
-            vec3 Lo = vec3(0.0);
-            for (int i = 0; i < numLights && i < 32; ++i) {
-                vec3 L;
-                float attenuation = 1.0;
-                if (lightTypes[i] == 0) {
-                    L = normalize(-lightPositions[i]);
-                } else {
-                    vec3 lightVec = lightPositions[i] - FragPos;
-                    float distance = length(lightVec);
-                    L = lightVec / max(distance, 1e-4);
-                    if (distance > lightRanges[i]) continue;
-                    attenuation = 1.0 / max(distance * distance, 1e-4);
-                }
-                
-                vec3 H = normalize(V + L);
-                float NDF = DistributionGGX(N, H, roughness);
-                float G   = GeometrySmith(N, V, L, roughness);
-                vec3  F   = FresnelSchlick(max(dot(H, V), 0.0), F0);
-                
-                vec3 numerator    = NDF * G * F;
-                float denom       = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 1e-4;
-                vec3 specular     = numerator / denom;
-                
-                vec3 kS = F;
-                vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
-                float NdotL = max(dot(N, L), 0.0);
-                
-                float shadow = 0.0;
-                if (lightHasShadow[i] == 1) {
-                    if (shadowType[i] == 1) {
+            vec3 kS = F;
+            vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
+            float NdotL = max(dot(N, L), 0.0);
+            
+            float shadow = 0.0;
+            int i = int(light.spotSource.w);
+            if (i < 32) {
+                if (lights[i].typeShadow.y == 1) {
+                    if (lights[i].typeShadow.z == 1) {
                         shadow = ComputeShadowPoint(i, FragPos);
                     } else {
                         shadow = ComputeShadowDir(i, FragPos, N, L);
@@ -251,9 +237,30 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
                 if (insideAnyLightVolume(i, FragPos)) {
                     shadow = 1.0;
                 }
-                
-                vec3 radiance = lightColors[i] * lightIntensities[i] * attenuation;
-                Lo += (1.0 - shadow) * (kD * albedo / 3.14159265 + specular) * radiance * NdotL;
+            }
+            
+            vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.w * attenuation;
+            return (1.0 - shadow) * (kD * albedo / 3.14159265 + specular) * radiance * NdotL;
+        }
+        
+        void main() {
+            vec3 N = normalize(Normal);
+            vec3 V = normalize(viewPosition.xyz - FragPos);
+            
+            vec3 albedo = clamp(Color, 0.0, 1.0);
+            float metallic = 0.0;
+            float roughness = 0.5;
+            float ao = 1.0;
+            
+            vec3 F0 = mix(vec3(0.04), albedo, metallic);
+            
+            vec3 Lo = vec3(0.0);
+            for (int i = 0; i < clusterGrid.w; ++i) {
+                Lo += ShadeLight(i, N, V, albedo, F0, metallic, roughness);
+            }
+            uvec2 cluster = ClusterLightRange(FragPos);
+            for (uint k = 0u; k < cluster.y; ++k) {
+                Lo += ShadeLight(int(clusterLightIndices[cluster.x + k]), N, V, albedo, F0, metallic, roughness);
             }
             
             vec3 ambient = vec3(0.03) * albedo * ao;
@@ -262,25 +269,17 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             color = pow(color, vec3(1.0/2.2));
             FragColor = vec4(color, 1.0);
         }
-    )";
+    )"));
     
     m_forwardShader->LoadFromSource(vertexShaderSource, fragmentShaderSource);
     
-    std::string transparentFragmentSource = R"(
-        #version 330 core
+    std::string transparentFragmentSource = FrameUniforms::ComposeSource("430 core", LightClusterGrid::GetShaderDeclarations() + std::string(R"(
         out vec4 FragColor;
         
         in vec3 FragPos;
         in vec3 Normal;
         in vec3 Color;
         
-        uniform int numLights;
-        uniform vec3 lightPositions[32];
-        uniform vec3 lightColors[32];
-        uniform float lightIntensities[32];
-        uniform int lightTypes[32];
-        uniform float lightRanges[32];
-        uniform vec3 viewPos;
         uniform float alpha;
         
         float DistributionGGX(vec3 N, vec3 H, float roughness) {
@@ -306,9 +305,39 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             return F0 + (1.0 - F0) * pow(1.0 - cosTheta, 5.0);
         }
         
+        vec3 ShadeLight(int recordIndex, vec3 N, vec3 V, vec3 albedo, vec3 F0, float metallic, float roughness) {
+            ClusterLight light = clusterLights[recordIndex];
+            vec3 L;
+            float attenuation = 1.0;
+            if (int(light.directionType.w) == 0) {
+                L = normalize(-light.positionRange.xyz);
+            } else {
+                vec3 lightVec = light.positionRange.xyz - FragPos;
+                float distance = length(lightVec);
+                if (distance > light.positionRange.w) return vec3(0.0);
+                L = lightVec / max(distance, 1e-4);
+                attenuation = 1.0 / max(distance*distance, 1e-4);
+            }
+            vec3 H = normalize(V + L);
+            float NDF = DistributionGGX(N, H, roughness);
+            float G   = GeometrySmith(N, V, L, roughness);
+            vec3  F   = FresnelSchlick(max(dot(H, V), 0.0), F0);
+            
+            vec3 numerator = NDF * G * F;
+            float denom = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 1e-4;
+            vec3 specular = numerator / denom;
+            
+            vec3 kS = F;
+            vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
+            float NdotL = max(dot(N, L), 0.0);
+            
+            vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.w * attenuation;
+            return (kD * albedo / 3.14159265 + specular) * radiance * NdotL;
+        }
+        
         void main() {
             vec3 N = normalize(Normal);
-            vec3 V = normalize(viewPos - FragPos);
+            vec3 V = normalize(viewPosition.xyz - FragPos);
             vec3 albedo = clamp(Color, 0.0, 1.0);
             float metallic = 0.0;
             float roughness = 0.5;
@@ -316,33 +345,12 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             vec3 F0 = mix(vec3(0.04), albedo, metallic);
             
             vec3 Lo = vec3(0.0);
-            for (int i = 0; i < numLights && i < 32; ++i) {
-                vec3 L;
-                float attenuation = 1.0;
-                if (lightTypes[i] == 0) {
-                    L = normalize(-lightPositions[i]);
-                } else {
-                    vec3 lightVec = lightPositions[i] - FragPos;
-                    float distance = length(lightVec);
-                    if (distance > lightRanges[i]) continue;
-                    L = lightVec / max(distance, 1e-4);
-                    attenuation = 1.0 / max(distance*distance, 1e-4);
-                }
-                vec3 H = normalize(V + L);
-                float NDF = DistributionGGX(N, H, roughness);
-                float G   = GeometrySmith(N, V, L, roughness);
-                vec3  F   = FresnelSchlick(max(dot(H, V), 0.0), F0);
-                
-                vec3 numerator = NDF * G * F;
-                float denom = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 1e-4;
-                vec3 specular = numerator / denom;
-                
-                vec3 kS = F;
-                vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
-                float NdotL = max(dot(N, L), 0.0);
-                
-                vec3 radiance = lightColors[i] * lightIntensities[i] * attenuation;
-                Lo += (kD * albedo / 3.14159265 + specular) * radiance * NdotL;
+            for (int i = 0; i < clusterGrid.w; ++i) {
+                Lo += ShadeLight(i, N, V, albedo, F0, metallic, roughness);
+            }
+            uvec2 cluster = ClusterLightRange(FragPos);
+            for (uint k = 0u; k < cluster.y; ++k) {
+                Lo += ShadeLight(int(clusterLightIndices[cluster.x + k]), N, V, albedo, F0, metallic, roughness);
             }
             
             vec3 ambient = vec3(0.03) * albedo * ao;
@@ -352,18 +360,19 @@ bool ForwardRenderPipeline::Initialize(int width, int height) {
             color = pow(color, vec3(1.0/2.2));
             FragColor = vec4(color, alpha);
         }
-    )";
+    )"));
     
     m_transparentShader->LoadFromSource(vertexShaderSource, transparentFragmentSource);
     m_effectsShader->LoadFromSource(vertexShaderSource, fragmentShaderSource);
+    FrameUniforms::BindBlocks(*m_forwardShader);
+    FrameUniforms::BindBlocks(*m_transparentShader);
+    FrameUniforms::BindBlocks(*m_effectsShader);
     if (!m_depthShader) {
-        std::string depthVS = R"(
-            #version 330 core
-            layout (location = 0) in vec3 aPos;
-            uniform mat4 model;
+        std::string depthVS = std::string("#version 330 core\n") + VertexPacking::GetShaderDeclarations() + R"(
+            layout (location = 3) in mat4 aInstanceModel;
             uniform mat4 lightSpaceMatrix;
             void main() {
-                gl_Position = lightSpaceMatrix * vec4(aPos, 1.0);
+                gl_Position = lightSpaceMatrix * aInstanceModel * vec4(DecodePosition(), 1.0);
             }
         )";
         std::string depthFS = R"(
@@ -384,6 +393,12 @@ void ForwardRenderPipeline::Render(World* world) {
         return;
     }
 
+    {
+        PROFILE_SCOPE("ForwardPipeline::Visibility");
+        m_visibility.Update(world);
+        m_visibility.SelectLODs(m_renderData.viewMatrix, m_renderData.projectionMatrix);
+    }
+
     {
         PROFILE_GPU("ForwardPipeline::ShadowPass");
         RenderShadowPass(world);
@@ -489,37 +504,36 @@ void ForwardRenderPipeline::RenderOpaqueObjects(World* world) {
         return;
     }
     m_forwardShader->Use();
-    m_forwardShader->SetMatrix4("projection", m_renderData.projectionMatrix);
     
     if (!m_cachedLightManager) {
         m_cachedLightManager = std::make_unique<LightManager>();
+        m_cachedLightManager->SetLightLimit(LightClusterGrid::MaxLights);
     }
     m_cachedLightManager->CollectLights(world);
     m_cachedLightManager->ApplyBrightnessLimits();
     
     auto activeLights = m_cachedLightManager->GetActiveLights();
+    std::vector<LightManager::ShaderLightData> lightData;
+    m_cachedLightManager->GetShaderLightData(lightData);
 
-    int lightHasShadowArr[32] = {0};
-    int shadowTypeArr[32] = {0};
-    int shadowSamplerIdxArr[32] = {0};
-    float shadowBiasesArr[32] = {0};
-    float shadowTexelSizesArr[32] = {0};
-    Vector3 shadowLightPosArr[32];
-    float shadowNearArr[32] = {0};
-    float shadowFarArr[32] = {0};
-    Matrix4 lightSpaceMatricesArr[32];
+    m_frameUniforms.SetCamera(m_renderData.viewMatrix, m_renderData.projectionMatrix);
+    int lightCount = m_frameUniforms.SetLights(lightData);
 
     int used2D = 0;
     int usedCube = 0;
     const int base2D = 5;
     const int baseCube = base2D + 8;
 
+    int units2D[8];
+    int unitsCube[8];
     for (int i = 0; i < 8; ++i) {
-        m_forwardShader->SetInt("shadowMaps2D[" + std::to_string(i) + "]", base2D + i);
-        m_forwardShader->SetInt("shadowMapsCube[" + std::to_string(i) + "]", baseCube + i);
+        units2D[i] = base2D + i;
+        unitsCube[i] = baseCube + i;
     }
+    m_forwardShader->SetIntArray(ShadowMaps2DID, units2D, 8);
+    m_forwardShader->SetIntArray(ShadowMapsCubeID, unitsCube, 8);
 
-    for (size_t i = 0; i < activeLights.size() && i < 32; ++i) {
+    for (size_t i = 0; i < activeLights.size() && i < static_cast<size_t>(lightCount); ++i) {
         Light* l = activeLights[i];
         if (!l || !l->GetCastShadows()) continue;
         l->InitializeShadowMap();
@@ -527,71 +541,41 @@ void ForwardRenderPipeline::RenderOpaqueObjects(World* world) {
         auto fb = l->GetShadowFramebuffer();
         if (!sm || !fb) continue;
 
-        lightHasShadowArr[i] = 1;
-        shadowBiasesArr[i] = l->GetShadowBias();
-
-        if (l->GetType() == LightType::Point) {
-            shadowTypeArr[i] = 1;
-            shadowLightPosArr[i] = l->GetPosition();
-            shadowNearArr[i] = l->GetData().shadowNearPlane;
-            shadowFarArr[i] = l->GetData().shadowFarPlane;
-
-            int cubeIdx = usedCube;
-            shadowSamplerIdxArr[i] = cubeIdx;
-            int unit = baseCube + cubeIdx;
-            sm->Bind(unit);
+        bool isPoint = l->GetType() == LightType::Point;
+        if ((isPoint && usedCube >= 8) || (!isPoint && used2D >= 8)) continue;
+
+        LightBlockEntry& entry = m_frameUniforms.GetLight(static_cast<int>(i));
+        entry.typeShadow[1] = 1;
+        entry.shadowParams[0] = l->GetShadowBias();
+
+        if (isPoint) {
+            Vector3 lightPosition = l->GetPosition();
+            entry.typeShadow[2] = 1;
+            entry.typeShadow[3] = usedCube;
+            entry.shadowLightPosition[0] = lightPosition.x;
+            entry.shadowLightPosition[1] = lightPosition.y;
+            entry.shadowLightPosition[2] = lightPosition.z;
+            entry.shadowParams[2] = l->GetData().shadowNearPlane;
+            entry.shadowParams[3] = l->GetData().shadowFarPlane;
+            sm->Bind(baseCube + usedCube);
             usedCube++;
         } else {
-            shadowTypeArr[i] = (l->GetType() == LightType::Directional) ? 0 : 2;
-            lightSpaceMatricesArr[i] = l->GetLightSpaceMatrix();
-            shadowTexelSizesArr[i] = 1.0f / static_cast<float>(l->GetShadowMapSize());
-
-            int idx2d = used2D;
-            shadowSamplerIdxArr[i] = idx2d;
-            int unit = base2D + idx2d;
-            sm->Bind(unit);
+            entry.typeShadow[2] = (l->GetType() == LightType::Directional) ? 0 : 2;
+            entry.typeShadow[3] = used2D;
+            entry.lightSpace = l->GetLightSpaceMatrix();
+            entry.shadowParams[1] = 1.0f / static_cast<float>(l->GetShadowMapSize());
+            sm->Bind(base2D + used2D);
             used2D++;
         }
     }
 
-    for (int i = 0; i < 32; ++i) {
-        m_forwardShader->SetInt("lightHasShadow[" + std::to_string(i) + "]", lightHasShadowArr[i]);
-        m_forwardShader->SetInt("shadowType[" + std::to_string(i) + "]", shadowTypeArr[i]);
-        m_forwardShader->SetInt("shadowSamplerIndex[" + std::to_string(i) + "]", shadowSamplerIdxArr[i]);
-        m_forwardShader->SetFloat("shadowBiases[" + std::to_string(i) + "]", shadowBiasesArr[i]);
-        m_forwardShader->SetFloat("shadowTexelSizes[" + std::to_string(i) + "]", shadowTexelSizesArr[i]);
-        m_forwardShader->SetVector3("shadowLightPositions[" + std::to_string(i) + "]", shadowLightPosArr[i]);
-        m_forwardShader->SetFloat("shadowNearPlanes[" + std::to_string(i) + "]", shadowNearArr[i]);
-        m_forwardShader->SetFloat("shadowFarPlanes[" + std::to_string(i) + "]", shadowFarArr[i]);
-        m_forwardShader->SetMatrix4("lightSpaceMatrices[" + std::to_string(i) + "]", lightSpaceMatricesArr[i]);
-    }
-    
-    Logger::Debug("ForwardRenderPipeline: Setting view matrix");
-    Logger::Debug("View matrix: [" + 
-        std::to_string(m_renderData.viewMatrix.m[0]) + ", " + std::to_string(m_renderData.viewMatrix.m[1]) + ", " + std::to_string(m_renderData.viewMatrix.m[2]) + ", " + std::to_string(m_renderData.viewMatrix.m[3]) + "]");
-    Logger::Debug("             [" + 
-        std::to_string(m_renderData.viewMatrix.m[4]) + ", " + std::to_string(m_renderData.viewMatrix.m[5]) + ", " + std::to_string(m_renderData.viewMatrix.m[6]) + ", " + std::to_string(m_renderData.viewMatrix.m[7]) + "]");
-    m_forwardShader->SetMatrix4("view", m_renderData.viewMatrix);
-    Logger::Debug("ForwardRenderPipeline: Setting projection matrix");
-    Logger::Debug("Projection matrix: [" + 
-        std::to_string(m_renderData.projectionMatrix.m[0]) + ", " + std::to_string(m_renderData.projectionMatrix.m[1]) + ", " + std::to_string(m_renderData.projectionMatrix.m[2]) + ", " + std::to_string(m_renderData.projectionMatrix.m[3]) + "]");
-    Logger::Debug("                   [" + 
-        std::to_string(m_renderData.projectionMatrix.m[4]) + ", " + std::to_string(m_renderData.projectionMatrix.m[5]) + ", " + std::to_string(m_renderData.projectionMatrix.m[6]) + ", " + std::to_string(m_renderData.projectionMatrix.m[7]) + "]");
-    m_forwardShader->SetMatrix4("projection", m_renderData.projectionMatrix);
-    
-    std::vector<LightManager::ShaderLightData> lightData;
-    m_cachedLightManager->GetShaderLightData(lightData);
-    
-    m_forwardShader->SetInt("numLights", static_cast<int>(lightData.size()));
-    
-    for (size_t i = 0; i < lightData.size() && i < MAX_LIGHTS; ++i) {
-        std::string indexStr = std::to_string(i);
-        m_forwardShader->SetVector3("lightPositions[" + indexStr + "]", lightData[i].position);
-        m_forwardShader->SetVector3("lightColors[" + indexStr + "]", lightData[i].color);
-        m_forwardShader->SetFloat("lightIntensities[" + indexStr + "]", lightData[i].intensity);
-        m_forwardShader->SetInt("lightTypes[" + indexStr + "]", lightData[i].type);
-        m_forwardShader->SetFloat("lightRanges[" + indexStr + "]", lightData[i].range);
-    }
+    // Camera and all light data go to the GPU in one write per block
+    m_frameUniforms.Upload();
+
+    // Point and spot lights are binned into view clusters; fragments shade only their cluster's list
+    m_lightClusters.Build(lightData, m_renderData.viewMatrix, m_renderData.projectionMatrix);
+    m_lightClusters.Upload();
+    SetClusterUniforms(*m_forwardShader);
 
     if (!m_lightOcclusion) {
         m_lightOcclusion = std::make_unique<LightOcclusion>();
@@ -608,11 +592,20 @@ void ForwardRenderPipeline::RenderOpaqueObjects(World* world) {
     int baseOffset = 0;
     int farOffset = 0;
 
-    for (size_t li = 0; li < activeLights.size(); ++li) {
+    // Shadow volumes are looked up by LightData index, so only those lights get them; all of
+    // them are built in one request so silhouette extraction runs as a single parallel pass
+    const size_t volumeLightCount = std::min(activeLights.size(), static_cast<size_t>(FrameUniforms::MaxLights));
+    std::vector<ShadowVolumeRequest> volumeRequests;
+    for (size_t li = 0; li < volumeLightCount; ++li) {
+        if (activeLights[li]) {
+            volumeRequests.push_back({activeLights[li], static_cast<int>(li), 1000.0f});
+        }
+    }
+    m_lightOcclusion->BuildShadowVolumes(volumeRequests, world);
+
+    for (size_t li = 0; li < volumeLightCount; ++li) {
         Light* l = activeLights[li];
         if (!l) continue;
-        float dirFar = 1000.0f;
-        m_lightOcclusion->BuildShadowVolumesForLight(l, world, static_cast<int>(li), dirFar);
         const auto* vols = m_lightOcclusion->GetVolumesForLight(l);
         if (!vols) continue;
 
@@ -659,11 +652,7 @@ void ForwardRenderPipeline::RenderOpaqueObjects(World* world) {
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_shadowVolumeVerticesSSBO);
 
     Logger::Debug("Shadow volumes: headers=" + std::to_string(totalHeaders) + ", headerInts=" + std::to_string(headersCPU.size()) + ", vertsFloats=" + std::to_string(vertsCPU.size()));
-    m_forwardShader->SetInt("numVolumeHeaders", totalHeaders);
-
-    Matrix4 invViewMatrix = m_renderData.viewMatrix.Inverted();
-    Vector3 cameraPosition = Vector3(invViewMatrix.m[12], invViewMatrix.m[13], invViewMatrix.m[14]);
-    m_forwardShader->SetVector3("viewPos", cameraPosition);
+    m_forwardShader->SetInt(NumVolumeHeadersID, totalHeaders);
 
     GLint currProg = 0, vao=0, ebo=0, abo=0, dfb=0;
     glGetIntegerv(GL_CURRENT_PROGRAM, &currProg);
@@ -696,56 +685,35 @@ void ForwardRenderPipeline::RenderOpaqueObjects(World* world) {
         Logger::Error("Forward draw with no current program bound");
     }
     
-    int entitiesRendered = 0;
-    
-    for (const auto& entity : world->GetEntities()) {
-        if (world->HasComponent<TransformComponent>(entity) && world->HasComponent<MeshComponent>(entity)) {
-            auto* transformComp = world->GetComponent<TransformComponent>(entity);
-            auto* meshComp = world->GetComponent<MeshComponent>(entity);
-            if (transformComp && meshComp && meshComp->HasMesh() && meshComp->IsVisible()) {
-                Matrix4 modelMatrix = transformComp->transform.GetLocalToWorldMatrix();
-                Vector3 position = transformComp->transform.GetPosition();
-                Logger::Debug("Entity position: (" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(position.z) + ")");
-                m_forwardShader->SetMatrix4("model", modelMatrix);
-                
-                meshComp->GetMesh()->Draw();
-                entitiesRendered++;
-            }
-        }
+    m_visibility.Cull(m_renderData.projectionMatrix * m_renderData.viewMatrix, m_visibleOpaque);
+    const auto& renderables = m_visibility.GetRenderables();
+    const auto& view = m_renderData.viewMatrix.m;
+    m_renderQueue.Clear();
+    for (uint32_t index : m_visibleOpaque) {
+        const Renderable& renderable = renderables[index];
+        Vector3 center = (renderable.boundsMin + renderable.boundsMax) * 0.5f;
+        float depth = -(view[2] * center.x + view[6] * center.y + view[10] * center.z + view[14]);
+        m_renderQueue.Submit(RenderPass::Opaque, ForwardShaderKey, 0, renderable.mesh, renderable.model, depth);
+    }
+    m_renderQueue.Sort();
+    m_renderQueue.Upload();
+    for (const RenderBatch& batch : m_renderQueue.GetBatches()) {
+        m_renderQueue.DrawBatch(batch);
     }
     
-    Logger::Debug("Forward rendering: Rendered " + std::to_string(entitiesRendered) + " entities");
+    Logger::Debug("Forward rendering: Rendered " + std::to_string(m_visibleOpaque.size()) + " of " + std::to_string(renderables.size()) +
+                  " entities in " + std::to_string(m_renderQueue.GetBatches().size()) + " instanced draws");
 }
 
-void ForwardRenderPipeline::RenderTransparentObjects(World* world) {
+void ForwardRenderPipeline::RenderTransparentObjects(World* /*world*/) {
     if (!m_transparentShader) {
         return;
     }
     
+    // Camera and lights come from the uniform blocks uploaded by the opaque pass
     m_transparentShader->Use();
-    
-    LightManager transparentLightManager;
-    transparentLightManager.CollectLights(world);
-    transparentLightManager.ApplyBrightnessLimits();
-    
-    std::vector<LightManager::ShaderLightData> transparentLightData;
-    transparentLightManager.GetShaderLightData(transparentLightData);
-    
-    m_transparentShader->SetInt("numLights", static_cast<int>(transparentLightData.size()));
-    
-    for (size_t i = 0; i < transparentLightData.size() && i < MAX_LIGHTS; ++i) {
-        std::string indexStr = std::to_string(i);
-        m_transparentShader->SetVector3("lightPositions[" + indexStr + "]", transparentLightData[i].position);
-        m_transparentShader->SetVector3("lightColors[" + indexStr + "]", transparentLightData[i].color);
-        m_transparentShader->SetFloat("lightIntensities[" + indexStr + "]", transparentLightData[i].intensity);
-        m_transparentShader->SetInt("lightTypes[" + indexStr + "]", transparentLightData[i].type);
-        m_transparentShader->SetFloat("lightRanges[" + indexStr + "]", transparentLightData[i].range);
-    }
-    
-    Matrix4 invViewMatrix = m_renderData.viewMatrix.Inverted();
-    Vector3 cameraPosition = Vector3(invViewMatrix.m[12], invViewMatrix.m[13], invViewMatrix.m[14]);
-    m_transparentShader->SetVector3("viewPos", cameraPosition);
-    m_transparentShader->SetFloat("alpha", 0.7f);
+    m_transparentShader->SetFloat(AlphaID, 0.7f);
+    SetClusterUniforms(*m_transparentShader);
     
     Logger::Debug("Rendered transparent objects (simplified for demo)");
 }
@@ -810,7 +778,7 @@ void ForwardRenderPipeline::CompositePass() {
     auto finalTexture = m_framebuffer->GetColorTexture(0);
     if (finalTexture) {
         finalTexture->Bind(0);
-        m_compositeShader->SetInt("finalTexture", 0);
+        m_compositeShader->SetInt(FinalTextureID, 0);
     }
     
     RenderFullscreenQuad();
@@ -822,10 +790,15 @@ void ForwardRenderPipeline::RenderShadowPass(World* world) {
 
     if (!m_cachedLightManager) {
         m_cachedLightManager = std::make_unique<LightManager>();
+        m_cachedLightManager->SetLightLimit(LightClusterGrid::MaxLights);
     }
     m_cachedLightManager->CollectLights(world);
     auto act = m_cachedLightManager->GetActiveLights();
-    if (act.empty()) return;
+    if (act.empty()) {
+        // Changes made while nothing casts would otherwise go unnoticed by cached maps
+        m_shadowCache.Invalidate();
+        return;
+    }
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
@@ -833,13 +806,11 @@ void ForwardRenderPipeline::RenderShadowPass(World* world) {
 
     if (!m_depthShader) {
         m_depthShader = std::make_shared<Shader>();
-        std::string vsrc = R"(
-            #version 330 core
-            layout (location = 0) in vec3 aPos;
-            uniform mat4 model;
+        std::string vsrc = std::string("#version 330 core\n") + VertexPacking::GetShaderDeclarations() + R"(
+            layout (location = 3) in mat4 aInstanceModel;
             uniform mat4 lightSpaceMatrix;
             void main() {
-                gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+                gl_Position = lightSpaceMatrix * aInstanceModel * vec4(DecodePosition(), 1.0);
             }
         )";
         std::string fsrc = R"(
@@ -849,13 +820,21 @@ void ForwardRenderPipeline::RenderShadowPass(World* world) {
         m_depthShader->LoadFromSource(vsrc, fsrc);
     }
     m_depthShader->Use();
+    m_shadowCache.BeginFrame(m_visibility.GetChangedBounds());
 
-    for (auto* shadowLight : act) {
+    // Same selection as RenderOpaqueObjects: lights in LightData, up to 8 2D and 8 cube maps
+    int used2D = 0;
+    int usedCube = 0;
+    for (size_t i = 0; i < act.size() && i < static_cast<size_t>(FrameUniforms::MaxLights); ++i) {
+        Light* shadowLight = act[i];
         if (!shadowLight || !shadowLight->GetCastShadows()) continue;
         shadowLight->InitializeShadowMap();
         auto fb = shadowLight->GetShadowFramebuffer();
         auto sm = shadowLight->GetShadowMap();
         if (!fb || !sm) continue;
+        int& usedSlots = shadowLight->GetType() == LightType::Point ? usedCube : used2D;
+        if (usedSlots >= 8) continue;
+        ++usedSlots;
 
         int sz = shadowLight->GetData().shadowMapSize;
 
@@ -872,79 +851,76 @@ void ForwardRenderPipeline::RenderShadowPass(World* world) {
 
             Vector3 lp = shadowLight->GetPosition();
             for (int face = 0; face < 6; ++face) {
+                Matrix4 view = Matrix4::LookAt(lp, lp + dirs[face], ups[face]);
+                Matrix4 lightSpace = proj * view;
+                if (!m_shadowCache.NeedsUpdate(sm.get(), face, lightSpace)) {
+                    continue;
+                }
+
                 size_t shadowDrawnThisFace = 0;
                 fb->Bind();
                 fb->AttachDepthCubeFace(sm, face);
                 glViewport(0, 0, sz, sz);
                 glClear(GL_DEPTH_BUFFER_BIT);
+                m_depthShader->SetMatrix4(LightSpaceMatrixID, lightSpace);
 
-                Matrix4 view = Matrix4::LookAt(lp, lp + dirs[face], ups[face]);
-                Matrix4 lightSpace = proj * view;
-                m_depthShader->SetMatrix4("lightSpaceMatrix", lightSpace);
-
-                Vector3 cameraPos = Vector3(m_renderData.viewMatrix.Inverted().m[12], 
-                                           m_renderData.viewMatrix.Inverted().m[13], 
-                                           m_renderData.viewMatrix.Inverted().m[14]);
-                
-                for (const auto& e : world->GetEntities()) {
-                    auto* t = world->GetComponent<TransformComponent>(e);
-                    auto* mc = world->GetComponent<MeshComponent>(e);
-                    if (!t || !mc) continue;
-                    auto mesh = mc->GetMesh();
-                    if (!mesh) continue;
-
-                    float distance = (t->transform.GetPosition() - cameraPos).Length();
-                    if (distance > 100.0f) continue;
-
-                    Matrix4 model = t->transform.GetLocalToWorldMatrix();
-                    m_depthShader->SetMatrix4("model", model);
-                    ++shadowDrawnThisFace;
-
-                    mesh->Draw();
-                }
+                m_visibility.Cull(lightSpace, m_visibleShadow);
+                shadowDrawnThisFace = DrawShadowCasters();
                 Logger::Debug(std::string("Shadow pass (point) face ") + std::to_string(face) + " drew " + std::to_string(shadowDrawnThisFace) + " meshes");
             }
             fb->Unbind();
         } else {
+            Matrix4 lightSpace = shadowLight->GetLightSpaceMatrix();
+            if (!m_shadowCache.NeedsUpdate(sm.get(), 0, lightSpace)) {
+                continue;
+            }
+
             fb->Bind();
             glViewport(0, 0, sz, sz);
             glClear(GL_DEPTH_BUFFER_BIT);
             size_t shadowDrawn = 0;
+            m_depthShader->SetMatrix4(LightSpaceMatrixID, lightSpace);
 
-            Matrix4 lightSpace = shadowLight->GetLightSpaceMatrix();
-            m_depthShader->SetMatrix4("lightSpaceMatrix", lightSpace);
-
-            Vector3 cameraPos = Vector3(m_renderData.viewMatrix.Inverted().m[12], 
-                                       m_renderData.viewMatrix.Inverted().m[13], 
-                                       m_renderData.viewMatrix.Inverted().m[14]);
-            
-            for (const auto& e : world->GetEntities()) {
-                auto* t = world->GetComponent<TransformComponent>(e);
-                auto* mc = world->GetComponent<MeshComponent>(e);
-                if (!t || !mc) continue;
-                auto mesh = mc->GetMesh();
-                if (!mesh) continue;
-
-                float distance = (t->transform.GetPosition() - cameraPos).Length();
-                if (distance > 100.0f) continue;
-
-                Matrix4 model = t->transform.GetLocalToWorldMatrix();
-                m_depthShader->SetMatrix4("model", model);
-                ++shadowDrawn;
-
-                mesh->Draw();
-            }
+            m_visibility.Cull(lightSpace, m_visibleShadow);
+            shadowDrawn = DrawShadowCasters();
             Logger::Debug("Shadow pass drew " + std::to_string(shadowDrawn) + " meshes");
             fb->Unbind();
         }
     }
 
+    m_shadowCache.EndFrame();
+    Logger::Debug("Shadow pass: " + std::to_string(m_shadowCache.GetRenderedFaceCount()) + " faces rendered, " +
+                  std::to_string(m_shadowCache.GetCachedFaceCount()) + " reused");
+
     glCullFace(GL_BACK);
     glViewport(0, 0, m_renderData.viewportWidth, m_renderData.viewportHeight);
 }
 
 
 
+void ForwardRenderPipeline::SetClusterUniforms(Shader& shader) {
+    shader.SetInt4(ClusterGridID, LightClusterGrid::GridX, LightClusterGrid::GridY, LightClusterGrid::GridZ, m_lightClusters.GetGlobalLightCount());
+    shader.SetVector4(ClusterParamsID, Vector4(m_lightClusters.GetDepthScale(), m_lightClusters.GetDepthBias(),
+                                               static_cast<float>(LightClusterGrid::GridX) / std::max(1, m_renderData.viewportWidth),
+                                               static_cast<float>(LightClusterGrid::GridY) / std::max(1, m_renderData.viewportHeight)));
+    shader.SetInt(ClusterLogDepthID, m_lightClusters.IsLogarithmic() ? 1 : 0);
+}
+
+// Depth-only draws of m_visibleShadow, batched by mesh; returns the number of casters drawn
+size_t ForwardRenderPipeline::DrawShadowCasters() {
+    m_renderQueue.Clear();
+    for (uint32_t index : m_visibleShadow) {
+        const Renderable& renderable = m_visibility.GetRenderables()[index];
+        m_renderQueue.Submit(RenderPass::Shadow, DepthShaderKey, 0, renderable.mesh, renderable.model, 0.0f);
+    }
+    m_renderQueue.Sort();
+    m_renderQueue.Upload();
+    for (const RenderBatch& batch : m_renderQueue.GetBatches()) {
+        m_renderQueue.DrawBatch(batch);
+    }
+    return m_visibleShadow.size();
+}
+
 void ForwardRenderPipeline::RenderFullscreenQuad() {
     static unsigned int quadVAO = 0;
     static unsigned int quadVBO = 0;
@@ -4,7 +4,12 @@
 #include "../Core/Texture.h"
 #include "../Core/FrameBuffer.h"
 #include "../Shaders/Shader.h"
+#include "../Shaders/FrameUniforms.h"
 #include "../Lighting/LightManager.h"
+#include "../Lighting/LightClusters.h"
+#include "../Lighting/ShadowCache.h"
+#include "../Culling/VisibilitySystem.h"
+#include "../Core/RenderQueue.h"
 #include <memory>
 #include <vector>
 
@@ -42,6 +47,8 @@ private:
     void RenderFullscreenQuad();
 
     void RenderShadowPass(World* world);
+    size_t DrawShadowCasters();
+    void SetClusterUniforms(Shader& shader);
 
     std::shared_ptr<Shader> m_forwardShader;
     std::shared_ptr<Shader> m_transparentShader;
@@ -63,6 +70,15 @@ private:
     std::unique_ptr<LightOcclusion> m_lightOcclusion;
     
     std::unique_ptr<LightManager> m_cachedLightManager;
+    
+    // Per-frame renderable bounds and the compact visible lists built from them for each pass
+    VisibilitySystem m_visibility;
+    std::vector<uint32_t> m_visibleOpaque;
+    std::vector<uint32_t> m_visibleShadow;
+    RenderQueue m_renderQueue;
+    FrameUniforms m_frameUniforms;
+    LightClusterGrid m_lightClusters;
+    ShadowCache m_shadowCache;
 };
 
 }
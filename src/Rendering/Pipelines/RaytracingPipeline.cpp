@@ -2,11 +2,14 @@
 #include "../../Core/Logging/Logger.h"
 #include "../../Core/Profiling/Profiler.h"
 #include "../../Core/ECS/World.h"
+#include "../../Core/Threading/WorkerPool.h"
 #include "../Core/OpenGLHeaders.h"
 #include <cmath>
 #include <algorithm>
 #include <random>
 #include <limits>
+#include <string>
+#include <chrono>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -14,6 +17,43 @@
 
 namespace GameEngine {
 
+namespace {
+
+// PCG-style hash; gives each (pixel, sample index) its own decorrelated random stream
+uint32_t HashSeed(uint32_t x, uint32_t y, uint32_t sample) {
+    uint32_t state = x * 1973u + y * 9277u + sample * 26699u + 0x9E3779B9u;
+    state = state * 747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float NextRandom(uint32_t& state) {
+    state = state * 747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    word = (word >> 22u) ^ word;
+    return static_cast<float>(word >> 8) * (1.0f / 16777216.0f);
+}
+
+float Luminance(const Vector3& color) {
+    return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+}
+
+Vector3 SampleCosineHemisphere(const Vector3& normal, float u1, float u2) {
+    // Orthonormal basis around the normal (Duff et al. 2017)
+    float sign = std::copysign(1.0f, normal.z);
+    float a = -1.0f / (sign + normal.z);
+    float b = normal.x * normal.y * a;
+    Vector3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+    Vector3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+    
+    float r = std::sqrt(u1);
+    float phi = 2.0f * static_cast<float>(M_PI) * u2;
+    float z = std::sqrt(std::max(0.0f, 1.0f - u1));
+    return tangent * (r * std::cos(phi)) + bitangent * (r * std::sin(phi)) + normal * z;
+}
+
+}
+
 RaytracingPipeline::RaytracingPipeline() 
     : m_cameraPos(0.0f, 0.0f, 3.0f)
     , m_cameraTarget(0.0f, 0.0f, 0.0f)
@@ -35,30 +75,10 @@ bool RaytracingPipeline::Initialize(int width, int height) {
     m_renderData.viewportWidth = width;
     m_renderData.viewportHeight = height;
     
-    m_framebuffer = std::make_shared<FrameBuffer>(width, height);
-    
-    m_colorTexture = std::make_shared<Texture>();
-    m_colorTexture->CreateEmpty(width, height, TextureFormat::RGBA8);
-    
-    m_accumulation.assign(width * height, Vector3(0.0f, 0.0f, 0.0f));
-    m_accumulatedFrames = 0;
-    
-    m_framebuffer->AddColorAttachment(TextureFormat::RGBA8);
-    
-    if (!m_framebuffer->IsComplete()) {
-        Logger::Error("Raytracing framebuffer is not complete");
+    if (!CreateFrameTargets(width, height)) {
         return false;
     }
     
-    AddSphere(Sphere(Vector3(0.0f, 0.0f, 0.0f), 1.0f, Vector3(1.0f, 0.2f, 0.2f), 0.3f));
-    AddSphere(Sphere(Vector3(-2.0f, 0.0f, -1.0f), 0.8f, Vector3(0.2f, 1.0f, 0.2f), 0.1f));
-    AddSphere(Sphere(Vector3(2.0f, 0.0f, -1.0f), 0.6f, Vector3(0.2f, 0.2f, 1.0f), 0.8f));
-    AddSphere(Sphere(Vector3(0.0f, -100.5f, -1.0f), 100.0f, Vector3(0.8f, 0.8f, 0.8f), 0.0f));
-    
-    AddTriangle(Triangle(Vector3(-1, -1, -5), Vector3(1, -1, -5), Vector3(0, 1, -5), Vector3(0.8f, 0.3f, 0.3f), 0.1f));
-    AddTriangle(Triangle(Vector3(-3, -1, -8), Vector3(-1, -1, -8), Vector3(-2, 1, -8), Vector3(0.3f, 0.8f, 0.3f), 0.3f));
-    AddTriangle(Triangle(Vector3(1, -1, -6), Vector3(3, -1, -6), Vector3(2, 1, -6), Vector3(0.3f, 0.3f, 0.8f), 0.5f));
-    
     if (m_useComputeShader) {
         m_computeShader = std::make_shared<Shader>();
         
@@ -74,11 +94,33 @@ bool RaytracingPipeline::Initialize(int width, int height) {
     BuildBVH();
     
     m_initialized = true;
-    Logger::Info("Raytracing pipeline initialized with " + std::to_string(m_spheres.size()) + " spheres and " + std::to_string(m_triangles.size()) + " triangles");
+    Logger::Info("Raytracing pipeline initialized");
     return true;
 }
 
-void RaytracingPipeline::Render(World* /*world*/) {
+bool RaytracingPipeline::CreateFrameTargets(int width, int height) {
+    m_framebuffer = std::make_shared<FrameBuffer>(width, height);
+    
+    m_colorTexture = std::make_shared<Texture>();
+    m_colorTexture->CreateEmpty(width, height, TextureFormat::RGBA8);
+    
+    m_accumulation.assign(width * height, Vector3(0.0f, 0.0f, 0.0f));
+    m_accumulationLumSq.assign(static_cast<size_t>(width) * height, 0.0f);
+    m_accumulatedFrames = 0;
+    m_frameColor.assign(width * height, Vector3(0.0f, 0.0f, 0.0f));
+    m_framePixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    BuildTileOrder(width, height);
+    
+    m_framebuffer->AddColorAttachment(TextureFormat::RGBA8);
+    
+    if (!m_framebuffer->IsComplete()) {
+        Logger::Error("Raytracing framebuffer is not complete");
+        return false;
+    }
+    return true;
+}
+
+void RaytracingPipeline::Render(World* world) {
     PROFILE_GPU("RaytracingPipeline::Render");
     if (!m_initialized) {
         return;
@@ -89,42 +131,91 @@ void RaytracingPipeline::Render(World* /*world*/) {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
     
+    TraceFrame(world);
+    
     int width = m_renderData.viewportWidth;
     int height = m_renderData.viewportHeight;
+    if (m_colorTexture && m_colorTexture->GetWidth() == width && m_colorTexture->GetHeight() == height) {
+        PROFILE_SCOPE("Raytracing::Upload");
+        m_colorTexture->UpdateRegion(0, 0, width, height, m_framePixels.data());
+    }
     
-    std::vector<Vector3> framebuffer(width * height);
+    Logger::Debug("Raytraced frame with " + std::to_string(width) + "x" + std::to_string(height) + " pixels");
+    
+    m_framebuffer->Unbind();
+}
+
+void RaytracingPipeline::TraceFrame(World* world) {
+    PROFILE_SCOPE("RaytracingPipeline::TraceFrame");
+    int width = m_renderData.viewportWidth;
+    int height = m_renderData.viewportHeight;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    
+    if (m_frameColor.size() != static_cast<size_t>(width) * height) {
+        // Viewport changed without a Resize call; the accumulation restarts at the new size
+        m_accumulation.assign(width * height, Vector3(0.0f, 0.0f, 0.0f));
+        m_accumulationLumSq.assign(static_cast<size_t>(width) * height, 0.0f);
+        m_accumulatedFrames = 0;
+        m_frameColor.assign(width * height, Vector3(0.0f, 0.0f, 0.0f));
+        m_framePixels.assign(static_cast<size_t>(width) * height * 4, 0);
+        BuildTileOrder(width, height);
+    }
     
     {
-        PROFILE_SCOPE("Raytracing::TileRendering");
-        const int tileSize = 32;
-        for (int y = 0; y < height; y += tileSize) {
-            for (int x = 0; x < width; x += tileSize) {
-                int endX = std::min(x + tileSize, width);
-                int endY = std::min(y + tileSize, height);
-                RenderTile(x, y, endX, endY, framebuffer);
-            }
+        PROFILE_SCOPE("Raytracing::SceneUpdate");
+        bool sceneChanged = m_scene.Update(world);
+        bool lightsChanged = m_mode == RaytracingMode::PathTraced && UpdatePathLights(world);
+        if (sceneChanged || lightsChanged) {
+            // Scene geometry, materials or lights changed, so earlier samples no longer match
+            ResetAccumulation();
         }
     }
     
-    m_accumulatedFrames++;
-    
-    std::vector<unsigned char> pixels(width * height * 4);
-    for (int i = 0; i < width * height; ++i) {
-        Vector3 color = framebuffer[i];
+    if (m_mode == RaytracingMode::Interactive) {
+        m_activeTiles.resize(m_tiles.size());
+        for (size_t i = 0; i < m_tiles.size(); ++i) {
+            m_activeTiles[i] = i;
+        }
         
-        color.x = std::sqrt(std::clamp(color.x, 0.0f, 1.0f));
-        color.y = std::sqrt(std::clamp(color.y, 0.0f, 1.0f));
-        color.z = std::sqrt(std::clamp(color.z, 0.0f, 1.0f));
+        // Count this frame before tracing so the running average divides by the samples taken
+        m_accumulatedFrames++;
         
-        pixels[i * 4 + 0] = static_cast<unsigned char>(color.x * 255);
-        pixels[i * 4 + 1] = static_cast<unsigned char>(color.y * 255);
-        pixels[i * 4 + 2] = static_cast<unsigned char>(color.z * 255);
-        pixels[i * 4 + 3] = 255;
+        PROFILE_SCOPE("Raytracing::TileRendering");
+        RenderTilesCPU();
+        return;
     }
     
-    Logger::Debug("Raytraced frame with " + std::to_string(width) + "x" + std::to_string(height) + " pixels");
-    
-    m_framebuffer->Unbind();
+    // Progressive passes over the tiles that have not converged yet, repeated while the next
+    // pass is expected to fit in the frame budget
+    using Clock = std::chrono::steady_clock;
+    auto frameStart = Clock::now();
+    double lastPassMs = 0.0;
+    for (;;) {
+        m_activeTiles.clear();
+        for (size_t i = 0; i < m_tiles.size(); ++i) {
+            if (!m_tiles[i].converged) {
+                m_activeTiles.push_back(i);
+            }
+        }
+        if (m_activeTiles.empty()) {
+            break;
+        }
+        
+        auto passStart = Clock::now();
+        m_accumulatedFrames++;
+        {
+            PROFILE_SCOPE("Raytracing::PathTracePass");
+            RenderTilesCPU();
+        }
+        auto passEnd = Clock::now();
+        lastPassMs = std::chrono::duration<double, std::milli>(passEnd - passStart).count();
+        double frameMs = std::chrono::duration<double, std::milli>(passEnd - frameStart).count();
+        if (m_frameTimeBudgetMs <= 0.0f || frameMs + lastPassMs > m_frameTimeBudgetMs) {
+            break;
+        }
+    }
 }
 
 void RaytracingPipeline::Resize(int width, int height) {
@@ -135,9 +226,9 @@ void RaytracingPipeline::Resize(int width, int height) {
     m_renderData.viewportWidth = width;
     m_renderData.viewportHeight = height;
     
-    if (m_initialized) {
-        Cleanup();
-        Initialize(width, height);
+    // Only the size-dependent targets are recreated; the scene and its BLAS cache are kept
+    if (m_initialized && !CreateFrameTargets(width, height)) {
+        Logger::Error("Failed to resize raytracing targets");
     }
     
     Logger::Info("Raytracing pipeline resized to " + std::to_string(width) + "x" + std::to_string(height));
@@ -161,12 +252,75 @@ void RaytracingPipeline::BeginFrame(const RenderData& renderData) {
                 || (prevUp - m_cameraUp).LengthSquared() > 1e-6f
                 || std::abs(prevFov - m_fov) > 1e-6f;
     if (changed && !m_accumulation.empty()) {
-        std::fill(m_accumulation.begin(), m_accumulation.end(), Vector3(0.0f, 0.0f, 0.0f));
-        m_accumulatedFrames = 0;
+        ResetAccumulation();
     }
     prevPos = m_cameraPos; prevTarget = m_cameraTarget; prevUp = m_cameraUp; prevFov = m_fov;
 }
 
+void RaytracingPipeline::SetCamera(const Vector3& position, const Vector3& target, const Vector3& up, float fovDegrees) {
+    bool changed = (position - m_cameraPos).LengthSquared() > 1e-12f
+                || (target - m_cameraTarget).LengthSquared() > 1e-12f
+                || (up - m_cameraUp).LengthSquared() > 1e-12f
+                || std::abs(fovDegrees - m_fov) > 1e-6f;
+    m_cameraPos = position;
+    m_cameraTarget = target;
+    m_cameraUp = up;
+    m_fov = fovDegrees;
+    if (changed) {
+        ResetAccumulation();
+    }
+}
+
+void RaytracingPipeline::SetMode(RaytracingMode mode) {
+    if (mode == m_mode) {
+        return;
+    }
+    m_mode = mode;
+    m_lightSignature.clear();
+    ResetAccumulation();
+}
+
+void RaytracingPipeline::SetAdaptiveSampling(bool enabled, float errorThreshold, int minSamples) {
+    m_adaptiveSampling = enabled;
+    m_adaptiveErrorThreshold = std::max(0.0f, errorThreshold);
+    m_adaptiveMinSamples = std::max(2, minSamples);
+    for (auto& tile : m_tiles) {
+        tile.converged = IsTileConverged(tile);
+    }
+}
+
+void RaytracingPipeline::ResetAccumulation() {
+    std::fill(m_accumulation.begin(), m_accumulation.end(), Vector3(0.0f, 0.0f, 0.0f));
+    std::fill(m_accumulationLumSq.begin(), m_accumulationLumSq.end(), 0.0f);
+    for (auto& tile : m_tiles) {
+        tile.samples = 0;
+        tile.converged = false;
+    }
+    m_accumulatedFrames = 0;
+}
+
+int RaytracingPipeline::GetMinSampleCount() const {
+    if (m_tiles.empty()) {
+        return 0;
+    }
+    int minSamples = m_tiles.front().samples;
+    for (const auto& tile : m_tiles) {
+        minSamples = std::min(minSamples, tile.samples);
+    }
+    return minSamples;
+}
+
+float RaytracingPipeline::GetConvergedFraction() const {
+    if (m_tiles.empty()) {
+        return 0.0f;
+    }
+    size_t converged = 0;
+    for (const auto& tile : m_tiles) {
+        converged += tile.converged ? 1 : 0;
+    }
+    return static_cast<float>(converged) / static_cast<float>(m_tiles.size());
+}
+
 void RaytracingPipeline::EndFrame() {
     // Raytracing doesn't need special end frame handling
 }
@@ -195,7 +349,10 @@ void RaytracingPipeline::Cleanup() {
     m_colorTexture.reset();
     m_spheres.clear();
     m_triangles.clear();
-    m_bvhNodes.clear();
+    m_triangleBVH.Clear();
+    m_scene.Clear();
+    m_pathLights.clear();
+    m_lightSignature.clear();
     
     m_initialized = false;
     Logger::Info("Raytracing pipeline cleaned up");
@@ -203,55 +360,32 @@ void RaytracingPipeline::Cleanup() {
 
 void RaytracingPipeline::AddSphere(const Sphere& sphere) {
     m_spheres.push_back(sphere);
-    Logger::Info("Added sphere to raytracing scene. Total spheres: " + std::to_string(m_spheres.size()));
+    Logger::Debug("Added sphere to raytracing scene. Total spheres: " + std::to_string(m_spheres.size()));
 }
 
 void RaytracingPipeline::AddTriangle(const Triangle& triangle) {
     m_triangles.push_back(triangle);
-    Logger::Info("Added triangle to raytracing scene. Total triangles: " + std::to_string(m_triangles.size()));
+    Logger::Debug("Added triangle to raytracing scene. Total triangles: " + std::to_string(m_triangles.size()));
 }
 
 void RaytracingPipeline::ClearScene() {
     m_spheres.clear();
     m_triangles.clear();
-    m_bvhNodes.clear();
+    m_triangleBVH.Clear();
     Logger::Info("Cleared raytracing scene");
 }
 
 void RaytracingPipeline::BuildBVH() {
+    PROFILE_SCOPE("Raytracing::BuildBVH");
     if (m_triangles.empty()) {
+        m_triangleBVH.Clear();
         Logger::Warning("Cannot build BVH: no triangles in scene");
         return;
     }
 
-    m_bvhNodes.clear();
-    m_triangleIndices.clear();
-    m_bvhNodes.reserve(m_triangles.size() * 2);
-    m_bvhNodes.resize(1);
-
-    std::vector<int> indices(m_triangles.size());
-    for (size_t i = 0; i < m_triangles.size(); ++i) {
-        indices[i] = static_cast<int>(i);
-    }
-
-    Vector3 minBounds(1e30f, 1e30f, 1e30f);
-    Vector3 maxBounds(-1e30f, -1e30f, -1e30f);
-    for (const auto& tri : m_triangles) {
-        minBounds = Vector3::Min(minBounds, Vector3::Min(Vector3::Min(tri.v0, tri.v1), tri.v2));
-        maxBounds = Vector3::Max(maxBounds, Vector3::Max(Vector3::Max(tri.v0, tri.v1), tri.v2));
-    }
-
-    BVHNode& root = m_bvhNodes[0];
-    root.minBounds = minBounds;
-    root.maxBounds = maxBounds;
-    root.leftChild = -1;
-    root.rightChild = -1;
-    root.triangleStart = -1;
-    root.triangleCount = 0;
-
-    BuildBVHRecursive(0, indices);
-
-    Logger::Info("Built BVH with " + std::to_string(m_bvhNodes.size()) + " nodes; leaf index buffer size " + std::to_string(m_triangleIndices.size()));
+    m_triangleBVH.Build(m_triangles);
+    Logger::Info("Built BVH with " + std::to_string(m_triangleBVH.GetNodes().size()) + " nodes (" +
+                 std::to_string(m_triangleBVH.GetWideNodes().size()) + " 4-wide) over " + std::to_string(m_triangles.size()) + " triangles");
 }
 
 Vector3 RaytracingPipeline::TraceRay(const Ray& ray, int depth) {
@@ -279,6 +413,132 @@ Vector3 RaytracingPipeline::TraceRay(const Ray& ray, int depth) {
     return color;
 }
 
+Vector3 RaytracingPipeline::SkyColor(const Vector3& direction) const {
+    float t = std::clamp(0.5f * (direction.y + 1.0f), 0.0f, 1.0f);
+    return m_skyHorizon * (1.0f - t) + m_skyZenith * t;
+}
+
+// Unidirectional path tracer. Surfaces are Lambertian with a mirror lobe chosen with probability
+// equal to their reflectivity. Engine lights are all punctual, so direct light comes only from
+// next-event estimation and needs no MIS; the sky is reached only through bounces.
+Vector3 RaytracingPipeline::TracePath(Ray ray, uint32_t& rngState) {
+    Vector3 radiance(0.0f, 0.0f, 0.0f);
+    Vector3 throughput(1.0f, 1.0f, 1.0f);
+    
+    for (int depth = 0; depth < m_maxPathDepth; ++depth) {
+        HitInfo hit = RayIntersectScene(ray);
+        if (!hit.hit) {
+            radiance = radiance + throughput * SkyColor(ray.direction);
+            break;
+        }
+        
+        Vector3 normal = hit.normal.Dot(ray.direction) > 0.0f ? hit.normal * -1.0f : hit.normal;
+        Vector3 origin = hit.point + normal * 0.001f;
+        
+        if (NextRandom(rngState) < hit.reflectivity) {
+            Vector3 reflectDir = ray.direction - normal * 2.0f * ray.direction.Dot(normal);
+            ray = Ray(origin, reflectDir);
+            continue;
+        }
+        
+        radiance = radiance + throughput * hit.color * SampleDirectLighting(origin, normal);
+        
+        // Cosine-weighted sampling cancels the Lambert cos/pi term, leaving only the albedo
+        throughput = throughput * hit.color;
+        if (depth >= 3) {
+            float survive = std::min(0.95f, std::max(throughput.x, std::max(throughput.y, throughput.z)));
+            if (NextRandom(rngState) >= survive) {
+                break;
+            }
+            throughput = throughput / survive;
+        }
+        
+        float u1 = NextRandom(rngState);
+        float u2 = NextRandom(rngState);
+        ray = Ray(origin, SampleCosineHemisphere(normal, u1, u2));
+    }
+    
+    return radiance;
+}
+
+// Light color * intensity is treated as the irradiance-scaled radiance the raster pipelines use,
+// so a lit diffuse surface gets albedo * N.L * color, the same as the forward shader
+Vector3 RaytracingPipeline::SampleDirectLighting(const Vector3& point, const Vector3& normal) {
+    Vector3 result(0.0f, 0.0f, 0.0f);
+    
+    if (m_useBuiltInLight) {
+        // Rendering without a World: use the pipeline's built-in point light
+        Vector3 toLight = m_lightPos - point;
+        float distance = toLight.Length();
+        if (distance < 1e-4f) return result;
+        Vector3 direction = toLight / distance;
+        float cosTheta = normal.Dot(direction);
+        if (cosTheta > 0.0f && !IsOccluded(Ray(point, direction), distance)) {
+            result = m_lightColor * cosTheta;
+        }
+        return result;
+    }
+    
+    for (const Light* light : m_pathLights) {
+        Vector3 direction;
+        float distance;
+        float attenuation = 1.0f;
+        if (light->GetType() == LightType::Directional) {
+            direction = light->GetDirection() * -1.0f;
+            distance = std::numeric_limits<float>::max();
+        } else {
+            Vector3 toLight = light->GetPosition() - point;
+            distance = toLight.Length();
+            if (distance < 1e-4f) continue;
+            direction = toLight / distance;
+            attenuation = light->GetAttenuationAtDistance(distance) * light->GetSpotAttenuation(point - light->GetPosition());
+        }
+        
+        float cosTheta = normal.Dot(direction);
+        if (cosTheta <= 0.0f || attenuation <= 0.0f) {
+            continue;
+        }
+        if (IsOccluded(Ray(point, direction), distance)) {
+            continue;
+        }
+        result = result + light->GetFinalColor() * (attenuation * cosTheta);
+    }
+    return result;
+}
+
+// Snapshots the World's lights; returns true if they differ from the previous frame
+bool RaytracingPipeline::UpdatePathLights(World* world) {
+    m_pathLights.clear();
+    m_useBuiltInLight = world == nullptr;
+    if (world) {
+        if (!m_lightManager) {
+            m_lightManager = std::make_unique<LightManager>();
+        }
+        // Brightness limits are deliberately not applied: reference images use the authored values
+        m_lightManager->CollectLights(world);
+        m_pathLights.assign(m_lightManager->GetActiveLights().begin(), m_lightManager->GetActiveLights().end());
+    }
+    
+    std::vector<float> signature;
+    signature.reserve(m_pathLights.size() * 14);
+    for (const Light* light : m_pathLights) {
+        const LightData& data = light->GetData();
+        signature.insert(signature.end(), {
+            static_cast<float>(light->GetType()),
+            data.position.x, data.position.y, data.position.z,
+            data.direction.x, data.direction.y, data.direction.z,
+            data.color.x, data.color.y, data.color.z,
+            data.intensity, data.range, data.innerConeAngle, data.outerConeAngle
+        });
+    }
+    signature.push_back(m_useBuiltInLight ? 1.0f : 0.0f);
+    if (signature == m_lightSignature) {
+        return false;
+    }
+    m_lightSignature = std::move(signature);
+    return true;
+}
+
 HitInfo RaytracingPipeline::RayIntersectSphere(const Ray& ray, const Sphere& sphere) {
     HitInfo hit;
     
@@ -323,12 +583,21 @@ HitInfo RaytracingPipeline::RayIntersectScene(const Ray& ray) {
         }
     }
     
-    HitInfo triHit = TraverseBVH(ray);
-    if (triHit.hit && triHit.distance < closestDistance) {
-        closestDistance = triHit.distance;
-        closestHit = triHit;
+    PreparedRay prepared = PrepareRay(ray);
+    int triangle = -1;
+    if (m_triangleBVH.Intersect(prepared, closestDistance, triangle)) {
+        const Triangle& tri = m_triangleBVH.GetTriangles()[triangle];
+        closestHit.hit = true;
+        closestHit.distance = closestDistance;
+        closestHit.point = ray.origin + ray.direction * closestDistance;
+        closestHit.normal = tri.normal;
+        closestHit.color = tri.color;
+        closestHit.reflectivity = tri.reflectivity;
     }
     
+    // World instances; only hits closer than the loose primitives replace closestHit
+    m_scene.Intersect(prepared, closestDistance, closestHit);
+    
     return closestHit;
 }
 
@@ -342,15 +611,8 @@ Vector3 RaytracingPipeline::CalculateLighting(const HitInfo& hit, const Vector3&
     }
     
     Ray shadowRay(hit.point + hit.normal * 0.001f, lightDir);
-    HitInfo shadowHit = RayIntersectScene(shadowRay);
-    
-    float shadow = 1.0f;
-    if (shadowHit.hit) {
-        float lightDistance = (m_lightPos - hit.point).Length();
-        if (shadowHit.distance < lightDistance) {
-            shadow = 0.3f;
-        }
-    }
+    float lightDistance = (m_lightPos - hit.point).Length();
+    float shadow = IsOccluded(shadowRay, lightDistance) ? 0.3f : 1.0f;
     
     Vector3 ambient = hit.color * 0.1f;
     
@@ -427,166 +689,157 @@ void RaytracingPipeline::RenderPixel(int x, int y, std::vector<Vector3>& framebu
     }
 }
 
-void RaytracingPipeline::RenderTile(int startX, int startY, int endX, int endY, std::vector<Vector3>& framebuffer) {
-    for (int y = startY; y < endY; ++y) {
-        for (int x = startX; x < endX; ++x) {
-            RenderPixel(x, y, framebuffer);
+// One progressive pass over a tile: m_samplesPerPixel new path samples per pixel, then the
+// tile's variance estimate decides whether it keeps sampling
+void RaytracingPipeline::RenderTilePath(Tile& tile) {
+    int width = m_renderData.viewportWidth;
+    int height = m_renderData.viewportHeight;
+    int passSamples = std::min(m_samplesPerPixel, m_maxSamplesPerPixel - tile.samples);
+    if (passSamples <= 0) {
+        tile.converged = true;
+        return;
+    }
+    
+    for (int y = tile.startY; y < tile.endY; ++y) {
+        for (int x = tile.startX; x < tile.endX; ++x) {
+            size_t index = static_cast<size_t>(y) * width + x;
+            Vector3 sum(0.0f, 0.0f, 0.0f);
+            float lumSq = 0.0f;
+            for (int s = 0; s < passSamples; ++s) {
+                uint32_t rngState = HashSeed(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(tile.samples + s));
+                float u = (static_cast<float>(x) + NextRandom(rngState)) / static_cast<float>(width);
+                float v = (static_cast<float>(y) + NextRandom(rngState)) / static_cast<float>(height);
+                Vector3 sample = TracePath(GetCameraRay(u, v), rngState);
+                if (!std::isfinite(sample.x) || !std::isfinite(sample.y) || !std::isfinite(sample.z)) {
+                    sample = Vector3(0.0f, 0.0f, 0.0f);
+                }
+                sum = sum + sample;
+                float lum = Luminance(sample);
+                lumSq += lum * lum;
+            }
+            m_accumulation[index] = m_accumulation[index] + sum;
+            m_accumulationLumSq[index] += lumSq;
+            m_frameColor[index] = m_accumulation[index] / static_cast<float>(tile.samples + passSamples);
         }
     }
+    tile.samples += passSamples;
+    tile.converged = IsTileConverged(tile);
 }
 
-HitInfo RaytracingPipeline::RayIntersectTriangle(const Ray& ray, const Triangle& triangle) {
-    HitInfo hit;
-    
-    Vector3 edge1 = triangle.v1 - triangle.v0;
-    Vector3 edge2 = triangle.v2 - triangle.v0;
-    Vector3 h = ray.direction.Cross(edge2);
-    float a = edge1.Dot(h);
-    
-    if (a > -0.00001f && a < 0.00001f) {
-        return hit; // Ray is parallel to triangle
-    }
-    
-    float f = 1.0f / a;
-    Vector3 s = ray.origin - triangle.v0;
-    float u = f * s.Dot(h);
-    
-    if (u < 0.0f || u > 1.0f) {
-        return hit;
+// Mean over the tile of each pixel's relative standard error of its luminance estimate. The
+// error is taken relative to luminance + 0.05 so near-black pixels do not keep a tile alive.
+bool RaytracingPipeline::IsTileConverged(const Tile& tile) const {
+    if (tile.samples >= m_maxSamplesPerPixel) {
+        return true;
     }
-    
-    Vector3 q = s.Cross(edge1);
-    float v = f * ray.direction.Dot(q);
-    
-    if (v < 0.0f || u + v > 1.0f) {
-        return hit;
+    if (!m_adaptiveSampling || tile.samples < m_adaptiveMinSamples) {
+        return false;
     }
     
-    float t = f * edge2.Dot(q);
-    
-    if (t > 0.00001f) {
-        hit.hit = true;
-        hit.distance = t;
-        hit.point = ray.origin + ray.direction * t;
-        hit.normal = triangle.normal;
-        hit.color = triangle.color;
-        hit.reflectivity = triangle.reflectivity;
+    int width = m_renderData.viewportWidth;
+    float n = static_cast<float>(tile.samples);
+    float errorSum = 0.0f;
+    for (int y = tile.startY; y < tile.endY; ++y) {
+        for (int x = tile.startX; x < tile.endX; ++x) {
+            size_t index = static_cast<size_t>(y) * width + x;
+            float mean = Luminance(m_accumulation[index]) / n;
+            float variance = std::max(0.0f, m_accumulationLumSq[index] / n - mean * mean);
+            errorSum += std::sqrt(variance / n) / (mean + 0.05f);
+        }
     }
-    
-    return hit;
+    int pixelCount = (tile.endX - tile.startX) * (tile.endY - tile.startY);
+    return errorSum <= m_adaptiveErrorThreshold * static_cast<float>(pixelCount);
 }
 
-void RaytracingPipeline::BuildBVHRecursive(int nodeIndex, std::vector<int>& triIdx) {
-    BVHNode& node = m_bvhNodes[nodeIndex];
-
-    if (triIdx.size() <= 4) {
-        node.triangleStart = static_cast<int>(m_triangleIndices.size());
-        node.triangleCount = static_cast<int>(triIdx.size());
-        m_triangleIndices.insert(m_triangleIndices.end(), triIdx.begin(), triIdx.end());
-        return;
-    }
-
-    Vector3 extent = node.maxBounds - node.minBounds;
-    int splitAxis = 0;
-    if (extent.y > extent.x) splitAxis = 1;
-    if (extent.z > extent[splitAxis]) splitAxis = 2;
-
-    std::sort(triIdx.begin(), triIdx.end(),
-        [this, splitAxis](int a, int b) {
-            Vector3 ca = (m_triangles[a].v0 + m_triangles[a].v1 + m_triangles[a].v2) / 3.0f;
-            Vector3 cb = (m_triangles[b].v0 + m_triangles[b].v1 + m_triangles[b].v2) / 3.0f;
-            return ca[splitAxis] < cb[splitAxis];
-        });
-
-    size_t mid = triIdx.size() / 2;
-    std::vector<int> leftTris(triIdx.begin(), triIdx.begin() + mid);
-    std::vector<int> rightTris(triIdx.begin() + mid, triIdx.end());
-
-    int leftChildIndex = static_cast<int>(m_bvhNodes.size());
-    int rightChildIndex = leftChildIndex + 1;
-    m_bvhNodes.resize(m_bvhNodes.size() + 2);
-
-    node.leftChild = leftChildIndex;
-    node.rightChild = rightChildIndex;
-
-    BVHNode& leftChild = m_bvhNodes[leftChildIndex];
-    BVHNode& rightChild = m_bvhNodes[rightChildIndex];
-
-    leftChild.minBounds = Vector3(std::numeric_limits<float>::max());
-    leftChild.maxBounds = Vector3(std::numeric_limits<float>::lowest());
-    for (int ti : leftTris) {
-        const Triangle& tri = m_triangles[ti];
-        leftChild.minBounds = Vector3::Min(leftChild.minBounds, Vector3::Min(Vector3::Min(tri.v0, tri.v1), tri.v2));
-        leftChild.maxBounds = Vector3::Max(leftChild.maxBounds, Vector3::Max(Vector3::Max(tri.v0, tri.v1), tri.v2));
+void RaytracingPipeline::RenderTile(int startX, int startY, int endX, int endY, std::vector<Vector3>& framebuffer) {
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            RenderPixel(x, y, framebuffer);
+        }
     }
+}
 
-    rightChild.minBounds = Vector3(std::numeric_limits<float>::max());
-    rightChild.maxBounds = Vector3(std::numeric_limits<float>::lowest());
-    for (int ti : rightTris) {
-        const Triangle& tri = m_triangles[ti];
-        rightChild.minBounds = Vector3::Min(rightChild.minBounds, Vector3::Min(Vector3::Min(tri.v0, tri.v1), tri.v2));
-        rightChild.maxBounds = Vector3::Max(rightChild.maxBounds, Vector3::Max(Vector3::Max(tri.v0, tri.v1), tri.v2));
+// Gamma-encodes one tile into the RGBA8 upload buffer
+void RaytracingPipeline::ResolveTile(int startX, int startY, int endX, int endY) {
+    int width = m_renderData.viewportWidth;
+    for (int y = startY; y < endY; ++y) {
+        for (int x = startX; x < endX; ++x) {
+            size_t i = static_cast<size_t>(y) * width + x;
+            Vector3 color = m_frameColor[i];
+            
+            color.x = std::sqrt(std::clamp(color.x, 0.0f, 1.0f));
+            color.y = std::sqrt(std::clamp(color.y, 0.0f, 1.0f));
+            color.z = std::sqrt(std::clamp(color.z, 0.0f, 1.0f));
+            
+            m_framePixels[i * 4 + 0] = static_cast<unsigned char>(color.x * 255);
+            m_framePixels[i * 4 + 1] = static_cast<unsigned char>(color.y * 255);
+            m_framePixels[i * 4 + 2] = static_cast<unsigned char>(color.z * 255);
+            m_framePixels[i * 4 + 3] = 255;
+        }
     }
-
-    BuildBVHRecursive(leftChildIndex, leftTris);
-    BuildBVHRecursive(rightChildIndex, rightTris);
 }
 
-bool RaytracingPipeline::RayBoxIntersect(const Ray& ray, const Vector3& boxMin, const Vector3& boxMax) {
-    Vector3 invDir = Vector3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
-    Vector3 t1 = (boxMin - ray.origin) * invDir;
-    Vector3 t2 = (boxMax - ray.origin) * invDir;
-    
-    Vector3 tMin = Vector3::Min(t1, t2);
-    Vector3 tMax = Vector3::Max(t1, t2);
-    
-    float tNear = std::max(std::max(tMin.x, tMin.y), tMin.z);
-    float tFar = std::min(std::min(tMax.x, tMax.y), tMax.z);
-    
-    return tNear <= tFar && tFar > 0.0f;
+static uint32_t MortonCode2D(uint32_t x, uint32_t y) {
+    auto spread = [](uint32_t v) {
+        v &= 0x0000FFFFu;
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
 }
 
-HitInfo RaytracingPipeline::TraverseBVH(const Ray& ray) {
-    HitInfo closestHit;
-    float closestDistance = std::numeric_limits<float>::max();
-
-    if (m_bvhNodes.empty()) {
-        return closestHit;
+void RaytracingPipeline::BuildTileOrder(int width, int height) {
+    m_tiles.clear();
+    if (width <= 0 || height <= 0) return;
+    
+    int tilesX = (width + TileSize - 1) / TileSize;
+    int tilesY = (height + TileSize - 1) / TileSize;
+    std::vector<std::pair<uint32_t, Tile>> ordered;
+    ordered.reserve(static_cast<size_t>(tilesX) * tilesY);
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            Tile tile;
+            tile.startX = tx * TileSize;
+            tile.startY = ty * TileSize;
+            tile.endX = std::min(tile.startX + TileSize, width);
+            tile.endY = std::min(tile.startY + TileSize, height);
+            ordered.emplace_back(MortonCode2D(static_cast<uint32_t>(tx), static_cast<uint32_t>(ty)), tile);
+        }
     }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    m_tiles.reserve(ordered.size());
+    for (const auto& entry : ordered) {
+        m_tiles.push_back(entry.second);
+    }
+}
 
-    std::vector<int> nodeStack;
-    nodeStack.reserve(64);
-    nodeStack.push_back(0);
-
-    while (!nodeStack.empty()) {
-        int nodeIndex = nodeStack.back();
-        nodeStack.pop_back();
-
-        const BVHNode& node = m_bvhNodes[nodeIndex];
-
-        if (!RayBoxIntersect(ray, node.minBounds, node.maxBounds)) {
-            continue;
+void RaytracingPipeline::RenderTilesCPU() {
+    // The render thread takes tiles too instead of idling
+    WorkerPool::Instance().ParallelFor(m_activeTiles.size(), [this](size_t index, size_t) {
+        Tile& tile = m_tiles[m_activeTiles[index]];
+        if (m_mode == RaytracingMode::PathTraced) {
+            RenderTilePath(tile);
+        } else {
+            RenderTile(tile.startX, tile.startY, tile.endX, tile.endY, m_frameColor);
         }
+        ResolveTile(tile.startX, tile.startY, tile.endX, tile.endY);
+    });
+}
 
-        if (node.triangleCount > 0) {
-            for (int i = 0; i < node.triangleCount; ++i) {
-                int idx = node.triangleStart + i;
-                if (idx >= 0 && idx < static_cast<int>(m_triangleIndices.size())) {
-                    int triIndex = m_triangleIndices[idx];
-                    HitInfo hit = RayIntersectTriangle(ray, m_triangles[triIndex]);
-                    if (hit.hit && hit.distance < closestDistance) {
-                        closestDistance = hit.distance;
-                        closestHit = hit;
-                    }
-                }
-            }
-        } else {
-            if (node.leftChild >= 0) nodeStack.push_back(node.leftChild);
-            if (node.rightChild >= 0) nodeStack.push_back(node.rightChild);
+bool RaytracingPipeline::IsOccluded(const Ray& ray, float maxDistance) {
+    for (const auto& sphere : m_spheres) {
+        HitInfo hit = RayIntersectSphere(ray, sphere);
+        if (hit.hit && hit.distance < maxDistance) {
+            return true;
         }
     }
-
-    return closestHit;
+    PreparedRay prepared = PrepareRay(ray);
+    return m_triangleBVH.Occluded(prepared, maxDistance) || m_scene.Occluded(prepared, maxDistance);
 }
 
 void RaytracingPipeline::RenderWithComputeShader() {
@@ -614,7 +867,7 @@ void RaytracingPipeline::SetupComputeShaderBuffers() {
     
     
     Logger::Info("Triangle SSBO setup (simplified): " + std::to_string(m_triangles.size()) + " triangles");
-    Logger::Info("BVH SSBO setup (simplified): " + std::to_string(m_bvhNodes.size()) + " nodes");
+    Logger::Info("BVH SSBO setup (simplified): " + std::to_string(m_triangleBVH.GetNodes().size()) + " nodes");
     
     m_triangleSSBO = 1;
     m_bvhSSBO = 2;
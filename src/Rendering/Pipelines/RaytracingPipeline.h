@@ -4,51 +4,17 @@
 #include "../Core/Texture.h"
 #include "../Core/FrameBuffer.h"
 #include "../Shaders/Shader.h"
+#include "../Raytracing/TriangleBVH.h"
+#include "../Raytracing/RaytracingScene.h"
+#include "../Lighting/LightManager.h"
 #include "../../Core/Math/Vector3.h"
 #include <memory>
+#include <algorithm>
 #include <vector>
+#include <cstdint>
 
 namespace GameEngine {
 
-struct Ray {
-    Vector3 origin;
-    Vector3 direction;
-    
-    Ray(const Vector3& o, const Vector3& d) : origin(o), direction(d) {}
-};
-
-struct Triangle {
-    Vector3 v0, v1, v2;
-    Vector3 normal;
-    Vector3 color;
-    float reflectivity;
-    
-    Triangle() = default;
-    Triangle(const Vector3& vertex0, const Vector3& vertex1, const Vector3& vertex2, 
-             const Vector3& col, float refl = 0.0f) 
-        : v0(vertex0), v1(vertex1), v2(vertex2), color(col), reflectivity(refl) {
-        Vector3 edge1 = v1 - v0;
-        Vector3 edge2 = v2 - v0;
-        Vector3 crossProduct = edge1.Cross(edge2);
-        if (crossProduct.LengthSquared() > 0.0001f) {
-            normal = crossProduct.Normalized();
-        } else {
-            normal = Vector3(0.0f, 1.0f, 0.0f); // Default up normal
-        }
-    }
-};
-
-struct BVHNode {
-    Vector3 minBounds;
-    Vector3 maxBounds;
-    int leftChild = -1;
-    int rightChild = -1;
-    int triangleStart = -1;
-    int triangleCount = 0;
-    
-    BVHNode() = default;
-};
-
 struct Sphere {
     Vector3 center;
     float radius;
@@ -59,13 +25,9 @@ struct Sphere {
         : center(c), radius(r), color(col), reflectivity(refl) {}
 };
 
-struct HitInfo {
-    bool hit = false;
-    float distance = 0.0f;
-    Vector3 point;
-    Vector3 normal;
-    Vector3 color;
-    float reflectivity = 0.0f;
+enum class RaytracingMode {
+    Interactive,    // Whitted-style reflections with one fixed light, one pass per frame
+    PathTraced      // Progressive reference renderer: path tracing with next-event estimation
 };
 
 class RaytracingPipeline : public RenderPipeline {
@@ -91,24 +53,61 @@ public:
     void SetMaxBounces(int bounces) { m_maxBounces = bounces; }
     void SetUseComputeShader(bool use) { m_useComputeShader = use; }
     void SetSingleSpecularBounce(bool enabled) { m_maxBounces = enabled ? 2 : 1; }
+    void SetSamplesPerPixel(int samples) { m_samplesPerPixel = std::max(1, samples); }
+    void SetCamera(const Vector3& position, const Vector3& target, const Vector3& up, float fovDegrees);
+    
+    // Progressive reference mode. Changing the mode, camera, scene or lights restarts accumulation.
+    void SetMode(RaytracingMode mode);
+    RaytracingMode GetMode() const { return m_mode; }
+    void SetMaxPathDepth(int depth) { m_maxPathDepth = std::max(1, depth); }
+    // Passes are repeated within one frame until the budget is used; 0 renders one pass per frame
+    void SetFrameTimeBudget(float milliseconds) { m_frameTimeBudgetMs = std::max(0.0f, milliseconds); }
+    // Tiles stop sampling once their mean relative standard error drops below errorThreshold
+    void SetAdaptiveSampling(bool enabled, float errorThreshold = 0.01f, int minSamples = 16);
+    void SetMaxSamplesPerPixel(int samples) { m_maxSamplesPerPixel = std::max(1, samples); }
+    void SetSkyColors(const Vector3& horizon, const Vector3& zenith) { m_skyHorizon = horizon; m_skyZenith = zenith; }
+    
+    // Traces one frame on the CPU without touching GL, so reference images can be made headlessly.
+    // The viewport comes from BeginFrame; GetImage returns linear, unclamped radiance.
+    void TraceFrame(World* world);
+    const std::vector<Vector3>& GetImage() const { return m_frameColor; }
+    int GetMinSampleCount() const;
+    float GetConvergedFraction() const;
+    bool IsConverged() const { return !m_tiles.empty() && GetConvergedFraction() >= 1.0f; }
 
 private:
     void Cleanup();
-    void SetSamplesPerPixel(int samples) { m_samplesPerPixel = samples; }
+    // Framebuffer, output texture, accumulation buffers and tiles for the viewport size
+    bool CreateFrameTargets(int width, int height);
+    void ResetAccumulation();
     
     Vector3 TraceRay(const Ray& ray, int depth = 0);
+    Vector3 TracePath(Ray ray, uint32_t& rngState);
+    Vector3 SampleDirectLighting(const Vector3& point, const Vector3& normal);
+    Vector3 SkyColor(const Vector3& direction) const;
+    bool UpdatePathLights(World* world);
     HitInfo RayIntersectSphere(const Ray& ray, const Sphere& sphere);
-    HitInfo RayIntersectTriangle(const Ray& ray, const Triangle& triangle);
     HitInfo RayIntersectScene(const Ray& ray);
     Vector3 CalculateLighting(const HitInfo& hit, const Vector3& viewDir);
     Ray GetCameraRay(float x, float y);
     
     void RenderPixel(int x, int y, std::vector<Vector3>& framebuffer);
     void RenderTile(int startX, int startY, int endX, int endY, std::vector<Vector3>& framebuffer);
-    
-    void BuildBVHRecursive(int nodeIndex, std::vector<int>& triangleIndices);
-    bool RayBoxIntersect(const Ray& ray, const Vector3& boxMin, const Vector3& boxMax);
-    HitInfo TraverseBVH(const Ray& ray);
+    void ResolveTile(int startX, int startY, int endX, int endY);
+    
+    // CPU tile scheduling: tiles are claimed from a Morton-ordered list by the WorkerPool
+    // threads plus the render thread, so neighbouring tiles (and their BVH nodes) stay hot in cache
+    struct Tile {
+        int startX, startY, endX, endY;
+        int samples = 0;            // Path-traced samples per pixel accumulated so far
+        bool converged = false;
+    };
+    void BuildTileOrder(int width, int height);
+    void RenderTilePath(Tile& tile);
+    bool IsTileConverged(const Tile& tile) const;
+    void RenderTilesCPU();
+    
+    bool IsOccluded(const Ray& ray, float maxDistance);
     void RenderWithComputeShader();
     void SetupComputeShaderBuffers();
     
@@ -117,8 +116,9 @@ private:
     
     std::vector<Sphere> m_spheres;
     std::vector<Triangle> m_triangles;
-    std::vector<BVHNode> m_bvhNodes;
-    std::vector<int> m_triangleIndices;
+    TriangleBVH m_triangleBVH;
+    // Mesh instances extracted from the World each frame (BLAS per mesh, TLAS over instances)
+    RaytracingScene m_scene;
     
     Vector3 m_cameraPos;
     Vector3 m_cameraTarget;
@@ -137,6 +137,30 @@ private:
     int m_accumulatedFrames = 0;
     unsigned int m_rngSeed = 1337;
     
+    RaytracingMode m_mode = RaytracingMode::Interactive;
+    int m_maxPathDepth = 8;
+    float m_frameTimeBudgetMs = 0.0f;
+    bool m_adaptiveSampling = true;
+    float m_adaptiveErrorThreshold = 0.01f;
+    int m_adaptiveMinSamples = 16;
+    int m_maxSamplesPerPixel = 65536;
+    Vector3 m_skyHorizon = Vector3(1.0f, 1.0f, 1.0f);
+    Vector3 m_skyZenith = Vector3(0.5f, 0.7f, 1.0f);
+    // Per-pixel sum of squared sample luminance, for the variance estimate
+    std::vector<float> m_accumulationLumSq;
+    std::unique_ptr<LightManager> m_lightManager;
+    std::vector<const Light*> m_pathLights;
+    bool m_useBuiltInLight = false;
+    std::vector<float> m_lightSignature;
+    
+    // Persistent CPU frame storage, reallocated only on resize
+    std::vector<Vector3> m_frameColor;
+    std::vector<unsigned char> m_framePixels;
+    
+    static constexpr int TileSize = 32;
+    std::vector<Tile> m_tiles;
+    std::vector<size_t> m_activeTiles;  // Indices into m_tiles rendered by the current pass
+    
     std::shared_ptr<Shader> m_computeShader;
     unsigned int m_triangleSSBO = 0;
     unsigned int m_bvhSSBO = 0;
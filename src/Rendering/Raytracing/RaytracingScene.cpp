@@ -0,0 +1,393 @@
+#include "RaytracingScene.h"
+#include "../Meshes/Mesh.h"
+#include "../../Core/ECS/World.h"
+#include "../../Core/Components/MeshComponent.h"
+#include "../../Core/Components/TransformComponent.h"
+#include "../../Core/Logging/Logger.h"
+#include "../../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace GameEngine {
+
+namespace {
+
+constexpr int TLASMaxLeafInstances = 2;
+constexpr float TLASRebuildAreaGrowth = 2.0f;   // Refit quality limit before a full rebuild
+
+float HalfSurfaceArea(const Vector3& minBounds, const Vector3& maxBounds) {
+    Vector3 e = maxBounds - minBounds;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+bool SameMatrix(const Matrix4& a, const Matrix4& b) {
+    return a.m == b.m;
+}
+
+// Matrix4::Inverted assumes a rigid transform; instances may be scaled, so invert the full 3x3
+Matrix4 AffineInverse(const Matrix4& matrix) {
+    const auto& a = matrix.m;
+    float c00 = a[5] * a[10] - a[9] * a[6];
+    float c01 = a[9] * a[2] - a[1] * a[10];
+    float c02 = a[1] * a[6] - a[5] * a[2];
+    float det = a[0] * c00 + a[4] * c01 + a[8] * c02;
+    if (std::fabs(det) < 1e-20f) {
+        return Matrix4::Identity();
+    }
+    float invDet = 1.0f / det;
+
+    Matrix4 result = Matrix4::Identity();
+    auto& r = result.m;
+    r[0] = c00 * invDet;
+    r[1] = c01 * invDet;
+    r[2] = c02 * invDet;
+    r[4] = (a[8] * a[6] - a[4] * a[10]) * invDet;
+    r[5] = (a[0] * a[10] - a[8] * a[2]) * invDet;
+    r[6] = (a[4] * a[2] - a[0] * a[6]) * invDet;
+    r[8] = (a[4] * a[9] - a[8] * a[5]) * invDet;
+    r[9] = (a[8] * a[1] - a[0] * a[9]) * invDet;
+    r[10] = (a[0] * a[5] - a[4] * a[1]) * invDet;
+    r[12] = -(r[0] * a[12] + r[4] * a[13] + r[8] * a[14]);
+    r[13] = -(r[1] * a[12] + r[5] * a[13] + r[9] * a[14]);
+    r[14] = -(r[2] * a[12] + r[6] * a[13] + r[10] * a[14]);
+    return result;
+}
+
+Vector3 TransformDirection(const Matrix4& matrix, const Vector3& direction) {
+    return Vector3(
+        matrix.m[0] * direction.x + matrix.m[4] * direction.y + matrix.m[8] * direction.z,
+        matrix.m[1] * direction.x + matrix.m[5] * direction.y + matrix.m[9] * direction.z,
+        matrix.m[2] * direction.x + matrix.m[6] * direction.y + matrix.m[10] * direction.z
+    );
+}
+
+// Normals transform by the inverse transpose; worldToLocal already is the inverse
+Vector3 TransformNormal(const Matrix4& worldToLocal, const Vector3& normal) {
+    Vector3 n(
+        worldToLocal.m[0] * normal.x + worldToLocal.m[1] * normal.y + worldToLocal.m[2] * normal.z,
+        worldToLocal.m[4] * normal.x + worldToLocal.m[5] * normal.y + worldToLocal.m[6] * normal.z,
+        worldToLocal.m[8] * normal.x + worldToLocal.m[9] * normal.y + worldToLocal.m[10] * normal.z
+    );
+    return n.LengthSquared() > 0.0f ? n.Normalized() : normal;
+}
+
+}
+
+bool RaytracingScene::Update(World* world) {
+    PROFILE_SCOPE("RaytracingScene::Update");
+    m_nextInstances.clear();
+
+    if (world) {
+        for (const auto& entity : world->GetEntities()) {
+            auto* meshComp = world->GetComponent<MeshComponent>(entity);
+            auto* transformComp = world->GetComponent<TransformComponent>(entity);
+            if (!meshComp || !transformComp || !meshComp->HasMesh() || !meshComp->IsVisible()) {
+                continue;
+            }
+
+            std::shared_ptr<Mesh> mesh = meshComp->GetMesh();
+            std::shared_ptr<TriangleBVH> blas = GetOrBuildBLAS(mesh);
+            if (!blas || blas->IsEmpty()) {
+                continue;
+            }
+
+            Instance instance;
+            instance.entityId = entity.GetID();
+            instance.mesh = mesh.get();
+            instance.blas = std::move(blas);
+            instance.localToWorld = transformComp->transform.GetLocalToWorldMatrix();
+            instance.color = meshComp->GetColor();
+            instance.reflectivity = meshComp->GetMetallic();
+            m_nextInstances.push_back(std::move(instance));
+        }
+    }
+
+    // Drop BLASes whose mesh no longer exists
+    for (auto it = m_blasCache.begin(); it != m_blasCache.end();) {
+        if (it->second.mesh.expired()) {
+            it = m_blasCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    bool sameSet = m_nextInstances.size() == m_instances.size();
+    for (size_t i = 0; sameSet && i < m_nextInstances.size(); ++i) {
+        sameSet = m_nextInstances[i].entityId == m_instances[i].entityId &&
+                  m_nextInstances[i].blas == m_instances[i].blas;
+    }
+
+    bool moved = false;
+    bool materialChanged = false;
+    for (size_t i = 0; i < m_nextInstances.size(); ++i) {
+        Instance& next = m_nextInstances[i];
+        if (sameSet && SameMatrix(next.localToWorld, m_instances[i].localToWorld)) {
+            next.worldToLocal = m_instances[i].worldToLocal;
+            next.boundsMin = m_instances[i].boundsMin;
+            next.boundsMax = m_instances[i].boundsMax;
+        } else {
+            next.worldToLocal = AffineInverse(next.localToWorld);
+            ComputeWorldBounds(next);
+            moved = true;
+        }
+        if (sameSet && ((next.color - m_instances[i].color).LengthSquared() > 0.0f ||
+                        next.reflectivity != m_instances[i].reflectivity)) {
+            materialChanged = true;
+        }
+    }
+    std::swap(m_instances, m_nextInstances);
+
+    if (!sameSet) {
+        BuildTLAS();
+        return true;
+    }
+    if (moved) {
+        RefitTLAS();
+        return true;
+    }
+    return materialChanged;
+}
+
+void RaytracingScene::Clear() {
+    m_blasCache.clear();
+    m_instances.clear();
+    m_nextInstances.clear();
+    m_tlasNodes.clear();
+    m_instanceIndices.clear();
+    m_builtRootArea = 0.0f;
+}
+
+std::shared_ptr<TriangleBVH> RaytracingScene::GetOrBuildBLAS(const std::shared_ptr<Mesh>& mesh) {
+    const std::vector<unsigned int>& indices = mesh->GetIndices();
+
+    // The version changes whenever the geometry is replaced, also with the same counts
+    auto it = m_blasCache.find(mesh.get());
+    if (it != m_blasCache.end() && it->second.mesh.lock() == mesh &&
+        it->second.geometryVersion == mesh->GetGeometryVersion()) {
+        return it->second.bvh;
+    }
+
+    // Positions are decoded only for the build, so packed meshes keep no float copy
+    std::vector<Vector3> positions;
+    mesh->GetVertexPositions(positions);
+    std::vector<Triangle> triangles;
+    const Vector3 white(1.0f, 1.0f, 1.0f);
+    if (!indices.empty()) {
+        triangles.reserve(indices.size() / 3);
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            if (indices[i] >= positions.size() || indices[i + 1] >= positions.size() || indices[i + 2] >= positions.size()) continue;
+            triangles.emplace_back(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]], white);
+        }
+    } else {
+        triangles.reserve(positions.size() / 3);
+        for (size_t i = 0; i + 2 < positions.size(); i += 3) {
+            triangles.emplace_back(positions[i], positions[i + 1], positions[i + 2], white);
+        }
+    }
+
+    BLASEntry entry;
+    entry.mesh = mesh;
+    entry.bvh = std::make_shared<TriangleBVH>();
+    // A BVH baked by the mesh cooker indexes the index buffer's triangles, so it only fits
+    // when none were skipped above
+    const auto& bakedNodes = mesh->GetBakedBVHNodes();
+    bool adopted = !bakedNodes.empty() && triangles.size() * 3 == indices.size() &&
+                   entry.bvh->BuildFromNodes(triangles, bakedNodes, mesh->GetBakedBVHTriangleIndices());
+    if (!adopted) {
+        entry.bvh->Build(triangles);
+    }
+    entry.geometryVersion = mesh->GetGeometryVersion();
+    Logger::Debug(std::string(adopted ? "Adopted baked" : "Built") + " raytracing BLAS with " + std::to_string(triangles.size()) + " triangles");
+
+    std::shared_ptr<TriangleBVH> bvh = entry.bvh;
+    m_blasCache[mesh.get()] = std::move(entry);
+    return bvh;
+}
+
+void RaytracingScene::ComputeWorldBounds(Instance& instance) {
+    const Vector3& localMin = instance.blas->GetBoundsMin();
+    const Vector3& localMax = instance.blas->GetBoundsMax();
+    instance.boundsMin = Vector3(std::numeric_limits<float>::max());
+    instance.boundsMax = Vector3(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner) {
+        Vector3 p((corner & 1) ? localMax.x : localMin.x,
+                  (corner & 2) ? localMax.y : localMin.y,
+                  (corner & 4) ? localMax.z : localMin.z);
+        Vector3 world = instance.localToWorld * p;
+        instance.boundsMin = Vector3::Min(instance.boundsMin, world);
+        instance.boundsMax = Vector3::Max(instance.boundsMax, world);
+    }
+}
+
+// Instance counts are small, so the TLAS uses a median split on the longest centroid axis
+void RaytracingScene::BuildTLAS() {
+    m_tlasNodes.clear();
+    m_instanceIndices.resize(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        m_instanceIndices[i] = static_cast<int>(i);
+    }
+    m_tlasBuilds++;
+    if (m_instances.empty()) {
+        m_builtRootArea = 0.0f;
+        return;
+    }
+
+    m_tlasNodes.reserve(m_instances.size() * 2);
+    auto build = [this](auto& self, int begin, int end) -> void {
+        int nodeIndex = static_cast<int>(m_tlasNodes.size());
+        m_tlasNodes.emplace_back();
+
+        Vector3 boundsMin(std::numeric_limits<float>::max());
+        Vector3 boundsMax(std::numeric_limits<float>::lowest());
+        Vector3 centroidMin(std::numeric_limits<float>::max());
+        Vector3 centroidMax(std::numeric_limits<float>::lowest());
+        for (int i = begin; i < end; ++i) {
+            const Instance& instance = m_instances[m_instanceIndices[i]];
+            boundsMin = Vector3::Min(boundsMin, instance.boundsMin);
+            boundsMax = Vector3::Max(boundsMax, instance.boundsMax);
+            Vector3 centroid = (instance.boundsMin + instance.boundsMax) * 0.5f;
+            centroidMin = Vector3::Min(centroidMin, centroid);
+            centroidMax = Vector3::Max(centroidMax, centroid);
+        }
+        m_tlasNodes[nodeIndex].minBounds = boundsMin;
+        m_tlasNodes[nodeIndex].maxBounds = boundsMax;
+
+        if (end - begin <= TLASMaxLeafInstances) {
+            m_tlasNodes[nodeIndex].rightOrFirst = begin;
+            m_tlasNodes[nodeIndex].triangleCount = end - begin;
+            return;
+        }
+
+        Vector3 extent = centroidMax - centroidMin;
+        int axis = 0;
+        if (extent.y > extent.x) axis = 1;
+        if (extent.z > extent[axis]) axis = 2;
+        int mid = (begin + end) / 2;
+        std::nth_element(m_instanceIndices.begin() + begin, m_instanceIndices.begin() + mid, m_instanceIndices.begin() + end,
+            [this, axis](int a, int b) {
+                return m_instances[a].boundsMin[axis] + m_instances[a].boundsMax[axis] <
+                       m_instances[b].boundsMin[axis] + m_instances[b].boundsMax[axis];
+            });
+
+        self(self, begin, mid);
+        m_tlasNodes[nodeIndex].rightOrFirst = static_cast<int>(m_tlasNodes.size());
+        self(self, mid, end);
+    };
+    build(build, 0, static_cast<int>(m_instances.size()));
+    m_builtRootArea = HalfSurfaceArea(m_tlasNodes[0].minBounds, m_tlasNodes[0].maxBounds);
+}
+
+// Children always follow their parent in depth-first order, so one reverse pass refits bottom-up
+void RaytracingScene::RefitTLAS() {
+    if (m_tlasNodes.empty()) {
+        return;
+    }
+    for (int i = static_cast<int>(m_tlasNodes.size()) - 1; i >= 0; --i) {
+        BVHNode& node = m_tlasNodes[i];
+        if (node.IsLeaf()) {
+            node.minBounds = Vector3(std::numeric_limits<float>::max());
+            node.maxBounds = Vector3(std::numeric_limits<float>::lowest());
+            for (int k = 0; k < node.triangleCount; ++k) {
+                const Instance& instance = m_instances[m_instanceIndices[node.rightOrFirst + k]];
+                node.minBounds = Vector3::Min(node.minBounds, instance.boundsMin);
+                node.maxBounds = Vector3::Max(node.maxBounds, instance.boundsMax);
+            }
+        } else {
+            const BVHNode& left = m_tlasNodes[i + 1];
+            const BVHNode& right = m_tlasNodes[node.rightOrFirst];
+            node.minBounds = Vector3::Min(left.minBounds, right.minBounds);
+            node.maxBounds = Vector3::Max(left.maxBounds, right.maxBounds);
+        }
+    }
+    m_tlasRefits++;
+
+    // Refitting keeps the topology, so once objects have spread far apart the tree is rebuilt
+    float rootArea = HalfSurfaceArea(m_tlasNodes[0].minBounds, m_tlasNodes[0].maxBounds);
+    if (rootArea > m_builtRootArea * TLASRebuildAreaGrowth) {
+        BuildTLAS();
+    }
+}
+
+bool RaytracingScene::Intersect(const PreparedRay& ray, float& maxDistance, HitInfo& hit) const {
+    if (m_tlasNodes.empty()) {
+        return false;
+    }
+
+    int hitInstance = -1;
+    int hitTriangle = -1;
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        int nodeIndex = stack[--stackSize];
+        const BVHNode& node = m_tlasNodes[nodeIndex];
+        float tNear;
+        if (!IntersectBox(ray, node.minBounds, node.maxBounds, maxDistance, tNear)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            for (int k = 0; k < node.triangleCount; ++k) {
+                int instanceIndex = m_instanceIndices[node.rightOrFirst + k];
+                const Instance& instance = m_instances[instanceIndex];
+                // The local direction is not renormalized, so t stays comparable across instances
+                Ray localRay(instance.worldToLocal * ray.origin, TransformDirection(instance.worldToLocal, ray.direction));
+                int triangle = -1;
+                if (instance.blas->Intersect(PrepareRay(localRay), maxDistance, triangle)) {
+                    hitInstance = instanceIndex;
+                    hitTriangle = triangle;
+                }
+            }
+        } else if (stackSize + 2 <= 64) {
+            stack[stackSize++] = node.rightOrFirst;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+
+    if (hitInstance < 0) {
+        return false;
+    }
+    const Instance& instance = m_instances[hitInstance];
+    const Triangle& tri = instance.blas->GetTriangles()[hitTriangle];
+    hit.hit = true;
+    hit.distance = maxDistance;
+    hit.point = ray.origin + ray.direction * maxDistance;
+    hit.normal = TransformNormal(instance.worldToLocal, tri.normal);
+    hit.color = instance.color;
+    hit.reflectivity = instance.reflectivity;
+    return true;
+}
+
+bool RaytracingScene::Occluded(const PreparedRay& ray, float maxDistance) const {
+    if (m_tlasNodes.empty()) {
+        return false;
+    }
+
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        int nodeIndex = stack[--stackSize];
+        const BVHNode& node = m_tlasNodes[nodeIndex];
+        float tNear;
+        if (!IntersectBox(ray, node.minBounds, node.maxBounds, maxDistance, tNear)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            for (int k = 0; k < node.triangleCount; ++k) {
+                const Instance& instance = m_instances[m_instanceIndices[node.rightOrFirst + k]];
+                Ray localRay(instance.worldToLocal * ray.origin, TransformDirection(instance.worldToLocal, ray.direction));
+                if (instance.blas->Occluded(PrepareRay(localRay), maxDistance)) {
+                    return true;
+                }
+            }
+        } else if (stackSize + 2 <= 64) {
+            stack[stackSize++] = node.rightOrFirst;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "TriangleBVH.h"
+#include "../../Core/Math/Matrix4.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+    class World;
+    class Mesh;
+
+    // Two-level acceleration structure over the World's MeshComponents. Every unique Mesh gets
+    // one bottom-level TriangleBVH (BLAS) in mesh space, built on first use and cached. The
+    // top-level BVH (TLAS) over instance world bounds is rebuilt when the instance set changes
+    // and only refit when instances merely move.
+    class RaytracingScene {
+    public:
+        // Extracts visible MeshComponents; returns true if anything that affects the image changed
+        bool Update(World* world);
+        void Clear();
+
+        // Closest instance hit closer than maxDistance; on a hit shortens maxDistance and fills hit
+        bool Intersect(const PreparedRay& ray, float& maxDistance, HitInfo& hit) const;
+        bool Occluded(const PreparedRay& ray, float maxDistance) const;
+
+        size_t GetInstanceCount() const { return m_instances.size(); }
+        size_t GetCachedMeshCount() const { return m_blasCache.size(); }
+        uint64_t GetTLASBuildCount() const { return m_tlasBuilds; }
+        uint64_t GetTLASRefitCount() const { return m_tlasRefits; }
+
+    private:
+        struct BLASEntry {
+            std::weak_ptr<Mesh> mesh;
+            std::shared_ptr<TriangleBVH> bvh;
+            uint64_t geometryVersion = 0;   // Mesh::GetGeometryVersion() the BVH was built from
+        };
+
+        struct Instance {
+            uint32_t entityId = 0;
+            const Mesh* mesh = nullptr;
+            std::shared_ptr<TriangleBVH> blas;
+            Matrix4 localToWorld;
+            Matrix4 worldToLocal;
+            Vector3 boundsMin;
+            Vector3 boundsMax;
+            Vector3 color;
+            float reflectivity = 0.0f;
+        };
+
+        std::shared_ptr<TriangleBVH> GetOrBuildBLAS(const std::shared_ptr<Mesh>& mesh);
+        void BuildTLAS();
+        void RefitTLAS();
+        static void ComputeWorldBounds(Instance& instance);
+
+        std::unordered_map<const Mesh*, BLASEntry> m_blasCache;
+        std::vector<Instance> m_instances;
+        std::vector<Instance> m_nextInstances;
+
+        // TLAS nodes use the BVHNode layout; leaves index m_instanceIndices
+        std::vector<BVHNode> m_tlasNodes;
+        std::vector<int> m_instanceIndices;
+        float m_builtRootArea = 0.0f;
+        uint64_t m_tlasBuilds = 0;
+        uint64_t m_tlasRefits = 0;
+    };
+}
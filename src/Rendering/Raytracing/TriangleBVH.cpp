@@ -0,0 +1,546 @@
+#include "TriangleBVH.h"
+#include "../../Core/Math/SIMD.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+
+namespace GameEngine {
+
+namespace {
+constexpr float TriangleHitEpsilon = 0.00001f;
+}
+
+PreparedRay PrepareRay(const Ray& ray) {
+    PreparedRay r;
+    r.origin = ray.origin;
+    r.direction = ray.direction;
+    // Zero components are nudged so slab tests never compute 0 * inf
+    for (int a = 0; a < 3; ++a) {
+        float d = ray.direction[a];
+        if (std::fabs(d) < 1e-30f) d = d < 0.0f ? -1e-30f : 1e-30f;
+        r.invDirection[a] = 1.0f / d;
+    }
+    
+    // Watertight test setup (Woop et al. 2013): kz is the dominant axis
+    float ax = std::fabs(ray.direction.x), ay = std::fabs(ray.direction.y), az = std::fabs(ray.direction.z);
+    r.kz = (ax > ay) ? (ax > az ? 0 : 2) : (ay > az ? 1 : 2);
+    r.kx = (r.kz + 1) % 3;
+    r.ky = (r.kx + 1) % 3;
+    if (ray.direction[r.kz] < 0.0f) std::swap(r.kx, r.ky);
+    r.shearX = ray.direction[r.kx] / ray.direction[r.kz];
+    r.shearY = ray.direction[r.ky] / ray.direction[r.kz];
+    r.shearZ = 1.0f / ray.direction[r.kz];
+    return r;
+}
+
+// Watertight ray/triangle test: edges shared by two triangles are never missed or hit twice.
+// Double-sided, so winding does not matter.
+bool IntersectTriangle(const PreparedRay& r, const Triangle& tri, float maxDistance, float& outT) {
+    Vector3 a = tri.v0 - r.origin;
+    Vector3 b = tri.v1 - r.origin;
+    Vector3 c = tri.v2 - r.origin;
+    
+    float ax = a[r.kx] - r.shearX * a[r.kz];
+    float ay = a[r.ky] - r.shearY * a[r.kz];
+    float bx = b[r.kx] - r.shearX * b[r.kz];
+    float by = b[r.ky] - r.shearY * b[r.kz];
+    float cx = c[r.kx] - r.shearX * c[r.kz];
+    float cy = c[r.ky] - r.shearY * c[r.kz];
+    
+    float u = cx * by - cy * bx;
+    float v = ax * cy - ay * cx;
+    float w = bx * ay - by * ax;
+    if (u == 0.0f || v == 0.0f || w == 0.0f) {
+        // Fall back to double precision exactly on an edge
+        u = static_cast<float>(static_cast<double>(cx) * by - static_cast<double>(cy) * bx);
+        v = static_cast<float>(static_cast<double>(ax) * cy - static_cast<double>(ay) * cx);
+        w = static_cast<float>(static_cast<double>(bx) * ay - static_cast<double>(by) * ax);
+    }
+    if ((u < 0.0f || v < 0.0f || w < 0.0f) && (u > 0.0f || v > 0.0f || w > 0.0f)) {
+        return false;
+    }
+    
+    float det = u + v + w;
+    if (det == 0.0f) {
+        return false;
+    }
+    
+    float az = r.shearZ * a[r.kz];
+    float bz = r.shearZ * b[r.kz];
+    float cz = r.shearZ * c[r.kz];
+    float t = (u * az + v * bz + w * cz) / det;
+    if (t <= TriangleHitEpsilon || t >= maxDistance) {
+        return false;
+    }
+    outT = t;
+    return true;
+}
+
+bool IntersectBox(const PreparedRay& ray, const Vector3& boxMin, const Vector3& boxMax, float maxDistance, float& outNear) {
+    float tx0 = (boxMin.x - ray.origin.x) * ray.invDirection.x, tx1 = (boxMax.x - ray.origin.x) * ray.invDirection.x;
+    float ty0 = (boxMin.y - ray.origin.y) * ray.invDirection.y, ty1 = (boxMax.y - ray.origin.y) * ray.invDirection.y;
+    float tz0 = (boxMin.z - ray.origin.z) * ray.invDirection.z, tz1 = (boxMax.z - ray.origin.z) * ray.invDirection.z;
+    float enter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+    float exit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+    outNear = enter;
+    return enter <= exit;
+}
+
+namespace {
+
+// Slab test of one ray against the four child boxes; returns a bit mask of hit children
+// and their entry distances
+int IntersectChildren(const BVH4Node& node, const PreparedRay& r, float maxDistance, float tNear[4]) {
+#ifdef GE_SSE2
+    const __m128 ox = _mm_set1_ps(r.origin.x), oy = _mm_set1_ps(r.origin.y), oz = _mm_set1_ps(r.origin.z);
+    const __m128 ix = _mm_set1_ps(r.invDirection.x), iy = _mm_set1_ps(r.invDirection.y), iz = _mm_set1_ps(r.invDirection.z);
+    
+    __m128 tx0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+    __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+    __m128 ty0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+    __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+    __m128 tz0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+    __m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+    
+    __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1)),
+                              _mm_max_ps(_mm_min_ps(tz0, tz1), _mm_setzero_ps()));
+    __m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1)),
+                             _mm_min_ps(_mm_max_ps(tz0, tz1), _mm_set1_ps(maxDistance)));
+    
+    __m128i valid = _mm_cmpgt_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(node.child)), _mm_set1_epi32(-1));
+    __m128 hit = _mm_and_ps(_mm_cmple_ps(enter, exit), _mm_castsi128_ps(valid));
+    _mm_storeu_ps(tNear, enter);
+    return _mm_movemask_ps(hit);
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (node.child[i] < 0) continue;
+        float tx0 = (node.minX[i] - r.origin.x) * r.invDirection.x, tx1 = (node.maxX[i] - r.origin.x) * r.invDirection.x;
+        float ty0 = (node.minY[i] - r.origin.y) * r.invDirection.y, ty1 = (node.maxY[i] - r.origin.y) * r.invDirection.y;
+        float tz0 = (node.minZ[i] - r.origin.z) * r.invDirection.z, tz1 = (node.maxZ[i] - r.origin.z) * r.invDirection.z;
+        float enter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+        float exit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+        tNear[i] = enter;
+        if (enter <= exit) mask |= 1 << i;
+    }
+    return mask;
+#endif
+}
+
+}
+
+
+namespace {
+
+struct BVHBuildPrimitive {
+    Vector3 minBounds;
+    Vector3 maxBounds;
+    Vector3 centroid;
+};
+
+struct BVHBuildContext {
+    const std::vector<BVHBuildPrimitive>& primitives;
+    std::vector<int>& indices;
+    int maxParallelDepth;
+};
+
+constexpr int BVHBinCount = 16;
+constexpr int BVHMaxLeafTriangles = 8;
+constexpr int BVHMaxDepth = 60;
+// Each 4-wide level pushes at most three more entries than it pops, and 4-wide trees are
+// never deeper than the binary tree they come from
+constexpr int BVHTraversalStackSize = 256;
+static_assert(3 * BVHMaxDepth + 1 <= BVHTraversalStackSize, "traversal stack too small for BVHMaxDepth");
+constexpr int BVHParallelThreshold = 4096;      // Smaller subtrees are not worth a thread
+constexpr float BVHTraversalCost = 1.0f;        // Relative to one triangle test
+
+float HalfSurfaceArea(const Vector3& minBounds, const Vector3& maxBounds) {
+    Vector3 e = maxBounds - minBounds;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+// Builds the subtree over indices[begin, end) into nodes in depth-first order and returns
+// its root index. Partitioning happens in place; large right subtrees are built on another
+// thread into their own array and appended afterwards.
+int BuildBVHRange(BVHBuildContext& ctx, int begin, int end, std::vector<BVHNode>& nodes, int depth) {
+    int nodeIndex = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    
+    Vector3 boundsMin(std::numeric_limits<float>::max());
+    Vector3 boundsMax(std::numeric_limits<float>::lowest());
+    Vector3 centroidMin(std::numeric_limits<float>::max());
+    Vector3 centroidMax(std::numeric_limits<float>::lowest());
+    for (int i = begin; i < end; ++i) {
+        const BVHBuildPrimitive& prim = ctx.primitives[ctx.indices[i]];
+        boundsMin = Vector3::Min(boundsMin, prim.minBounds);
+        boundsMax = Vector3::Max(boundsMax, prim.maxBounds);
+        centroidMin = Vector3::Min(centroidMin, prim.centroid);
+        centroidMax = Vector3::Max(centroidMax, prim.centroid);
+    }
+    nodes[nodeIndex].minBounds = boundsMin;
+    nodes[nodeIndex].maxBounds = boundsMax;
+    
+    int count = end - begin;
+    auto makeLeaf = [&]() {
+        nodes[nodeIndex].rightOrFirst = begin;
+        nodes[nodeIndex].triangleCount = count;
+        return nodeIndex;
+    };
+    if (count <= 2 || depth >= BVHMaxDepth) {
+        return makeLeaf();
+    }
+    
+    // Binned SAH: evaluate BVHBinCount - 1 split planes per axis over the centroid bounds
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = centroidMax[axis] - centroidMin[axis];
+        if (extent <= 1e-6f) continue;
+        float scale = BVHBinCount / extent;
+        
+        int binCount[BVHBinCount] = {};
+        Vector3 binMin[BVHBinCount];
+        Vector3 binMax[BVHBinCount];
+        for (int b = 0; b < BVHBinCount; ++b) {
+            binMin[b] = Vector3(std::numeric_limits<float>::max());
+            binMax[b] = Vector3(std::numeric_limits<float>::lowest());
+        }
+        for (int i = begin; i < end; ++i) {
+            const BVHBuildPrimitive& prim = ctx.primitives[ctx.indices[i]];
+            int b = std::min(BVHBinCount - 1, static_cast<int>((prim.centroid[axis] - centroidMin[axis]) * scale));
+            binCount[b]++;
+            binMin[b] = Vector3::Min(binMin[b], prim.minBounds);
+            binMax[b] = Vector3::Max(binMax[b], prim.maxBounds);
+        }
+        
+        // Right-to-left sweep stores the right side's cost for every plane
+        float rightCost[BVHBinCount] = {};
+        Vector3 accMin(std::numeric_limits<float>::max());
+        Vector3 accMax(std::numeric_limits<float>::lowest());
+        int accCount = 0;
+        for (int b = BVHBinCount - 1; b > 0; --b) {
+            accCount += binCount[b];
+            if (binCount[b] > 0) {
+                accMin = Vector3::Min(accMin, binMin[b]);
+                accMax = Vector3::Max(accMax, binMax[b]);
+            }
+            rightCost[b] = accCount > 0 ? HalfSurfaceArea(accMin, accMax) * accCount : 0.0f;
+        }
+        accMin = Vector3(std::numeric_limits<float>::max());
+        accMax = Vector3(std::numeric_limits<float>::lowest());
+        accCount = 0;
+        for (int b = 0; b < BVHBinCount - 1; ++b) {
+            accCount += binCount[b];
+            if (binCount[b] > 0) {
+                accMin = Vector3::Min(accMin, binMin[b]);
+                accMax = Vector3::Max(accMax, binMax[b]);
+            }
+            if (accCount == 0 || accCount == count) continue;
+            float cost = HalfSurfaceArea(accMin, accMax) * accCount + rightCost[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b + 1;
+            }
+        }
+    }
+    
+    float nodeArea = HalfSurfaceArea(boundsMin, boundsMax);
+    float leafCost = static_cast<float>(count);
+    float splitCost = bestAxis >= 0 && nodeArea > 0.0f ? BVHTraversalCost + bestCost / nodeArea : leafCost;
+    if (splitCost >= leafCost && count <= BVHMaxLeafTriangles) {
+        return makeLeaf();
+    }
+    
+    int mid = begin + count / 2;
+    if (bestAxis >= 0) {
+        float cmin = centroidMin[bestAxis];
+        float scale = BVHBinCount / (centroidMax[bestAxis] - cmin);
+        auto* split = std::partition(ctx.indices.data() + begin, ctx.indices.data() + end, [&](int index) {
+            int b = std::min(BVHBinCount - 1, static_cast<int>((ctx.primitives[index].centroid[bestAxis] - cmin) * scale));
+            return b < bestSplit;
+        });
+        mid = static_cast<int>(split - ctx.indices.data());
+        if (mid == begin || mid == end) {
+            mid = begin + count / 2;
+        }
+    }
+    // Otherwise all centroids coincide and an arbitrary half split is as good as any
+    
+    // Deliberately plain threads rather than the WorkerPool: the pool runs nested loops serially,
+    // so only the top split could use it, and a build (also run while cooking meshes) lasts far
+    // longer than a frame's loops would tolerate waiting or running serially behind it.
+    // maxParallelDepth keeps this to about one thread per core.
+    if (count >= BVHParallelThreshold && depth < ctx.maxParallelDepth) {
+        std::vector<BVHNode> rightNodes;
+        rightNodes.reserve(static_cast<size_t>(end - mid) * 2);
+        std::thread rightThread([&]() { BuildBVHRange(ctx, mid, end, rightNodes, depth + 1); });
+        BuildBVHRange(ctx, begin, mid, nodes, depth + 1);
+        rightThread.join();
+        
+        int base = static_cast<int>(nodes.size());
+        for (BVHNode& node : rightNodes) {
+            if (!node.IsLeaf()) node.rightOrFirst += base;
+        }
+        nodes.insert(nodes.end(), rightNodes.begin(), rightNodes.end());
+        nodes[nodeIndex].rightOrFirst = base;
+    } else {
+        BuildBVHRange(ctx, begin, mid, nodes, depth + 1);
+        nodes[nodeIndex].rightOrFirst = static_cast<int>(nodes.size());
+        BuildBVHRange(ctx, mid, end, nodes, depth + 1);
+    }
+    return nodeIndex;
+}
+
+}
+
+void TriangleBVH::Clear() {
+    m_triangles.clear();
+    m_triangleIndices.clear();
+    m_nodes.clear();
+    m_wideNodes.clear();
+    m_boundsMin = Vector3(0.0f, 0.0f, 0.0f);
+    m_boundsMax = Vector3(0.0f, 0.0f, 0.0f);
+}
+
+void TriangleBVH::Build(const std::vector<Triangle>& triangles) {
+    Clear();
+    if (triangles.empty()) {
+        return;
+    }
+    m_triangles = triangles;
+
+    std::vector<BVHBuildPrimitive> primitives(m_triangles.size());
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        const Triangle& tri = m_triangles[i];
+        primitives[i].minBounds = Vector3::Min(Vector3::Min(tri.v0, tri.v1), tri.v2);
+        primitives[i].maxBounds = Vector3::Max(Vector3::Max(tri.v0, tri.v1), tri.v2);
+        primitives[i].centroid = (tri.v0 + tri.v1 + tri.v2) / 3.0f;
+    }
+    m_triangleIndices.resize(m_triangles.size());
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        m_triangleIndices[i] = static_cast<int>(i);
+    }
+
+    // Each parallel level doubles the builder threads; stop once every core has one
+    unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    int maxParallelDepth = 0;
+    while ((1u << maxParallelDepth) < numThreads) ++maxParallelDepth;
+
+    BVHBuildContext ctx{primitives, m_triangleIndices, maxParallelDepth};
+    m_nodes.reserve(m_triangles.size() * 2);
+    BuildBVHRange(ctx, 0, static_cast<int>(m_triangleIndices.size()), m_nodes, 0);
+    m_boundsMin = m_nodes[0].minBounds;
+    m_boundsMax = m_nodes[0].maxBounds;
+
+    m_wideNodes.reserve(m_nodes.size() / 2 + 1);
+    CollapseBVH4(0);
+}
+
+bool TriangleBVH::BuildFromNodes(const std::vector<Triangle>& triangles, const std::vector<BVHNode>& nodes,
+                                 const std::vector<int>& triangleIndices) {
+    Clear();
+    if (triangles.empty() || nodes.empty() || triangleIndices.size() != triangles.size()) {
+        return false;
+    }
+    // Depth-first layout: every child index points forward and every leaf range is in bounds
+    const int nodeCount = static_cast<int>(nodes.size());
+    const int indexCount = static_cast<int>(triangleIndices.size());
+    for (int i = 0; i < nodeCount; ++i) {
+        const BVHNode& node = nodes[i];
+        bool valid = node.IsLeaf()
+            ? node.rightOrFirst >= 0 && node.rightOrFirst + node.triangleCount <= indexCount
+            : node.triangleCount == 0 && i + 1 < nodeCount && node.rightOrFirst > i + 1 && node.rightOrFirst < nodeCount;
+        if (!valid) {
+            return false;
+        }
+    }
+    for (int index : triangleIndices) {
+        if (index < 0 || index >= static_cast<int>(triangles.size())) {
+            return false;
+        }
+    }
+    // Every node must be reached exactly once from the root, no deeper than Build goes; that
+    // bounds the traversal stacks and the recursion in CollapseBVH4
+    std::vector<char> reached(nodes.size(), 0);
+    std::vector<std::pair<int, int>> pending{{0, 0}};     // Node, depth
+    int reachedCount = 0;
+    while (!pending.empty()) {
+        auto [index, depth] = pending.back();
+        pending.pop_back();
+        if (depth > BVHMaxDepth || reached[index]) {
+            return false;
+        }
+        reached[index] = 1;
+        ++reachedCount;
+        if (!nodes[index].IsLeaf()) {
+            pending.push_back({nodes[index].rightOrFirst, depth + 1});
+            pending.push_back({index + 1, depth + 1});
+        }
+    }
+    if (reachedCount != nodeCount) {
+        return false;
+    }
+
+    m_triangles = triangles;
+    m_nodes = nodes;
+    m_triangleIndices = triangleIndices;
+    m_boundsMin = m_nodes[0].minBounds;
+    m_boundsMax = m_nodes[0].maxBounds;
+    m_wideNodes.reserve(m_nodes.size() / 2 + 1);
+    CollapseBVH4(0);
+    return true;
+}
+
+// Collapses the binary subtree rooted at binaryIndex into one 4-wide node by repeatedly
+// opening the largest interior child, then recurses into the remaining interior children
+int TriangleBVH::CollapseBVH4(int binaryIndex) {
+    int nodeIndex = static_cast<int>(m_wideNodes.size());
+    m_wideNodes.emplace_back();
+    
+    int slots[4];
+    int slotCount = 0;
+    const BVHNode& root = m_nodes[binaryIndex];
+    if (root.IsLeaf()) {
+        slots[slotCount++] = binaryIndex;
+    } else {
+        slots[slotCount++] = binaryIndex + 1;
+        slots[slotCount++] = root.rightOrFirst;
+    }
+    while (slotCount < 4) {
+        int open = -1;
+        float openArea = -1.0f;
+        for (int i = 0; i < slotCount; ++i) {
+            const BVHNode& candidate = m_nodes[slots[i]];
+            if (candidate.IsLeaf()) continue;
+            Vector3 e = candidate.maxBounds - candidate.minBounds;
+            float area = e.x * e.y + e.y * e.z + e.z * e.x;
+            if (area > openArea) {
+                openArea = area;
+                open = i;
+            }
+        }
+        if (open < 0) break;
+        int opened = slots[open];
+        slots[open] = opened + 1;
+        slots[slotCount++] = m_nodes[opened].rightOrFirst;
+    }
+    
+    for (int i = 0; i < 4; ++i) {
+        BVH4Node& node = m_wideNodes[nodeIndex];
+        if (i >= slotCount) {
+            // Empty slots are masked out by child == -1; the bounds only need to be finite
+            node.minX[i] = node.minY[i] = node.minZ[i] = 0.0f;
+            node.maxX[i] = node.maxY[i] = node.maxZ[i] = 0.0f;
+            continue;
+        }
+        const BVHNode& child = m_nodes[slots[i]];
+        node.minX[i] = child.minBounds.x; node.minY[i] = child.minBounds.y; node.minZ[i] = child.minBounds.z;
+        node.maxX[i] = child.maxBounds.x; node.maxY[i] = child.maxBounds.y; node.maxZ[i] = child.maxBounds.z;
+        if (child.IsLeaf()) {
+            node.child[i] = child.rightOrFirst;
+            node.count[i] = child.triangleCount;
+        } else {
+            int collapsed = CollapseBVH4(slots[i]);
+            m_wideNodes[nodeIndex].child[i] = collapsed;
+            m_wideNodes[nodeIndex].count[i] = 0;
+        }
+    }
+    return nodeIndex;
+}
+
+bool TriangleBVH::Intersect(const PreparedRay& r, float& maxDistance, int& triangle) const {
+    if (m_wideNodes.empty()) {
+        return false;
+    }
+    
+    float closestDistance = maxDistance;
+    int closestTriangle = -1;
+    
+    // Children are pushed far-to-near with their entry distance so subtrees behind the
+    // current closest hit are skipped when popped
+    struct StackEntry { int node; float tNear; };
+    StackEntry stack[BVHTraversalStackSize];
+    int stackSize = 0;
+    stack[stackSize++] = {0, 0.0f};
+    
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        if (entry.tNear > closestDistance) continue;
+        const BVH4Node& node = m_wideNodes[entry.node];
+        
+        float tNear[4];
+        int mask = IntersectChildren(node, r, closestDistance, tNear);
+        if (mask == 0) continue;
+        
+        int order[4];
+        int hitCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!(mask & (1 << i))) continue;
+            if (node.count[i] > 0) {
+                for (int k = 0; k < node.count[i]; ++k) {
+                    int triIndex = m_triangleIndices[node.child[i] + k];
+                    float t;
+                    if (IntersectTriangle(r, m_triangles[triIndex], closestDistance, t)) {
+                        closestDistance = t;
+                        closestTriangle = triIndex;
+                    }
+                }
+            } else {
+                // Insertion sort by distance, farthest first
+                int j = hitCount++;
+                while (j > 0 && tNear[order[j - 1]] < tNear[i]) {
+                    order[j] = order[j - 1];
+                    --j;
+                }
+                order[j] = i;
+            }
+        }
+        for (int k = 0; k < hitCount; ++k) {
+            stack[stackSize++] = {node.child[order[k]], tNear[order[k]]};
+        }
+    }
+    
+    if (closestTriangle < 0) {
+        return false;
+    }
+    maxDistance = closestDistance;
+    triangle = closestTriangle;
+    return true;
+}
+
+// Any-hit query for shadow rays: stops at the first triangle closer than maxDistance
+bool TriangleBVH::Occluded(const PreparedRay& r, float maxDistance) const {
+    if (m_wideNodes.empty()) {
+        return false;
+    }
+    
+    int stack[BVHTraversalStackSize];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    
+    while (stackSize > 0) {
+        const BVH4Node& node = m_wideNodes[stack[--stackSize]];
+        float tNear[4];
+        int mask = IntersectChildren(node, r, maxDistance, tNear);
+        for (int i = 0; i < 4; ++i) {
+            if (!(mask & (1 << i))) continue;
+            if (node.count[i] > 0) {
+                for (int k = 0; k < node.count[i]; ++k) {
+                    float t;
+                    if (IntersectTriangle(r, m_triangles[m_triangleIndices[node.child[i] + k]], maxDistance, t)) {
+                        return true;
+                    }
+                }
+            } else {
+                stack[stackSize++] = node.child[i];
+            }
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../../Core/Math/Vector3.h"
+#include <vector>
+
+namespace GameEngine {
+    struct Ray {
+        Vector3 origin;
+        Vector3 direction;
+
+        Ray(const Vector3& o, const Vector3& d) : origin(o), direction(d) {}
+    };
+
+    struct Triangle {
+        Vector3 v0, v1, v2;
+        Vector3 normal;
+        Vector3 color;
+        float reflectivity;
+
+        Triangle() = default;
+        Triangle(const Vector3& vertex0, const Vector3& vertex1, const Vector3& vertex2,
+                 const Vector3& col, float refl = 0.0f)
+            : v0(vertex0), v1(vertex1), v2(vertex2), color(col), reflectivity(refl) {
+            Vector3 edge1 = v1 - v0;
+            Vector3 edge2 = v2 - v0;
+            Vector3 crossProduct = edge1.Cross(edge2);
+            if (crossProduct.LengthSquared() > 0.0001f) {
+                normal = crossProduct.Normalized();
+            } else {
+                normal = Vector3(0.0f, 1.0f, 0.0f); // Default up normal
+            }
+        }
+    };
+
+    struct HitInfo {
+        bool hit = false;
+        float distance = 0.0f;
+        Vector3 point;
+        Vector3 normal;
+        Vector3 color;
+        float reflectivity = 0.0f;
+    };
+
+    // 32-byte node in depth-first order: an interior node's left child is the next node and
+    // rightOrFirst is the right child; a leaf's rightOrFirst indexes the primitive index array
+    struct BVHNode {
+        Vector3 minBounds;
+        int rightOrFirst = -1;
+        Vector3 maxBounds;
+        int triangleCount = 0;
+
+        BVHNode() = default;
+        bool IsLeaf() const { return triangleCount > 0; }
+    };
+    static_assert(sizeof(BVHNode) == 32, "BVHNode layout is shared with raytracing.comp");
+
+    // 4-wide node collapsed from the binary BVH for the CPU traversal kernel. Child bounds are
+    // stored per axis so one ray is tested against all four boxes with a single SIMD pass.
+    // A child with count > 0 is a leaf whose first index into the triangle index array is child;
+    // count == 0 means an interior BVH4 node; child == -1 is an empty slot.
+    struct alignas(16) BVH4Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        int child[4] = {-1, -1, -1, -1};
+        int count[4] = {0, 0, 0, 0};
+    };
+    static_assert(sizeof(BVH4Node) == 128, "BVH4Node should span exactly two cache lines");
+
+    // Per-ray constants shared by the box and triangle tests. The direction does not need to
+    // be normalized, so rays transformed into instance space keep their world-space t.
+    struct PreparedRay {
+        Vector3 origin;
+        Vector3 direction;
+        Vector3 invDirection;
+        int kx, ky, kz;
+        float shearX, shearY, shearZ;
+    };
+
+    PreparedRay PrepareRay(const Ray& ray);
+
+    // Watertight, double-sided ray/triangle test. Hits at t <= a small epsilon are rejected.
+    bool IntersectTriangle(const PreparedRay& ray, const Triangle& triangle, float maxDistance, float& outT);
+
+    // Slab test of one ray against an axis-aligned box using the precomputed inverse direction
+    bool IntersectBox(const PreparedRay& ray, const Vector3& boxMin, const Vector3& boxMax, float maxDistance, float& outNear);
+
+    // Triangle BVH: parallel binned-SAH build into 32-byte binary nodes, collapsed into 4-wide
+    // nodes for traversal. Used for the raytracer's loose triangles and as the per-mesh BLAS.
+    class TriangleBVH {
+    public:
+        void Build(const std::vector<Triangle>& triangles);
+        // Adopts a binary BVH baked offline over the same triangles; false (and empty) if the
+        // nodes do not describe a valid tree over them
+        bool BuildFromNodes(const std::vector<Triangle>& triangles, const std::vector<BVHNode>& nodes,
+                            const std::vector<int>& triangleIndices);
+        void Clear();
+        bool IsEmpty() const { return m_wideNodes.empty(); }
+
+        // Closest hit closer than maxDistance; on a hit maxDistance is shortened to it and
+        // triangle is set to an index into GetTriangles()
+        bool Intersect(const PreparedRay& ray, float& maxDistance, int& triangle) const;
+        // Any hit closer than maxDistance
+        bool Occluded(const PreparedRay& ray, float maxDistance) const;
+
+        const std::vector<Triangle>& GetTriangles() const { return m_triangles; }
+        const std::vector<int>& GetTriangleIndices() const { return m_triangleIndices; }
+        const std::vector<BVHNode>& GetNodes() const { return m_nodes; }
+        const std::vector<BVH4Node>& GetWideNodes() const { return m_wideNodes; }
+        const Vector3& GetBoundsMin() const { return m_boundsMin; }
+        const Vector3& GetBoundsMax() const { return m_boundsMax; }
+
+    private:
+        int CollapseBVH4(int binaryIndex);
+
+        std::vector<Triangle> m_triangles;
+        std::vector<int> m_triangleIndices;
+        std::vector<BVHNode> m_nodes;
+        std::vector<BVH4Node> m_wideNodes;
+        Vector3 m_boundsMin;
+        Vector3 m_boundsMax;
+    };
+}
@@ -0,0 +1,91 @@
+#include "FrameUniforms.h"
+#include "Shader.h"
+#include "../Core/Buffer.h"
+#include <algorithm>
+
+namespace GameEngine {
+
+namespace {
+
+const char* const BlockDeclarations = R"(
+layout(std140) uniform CameraData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+};
+
+struct LightEntry {
+    vec4 positionRange;
+    vec4 colorIntensity;
+    ivec4 typeShadow;
+    vec4 shadowParams;
+    vec4 shadowLightPosition;
+    mat4 lightSpace;
+};
+
+layout(std140) uniform LightData {
+    ivec4 lightCount;
+    LightEntry lights[32];
+};
+)";
+
+}
+
+FrameUniforms::FrameUniforms() = default;
+FrameUniforms::~FrameUniforms() = default;
+
+std::string FrameUniforms::ComposeSource(const char* version, const std::string& body) {
+    return std::string("#version ") + version + "\n" + BlockDeclarations + body;
+}
+
+void FrameUniforms::BindBlocks(Shader& shader) {
+    shader.BindUniformBlock("CameraData", CameraBinding);
+    shader.BindUniformBlock("LightData", LightBinding);
+}
+
+void FrameUniforms::SetCamera(const Matrix4& view, const Matrix4& projection) {
+    m_camera.view = view;
+    m_camera.projection = projection;
+
+    Matrix4 invView = view.Inverted();
+    m_camera.viewPosition[0] = invView.m[12];
+    m_camera.viewPosition[1] = invView.m[13];
+    m_camera.viewPosition[2] = invView.m[14];
+    m_camera.viewPosition[3] = 1.0f;
+}
+
+int FrameUniforms::SetLights(const std::vector<LightManager::ShaderLightData>& lights) {
+    int count = static_cast<int>(std::min(lights.size(), static_cast<size_t>(MaxLights)));
+    m_lights.lightCount[0] = count;
+
+    for (int i = 0; i < count; ++i) {
+        const LightManager::ShaderLightData& light = lights[i];
+        LightBlockEntry& entry = m_lights.lights[i];
+        entry = LightBlockEntry{};
+        entry.positionRange[0] = light.position.x;
+        entry.positionRange[1] = light.position.y;
+        entry.positionRange[2] = light.position.z;
+        entry.positionRange[3] = light.range;
+        entry.colorIntensity[0] = light.color.x;
+        entry.colorIntensity[1] = light.color.y;
+        entry.colorIntensity[2] = light.color.z;
+        entry.colorIntensity[3] = light.intensity;
+        entry.typeShadow[0] = light.type;
+    }
+    return count;
+}
+
+void FrameUniforms::Upload() {
+    if (!m_cameraBuffer) {
+        m_cameraBuffer = std::make_unique<Buffer>(BufferType::Uniform, BufferUsage::Stream);
+        m_lightBuffer = std::make_unique<Buffer>(BufferType::Uniform, BufferUsage::Stream);
+    }
+
+    m_cameraBuffer->SetData(&m_camera, sizeof(m_camera));
+    m_cameraBuffer->BindBase(CameraBinding);
+
+    m_lightBuffer->SetData(&m_lights, sizeof(m_lights));
+    m_lightBuffer->BindBase(LightBinding);
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../../Core/Math/Matrix4.h"
+#include "../../Core/Math/Vector3.h"
+#include "../Lighting/LightManager.h"
+#include "../Lighting/Light.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+    class Buffer;
+    class Shader;
+
+    // std140 mirror of the CameraData block
+    struct CameraBlock {
+        Matrix4 view;
+        Matrix4 projection;
+        float viewPosition[4];
+    };
+    static_assert(sizeof(CameraBlock) == 144, "CameraBlock must match the std140 CameraData layout");
+
+    // std140 mirror of one LightEntry in the LightData block
+    struct LightBlockEntry {
+        float positionRange[4];     // xyz position (direction for directional lights), w range
+        float colorIntensity[4];    // rgb color, w intensity
+        int32_t typeShadow[4];      // light type, has shadow, shadow type, shadow sampler index
+        float shadowParams[4];      // bias, texel size, near plane, far plane
+        float shadowLightPosition[4];
+        Matrix4 lightSpace;
+    };
+    static_assert(sizeof(LightBlockEntry) == 144, "LightBlockEntry must match the std140 LightEntry layout");
+
+    // Per-frame camera and light uniform buffers shared by the raster pipelines. Each block is
+    // filled on the CPU and uploaded with a single buffer write per frame instead of one
+    // glUniform call per field and light.
+    class FrameUniforms {
+    public:
+        static constexpr unsigned int CameraBinding = 0;
+        static constexpr unsigned int LightBinding = 1;
+        static constexpr int MaxLights = MAX_LIGHTS;     // Must match the LightData array size
+
+        struct LightBlock {
+            int32_t lightCount[4];
+            LightBlockEntry lights[MaxLights];
+        };
+
+        FrameUniforms();
+        ~FrameUniforms();
+
+        // Builds a shader source: the #version line, both block declarations, then body
+        static std::string ComposeSource(const char* version, const std::string& body);
+        // Points the shader's CameraData and LightData blocks at the shared binding points
+        static void BindBlocks(Shader& shader);
+
+        void SetCamera(const Matrix4& view, const Matrix4& projection);
+        // Fills the light entries with shadows disabled; returns the number of lights used
+        int SetLights(const std::vector<LightManager::ShaderLightData>& lights);
+        LightBlockEntry& GetLight(int index) { return m_lights.lights[index]; }
+
+        const CameraBlock& GetCameraBlock() const { return m_camera; }
+        const LightBlock& GetLightBlock() const { return m_lights; }
+
+        // Uploads both blocks and binds them to their binding points; needs a current context
+        void Upload();
+
+    private:
+        CameraBlock m_camera = {};
+        LightBlock m_lights = {};
+        std::unique_ptr<Buffer> m_cameraBuffer;
+        std::unique_ptr<Buffer> m_lightBuffer;
+    };
+}
@@ -3,6 +3,7 @@
 #include "../Core/OpenGLHeaders.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 namespace GameEngine {
 
@@ -138,6 +139,7 @@ bool Shader::LinkProgram(unsigned int vertexShader, unsigned int fragmentShader)
         return false;
     }
     
+    CacheActiveUniforms();
     Logger::Info("Shader program linked successfully");
     return true;
 }
@@ -164,6 +166,88 @@ int Shader::GetUniformLocation(const std::string& name) {
     return location;
 }
 
+void Shader::SetInt(UniformID id, int value) {
+    glUniform1i(GetUniformLocation(id), value);
+}
+
+void Shader::SetFloat(UniformID id, float value) {
+    glUniform1f(GetUniformLocation(id), value);
+}
+
+void Shader::SetVector3(UniformID id, const Vector3& value) {
+    glUniform3f(GetUniformLocation(id), value.x, value.y, value.z);
+}
+
+void Shader::SetMatrix4(UniformID id, const Matrix4& value) {
+    glUniformMatrix4fv(GetUniformLocation(id), 1, GL_FALSE, value.Data());
+}
+
+void Shader::SetVector4(UniformID id, const Vector4& value) {
+    glUniform4f(GetUniformLocation(id), value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetInt4(UniformID id, int x, int y, int z, int w) {
+    glUniform4i(GetUniformLocation(id), x, y, z, w);
+}
+
+void Shader::SetIntArray(UniformID id, const int* values, int count) {
+    glUniform1iv(GetUniformLocation(id), count, values);
+}
+
+bool Shader::HasUniform(UniformID id) const {
+    return GetUniformLocation(id) != -1;
+}
+
+bool Shader::BindUniformBlock(const char* blockName, unsigned int bindingPoint) {
+    unsigned int blockIndex = glGetUniformBlockIndex(m_programID, blockName);
+    if (blockIndex == GL_INVALID_INDEX) {
+        Logger::Debug(std::string("Uniform block '") + blockName + "' not used by shader " + std::to_string(m_programID));
+        return false;
+    }
+    glUniformBlockBinding(m_programID, blockIndex, bindingPoint);
+    return true;
+}
+
+int Shader::GetUniformLocation(UniformID id) const {
+    auto it = m_uniformLocations.find(id.hash);
+    return it != m_uniformLocations.end() ? it->second : -1;
+}
+
+void Shader::CacheActiveUniforms() {
+    m_uniformLocations.clear();
+
+    int uniformCount = 0;
+    int maxNameLength = 0;
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+
+    for (int i = 0; i < uniformCount; ++i) {
+        int length = 0;
+        int size = 0;
+        unsigned int type = 0;
+        glGetActiveUniform(m_programID, static_cast<unsigned int>(i), maxNameLength, &length, &size, &type, name.data());
+        std::string_view uniformName(name.data(), static_cast<size_t>(length));
+
+        // Members of uniform blocks have no location
+        int location = glGetUniformLocation(m_programID, name.c_str());
+        if (location == -1) {
+            continue;
+        }
+
+        // Arrays are reported as "name[0]"; register the base name as well
+        if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]") {
+            uniformName.remove_suffix(3);
+        }
+
+        auto [it, inserted] = m_uniformLocations.emplace(UniformID::Hash(uniformName), location);
+        if (!inserted && it->second != location) {
+            Logger::Warning("Uniform name hash collision for '" + std::string(uniformName) + "'");
+        }
+    }
+    Logger::Debug("Cached " + std::to_string(m_uniformLocations.size()) + " uniform locations for shader " + std::to_string(m_programID));
+}
+
 unsigned int Shader::GetProgramID() const {
     return m_programID;
 }
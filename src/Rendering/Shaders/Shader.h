@@ -1,12 +1,31 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <cstdint>
 #include "../../Core/Math/Matrix4.h"
 #include "../../Core/Math/Vector3.h"
 #include "../../Core/Math/Vector4.h"
 
 namespace GameEngine {
+    // Uniform name hashed at compile time (FNV-1a). Shader resolves every active uniform once
+    // at link time, so setting through an ID is a hash lookup with no string building.
+    // Arrays are addressed by their base name and set with the *Array setters.
+    struct UniformID {
+        uint32_t hash;
+
+        explicit constexpr UniformID(std::string_view name) : hash(Hash(name)) {}
+
+        static constexpr uint32_t Hash(std::string_view name) {
+            uint32_t h = 2166136261u;
+            for (char c : name) {
+                h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+            }
+            return h;
+        }
+    };
+
     class Shader {
     public:
         Shader();
@@ -29,14 +48,30 @@ namespace GameEngine {
         void SetVector3(const std::string& name, const Vector3& value);
         void SetVector4(const std::string& name, const Vector4& value);
         void SetMatrix4(const std::string& name, const Matrix4& value);
+
+        // Precomputed-handle setters; unknown IDs are ignored like a -1 location
+        void SetInt(UniformID id, int value);
+        void SetFloat(UniformID id, float value);
+        void SetVector3(UniformID id, const Vector3& value);
+        void SetMatrix4(UniformID id, const Matrix4& value);
+        void SetVector4(UniformID id, const Vector4& value);
+        void SetInt4(UniformID id, int x, int y, int z, int w);
+        void SetIntArray(UniformID id, const int* values, int count);
+        bool HasUniform(UniformID id) const;
+
+        // Assigns a named std140 uniform block to a buffer binding point
+        bool BindUniformBlock(const char* blockName, unsigned int bindingPoint);
         
     private:
         unsigned int CompileShader(const std::string& source, unsigned int type);
         bool LinkProgram(unsigned int vertexShader, unsigned int fragmentShader);
         bool LinkComputeProgram(unsigned int computeShader);
         int GetUniformLocation(const std::string& name);
+        int GetUniformLocation(UniformID id) const;
+        void CacheActiveUniforms();
         
         unsigned int m_programID = 0;
         mutable std::unordered_map<std::string, int> m_uniformLocationCache;
+        std::unordered_map<uint32_t, int> m_uniformLocations;     // Name hash -> location, filled at link time
     };
 }
@@ -244,7 +244,7 @@ void InspectorPanel::DrawMeshComponent(World* world, Entity entity) {
             static char objPath[256] = "";
             ImGui::InputText("OBJ Path", objPath, sizeof(objPath));
             if (ImGui::Button("Load") && strlen(objPath) > 0) {
-                mesh->LoadMeshFromOBJ(objPath);
+                mesh->LoadMeshFromOBJAsync(objPath);
                 ImGui::CloseCurrentPopup();
             }
             ImGui::SameLine();
@@ -8,12 +8,24 @@
 
 #include "Physics/PhysicsWorld.h"
 #include "Physics/RigidBody/RigidBody.h"
+#include "Physics/Constraints/JointSolver.h"
+#include "Physics/PhysicsSnapshot.h"
+#include "Physics/Character/CharacterController.h"
+#include "Physics/Spatial/Octree.h"
+#include "Physics/2D/PhysicsWorld2D.h"
+#include "Physics/2D/RigidBody2D.h"
 #include "Core/Components/ColliderComponent.h"
+#include "Core/Components/RigidBodyComponent.h"
 #include "Core/Components/TransformComponent.h"
+#include "Core/ECS/World.h"
+#include "Core/Scenes/Scene.h"
 #include "Core/Math/Quaternion.h"
 #include "Core/Math/Vector3.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 
 using namespace GameEngine;
 
@@ -620,6 +632,591 @@ static bool runFreeFallAnalyticCheck(bool verbose) {
     return pass;
 }
 
+static bool runContactEventScenario(bool verbose) {
+    PhysicsWorld world;
+    world.Initialize();
+
+    TransformComponent groundTr;
+    std::unique_ptr<ColliderComponent> groundCollider;
+    SetupGroundStaticCollider(world, 0.0f, 0.8f, groundTr, groundCollider);
+
+    TransformComponent triggerTr;
+    triggerTr.transform.SetPosition(Vector3(0.0f, 6.0f, 0.0f));
+    auto triggerCollider = std::make_unique<ColliderComponent>();
+    triggerCollider->SetBoxCollider(Vector3(2.0f, 0.5f, 2.0f));
+    triggerCollider->SetTrigger(true);
+    triggerCollider->SetOwnerTransform(&triggerTr);
+    world.AddStaticCollider(triggerCollider.get());
+
+    auto rb = std::make_unique<RigidBody>();
+    rb->SetBodyType(RigidBodyType::Dynamic);
+    rb->SetMass(1.0f);
+    rb->SetRestitution(0.0f);
+    rb->SetPosition(Vector3(0.0f, 10.0f, 0.0f));
+
+    auto boxCol = std::make_unique<ColliderComponent>();
+    boxCol->SetBoxCollider(Vector3(0.5f, 0.5f, 0.5f));
+    TransformComponent boxTr;
+    boxTr.transform.SetPosition(rb->GetPosition());
+    boxCol->SetOwnerTransform(&boxTr);
+    rb->SetColliderComponent(boxCol.get());
+    world.AddRigidBody(rb.get());
+
+    int triggerEnter = 0, triggerExit = 0, groundBegin = 0, groundStay = 0, groundEnd = 0;
+    bool exitBeforeGround = false;
+    const float dt = 1.0f / 60.0f;
+    for (int i = 0; i < 240; ++i) {
+        world.Update(dt);
+        boxTr.transform.SetPosition(rb->GetPosition());
+
+        for (const ContactEvent& ev : world.GetContactEvents()) {
+            bool withTrigger = ev.colliderA == triggerCollider.get() || ev.colliderB == triggerCollider.get();
+            bool withGround = ev.colliderA == groundCollider.get() || ev.colliderB == groundCollider.get();
+            switch (ev.type) {
+                case ContactEventType::TriggerEnter: if (withTrigger) triggerEnter++; break;
+                case ContactEventType::TriggerExit:
+                    if (withTrigger) { triggerExit++; exitBeforeGround = (groundBegin == 0); }
+                    break;
+                case ContactEventType::ContactBegin: if (withGround) groundBegin++; break;
+                case ContactEventType::ContactStay: if (withGround) groundStay++; break;
+                case ContactEventType::ContactEnd: if (withGround) groundEnd++; break;
+            }
+        }
+    }
+
+    bool pass = triggerEnter == 1 && triggerExit == 1 && exitBeforeGround &&
+                groundBegin >= 1 && groundBegin == groundEnd + 1 && groundStay > 0;
+
+    // Removing a participant while touching still closes its pairs, with the removed side nulled.
+    // A trigger inside the resting box, clear of the ground, is entered and then removed.
+    TransformComponent zoneTr;
+    zoneTr.transform.SetPosition(rb->GetPosition());
+    auto zoneCollider = std::make_unique<ColliderComponent>();
+    zoneCollider->SetBoxCollider(Vector3(0.25f, 0.25f, 0.25f));
+    zoneCollider->SetTrigger(true);
+    zoneCollider->SetOwnerTransform(&zoneTr);
+    world.AddStaticCollider(zoneCollider.get());
+    int zoneEnter = 0, zoneExit = 0;
+    for (int i = 0; i < 3; ++i) {
+        world.Update(dt);
+        boxTr.transform.SetPosition(rb->GetPosition());
+        for (const ContactEvent& ev : world.GetContactEvents()) {
+            if (ev.type == ContactEventType::TriggerEnter && (ev.colliderA == zoneCollider.get() || ev.colliderB == zoneCollider.get())) zoneEnter++;
+        }
+    }
+    world.RemoveStaticCollider(zoneCollider.get());
+    world.RemoveRigidBody(rb.get());
+    world.Update(dt);
+    bool removedEndsOk = true;
+    for (const ContactEvent& ev : world.GetContactEvents()) {
+        if (ev.type == ContactEventType::TriggerExit) {
+            // The zone side is gone; the box is still in the world when the zone is removed
+            bool boxSide = ev.colliderA == boxCol.get() || ev.colliderB == boxCol.get();
+            bool nulledSide = (!ev.colliderA && !ev.bodyA) || (!ev.colliderB && !ev.bodyB);
+            removedEndsOk = removedEndsOk && boxSide && nulledSide;
+            zoneExit++;
+        } else if (ev.type == ContactEventType::ContactEnd) {
+            bool groundSide = ev.colliderA == groundCollider.get() || ev.colliderB == groundCollider.get();
+            bool boxNulled = (ev.colliderA == groundCollider.get() ? (!ev.colliderB && !ev.bodyB) : (!ev.colliderA && !ev.bodyA));
+            removedEndsOk = removedEndsOk && groundSide && boxNulled;
+            if (groundSide) groundEnd++;
+        }
+    }
+    removedEndsOk = removedEndsOk && zoneEnter == 1 && zoneExit == 1 && groundBegin == groundEnd;
+    pass = pass && removedEndsOk;
+
+    if (verbose) {
+        std::cout << "ContactEvents: triggerEnter=" << triggerEnter
+                  << " triggerExit=" << triggerExit
+                  << " groundBegin=" << groundBegin
+                  << " groundStay=" << groundStay
+                  << " groundEnd=" << groundEnd
+                  << " removedEnds=" << (removedEndsOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    world.Shutdown();
+    return pass;
+}
+
+static bool runJointScenario(bool verbose) {
+    PhysicsWorld world;
+    world.Initialize();
+    JointSolver* joints = world.GetJointSolver();
+
+    // Pendulum hanging from a world anchor
+    auto bob = std::make_unique<RigidBody>();
+    bob->SetMass(1.0f);
+    bob->SetDamping(0.0f);
+    bob->SetPosition(Vector3(2.0f, 10.0f, 0.0f));
+    joints->CreateBallSocketJoint(nullptr, bob.get(), Vector3(0.0f, 10.0f, 0.0f));
+    world.AddRigidBody(bob.get());
+
+    // Chain of distance joints
+    const int links = 6;
+    std::vector<std::unique_ptr<RigidBody>> chain;
+    for (int i = 0; i < links; ++i) {
+        auto link = std::make_unique<RigidBody>();
+        link->SetMass(1.0f);
+        link->SetPosition(Vector3(10.0f + 0.5f * (i + 1), 10.0f, 0.0f));
+        world.AddRigidBody(link.get());
+        RigidBody* previous = i == 0 ? nullptr : chain.back().get();
+        Vector3 anchorA = i == 0 ? Vector3(10.0f, 10.0f, 0.0f) : previous->GetPosition();
+        joints->CreateDistanceJoint(previous, link.get(), anchorA, link->GetPosition());
+        chain.push_back(std::move(link));
+    }
+
+    // Motorized wheel on a world hinge
+    auto wheel = std::make_unique<RigidBody>();
+    wheel->SetMass(1.0f);
+    wheel->SetAngularDamping(0.0f);
+    wheel->SetPosition(Vector3(-10.0f, 5.0f, 0.0f));
+    JointHandle hinge = joints->CreateHingeJoint(nullptr, wheel.get(), wheel->GetPosition(), Vector3(0.0f, 0.0f, 1.0f));
+    joints->SetHingeMotor(hinge, true, 3.0f, 50.0f);
+    world.AddRigidBody(wheel.get());
+
+    const float dt = 1.0f / 60.0f;
+    float maxPendulumError = 0.0f;
+    float minBobY = 10.0f;
+    float maxChainStretch = 0.0f;
+    for (int i = 0; i < 300; ++i) {
+        world.Update(dt);
+        float r = (bob->GetPosition() - Vector3(0.0f, 10.0f, 0.0f)).Length();
+        maxPendulumError = std::max(maxPendulumError, std::fabs(r - 2.0f));
+        minBobY = std::min(minBobY, bob->GetPosition().y);
+        float length = (chain[0]->GetPosition() - Vector3(10.0f, 10.0f, 0.0f)).Length();
+        for (int l = 1; l < links; ++l) {
+            length += (chain[l]->GetPosition() - chain[l - 1]->GetPosition()).Length();
+        }
+        maxChainStretch = std::max(maxChainStretch, length / (0.5f * links) - 1.0f);
+    }
+
+    float wheelSpin = wheel->GetAngularVelocity().z;
+    float wheelDrift = (wheel->GetPosition() - Vector3(-10.0f, 5.0f, 0.0f)).Length();
+    float wheelWobble = std::fabs(wheel->GetAngularVelocity().x) + std::fabs(wheel->GetAngularVelocity().y);
+
+    bool pass = maxPendulumError < 0.05f && minBobY < 8.5f &&
+                maxChainStretch < 0.08f &&
+                std::fabs(wheelSpin - 3.0f) < 0.05f && wheelDrift < 0.05f && wheelWobble < 0.05f &&
+                joints->GetBatchCount() >= 2;
+
+    if (verbose) {
+        std::cout << "Joints: pendulumErr=" << maxPendulumError
+                  << " minBobY=" << minBobY
+                  << " chainStretch=" << maxChainStretch
+                  << " wheelSpin=" << wheelSpin
+                  << " wheelDrift=" << wheelDrift
+                  << " batches=" << joints->GetBatchCount()
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    world.Shutdown();
+    return pass;
+}
+
+static bool runSnapshotRollbackScenario(bool verbose) {
+    PhysicsWorld world;
+    world.Initialize();
+
+    TransformComponent groundTr;
+    std::unique_ptr<ColliderComponent> groundCollider;
+    SetupGroundStaticCollider(world, 0.0f, 0.8f, groundTr, groundCollider);
+
+    auto rb = std::make_unique<RigidBody>();
+    rb->SetMass(1.0f);
+    rb->SetRestitution(0.0f);
+    rb->SetPosition(Vector3(0.0f, 4.0f, 0.0f));
+    rb->SetRotation(Quaternion::FromAxisAngle(Vector3(0.3f, 0.0f, 1.0f).Normalized(), 0.4f));
+    auto boxCol = std::make_unique<ColliderComponent>();
+    boxCol->SetBoxCollider(Vector3(0.5f, 0.5f, 0.5f));
+    TransformComponent boxTr;
+    boxCol->SetOwnerTransform(&boxTr);
+    rb->SetColliderComponent(boxCol.get());
+    world.AddRigidBody(rb.get());
+
+    auto bob = std::make_unique<RigidBody>();
+    bob->SetMass(1.0f);
+    bob->SetPosition(Vector3(6.0f, 10.0f, 0.0f));
+    world.GetJointSolver()->CreateBallSocketJoint(nullptr, bob.get(), Vector3(4.0f, 10.0f, 0.0f));
+    world.AddRigidBody(bob.get());
+
+    const float dt = 1.0f / 60.0f;
+    auto step = [&]() {
+        boxTr.transform.SetPosition(rb->GetPosition());
+        boxTr.transform.SetRotation(rb->GetRotation());
+        world.Update(dt);
+    };
+
+    // Save mid-fall, record a trajectory through the landing, then rewind and replay it
+    for (int i = 0; i < 30; ++i) step();
+    PhysicsSnapshot snapshot;
+    world.SaveSnapshot(snapshot);
+
+    const int replaySteps = 90;
+    std::vector<Vector3> recorded;
+    for (int i = 0; i < replaySteps; ++i) {
+        step();
+        recorded.push_back(rb->GetPosition());
+        recorded.push_back(bob->GetPosition());
+    }
+
+    bool restored = world.RestoreSnapshot(snapshot);
+    float maxDeviation = 0.0f;
+    for (int i = 0; i < replaySteps && restored; ++i) {
+        step();
+        maxDeviation = std::max(maxDeviation, (rb->GetPosition() - recorded[2 * i]).Length());
+        maxDeviation = std::max(maxDeviation, (bob->GetPosition() - recorded[2 * i + 1]).Length());
+    }
+
+    // Restoring after the ground left the world must not bring back its contact pair
+    PhysicsSnapshot resting;
+    world.SaveSnapshot(resting);
+    world.RemoveStaticCollider(groundCollider.get());
+    for (int i = 0; i < 3; ++i) step();
+    bool staleDropped = world.RestoreSnapshot(resting);
+    step();
+    for (const ContactEvent& event : world.GetContactEvents()) {
+        if (event.colliderA == groundCollider.get() || event.colliderB == groundCollider.get()) staleDropped = false;
+    }
+
+    // A snapshot must be rejected once the body set changes
+    auto extra = std::make_unique<RigidBody>();
+    world.AddRigidBody(extra.get());
+    bool rejected = !world.RestoreSnapshot(snapshot);
+
+    bool pass = restored && rejected && staleDropped && maxDeviation < 1e-4f;
+    if (verbose) {
+        std::cout << "SnapshotRollback: bytes=" << snapshot.GetSize()
+                  << " maxDeviation=" << maxDeviation
+                  << " rejectedMismatch=" << (rejected ? "yes" : "no")
+                  << " staleDropped=" << (staleDropped ? "yes" : "no")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    world.Shutdown();
+    return pass;
+}
+
+static bool runCharacterControllerScenario(bool verbose) {
+    PhysicsWorld world;
+    world.Initialize();
+
+    TransformComponent groundTr;
+    std::unique_ptr<ColliderComponent> groundCollider;
+    SetupGroundStaticCollider(world, 0.0f, 0.8f, groundTr, groundCollider);
+    const float groundY = GroundTopY();
+
+    // Obstacles along +x: a low step, a wall, and a 25 degree ramp along -x
+    auto addBox = [&](TransformComponent& tr, std::unique_ptr<ColliderComponent>& col, const Vector3& center, const Vector3& halfExtents, const Quaternion& rotation) {
+        col = std::make_unique<ColliderComponent>();
+        col->SetBoxCollider(halfExtents);
+        tr.transform.SetPosition(center);
+        tr.transform.SetRotation(rotation);
+        col->SetOwnerTransform(&tr);
+        world.AddStaticCollider(col.get());
+    };
+    TransformComponent stepTr, wallTr, rampTr;
+    std::unique_ptr<ColliderComponent> stepCol, wallCol, rampCol;
+    addBox(stepTr, stepCol, Vector3(3.0f, groundY + 0.1f, 0.0f), Vector3(1.0f, 0.1f, 2.0f), Quaternion::Identity());
+    addBox(wallTr, wallCol, Vector3(6.0f, groundY + 1.0f, 0.0f), Vector3(0.25f, 1.0f, 2.0f), Quaternion::Identity());
+    const float rampAngle = 25.0f * 3.14159265f / 180.0f;
+    addBox(rampTr, rampCol, Vector3(-6.0f, groundY + 1.6f, 0.0f), Vector3(4.0f, 0.1f, 2.0f), Quaternion::FromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), -rampAngle));
+
+    CharacterController walker;
+    const CharacterControllerSettings& settings = walker.GetSettings();
+    const float centerAboveFeet = settings.height * 0.5f + settings.radius;
+    walker.SetPosition(Vector3(0.0f, groundY + 2.0f, 0.0f));
+    world.AddCharacterController(&walker);
+
+    const float dt = 1.0f / 60.0f;
+    // Fall and land
+    for (int i = 0; i < 90; ++i) world.Update(dt);
+    float landedGap = walker.GetFootPosition().y - groundY;
+    bool landed = walker.IsGrounded() && landedGap > 0.0f && landedGap < 0.05f;
+
+    // Walk over the step and into the wall
+    walker.SetMoveVelocity(Vector3(3.0f, 0.0f, 0.0f));
+    float maxFootOnStep = -1e9f;
+    bool groundedOnWalk = true;
+    for (int i = 0; i < 150; ++i) {
+        world.Update(dt);
+        if (walker.GetPosition().x > 2.6f && walker.GetPosition().x < 3.4f) {
+            maxFootOnStep = std::max(maxFootOnStep, walker.GetFootPosition().y);
+        }
+        groundedOnWalk = groundedOnWalk && walker.IsGrounded();
+    }
+    bool steppedUp = maxFootOnStep > groundY + 0.15f;
+    float wallFace = 6.0f - 0.25f;
+    float wallStopX = walker.GetPosition().x;
+    bool blockedByWall = wallStopX < wallFace - settings.radius + 0.01f &&
+                         wallStopX > wallFace - settings.radius - 0.1f &&
+                         (walker.GetCollisionFlags() & CharacterCollisionSides);
+
+    // Walk back past the start and up the ramp
+    walker.SetMoveVelocity(Vector3(-3.0f, 0.0f, 0.0f));
+    for (int i = 0; i < 200; ++i) world.Update(dt);
+    bool climbedRamp = walker.GetFootPosition().y > groundY + 0.5f && walker.IsGrounded();
+    world.RemoveCharacterController(&walker);
+
+    // A crowd stepping in parallel should all settle on the ground without any solver work
+    std::vector<std::unique_ptr<CharacterController>> crowd;
+    for (int i = 0; i < 200; ++i) {
+        auto npc = std::make_unique<CharacterController>();
+        npc->SetPosition(Vector3(-20.0f + (i % 20) * 1.5f, groundY + centerAboveFeet + 0.5f, 10.0f + (i / 20) * 1.5f));
+        npc->SetMoveVelocity(Vector3(0.0f, 0.0f, 1.0f));
+        world.AddCharacterController(npc.get());
+        crowd.push_back(std::move(npc));
+    }
+    for (int i = 0; i < 60; ++i) world.Update(dt);
+    int crowdGrounded = 0;
+    for (const auto& npc : crowd) {
+        if (npc->IsGrounded() && std::fabs(npc->GetFootPosition().y - groundY) < 0.05f) crowdGrounded++;
+    }
+
+    bool pass = landed && steppedUp && groundedOnWalk && blockedByWall && climbedRamp && crowdGrounded == 200;
+    if (verbose) {
+        std::cout << "CharacterController: landedGap=" << landedGap
+                  << " stepFoot=" << (maxFootOnStep - groundY)
+                  << " groundedOnWalk=" << (groundedOnWalk ? "yes" : "no")
+                  << " wallGap=" << (wallFace - settings.radius - wallStopX)
+                  << " rampFoot=" << (walker.GetFootPosition().y - groundY)
+                  << " crowdGrounded=" << crowdGrounded
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    world.Shutdown();
+    return pass;
+}
+static bool runBulkLoadScenario(bool verbose) {
+    PhysicsWorld world;
+    world.Initialize();
+
+    // 20k spheres on a grid, well apart, plus a dense cluster that overlaps heavily
+    const int gridCount = 20000;
+    const int clusterCount = 500;
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    std::vector<std::unique_ptr<ColliderComponent>> colliders;
+    std::vector<RigidBody*> batch;
+    for (int i = 0; i < gridCount + clusterCount; ++i) {
+        auto col = std::make_unique<ColliderComponent>();
+        col->SetSphereCollider(0.5f);
+        auto rb = std::make_unique<RigidBody>();
+        rb->SetColliderComponent(col.get());
+        if (i < gridCount) {
+            rb->SetPosition(Vector3(-600.0f + (i % 400) * 3.0f, 50.0f, -100.0f + (i / 400) * 3.0f));
+        } else {
+            int k = i - gridCount;
+            rb->SetPosition(Vector3(300.0f + (k * 37 % 100) * 0.1f, 20.0f + (k * 53 % 100) * 0.1f, 300.0f + (k * 71 % 100) * 0.1f));
+        }
+        batch.push_back(rb.get());
+        bodies.push_back(std::move(rb));
+        colliders.push_back(std::move(col));
+    }
+    const size_t total = batch.size();
+    // Duplicates within the batch must be ignored
+    for (int i = 0; i < 100; ++i) batch.push_back(batch[i * 7]);
+
+    auto t0 = std::chrono::steady_clock::now();
+    world.AddRigidBodies(batch);
+    auto t1 = std::chrono::steady_clock::now();
+    double addMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    bool countOk = world.GetRigidBodies().size() == total;
+
+    // Every body must be in the octree exactly once, and queries must match brute force
+    const Octree* octree = world.GetOctree();
+    auto octreeMatchesBruteForce = [&]() {
+        std::vector<RigidBody*> found;
+        octree->Query(AABB(Vector3(-1000.0f, -1000.0f, -1000.0f), Vector3(1000.0f, 1000.0f, 1000.0f)), found);
+        std::sort(found.begin(), found.end());
+        if (found.size() != world.GetRigidBodies().size() || std::adjacent_find(found.begin(), found.end()) != found.end()) return false;
+        for (int q = 0; q < 40; ++q) {
+            Vector3 center = (q % 2 == 0) ? Vector3(-600.0f + q * 29.0f, 50.0f, -100.0f + q * 3.7f)
+                                          : Vector3(300.0f + q * 0.25f, 20.0f + q * 0.2f, 300.0f + q * 0.15f);
+            Vector3 half(2.0f + (q % 5), 2.0f, 2.0f + (q % 3));
+            AABB box(center - half, center + half);
+            found.clear();
+            octree->Query(box, found);
+            size_t expected = 0;
+            for (RigidBody* body : world.GetRigidBodies()) {
+                AABB bodyBox(body->GetPosition() - Vector3(0.5f, 0.5f, 0.5f), body->GetPosition() + Vector3(0.5f, 0.5f, 0.5f));
+                if (bodyBox.Intersects(box)) expected++;
+            }
+            if (found.size() != expected) return false;
+        }
+        return true;
+    };
+    bool octreeOk = octree && octreeMatchesBruteForce();
+
+    // Swap-and-pop removal must keep membership consistent for the bodies that move
+    for (size_t i = 0; i < total; i += 3) world.RemoveRigidBody(bodies[i].get());
+    bool removeOk = true;
+    for (size_t i = 0; i < total; ++i) {
+        if (world.ContainsRigidBody(bodies[i].get()) != (i % 3 != 0)) removeOk = false;
+    }
+    removeOk = removeOk && octreeMatchesBruteForce();
+    world.AddRigidBodies(batch);
+    bool readdOk = world.GetRigidBodies().size() == total && octreeMatchesBruteForce();
+
+    // Static colliders take the same bulk path
+    std::vector<TransformComponent> staticTransforms(2000);
+    std::vector<std::unique_ptr<ColliderComponent>> statics;
+    std::vector<ColliderComponent*> staticBatch;
+    for (size_t i = 0; i < staticTransforms.size(); ++i) {
+        auto col = std::make_unique<ColliderComponent>();
+        col->SetBoxCollider(Vector3(0.5f, 0.5f, 0.5f));
+        staticTransforms[i].transform.SetPosition(Vector3(-500.0f + (i % 100) * 4.0f, -20.0f, -500.0f + (i / 100) * 4.0f));
+        col->SetOwnerTransform(&staticTransforms[i]);
+        staticBatch.push_back(col.get());
+        statics.push_back(std::move(col));
+    }
+    staticBatch.push_back(staticBatch[0]);
+    world.AddStaticColliders(staticBatch);
+    for (size_t i = 0; i < statics.size(); i += 2) world.RemoveStaticCollider(statics[i].get());
+    std::vector<ColliderComponent*> staticFound;
+    octree->Query(AABB(Vector3(-1000.0f, -1000.0f, -1000.0f), Vector3(1000.0f, 1000.0f, 1000.0f)), staticFound);
+    bool staticOk = world.GetStaticColliders().size() == statics.size() / 2 && staticFound.size() == statics.size() / 2;
+    for (size_t i = 0; i < statics.size(); ++i) {
+        if (world.ContainsStaticCollider(statics[i].get()) != (i % 2 == 1)) staticOk = false;
+    }
+
+    // 2D bodies
+    PhysicsWorld2D world2D;
+    world2D.Initialize();
+    std::vector<std::unique_ptr<RigidBody2D>> bodies2D;
+    std::vector<RigidBody2D*> batch2D;
+    for (int i = 0; i < 3000; ++i) {
+        auto rb = std::make_unique<RigidBody2D>();
+        rb->SetColliderType(Collider2DType::Circle);
+        rb->SetColliderRadius(0.2f);
+        rb->SetPosition(Vector2(-90.0f + (i % 60) * 3.0f, -90.0f + (i / 60) * 3.0f));
+        rb->SetBodyType(RigidBody2DType::Static);
+        batch2D.push_back(rb.get());
+        bodies2D.push_back(std::move(rb));
+    }
+    batch2D.push_back(batch2D[5]);
+    world2D.AddRigidBodies(batch2D);
+    world2D.RemoveRigidBody(bodies2D[0].get());
+    world2D.RemoveRigidBody(bodies2D[0].get());
+    world2D.Update(1.0f / 60.0f);
+    bool ok2D = world2D.GetRigidBodies().size() == bodies2D.size() - 1 &&
+                !world2D.ContainsRigidBody(bodies2D[0].get()) &&
+                world2D.ContainsRigidBody(bodies2D.back().get()) &&
+                world2D.GetCollisionCount() == 0;
+    world2D.Shutdown();
+
+    bool pass = countOk && octreeOk && removeOk && readdOk && staticOk && ok2D;
+    if (verbose) {
+        std::cout << "BulkLoad: bodies=" << world.GetRigidBodies().size()
+                  << " addMs=" << addMs
+                  << " octree=" << (octreeOk ? "ok" : "bad")
+                  << " remove=" << (removeOk ? "ok" : "bad")
+                  << " readd=" << (readdOk ? "ok" : "bad")
+                  << " statics=" << (staticOk ? "ok" : "bad")
+                  << " 2d=" << (ok2D ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    world.Shutdown();
+    return pass;
+}
+
+
+// Scene loads register their rigid bodies through one AddRigidBodies batch
+static bool runSceneBulkLoadScenario(bool verbose) {
+    PhysicsWorld physicsWorld;
+    physicsWorld.Initialize();
+    World world;
+    world.SetPhysicsWorld(&physicsWorld);
+
+    const int count = 300;
+    const std::string path = "_tmp_bulk_load.scene";
+    size_t savedBodies = 0;
+    {
+        Scene scene(&world, "BulkLoad");
+        for (int i = 0; i < count; ++i) {
+            GameObject object = scene.CreateGameObject(Vector3(-150.0f + i, 2.0f + (i % 5), 0.0f));
+            auto* rb = object.AddComponent<RigidBodyComponent>();
+            rb->GetRigidBody()->SetMass(1.0f + (i % 3));
+            rb->GetRigidBody()->SetDamping(0.25f);
+        }
+        savedBodies = physicsWorld.GetRigidBodies().size();
+        scene.SaveToFile(path);
+        scene.Clear();
+    }
+    bool clearedOk = physicsWorld.GetRigidBodies().empty();
+
+    Scene loaded(&world, "Loaded");
+    bool loadOk = loaded.LoadFromFile(path);
+    std::remove(path.c_str());
+    bool countOk = physicsWorld.GetRigidBodies().size() == static_cast<size_t>(count);
+    bool dataOk = true;
+    for (const GameObject& object : loaded.GetGameObjects()) {
+        const auto* rb = world.GetComponent<RigidBodyComponent>(object.GetEntity());
+        if (!rb || !physicsWorld.ContainsRigidBody(rb->GetRigidBody()) || rb->GetRigidBody()->GetDamping() != 0.25f ||
+            rb->GetRigidBody()->GetPosition().y < 2.0f) {
+            dataOk = false;
+        }
+    }
+
+    // Bodies wait for EndBulkLoad; ones destroyed before it are skipped
+    world.BeginBulkLoad();
+    Entity kept = world.CreateEntity();
+    Entity dropped = world.CreateEntity();
+    RigidBody* keptBody = world.AddComponent<RigidBodyComponent>(kept)->GetRigidBody();
+    world.AddComponent<RigidBodyComponent>(dropped);
+    bool deferredOk = !physicsWorld.ContainsRigidBody(keptBody);
+    world.DestroyEntity(dropped);
+    world.EndBulkLoad();
+    deferredOk = deferredOk && physicsWorld.ContainsRigidBody(keptBody) &&
+                 physicsWorld.GetRigidBodies().size() == static_cast<size_t>(count) + 1;
+
+    // Nested loads register at the outermost end
+    Entity nested = world.CreateEntity();
+    bool nestingOk = true;
+    {
+        World::BulkLoadScope outer(&world);
+        {
+            World::BulkLoadScope inner(&world);
+            world.AddComponent<RigidBodyComponent>(nested);
+        }
+        nestingOk = world.IsBulkLoading() &&
+                    !physicsWorld.ContainsRigidBody(world.GetComponent<RigidBodyComponent>(nested)->GetRigidBody());
+    }
+    nestingOk = nestingOk && !world.IsBulkLoading() &&
+                physicsWorld.ContainsRigidBody(world.GetComponent<RigidBodyComponent>(nested)->GetRigidBody());
+    world.DestroyEntity(nested);
+
+    // A malformed scene that throws mid-load must not leave later bodies deferred
+    const std::string badPath = "_tmp_bad_bulk_load.scene";
+    {
+        std::ofstream bad(badPath);
+        bad << "Name: Bad\nGameObjectCount: notanumber\n";
+    }
+    bool threw = false;
+    try {
+        Scene badScene(&world, "Bad");
+        badScene.LoadFromFile(badPath);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    std::remove(badPath.c_str());
+    Entity afterBad = world.CreateEntity();
+    RigidBody* afterBadBody = world.AddComponent<RigidBodyComponent>(afterBad)->GetRigidBody();
+    bool recoveredOk = threw && !world.IsBulkLoading() && physicsWorld.ContainsRigidBody(afterBadBody);
+    world.DestroyEntity(afterBad);
+
+    bool pass = savedBodies == static_cast<size_t>(count) && clearedOk && loadOk && countOk && dataOk && deferredOk &&
+                nestingOk && recoveredOk;
+    if (verbose) {
+        std::cout << "SceneBulkLoad: bodies=" << physicsWorld.GetRigidBodies().size()
+                  << " load=" << (loadOk && countOk ? "ok" : "bad")
+                  << " data=" << (dataOk ? "ok" : "bad")
+                  << " deferred=" << (deferredOk ? "ok" : "bad")
+                  << " nesting=" << (nestingOk ? "ok" : "bad")
+                  << " recovered=" << (recoveredOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    loaded.Clear();
+    world.DestroyEntity(kept);
+    physicsWorld.Shutdown();
+    return pass;
+}
+
 
 int main(int argc, char** argv) { (void)argc; (void)argv;
     bool verbose = true;
@@ -658,6 +1255,18 @@ int main(int argc, char** argv) { (void)argc; (void)argv;
     if (!passEdgeTip) allPass = false;
     bool passFreeFall = runFreeFallAnalyticCheck(verbose);
     if (!passFreeFall) allPass = false;
+    bool passContactEvents = runContactEventScenario(verbose);
+    if (!passContactEvents) allPass = false;
+    bool passJoints = runJointScenario(verbose);
+    if (!passJoints) allPass = false;
+    bool passSnapshot = runSnapshotRollbackScenario(verbose);
+    if (!passSnapshot) allPass = false;
+    bool passCharacter = runCharacterControllerScenario(verbose);
+    if (!passCharacter) allPass = false;
+    bool passBulkLoad = runBulkLoadScenario(verbose);
+    if (!passBulkLoad) allPass = false;
+    bool passSceneBulkLoad = runSceneBulkLoadScenario(verbose);
+    if (!passSceneBulkLoad) allPass = false;
 
 
 
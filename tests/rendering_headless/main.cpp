@@ -0,0 +1,1342 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Core/Components/MeshComponent.h"
+#include "Core/Components/TransformComponent.h"
+#include "Core/ECS/World.h"
+#include "Core/Math/Matrix4.h"
+#include "Core/Math/Transform.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Vector3.h"
+#include "Rendering/Core/MipGenerator.h"
+#include "Rendering/Core/RenderQueue.h"
+#include "Rendering/Core/TextureAtlas.h"
+#include "Rendering/Core/TextureCompressor.h"
+#include "Rendering/Culling/VisibilitySystem.h"
+#include "Rendering/Lighting/LightClusters.h"
+#include "Rendering/Loaders/CookedMesh.h"
+#include "Rendering/Loaders/ImageLoader.h"
+#include "Rendering/Loaders/OBJLoader.h"
+#include "Rendering/Meshes/MeshOptimizer.h"
+#include "Rendering/Meshes/MeshSimplifier.h"
+#include "Rendering/Raytracing/RaytracingScene.h"
+#include "Rendering/Raytracing/TriangleBVH.h"
+
+using namespace GameEngine;
+
+static bool NearlyEqual(const Vector3& a, const Vector3& b, float tolerance = 1e-4f) {
+    return (a - b).Length() <= tolerance * std::max(1.0f, b.Length());
+}
+
+// Matrix4 is column-major and operator* must compose like GLSL: (P * V) * p == P * (V * p)
+static bool runMatrixCompositionCheck(bool verbose) {
+    Matrix4 view = Matrix4::LookAt(Vector3(3.0f, 4.0f, 5.0f), Vector3(0.5f, 0.0f, -1.0f), Vector3(0.0f, 1.0f, 0.0f));
+    Matrix4 model = Matrix4::Translation(Vector3(-2.0f, 1.0f, 7.0f)) * Matrix4::Rotation(Vector3(1.0f, 2.0f, 0.5f), 0.7f) *
+                    Matrix4::Scale(Vector3(2.0f, 0.5f, 3.0f));
+    Vector3 point(0.25f, -1.5f, 2.0f);
+
+    bool productOk = NearlyEqual((view * model) * point, view * (model * point)) &&
+                     NearlyEqual((model * view) * point, model * (view * point));
+    // Translation must be applied after rotation and scale
+    bool trsOk = NearlyEqual(model * Vector3(0.0f, 0.0f, 0.0f), Vector3(-2.0f, 1.0f, 7.0f));
+
+    // A child's matrix applies its local transform first, then the parent's
+    Transform parent(Vector3(10.0f, 0.0f, 0.0f), Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 1.5707963f),
+                     Vector3(2.0f, 2.0f, 2.0f));
+    Transform child(Vector3(1.0f, 0.0f, 0.0f));
+    child.SetParent(&parent);
+    Vector3 expected = parent.GetLocalToWorldMatrix() * (child.GetPosition());
+    bool hierarchyOk = NearlyEqual(child.GetLocalToWorldMatrix() * Vector3(0.0f, 0.0f, 0.0f), expected) &&
+                       NearlyEqual(child.GetWorldPosition(), expected) &&
+                       NearlyEqual(child.GetWorldToLocalMatrix() * expected, Vector3(0.0f, 0.0f, 0.0f));
+
+    bool pass = productOk && trsOk && hierarchyOk;
+    if (verbose) {
+        std::cout << "MatrixComposition: product=" << (productOk ? "ok" : "bad")
+                  << " trs=" << (trsOk ? "ok" : "bad")
+                  << " hierarchy=" << (hierarchyOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Caches keyed by the hierarchy version must see every change along the parent chain
+static bool runHierarchyVersionCheck(bool verbose) {
+    Transform rootA, rootB, parentA, parentB, child;
+    parentA.SetParent(&rootA);
+    parentB.SetParent(&rootB);
+    child.SetParent(&parentA);
+
+    bool ok = true;
+    uint64_t last = child.GetHierarchyVersion();
+    auto changed = [&]() {
+        uint64_t version = child.GetHierarchyVersion();
+        bool increased = version > last;
+        last = version;
+        return increased;
+    };
+    // After this move a sum of versions along the chain would be the same before and after
+    // the reparent below
+    parentA.SetPosition(Vector3(0.0f, 1.0f, 0.0f));
+    ok = ok && changed();
+    child.SetParent(&parentB);
+    ok = ok && changed();
+    rootA.SetPosition(Vector3(0.0f, 0.0f, 5.0f));
+    ok = ok && !changed();
+    rootB.SetScale(2.0f);
+    ok = ok && changed();
+    parentB.SetRotation(Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 0.5f));
+    ok = ok && changed();
+
+    if (verbose) {
+        std::cout << "HierarchyVersion: pass=" << (ok ? "yes" : "no") << std::endl;
+    }
+    return ok;
+}
+
+
+// Baked BVHs come from asset files, so BuildFromNodes must reject anything Build would not make
+static bool runBakedBVHValidationCheck(bool verbose) {
+    std::vector<Triangle> triangles;
+    for (int z = 0; z < 32; ++z) {
+        for (int x = 0; x < 32; ++x) {
+            Vector3 base(static_cast<float>(x), 0.0f, static_cast<float>(z));
+            triangles.emplace_back(base, base + Vector3(1.0f, 0.0f, 0.0f), base + Vector3(0.0f, 0.0f, 1.0f), Vector3(1.0f, 1.0f, 1.0f));
+        }
+    }
+    TriangleBVH built;
+    built.Build(triangles);
+    TriangleBVH adopted;
+    bool roundTripOk = adopted.BuildFromNodes(triangles, built.GetNodes(), built.GetTriangleIndices());
+    PreparedRay ray = PrepareRay(Ray(Vector3(5.2f, 3.0f, 7.1f), Vector3(0.0f, -1.0f, 0.0f)));
+    float distance = 100.0f;
+    int hit = -1;
+    roundTripOk = roundTripOk && adopted.Intersect(ray, distance, hit) && hit == 7 * 32 + 5 && std::fabs(distance - 3.0f) < 1e-4f;
+
+    // A 120-level spine: every node passes the per-node checks but the tree is twice as deep
+    // as Build allows
+    const int levels = 120;
+    std::vector<BVHNode> spine(levels * 2 + 1);
+    for (int i = 0; i < static_cast<int>(spine.size()); ++i) {
+        spine[i].minBounds = Vector3(-1.0f, -1.0f, -1.0f);
+        spine[i].maxBounds = Vector3(33.0f, 1.0f, 33.0f);
+        if (i < levels) {
+            spine[i].rightOrFirst = levels + 1 + i;
+            spine[i].triangleCount = 0;
+        } else {
+            spine[i].rightOrFirst = 0;
+            spine[i].triangleCount = 1;
+        }
+    }
+    TriangleBVH deep;
+    bool deepRejected = !deep.BuildFromNodes(triangles, spine, built.GetTriangleIndices()) && deep.IsEmpty();
+
+    // Two parents sharing one subtree
+    std::vector<BVHNode> shared = built.GetNodes();
+    shared[0].rightOrFirst = 2;
+    bool sharedRejected = shared[1].IsLeaf() || !TriangleBVH().BuildFromNodes(triangles, shared, built.GetTriangleIndices());
+
+    bool pass = roundTripOk && deepRejected && sharedRejected;
+    if (verbose) {
+        std::cout << "BakedBVHValidation: roundTrip=" << (roundTripOk ? "ok" : "bad")
+                  << " deep=" << (deepRejected ? "rejected" : "accepted")
+                  << " shared=" << (sharedRejected ? "rejected" : "accepted")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Every light whose range reaches a point must be in that point's cluster list, unless the
+// per-cluster limit dropped it
+static bool runLightClusterCheck(bool verbose) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<LightManager::ShaderLightData> lights(2000);
+    for (auto& light : lights) {
+        light = {};
+        light.position = Vector3(-60.0f + 120.0f * unit(rng), -10.0f + 30.0f * unit(rng), -150.0f + 160.0f * unit(rng));
+        light.color = Vector3(1.0f, 1.0f, 1.0f);
+        light.intensity = 1.0f;
+        light.range = 1.0f + 9.0f * unit(rng);
+        light.type = 1;
+    }
+
+    Matrix4 view = Matrix4::LookAt(Vector3(2.0f, 5.0f, 10.0f), Vector3(0.0f, 2.0f, -40.0f), Vector3(0.0f, 1.0f, 0.0f));
+    Matrix4 projection = Matrix4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 200.0f);
+    LightClusterGrid grid;
+    grid.Build(lights, view, projection);
+
+    const auto& records = grid.GetRecords();
+    const auto& ranges = grid.GetClusterRanges();
+    const auto& indices = grid.GetLightIndices();
+    const auto& p = projection.m;
+    int samples = 0, covered = 0, missing = 0, dropped = 0;
+    for (int i = 0; i < 20000; ++i) {
+        Vector3 world(-60.0f + 120.0f * unit(rng), -10.0f + 30.0f * unit(rng), -150.0f + 160.0f * unit(rng));
+        Vector3 local = view * world;
+        float w = -local.z;
+        if (w <= 0.0f) continue;
+        float ndcX = (p[0] * local.x + p[8] * local.z) / w;
+        float ndcY = (p[5] * local.y + p[9] * local.z) / w;
+        if (std::fabs(ndcX) >= 1.0f || std::fabs(ndcY) >= 1.0f) continue;
+        int cluster = grid.FindCluster(ndcX, ndcY, w);
+        if (cluster < 0) continue;
+        ++samples;
+
+        uint32_t offset = ranges[cluster * 2];
+        uint32_t count = ranges[cluster * 2 + 1];
+        std::unordered_set<uint32_t> listed;
+        for (uint32_t k = 0; k < count; ++k) {
+            listed.insert(static_cast<uint32_t>(records[indices[offset + k]].spotSource[3]));
+        }
+        for (uint32_t l = 0; l < lights.size(); ++l) {
+            if ((lights[l].position - world).Length() > lights[l].range) continue;
+            ++covered;
+            if (listed.count(l)) continue;
+            // Only a full cluster may leave a reaching light out
+            if (grid.GetOverflowCount() > 0 && count == static_cast<uint32_t>(LightClusterGrid::MaxLightsPerCluster)) {
+                ++dropped;
+            } else {
+                ++missing;
+            }
+        }
+    }
+
+    // A full cluster keeps a near, bright light submitted after a hundred dim ones
+    Vector3 spot(1.0f, 2.0f, -20.0f);
+    std::vector<LightManager::ShaderLightData> crowd(101);
+    for (size_t i = 0; i < crowd.size(); ++i) {
+        LightManager::ShaderLightData& light = crowd[i];
+        light = {};
+        bool bright = i + 1 == crowd.size();
+        light.position = bright ? spot + Vector3(0.0f, 0.1f, 0.0f) : spot + Vector3(0.0f, 0.0f, -8.0f - 0.05f * i);
+        light.color = Vector3(1.0f, 1.0f, 1.0f);
+        light.intensity = bright ? 50.0f : 0.5f;
+        light.range = 30.0f;
+        light.type = 1;
+    }
+    LightClusterGrid crowdGrid;
+    crowdGrid.Build(crowd, view, projection);
+    Vector3 spotView = view * spot;
+    int spotCluster = crowdGrid.FindCluster((p[0] * spotView.x + p[8] * spotView.z) / -spotView.z,
+                                            (p[5] * spotView.y + p[9] * spotView.z) / -spotView.z, -spotView.z);
+    bool brightKept = false;
+    uint32_t spotCount = 0;
+    if (spotCluster >= 0) {
+        uint32_t offset = crowdGrid.GetClusterRanges()[spotCluster * 2];
+        spotCount = crowdGrid.GetClusterRanges()[spotCluster * 2 + 1];
+        for (uint32_t k = 0; k < spotCount; ++k) {
+            const ClusterLightRecord& record = crowdGrid.GetRecords()[crowdGrid.GetLightIndices()[offset + k]];
+            brightKept = brightKept || static_cast<size_t>(record.spotSource[3]) + 1 == crowd.size();
+        }
+    }
+    bool rankOk = brightKept && spotCount == static_cast<uint32_t>(LightClusterGrid::MaxLightsPerCluster) &&
+                  crowdGrid.GetOverflowCount() > 0;
+
+    bool pass = samples > 1000 && covered > 0 && missing == 0 && grid.GetGlobalLightCount() == 0 && rankOk;
+    if (verbose) {
+        std::cout << "LightClusters: samples=" << samples
+                  << " covered=" << covered
+                  << " missing=" << missing
+                  << " dropped=" << dropped
+                  << " overflow=" << grid.GetOverflowCount()
+                  << " brightKept=" << (rankOk ? "yes" : "no")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+static TextureData MakeImage(int width, int height, const std::function<void(int, int, unsigned char*)>& pixel) {
+    TextureData image;
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.resize(size_t(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            pixel(x, y, &image.pixels[(size_t(y) * width + x) * 4]);
+        }
+    }
+    return image;
+}
+
+// Largest per-channel difference after a compress/decompress round trip, or 256 on failure
+static int RoundTripError(const TextureData& image, TextureCompression format, bool withAlpha) {
+    std::vector<uint8_t> blocks = TextureCompressor::Compress(image, format);
+    TextureData decoded;
+    if (blocks.size() != TextureCompressor::GetCompressedSize(image.width, image.height, format) ||
+        !TextureCompressor::Decompress(blocks.data(), blocks.size(), image.width, image.height, format, decoded) ||
+        decoded.pixels.size() != image.pixels.size()) {
+        return 256;
+    }
+    int error = 0;
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        if (!withAlpha && i % 4 == 3) continue;
+        error = std::max(error, std::abs(int(image.pixels[i]) - int(decoded.pixels[i])));
+    }
+    return error;
+}
+
+// Block compression error bounds, block-rounded sizes and gamma-correct mip filtering
+static bool runTextureCompressionCheck(bool verbose) {
+    // Colors along one line through RGB space, as a block's endpoints can represent
+    TextureData gradient = MakeImage(16, 16, [](int x, int y, unsigned char* p) {
+        int t = (x + y) * 8;
+        p[0] = static_cast<unsigned char>(t);
+        p[1] = static_cast<unsigned char>(255 - t);
+        p[2] = static_cast<unsigned char>(64 + t / 2);
+        p[3] = static_cast<unsigned char>(255 - t);
+    });
+    TextureData opaqueGradient = gradient;
+    for (size_t i = 3; i < opaqueGradient.pixels.size(); i += 4) {
+        opaqueGradient.pixels[i] = 255;
+    }
+    TextureData solid = MakeImage(4, 4, [](int, int, unsigned char* p) {
+        p[0] = 200; p[1] = 100; p[2] = 50; p[3] = 160;
+    });
+    TextureData opaqueSolid = solid;
+    for (size_t i = 3; i < opaqueSolid.pixels.size(); i += 4) {
+        opaqueSolid.pixels[i] = 255;
+    }
+
+    int bc1Gradient = RoundTripError(opaqueGradient, TextureCompression::DXT1, false);
+    int bc3Gradient = RoundTripError(gradient, TextureCompression::DXT5, true);
+    int bc7Gradient = RoundTripError(gradient, TextureCompression::BC7, true);
+    int bc1Solid = RoundTripError(opaqueSolid, TextureCompression::DXT1, false);
+    int bc3Solid = RoundTripError(solid, TextureCompression::DXT5, true);
+    int bc7Solid = RoundTripError(solid, TextureCompression::BC7, true);
+    bool compressOk = bc1Gradient <= 12 && bc3Gradient <= 12 && bc7Gradient <= 4 &&
+                      bc1Solid <= 4 && bc3Solid <= 4 && bc7Solid <= 2;
+
+    // Partial blocks round up; a 5x3 image still round-trips
+    bool sizeOk = TextureCompressor::GetCompressedSize(5, 3, TextureCompression::DXT1) == 16 &&
+                  TextureCompressor::GetCompressedSize(1, 1, TextureCompression::BC7) == 16 &&
+                  TextureCompressor::GetCompressedSize(13, 7, TextureCompression::DXT5) == 128 &&
+                  TextureCompressor::GetCompressedSize(6, 9, TextureCompression::DXT3) == 96 &&
+                  RoundTripError(MakeImage(5, 3, [](int x, int y, unsigned char* p) {
+                      int t = (x * 3 + y) * 12;
+                      p[0] = static_cast<unsigned char>(t); p[1] = static_cast<unsigned char>(t / 2); p[2] = 90; p[3] = 255;
+                  }), TextureCompression::BC7, true) <= 4;
+
+    // Full chains end at 1x1; a non-square, non-power-of-two source included
+    std::vector<TextureData> chain = MipGenerator::Generate(MakeImage(13, 7, [](int, int, unsigned char* p) {
+        p[0] = p[1] = p[2] = 90; p[3] = 255;
+    }));
+    bool chainOk = MipGenerator::GetLevelCount(256, 64) == 9 && MipGenerator::GetLevelCount(1, 1) == 1 &&
+                   chain.size() == 4 && chain.back().width == 1 && chain.back().height == 1 &&
+                   chain[1].width == 6 && chain[1].height == 3;
+
+    // Half black, half white averages to half the light, which is 188 in sRGB, not 128
+    TextureData checker = MakeImage(16, 16, [](int x, int y, unsigned char* p) {
+        p[0] = p[1] = p[2] = ((x + y) & 1) ? 255 : 0;
+        p[3] = 255;
+    });
+    MipSettings boxSettings;
+    boxSettings.filter = MipFilter::Box;
+    int minGray = 255, maxGray = 0;
+    for (const MipSettings& settings : {boxSettings, MipSettings()}) {
+        std::vector<TextureData> levels = MipGenerator::Generate(checker, settings);
+        for (size_t level = 1; level < levels.size(); ++level) {
+            for (size_t i = 0; i < levels[level].pixels.size(); i += 4) {
+                minGray = std::min<int>(minGray, levels[level].pixels[i]);
+                maxGray = std::max<int>(maxGray, levels[level].pixels[i]);
+            }
+        }
+    }
+    bool gammaOk = minGray >= 184 && maxGray <= 192;
+
+    bool pass = compressOk && sizeOk && chainOk && gammaOk;
+    if (verbose) {
+        std::cout << "TextureCompression: bc1=" << bc1Gradient << "/" << bc1Solid
+                  << " bc3=" << bc3Gradient << "/" << bc3Solid
+                  << " bc7=" << bc7Gradient << "/" << bc7Solid
+                  << " sizes=" << (sizeOk ? "ok" : "bad")
+                  << " chain=" << (chainOk ? "ok" : "bad")
+                  << " checkerGray=" << minGray << ".." << maxGray
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Triangles as position triples, each rotated to start at its smallest corner and then sorted,
+// so welding and cache reordering do not affect the comparison
+static std::vector<std::string> TriangleKeys(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices) {
+    std::vector<std::string> keys;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        std::string corners[3];
+        for (int c = 0; c < 3; ++c) {
+            const Vector3& p = positions[indices[t + c]];
+            std::ostringstream corner;
+            // Adding zero turns -0 into 0, which welding does not keep apart
+            corner << p.x + 0.0f << "," << p.y + 0.0f << "," << p.z + 0.0f << ";";
+            corners[c] = corner.str();
+        }
+        int first = static_cast<int>(std::min_element(corners, corners + 3) - corners);
+        keys.push_back(corners[first] + corners[(first + 1) % 3] + corners[(first + 2) % 3]);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Quads fan into two triangles, negative indices count back from the latest attribute, and
+// CRLF line endings parse like LF
+static bool runOBJParseCheck(bool verbose) {
+    const std::string path = "_tmp_parse_check.obj";
+    {
+        std::ofstream obj(path, std::ios::binary);
+        obj << "# quad, then a triangle and a quad through relative indices\r\n"
+               "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\n"
+               "vt 0 0\r\nvt 1 0\r\nvt 1 1\r\nvt 0 1\r\n"
+               "f 1/1 2/2 3/3 4/4\r\n"
+               "v 0 0 2\r\nv 2 0 2\r\nv 2 2 2\r\n"
+               "f -3 -2 -1\r\n"
+               "v 0 0 -3\r\nv 3 0 -3\r\nv 3 3 -3\r\nv 0 3 -3\r\n"
+               "f -4/-4 -3/-3 -2/-2 -1/-1";    // No newline at the end
+    }
+
+    bool pass = true;
+    size_t indexCount = 0;
+    for (bool parallel : {false, true}) {
+        Mesh mesh = OBJLoader::LoadFromFile(path, parallel);
+        std::vector<Vector3> positions;
+        mesh.GetVertexPositions(positions);
+        std::vector<Vector3> expectedPositions = {
+            Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 1, 0), Vector3(0, 1, 0),
+            Vector3(0, 0, 2), Vector3(2, 0, 2), Vector3(2, 2, 2),
+            Vector3(0, 0, -3), Vector3(3, 0, -3), Vector3(3, 3, -3), Vector3(0, 3, -3)};
+        std::vector<unsigned int> expectedIndices = {0, 1, 2, 0, 2, 3, 4, 5, 6, 7, 8, 9, 7, 9, 10};
+        indexCount = mesh.GetIndices().size();
+        pass = pass && TriangleKeys(positions, mesh.GetIndices()) == TriangleKeys(expectedPositions, expectedIndices);
+    }
+    std::remove(path.c_str());
+
+    if (verbose) {
+        std::cout << "OBJParse: indices=" << indexCount << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Indexed grid of cells x cells quads in the XZ plane with a gentle height field
+static void MakeGrid(int cells, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    vertices.clear();
+    indices.clear();
+    for (int z = 0; z <= cells; ++z) {
+        for (int x = 0; x <= cells; ++x) {
+            float height = 0.25f * std::sin(x * 0.3f) * std::cos(z * 0.2f);
+            vertices.emplace_back(Vector3(static_cast<float>(x), height, static_cast<float>(z)), Vector3::Up, Vector3(1.0f, 1.0f, 1.0f),
+                                  Vector3(static_cast<float>(x) / cells, static_cast<float>(z) / cells, 0.0f));
+        }
+    }
+    for (int z = 0; z < cells; ++z) {
+        for (int x = 0; x < cells; ++x) {
+            unsigned int i = static_cast<unsigned int>(z * (cells + 1) + x);
+            unsigned int row = static_cast<unsigned int>(cells + 1);
+            indices.insert(indices.end(), {i, i + row, i + 1, i + 1, i + row, i + row + 1});
+        }
+    }
+}
+
+static std::vector<Vector3> Positions(const std::vector<Vertex>& vertices) {
+    std::vector<Vector3> positions;
+    positions.reserve(vertices.size());
+    for (const Vertex& vertex : vertices) {
+        positions.push_back(vertex.position);
+    }
+    return positions;
+}
+
+// Import-style triangle soup in random order: Optimize must weld it back to the shared grid
+// vertices and leave a lower cache miss ratio than the welded, unordered list had
+static bool runMeshOptimizerCheck(bool verbose) {
+    const int cells = 48;
+    std::vector<Vertex> gridVertices;
+    std::vector<unsigned int> gridIndices;
+    MakeGrid(cells, gridVertices, gridIndices);
+
+    std::vector<size_t> order(gridIndices.size() / 3);
+    for (size_t t = 0; t < order.size(); ++t) order[t] = t;
+    std::shuffle(order.begin(), order.end(), std::mt19937(99));
+    std::vector<unsigned int> shuffled;
+    std::vector<Vertex> soup;
+    std::vector<unsigned int> soupIndices;
+    for (size_t t : order) {
+        for (int c = 0; c < 3; ++c) {
+            shuffled.push_back(gridIndices[t * 3 + c]);
+            soupIndices.push_back(static_cast<unsigned int>(soup.size()));
+            soup.push_back(gridVertices[gridIndices[t * 3 + c]]);
+        }
+    }
+    float acmrBefore = MeshOptimizer::ComputeACMR(shuffled, gridVertices.size());
+
+    std::vector<Vertex> vertices = soup;
+    std::vector<unsigned int> indices = soupIndices;
+    MeshOptimizer::Optimize(vertices, indices);
+    float acmrAfter = MeshOptimizer::ComputeACMR(indices, vertices.size());
+
+    bool weldOk = vertices.size() == gridVertices.size();
+    bool geometryOk = indices.size() == gridIndices.size() &&
+                      TriangleKeys(Positions(vertices), indices) == TriangleKeys(Positions(soup), soupIndices);
+    // Optimal for a grid this wide is about 0.5 misses per triangle
+    bool acmrOk = acmrAfter < acmrBefore && acmrAfter < 0.9f;
+
+    bool pass = weldOk && geometryOk && acmrOk;
+    if (verbose) {
+        std::cout << "MeshOptimizer: vertices=" << soup.size() << "->" << vertices.size()
+                  << " acmr=" << acmrBefore << "->" << acmrAfter
+                  << " geometry=" << (geometryOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// A cooked mesh loads back exactly as written; a file cut short anywhere is rejected
+static bool runCookedMeshCheck(bool verbose) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    MakeGrid(24, vertices, indices);
+    Mesh mesh;
+    mesh.SetVertices(vertices);
+    mesh.SetIndices(indices);
+
+    const std::string path = "_tmp_cooked_check.gmesh";
+    CookedMesh::CookOptions options;
+    options.vertexFormat = VertexFormat::Float;
+    options.lodLevels = 2;
+    bool writeOk = CookedMesh::WriteToFile(path, mesh, options);
+
+    Mesh loaded = CookedMesh::LoadFromFile(path);
+    std::vector<Vector3> loadedPositions;
+    loaded.GetVertexPositions(loadedPositions);
+    bool roundTripOk = writeOk && loaded.GetIndices() == indices && loadedPositions.size() == vertices.size() &&
+                       !loaded.GetBakedBVHNodes().empty() && !loaded.GetCollisionIndices().empty() &&
+                       loaded.GetLODCount() > 1;
+    for (size_t i = 0; roundTripOk && i < vertices.size(); ++i) {
+        const Vertex& a = vertices[i];
+        const Vertex& b = loaded.GetVertices()[i];
+        roundTripOk = a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+                      a.texCoords.x == b.texCoords.x && a.texCoords.y == b.texCoords.y;
+    }
+
+    // Cut inside the header, the chunk table and the last payload
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bool truncatedRejected = bytes.size() > sizeof(CookedMeshHeader) + sizeof(CookedMeshChunk);
+    for (size_t length : {size_t(20), sizeof(CookedMeshHeader) + sizeof(CookedMeshChunk) / 2, bytes.size() - 1}) {
+        if (!truncatedRejected) break;
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(length));
+        }
+        Mesh truncated = CookedMesh::LoadFromFile(path);
+        truncatedRejected = truncated.GetVertexCount() == 0 && truncated.GetIndices().empty();
+    }
+    std::remove(path.c_str());
+
+    bool pass = roundTripOk && truncatedRejected;
+    if (verbose) {
+        std::cout << "CookedMesh: bytes=" << bytes.size()
+                  << " roundTrip=" << (roundTripOk ? "ok" : "bad")
+                  << " truncated=" << (truncatedRejected ? "rejected" : "accepted")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Pack/Unpack stays within each encoding's precision: exact float positions (Packed) or half a
+// unorm16 step of the bounds (PackedQuantized), octahedral normals, 8-bit color and half UVs
+static bool runVertexPackingCheck(bool verbose) {
+    std::mt19937 rng(45);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const Vector3 boundsMin(-10.0f, -2.0f, 0.0f);
+    const Vector3 boundsMax(10.0f, 3.0f, 50.0f);
+    std::vector<Vertex> vertices(4096);
+    for (Vertex& vertex : vertices) {
+        vertex.position = Vector3(boundsMin.x + (boundsMax.x - boundsMin.x) * unit(rng),
+                                  boundsMin.y + (boundsMax.y - boundsMin.y) * unit(rng),
+                                  boundsMin.z + (boundsMax.z - boundsMin.z) * unit(rng));
+        Vector3 normal;
+        do {
+            normal = Vector3(unit(rng) * 2.0f - 1.0f, unit(rng) * 2.0f - 1.0f, unit(rng) * 2.0f - 1.0f);
+        } while (normal.Length() < 0.1f || normal.Length() > 1.0f);
+        vertex.normal = normal.Normalized();
+        vertex.color = Vector3(unit(rng), unit(rng), unit(rng));
+        vertex.texCoords = Vector3(unit(rng), unit(rng), 0.0f);
+    }
+
+    bool pass = VertexPacking::GetStride(VertexFormat::Packed) == sizeof(PackedVertex) &&
+                VertexPacking::GetStride(VertexFormat::PackedQuantized) == sizeof(QuantizedVertex);
+    for (VertexFormat format : {VertexFormat::Packed, VertexFormat::PackedQuantized}) {
+        std::vector<uint8_t> packed = VertexPacking::Pack(vertices, format, boundsMin, boundsMax);
+        std::vector<Vertex> unpacked = VertexPacking::Unpack(packed.data(), vertices.size(), format, boundsMin, boundsMax);
+        std::vector<Vector3> positions = VertexPacking::UnpackPositions(packed.data(), vertices.size(), format, boundsMin, boundsMax);
+        bool sizeOk = packed.size() == vertices.size() * VertexPacking::GetStride(format) &&
+                      unpacked.size() == vertices.size() && positions.size() == vertices.size();
+        if (!sizeOk) {
+            pass = false;
+            continue;
+        }
+
+        Vector3 step = (boundsMax - boundsMin) * (1.0f / 65535.0f);
+        float positionError = 0.0f, normalError = 0.0f, colorError = 0.0f, uvError = 0.0f;
+        bool positionsMatch = true;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const Vertex& a = vertices[i];
+            const Vertex& b = unpacked[i];
+            Vector3 d = a.position - b.position;
+            // In units of the quantization step, so 0.5 is the rounding limit
+            positionError = std::max({positionError, std::fabs(d.x) / step.x, std::fabs(d.y) / step.y, std::fabs(d.z) / step.z});
+            normalError = std::max(normalError, (a.normal - b.normal).Length());
+            colorError = std::max({colorError, std::fabs(a.color.x - b.color.x), std::fabs(a.color.y - b.color.y), std::fabs(a.color.z - b.color.z)});
+            uvError = std::max({uvError, std::fabs(a.texCoords.x - b.texCoords.x), std::fabs(a.texCoords.y - b.texCoords.y)});
+            positionsMatch = positionsMatch && positions[i].x == b.position.x && positions[i].y == b.position.y && positions[i].z == b.position.z;
+        }
+        // Decoding offset + q * scale in float adds a little on top of the rounding
+        bool positionOk = format == VertexFormat::Packed ? positionError == 0.0f : positionError <= 0.51f;
+        bool formatOk = positionOk && positionsMatch && normalError <= 1e-4f &&
+                        colorError <= 0.5f / 255.0f + 1e-6f && uvError <= 1.0f / 4096.0f;
+        pass = pass && formatOk;
+        if (verbose) {
+            std::cout << "VertexPacking: format=" << static_cast<int>(format)
+                      << " positionSteps=" << positionError
+                      << " normal=" << normalError
+                      << " color=" << colorError
+                      << " uv=" << uvError
+                      << " pass=" << (formatOk ? "yes" : "no") << std::endl;
+        }
+    }
+    return pass;
+}
+
+
+// Simplify reaches the requested index count without leaving collapsed or dangling triangles,
+// and a tight error bound stops it early instead
+static bool runMeshSimplifierCheck(bool verbose) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> sourceIndices;
+    MakeGrid(40, vertices, sourceIndices);
+
+    auto valid = [&](const std::vector<unsigned int>& indices) {
+        if (indices.empty() || indices.size() % 3 != 0) return false;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            unsigned int a = indices[t], b = indices[t + 1], c = indices[t + 2];
+            if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size()) return false;
+            if (a == b || b == c || a == c) return false;
+        }
+        return true;
+    };
+
+    std::vector<size_t> reached;
+    bool targetOk = true;
+    for (size_t target : {sourceIndices.size() / 2, sourceIndices.size() / 8, size_t(300)}) {
+        std::vector<unsigned int> indices = sourceIndices;
+        float error = MeshSimplifier::Simplify(vertices, indices, target, 1e30f);
+        reached.push_back(indices.size());
+        targetOk = targetOk && indices.size() <= target && valid(indices) && error >= 0.0f;
+    }
+
+    std::vector<unsigned int> bounded = sourceIndices;
+    float boundedError = MeshSimplifier::Simplify(vertices, bounded, 300, 1e-3f);
+    bool boundOk = valid(bounded) && bounded.size() > 300 && boundedError <= 1e-3f;
+
+    bool pass = targetOk && boundOk;
+    if (verbose) {
+        std::cout << "MeshSimplifier: source=" << sourceIndices.size() << " reached=";
+        for (size_t i = 0; i < reached.size(); ++i) {
+            std::cout << (i ? "," : "") << reached[i];
+        }
+        std::cout << " bounded=" << bounded.size()
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Packed slots stay inside the bin, on the alignment grid and apart from each other; built
+// regions hold their own image and map [0, 1] UVs onto it
+static bool runTextureAtlasCheck(bool verbose) {
+    std::mt19937 rng(49);
+    std::uniform_int_distribution<int> side(6, 130);
+    std::vector<std::pair<int, int>> sizes(300);
+    for (auto& size : sizes) {
+        size = {side(rng), side(rng)};
+    }
+    const int alignment = 4;
+    std::vector<std::pair<int, int>> positions;
+    int width = 0, height = 0;
+    bool packed = TextureAtlas::Pack(sizes, alignment, 4096, positions, width, height);
+
+    bool boundsOk = packed && positions.size() == sizes.size() && width > 0 && height > 0 &&
+                    (width & (width - 1)) == 0 && (height & (height - 1)) == 0 && width <= 4096 && height <= 4096;
+    bool overlapOk = boundsOk;
+    for (size_t i = 0; boundsOk && i < sizes.size(); ++i) {
+        auto [x, y] = positions[i];
+        boundsOk = x >= 0 && y >= 0 && x + sizes[i].first <= width && y + sizes[i].second <= height &&
+                   x % alignment == 0 && y % alignment == 0;
+        for (size_t j = i + 1; overlapOk && j < sizes.size(); ++j) {
+            auto [ox, oy] = positions[j];
+            overlapOk = x + sizes[i].first <= ox || ox + sizes[j].first <= x ||
+                        y + sizes[i].second <= oy || oy + sizes[j].second <= y;
+        }
+    }
+    std::vector<std::pair<int, int>> oversizedPositions;
+    int oversizedWidth = 0, oversizedHeight = 0;
+    bool rejectOk = !TextureAtlas::Pack({{3000, 16}}, alignment, 2048, oversizedPositions, oversizedWidth, oversizedHeight);
+
+    // Three solid images: each region's texels and UV rectangle belong to its own image
+    std::vector<std::string> names = {"red", "green", "blue"};
+    std::vector<TextureData> images;
+    const int imageSizes[3][2] = {{20, 12}, {7, 33}, {64, 64}};
+    for (int i = 0; i < 3; ++i) {
+        images.push_back(MakeImage(imageSizes[i][0], imageSizes[i][1], [i](int, int, unsigned char* p) {
+            p[0] = i == 0 ? 255 : 0; p[1] = i == 1 ? 255 : 0; p[2] = i == 2 ? 255 : 0; p[3] = 255;
+        }));
+    }
+    TextureAtlas atlas;
+    bool buildOk = atlas.Build(names, images) && atlas.GetRegionCount() == 3;
+    for (int i = 0; buildOk && i < 3; ++i) {
+        const TextureAtlas::Region* region = atlas.GetRegion(names[i]);
+        buildOk = region && region->width == imageSizes[i][0] && region->height == imageSizes[i][1];
+        if (!buildOk) break;
+        const TextureData& image = atlas.GetImage();
+        for (int y = region->y; y < region->y + region->height; ++y) {
+            for (int x = region->x; x < region->x + region->width; ++x) {
+                const unsigned char* p = &image.pixels[(size_t(y) * image.width + x) * 4];
+                buildOk = buildOk && p[i] == 255 && p[(i + 1) % 3] == 0 && p[(i + 2) % 3] == 0;
+            }
+        }
+        Vector2 low = TextureAtlas::RemapUV(region->uvTransform, Vector2(0.0f, 0.0f));
+        Vector2 high = TextureAtlas::RemapUV(region->uvTransform, Vector2(1.0f, 1.0f));
+        buildOk = buildOk && std::fabs(low.x * atlas.GetWidth() - region->x) < 1e-3f &&
+                  std::fabs(low.y * atlas.GetHeight() - region->y) < 1e-3f &&
+                  std::fabs(high.x * atlas.GetWidth() - (region->x + region->width)) < 1e-3f &&
+                  std::fabs(high.y * atlas.GetHeight() - (region->y + region->height)) < 1e-3f;
+    }
+
+    bool pass = boundsOk && overlapOk && rejectOk && buildOk;
+    if (verbose) {
+        std::cout << "TextureAtlas: bin=" << width << "x" << height
+                  << " bounds=" << (boundsOk ? "ok" : "bad")
+                  << " overlap=" << (overlapOk ? "none" : "found")
+                  << " oversized=" << (rejectOk ? "rejected" : "accepted")
+                  << " build=" << (buildOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Sorted instances follow the key order, transparent draws run back to front across state,
+// and adjacent draws with identical state end up in one batch
+static bool runRenderQueueCheck(bool verbose) {
+    std::mt19937 rng(37);
+    std::vector<Mesh> meshes(4);
+    struct Submitted {
+        RenderPass pass;
+        uint16_t shader, material, meshId;
+        Mesh* mesh;
+        float depth;
+    };
+    std::vector<Submitted> submitted;
+    std::unordered_map<const Mesh*, uint16_t> meshIds;      // First-use order, as the queue numbers them
+
+    RenderQueue queue;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        Submitted draw;
+        draw.pass = static_cast<RenderPass>(rng() % 3);
+        draw.shader = static_cast<uint16_t>(rng() % 4);
+        draw.material = static_cast<uint16_t>(rng() % 3);
+        draw.mesh = &meshes[rng() % meshes.size()];
+        draw.meshId = meshIds.emplace(draw.mesh, static_cast<uint16_t>(meshIds.size())).first->second;
+        draw.depth = 0.5f + 99.5f * std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+        submitted.push_back(draw);
+        // The translation identifies the draw after sorting
+        queue.Submit(draw.pass, draw.shader, draw.material, draw.mesh, Matrix4::Translation(Vector3(static_cast<float>(i), 0.0f, 0.0f)),
+                     draw.depth, i);
+    }
+    queue.Sort();
+
+    const auto& batches = queue.GetBatches();
+    const auto& matrices = queue.GetInstanceMatrices();
+    bool coverOk = matrices.size() == submitted.size();
+    bool orderOk = true, stateOk = true, mergeOk = true, backToFrontOk = true;
+    uint32_t nextInstance = 0;
+    uint64_t lastKey = 0;
+    const Submitted* last = nullptr;
+    for (size_t b = 0; coverOk && b < batches.size(); ++b) {
+        const RenderBatch& batch = batches[b];
+        coverOk = batch.firstInstance == nextInstance && batch.instanceCount > 0 &&
+                  batch.firstInstance + batch.instanceCount <= matrices.size();
+        if (!coverOk) break;
+        nextInstance += batch.instanceCount;
+        if (b > 0) {
+            const RenderBatch& previous = batches[b - 1];
+            mergeOk = mergeOk && (previous.pass != batch.pass || previous.shader != batch.shader ||
+                                  previous.material != batch.material || previous.mesh != batch.mesh);
+        }
+        for (uint32_t k = batch.firstInstance; k < batch.firstInstance + batch.instanceCount; ++k) {
+            uint32_t index = static_cast<uint32_t>(matrices[k].m[12]);
+            const Submitted& draw = submitted[index];
+            if (k == batch.firstInstance) {
+                stateOk = stateOk && batch.userData == index;
+            }
+            stateOk = stateOk && draw.pass == batch.pass && draw.shader == batch.shader &&
+                      draw.material == batch.material && draw.mesh == batch.mesh;
+            uint64_t key = RenderQueue::MakeKey(draw.pass, draw.shader, draw.material, draw.meshId, draw.depth);
+            orderOk = orderOk && key >= lastKey;
+            lastKey = key;
+            // Depth keys keep 7 mantissa bits, so equal keys may hold depths within about 1%
+            if (last && last->pass == RenderPass::Transparent && draw.pass == RenderPass::Transparent) {
+                backToFrontOk = backToFrontOk && draw.depth <= last->depth * 1.01f;
+            }
+            last = &draw;
+        }
+    }
+    coverOk = coverOk && nextInstance == submitted.size();
+
+    bool pass = coverOk && orderOk && stateOk && mergeOk && backToFrontOk;
+    if (verbose) {
+        std::cout << "RenderQueue: draws=" << submitted.size() << " batches=" << batches.size()
+                  << " order=" << (orderOk ? "ok" : "bad")
+                  << " state=" << (stateOk ? "ok" : "bad")
+                  << " merged=" << (mergeOk ? "ok" : "bad")
+                  << " backToFront=" << (backToFrontOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// The 4-wide traversal must find the same closest hit as testing every triangle, and rays
+// through shared edges and vertices of a closed grid must not slip through
+static bool runBVHIntersectCheck(bool verbose) {
+    std::mt19937 rng(33);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto randomPoint = [&](float extent) {
+        return Vector3((unit(rng) * 2.0f - 1.0f) * extent, (unit(rng) * 2.0f - 1.0f) * extent, (unit(rng) * 2.0f - 1.0f) * extent);
+    };
+
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < 3000; ++i) {
+        Vector3 base = randomPoint(20.0f);
+        triangles.emplace_back(base, base + randomPoint(2.0f), base + randomPoint(2.0f), Vector3(1.0f, 1.0f, 1.0f));
+    }
+    // A 16x16 floor at y = -25 made of quads split along their diagonal
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            Vector3 p00(static_cast<float>(x), -25.0f, static_cast<float>(z));
+            Vector3 p10 = p00 + Vector3(1.0f, 0.0f, 0.0f);
+            Vector3 p01 = p00 + Vector3(0.0f, 0.0f, 1.0f);
+            Vector3 p11 = p00 + Vector3(1.0f, 0.0f, 1.0f);
+            triangles.emplace_back(p00, p01, p10, Vector3(1.0f, 1.0f, 1.0f));
+            triangles.emplace_back(p10, p01, p11, Vector3(1.0f, 1.0f, 1.0f));
+        }
+    }
+    TriangleBVH bvh;
+    bvh.Build(triangles);
+
+    auto bruteForce = [&](const PreparedRay& ray, float& closest) {
+        bool hit = false;
+        closest = 1e30f;
+        for (const Triangle& triangle : bvh.GetTriangles()) {
+            float t;
+            if (IntersectTriangle(ray, triangle, closest, t) && t < closest) {
+                closest = t;
+                hit = true;
+            }
+        }
+        return hit;
+    };
+
+    int rays = 0, hits = 0, mismatches = 0;
+    auto check = [&](const Ray& source) {
+        PreparedRay ray = PrepareRay(source);
+        float expected;
+        bool expectedHit = bruteForce(ray, expected);
+        float distance = 1e30f;
+        int triangle = -1;
+        bool hit = bvh.Intersect(ray, distance, triangle);
+        bool ok = hit == expectedHit;
+        if (ok && hit) {
+            float t;
+            ok = std::fabs(distance - expected) <= 1e-4f * std::max(1.0f, expected) && triangle >= 0 &&
+                 IntersectTriangle(ray, bvh.GetTriangles()[triangle], 1e30f, t) &&
+                 bvh.Occluded(ray, expected * 1.001f) && !bvh.Occluded(ray, expected * 0.999f);
+        } else if (ok) {
+            ok = !bvh.Occluded(ray, 1e30f);
+        }
+        ++rays;
+        hits += expectedHit ? 1 : 0;
+        mismatches += ok ? 0 : 1;
+        return expectedHit;
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        // Unnormalized directions, some with zero components
+        Vector3 direction = randomPoint(1.0f) * (0.5f + 3.0f * unit(rng));
+        if (i % 10 == 0) direction.x = 0.0f;
+        if (i % 15 == 0) direction.z = 0.0f;
+        if (direction.LengthSquared() < 1e-6f) direction = Vector3(0.0f, -1.0f, 0.0f);
+        check(Ray(randomPoint(30.0f), direction));
+    }
+
+    // Straight down through every vertex and edge midpoint of the floor's interior
+    int leaks = 0;
+    for (int z = 1; z < 32; ++z) {
+        for (int x = 1; x < 32; ++x) {
+            Vector3 origin(x * 0.5f, -24.0f, z * 0.5f);
+            if (!check(Ray(origin, Vector3(0.0f, -1.0f, 0.0f)))) ++leaks;
+        }
+    }
+
+    bool pass = mismatches == 0 && leaks == 0 && hits > 0;
+    if (verbose) {
+        std::cout << "BVHIntersect: rays=" << rays << " hits=" << hits
+                  << " mismatches=" << mismatches << " leaks=" << leaks
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// zlib.compress(level 9) of InflateSample(), a single dynamic Huffman block
+static const uint8_t DynamicZlibStream[] = {
+    0x78, 0xda, 0xed, 0x94, 0x49, 0x96, 0x45, 0x31, 0x08, 0x42, 0xd7, 0x9a, 0xde, 0xf4, 0xd9, 0xff,
+    0xa8, 0x80, 0xef, 0x2e, 0xea, 0x99, 0x31, 0x47, 0xc5, 0x4b, 0x42, 0x08, 0x31, 0xe5, 0x6a, 0x63,
+    0xdd, 0x58, 0xc6, 0x89, 0x75, 0xbe, 0x32, 0x43, 0xdb, 0x79, 0x26, 0xbe, 0x55, 0x8e, 0xc5, 0x55,
+    0xc3, 0xb6, 0xfc, 0x96, 0x95, 0x78, 0xf7, 0xec, 0xad, 0xd5, 0xc2, 0xaa, 0x0d, 0xaa, 0x13, 0x72,
+    0xa3, 0x6c, 0xdc, 0xdc, 0x6f, 0x59, 0xb1, 0xbf, 0x76, 0xf1, 0x5e, 0x8f, 0xab, 0x85, 0x59, 0xc3,
+    0xa2, 0xb0, 0xd7, 0x14, 0xdf, 0x59, 0x73, 0x74, 0xd6, 0x98, 0xfb, 0x86, 0x54, 0x6c, 0x52, 0x76,
+    0x52, 0x3f, 0x79, 0xbc, 0xea, 0x0d, 0xcb, 0x81, 0xaa, 0xdc, 0x51, 0xd0, 0x2d, 0x87, 0x33, 0xad,
+    0xe6, 0xf8, 0xee, 0xd9, 0x7b, 0x9f, 0x73, 0x1f, 0x54, 0xad, 0x63, 0xd0, 0x3a, 0x6f, 0xb2, 0x1d,
+    0x0d, 0xca, 0x60, 0xd7, 0x9e, 0xa1, 0x1d, 0x54, 0x3d, 0x9d, 0x5e, 0xc2, 0xee, 0x18, 0x73, 0x0d,
+    0x28, 0x53, 0x8a, 0xac, 0x94, 0xa1, 0x9a, 0x1b, 0x83, 0x42, 0xd6, 0x56, 0xa8, 0x2b, 0xda, 0x45,
+    0xc3, 0x85, 0xb7, 0x2b, 0x55, 0xe6, 0xc2, 0x9a, 0xde, 0xc1, 0x82, 0xd6, 0x2a, 0xab, 0x59, 0x5f,
+    0xe7, 0x45, 0x0c, 0x0a, 0x99, 0xdb, 0x92, 0xd0, 0x10, 0xed, 0x2c, 0xcc, 0x4c, 0x63, 0x5a, 0xdc,
+    0x14, 0x4e, 0x2b, 0x29, 0xdc, 0x8d, 0x05, 0x51, 0x73, 0x6d, 0xa8, 0x72, 0xc5, 0xa0, 0xe8, 0xf6,
+    0xca, 0xb8, 0x54, 0x9e, 0x82, 0x66, 0x05, 0xed, 0x68, 0xe7, 0x83, 0x31, 0x67, 0x54, 0x8c, 0xd9,
+    0x1b, 0x94, 0xef, 0xaa, 0x5e, 0x88, 0x3c, 0x04, 0x06, 0xb5, 0xf5, 0x72, 0x87, 0x33, 0x50, 0xa2,
+    0x61, 0xc7, 0x1b, 0x09, 0x2a, 0xb8, 0x32, 0x6b, 0x84, 0x30, 0x3d, 0x4e, 0x59, 0x0b, 0x36, 0x44,
+    0xe5, 0x52, 0x0d, 0x96, 0x62, 0x50, 0xc8, 0x60, 0x4b, 0xa3, 0xa1, 0x68, 0x88, 0x76, 0x6e, 0x67,
+    0xcf, 0x77, 0x50, 0xd8, 0x0a, 0xcf, 0x30, 0xb0, 0x20, 0xcb, 0x0f, 0x81, 0x41, 0x7f, 0xb2, 0x45,
+    0x43, 0x67, 0x44, 0xbb, 0x88, 0x76, 0xb4, 0x73, 0xc3, 0x98, 0xd1, 0x12, 0xc6, 0xe4, 0x19, 0x0e,
+    0x16, 0x5c, 0xa8, 0x7d, 0x78, 0xbe, 0x86, 0x41, 0x4b, 0xdf, 0x01, 0xc0, 0xc8, 0xd0, 0x76, 0x2a,
+    0x1e, 0x0e, 0x9f, 0x76, 0x03, 0x2e, 0xe9, 0xce, 0x86, 0x31, 0x75, 0x86, 0x18, 0x1e, 0x0b, 0xa0,
+    0x41, 0x45, 0xce, 0x20, 0x83, 0x2d, 0x38, 0x1e, 0x39, 0x8b, 0x03, 0x6f, 0xe6, 0x2d, 0xce, 0x56,
+    0xa3, 0x30, 0x07, 0x71, 0x86, 0x05, 0x59, 0x45, 0x9c, 0x3d, 0x0c, 0xca, 0x8e, 0xe2, 0x6c, 0xe2,
+    0xec, 0xde, 0x2e, 0xba, 0x31, 0xe8, 0x46, 0xce, 0xa8, 0xc4, 0x82, 0x26, 0xce, 0x78, 0x3e, 0xe0,
+    0xb9, 0xc5, 0x99, 0x6d, 0x1a, 0xba, 0x84, 0x35, 0xda, 0x41, 0x95, 0x71, 0x75, 0x72, 0x86, 0x31,
+    0x79, 0x86, 0x2b, 0xce, 0x40, 0xda, 0xf5, 0xf3, 0x51, 0x06, 0x5b, 0x38, 0x25, 0x39, 0x23, 0xd8,
+    0x16, 0x46, 0x16, 0x67, 0xd9, 0x01, 0xf5, 0x05, 0x59, 0x5c, 0x0f, 0x9c, 0x61, 0x50, 0xe5, 0x48,
+    0x9c, 0x1d, 0x6f, 0x28, 0xce, 0x36, 0x70, 0xf1, 0x38, 0xf0, 0x0c, 0xa6, 0x1c, 0x89, 0x33, 0x1e,
+    0x82, 0x39, 0x12, 0x67, 0x83, 0x86, 0x22, 0x47, 0xe2, 0x6c, 0xd0, 0x4e, 0xe0, 0x22, 0xce, 0x46,
+    0xcb, 0xca, 0x91, 0x38, 0x23, 0x68, 0x3c, 0x84, 0x38, 0x9b, 0xb0, 0xc5, 0xcf, 0x4e, 0xac, 0x97,
+    0x0e, 0x2f, 0xce, 0x28, 0x64, 0x8e, 0xc4, 0xd9, 0x61, 0x01, 0x34, 0x71, 0xf6, 0x28, 0x73, 0x5b,
+    0x70, 0xf6, 0xa7, 0x1c, 0x89, 0x33, 0xe0, 0xa2, 0x1c, 0x89, 0xb3, 0x06, 0xcc, 0x3c, 0x46, 0xd5,
+    0x03, 0x8f, 0x6e, 0x04, 0x86, 0x4a, 0xe6, 0x48, 0x9c, 0xd1, 0x4e, 0xe6, 0x48, 0x9c, 0xfd, 0x0e,
+    0xf8, 0xc3, 0x0c, 0xeb, 0x0d, 0xe5, 0x48, 0x9c, 0x21, 0x7e, 0xca, 0x91, 0x38, 0x03, 0x69, 0xca,
+    0x91, 0x38, 0x83, 0x50, 0x39, 0x12, 0x67, 0x2c, 0xe6, 0x48, 0x9c, 0x51, 0xc6, 0x1c, 0x79, 0x70,
+    0x8b, 0x72, 0x24, 0xce, 0x10, 0x40, 0xe5, 0x48, 0x9c, 0x45, 0x0f, 0x92, 0x1f, 0xe2, 0x04, 0x97,
+    0xf1, 0x7b, 0x59, 0xca, 0x91, 0x38, 0x63, 0x22, 0x98, 0x23, 0x71, 0xc6, 0x33, 0x30, 0x47, 0xe2,
+    0xac, 0xf2, 0x7c, 0x8e, 0x27, 0xe2, 0x67, 0x32, 0x54, 0x9c, 0x21, 0xb6, 0xca, 0x91, 0x38, 0xbb,
+    0x18, 0xd3, 0xbf, 0x33, 0x63, 0x29, 0x47, 0xe2, 0x8c, 0x81, 0x60, 0x8e, 0xc4, 0x19, 0xb1, 0x66,
+    0x8e, 0xc4, 0x59, 0x66, 0x1c, 0x3c, 0xee, 0xc0, 0x6c, 0x29, 0x47, 0xe2, 0x0c, 0xdf, 0xa0, 0x72,
+    0x24, 0xce, 0x12, 0xce, 0xee, 0xed, 0x86, 0x1b, 0x83, 0x6e, 0xe4, 0x8c, 0x4a, 0xe6, 0x28, 0x7c,
+    0xff, 0xf5, 0xf7, 0x5f, 0x7f, 0xff, 0xf5, 0xf7, 0x5f, 0x7f, 0xff, 0xf5, 0xbf, 0xfe, 0xaf, 0xff,
+    0x00, 0xaf, 0x92, 0xc8, 0x77,
+};
+
+static std::vector<uint8_t> InflateSample() {
+    std::vector<uint8_t> data(3000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>("abcdefghijklmnop"[((i * i) / 7 + i / 13) % 16]);
+    }
+    return data;
+}
+
+static void AppendLE16(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void AppendLE32(std::vector<uint8_t>& out, uint32_t value) {
+    AppendLE16(out, value & 0xFFFF);
+    AppendLE16(out, value >> 16);
+}
+
+static void AppendBE32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+static uint32_t Crc32(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static void AppendPNGChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& payload) {
+    AppendBE32(png, static_cast<uint32_t>(payload.size()));
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), payload.begin(), payload.end());
+    AppendBE32(png, Crc32(png.data() + start, png.size() - start));
+}
+
+// RGBA8 PNG whose rows cycle through all five filter types, stored in uncompressed deflate blocks
+static std::vector<uint8_t> EncodePNG(const TextureData& image) {
+    const size_t stride = size_t(image.width) * 4;
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> previous(stride, 0);
+    for (int row = 0; row < image.height; ++row) {
+        // PNG stores the top row first
+        const uint8_t* current = &image.pixels[size_t(image.height - 1 - row) * stride];
+        const int filter = row % 5;
+        raw.push_back(static_cast<uint8_t>(filter));
+        for (size_t i = 0; i < stride; ++i) {
+            int left = i >= 4 ? current[i - 4] : 0;
+            int up = previous[i];
+            int upLeft = i >= 4 ? previous[i - 4] : 0;
+            int predictor = 0;
+            if (filter == 1) predictor = left;
+            else if (filter == 2) predictor = up;
+            else if (filter == 3) predictor = (left + up) / 2;
+            else if (filter == 4) {
+                int p = left + up - upLeft;
+                int pa = std::abs(p - left), pb = std::abs(p - up), pc = std::abs(p - upLeft);
+                predictor = pa <= pb && pa <= pc ? left : (pb <= pc ? up : upLeft);
+            }
+            raw.push_back(static_cast<uint8_t>(current[i] - predictor));
+        }
+        previous.assign(current, current + stride);
+    }
+
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    for (size_t offset = 0; offset < raw.size(); offset += 65535) {
+        size_t length = std::min<size_t>(65535, raw.size() - offset);
+        zlib.push_back(offset + length == raw.size() ? 1 : 0);
+        AppendLE16(zlib, static_cast<uint32_t>(length));
+        AppendLE16(zlib, static_cast<uint32_t>(~length & 0xFFFF));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    AppendBE32(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> png = {137, 80, 78, 71, 13, 10, 26, 10};
+    std::vector<uint8_t> header;
+    AppendBE32(header, static_cast<uint32_t>(image.width));
+    AppendBE32(header, static_cast<uint32_t>(image.height));
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+    AppendPNGChunk(png, "IHDR", header);
+    AppendPNGChunk(png, "IDAT", zlib);
+    AppendPNGChunk(png, "IEND", {});
+    return png;
+}
+
+// Type 2 (raw, 32-bit, top row first) or type 10 (RLE, 24-bit, bottom row first)
+static std::vector<uint8_t> EncodeTGA(const TextureData& image, bool rle) {
+    std::vector<uint8_t> tga = {0, 0, static_cast<uint8_t>(rle ? 10 : 2), 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    AppendLE16(tga, static_cast<uint32_t>(image.width));
+    AppendLE16(tga, static_cast<uint32_t>(image.height));
+    tga.push_back(rle ? 24 : 32);
+    tga.push_back(rle ? 0 : 8 | 0x20);
+    auto pixel = [&](size_t index) {
+        size_t x = index % image.width;
+        size_t y = index / image.width;
+        return &image.pixels[((rle ? y : image.height - 1 - y) * image.width + x) * 4];
+    };
+    const size_t count = size_t(image.width) * image.height;
+    for (size_t i = 0; i < count;) {
+        const uint8_t* p = pixel(i);
+        if (!rle) {
+            tga.insert(tga.end(), {p[2], p[1], p[0], p[3]});
+            ++i;
+            continue;
+        }
+        // Runs of equal pixels as repeat packets, everything else as one-pixel raw packets
+        size_t run = 1;
+        while (i + run < count && run < 128 && std::memcmp(pixel(i + run), p, 3) == 0) ++run;
+        tga.push_back(static_cast<uint8_t>(run > 1 ? 0x80 | (run - 1) : 0));
+        tga.insert(tga.end(), {p[2], p[1], p[0]});
+        i += run;
+    }
+    return tga;
+}
+
+// 24-bit BI_RGB, bottom row first with rows padded to four bytes
+static std::vector<uint8_t> EncodeBMP(const TextureData& image) {
+    const size_t stride = (size_t(image.width) * 3 + 3) & ~size_t(3);
+    std::vector<uint8_t> bmp = {'B', 'M'};
+    AppendLE32(bmp, static_cast<uint32_t>(54 + stride * image.height));
+    AppendLE32(bmp, 0);
+    AppendLE32(bmp, 54);
+    AppendLE32(bmp, 40);
+    AppendLE32(bmp, static_cast<uint32_t>(image.width));
+    AppendLE32(bmp, static_cast<uint32_t>(image.height));
+    AppendLE16(bmp, 1);
+    AppendLE16(bmp, 24);
+    for (int i = 0; i < 6; ++i) AppendLE32(bmp, 0);
+    for (int y = 0; y < image.height; ++y) {
+        size_t start = bmp.size();
+        for (int x = 0; x < image.width; ++x) {
+            const uint8_t* p = &image.pixels[(size_t(y) * image.width + x) * 4];
+            bmp.insert(bmp.end(), {p[2], p[1], p[0]});
+        }
+        bmp.resize(start + stride, 0);
+    }
+    return bmp;
+}
+
+// Every format decodes its encoded image exactly; truncated or corrupt files and zlib streams
+// fail without running away, including a dynamic Huffman stream cut short
+static bool runImageLoaderCheck(bool verbose) {
+    TextureData source = MakeImage(13, 7, [](int x, int y, unsigned char* p) {
+        p[0] = static_cast<unsigned char>(x * 19);
+        p[1] = static_cast<unsigned char>(y * 36);
+        p[2] = static_cast<unsigned char>(x < 6 ? 40 : 200);     // Runs for the RLE encoder
+        p[3] = static_cast<unsigned char>(255 - x * y * 3);
+    });
+    TextureData opaque = source;
+    for (size_t i = 3; i < opaque.pixels.size(); i += 4) {
+        opaque.pixels[i] = 255;
+    }
+
+    struct Encoded {
+        const char* name;
+        std::vector<uint8_t> bytes;
+        const TextureData* expected;
+    };
+    std::vector<Encoded> files = {{"png", EncodePNG(source), &source},
+                                  {"tga", EncodeTGA(source, false), &source},
+                                  {"tgaRLE", EncodeTGA(opaque, true), &opaque},
+                                  {"bmp", EncodeBMP(opaque), &opaque}};
+    bool roundTripOk = true;
+    bool truncatedOk = true;
+    for (const Encoded& file : files) {
+        TextureData decoded;
+        bool ok = ImageLoader::LoadFromMemory(file.bytes.data(), file.bytes.size(), decoded) &&
+                  decoded.width == file.expected->width && decoded.height == file.expected->height &&
+                  decoded.channels == 4 && decoded.pixels == file.expected->pixels;
+        roundTripOk = roundTripOk && ok;
+        if (verbose && !ok) {
+            std::cout << "ImageLoader: " << file.name << " round trip failed" << std::endl;
+        }
+        // A PNG may lose part of IEND and still be whole
+        size_t keep = std::strncmp(file.name, "png", 3) == 0 ? 12 : 0;
+        for (size_t length = 0; length + keep < file.bytes.size(); ++length) {
+            if (ImageLoader::LoadFromMemory(file.bytes.data(), length, decoded) || !decoded.pixels.empty()) {
+                truncatedOk = false;
+            }
+        }
+    }
+
+    // Corrupt headers must be rejected; random damage elsewhere must never yield a wrong size
+    bool corruptOk = true;
+    std::vector<uint8_t> png = files[0].bytes;
+    TextureData decoded;
+    std::vector<uint8_t> bad = png;
+    bad[8 + 8 + 9] = 5;                             // Color type 5 does not exist
+    corruptOk = corruptOk && !ImageLoader::LoadFromMemory(bad.data(), bad.size(), decoded);
+    bad = png;
+    bad[8 + 8 + 0] = 0x7F;                          // Width far beyond MaxDimension
+    corruptOk = corruptOk && !ImageLoader::LoadFromMemory(bad.data(), bad.size(), decoded);
+    bad = png;
+    bad[33 + 8] ^= 0x0F;                            // zlib header check bits
+    corruptOk = corruptOk && !ImageLoader::LoadFromMemory(bad.data(), bad.size(), decoded);
+    bad = files[3].bytes;
+    bad[28] = 16;                                   // 16-bit BMPs are not supported
+    corruptOk = corruptOk && !ImageLoader::LoadFromMemory(bad.data(), bad.size(), decoded);
+    std::mt19937 rng(48);
+    for (int i = 0; i < 500; ++i) {
+        const Encoded& file = files[i % files.size()];
+        bad = file.bytes;
+        for (int flips = 0; flips < 4; ++flips) {
+            bad[rng() % bad.size()] ^= static_cast<uint8_t>(1u << (rng() % 8));
+        }
+        if (ImageLoader::LoadFromMemory(bad.data(), bad.size(), decoded) &&
+            decoded.pixels.size() != size_t(decoded.width) * decoded.height * 4) {
+            corruptOk = false;
+        }
+    }
+
+    // Past its end the input reads as zero bits, which this stream's literal table decodes, so
+    // a cut stream has to be caught by the overrun check rather than by an end-of-block code
+    std::vector<uint8_t> expected = InflateSample();
+    std::vector<uint8_t> inflated;
+    bool inflateOk = ImageLoader::Inflate(DynamicZlibStream, sizeof(DynamicZlibStream), inflated, expected.size()) &&
+                     inflated == expected;
+    for (size_t length = 0; length + 4 < sizeof(DynamicZlibStream); ++length) {
+        bool decodedCut = ImageLoader::Inflate(DynamicZlibStream, length, inflated, 0);
+        inflateOk = inflateOk && !decodedCut && inflated.size() <= expected.size();
+    }
+    // expectedSize is a hard limit
+    inflateOk = inflateOk && !ImageLoader::Inflate(DynamicZlibStream, sizeof(DynamicZlibStream), inflated, expected.size() - 1) &&
+                inflated.size() < expected.size();
+
+    bool pass = roundTripOk && truncatedOk && corruptOk && inflateOk;
+    if (verbose) {
+        std::cout << "ImageLoader: roundTrip=" << (roundTripOk ? "ok" : "bad")
+                  << " truncated=" << (truncatedOk ? "rejected" : "accepted")
+                  << " corrupt=" << (corruptOk ? "ok" : "bad")
+                  << " inflate=" << (inflateOk ? "ok" : "bad")
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Replacing a mesh's geometry with the same vertex and index counts must rebuild its BLAS
+static bool runBLASCacheCheck(bool verbose) {
+    auto mesh = std::make_shared<Mesh>();
+    auto setQuad = [&](float height) {
+        mesh->SetVertices({Vertex(Vector3(-1.0f, height, -1.0f)), Vertex(Vector3(1.0f, height, -1.0f)),
+                           Vertex(Vector3(1.0f, height, 1.0f)), Vertex(Vector3(-1.0f, height, 1.0f))});
+        mesh->SetIndices({0, 1, 2, 0, 2, 3});
+    };
+    setQuad(0.0f);
+
+    World world;
+    Entity entity = world.CreateEntity();
+    world.AddComponent<TransformComponent>(entity);
+    world.AddComponent<MeshComponent>(entity, mesh);
+
+    RaytracingScene scene;
+    PreparedRay ray = PrepareRay(Ray(Vector3(0.2f, 10.0f, 0.3f), Vector3(0.0f, -1.0f, 0.0f)));
+    auto hitDistance = [&]() {
+        float distance = 100.0f;
+        HitInfo hit;
+        return scene.Intersect(ray, distance, hit) ? distance : -1.0f;
+    };
+    scene.Update(&world);
+    float before = hitDistance();
+    setQuad(4.0f);
+    scene.Update(&world);
+    float after = hitDistance();
+
+    bool pass = std::fabs(before - 10.0f) < 1e-4f && std::fabs(after - 6.0f) < 1e-4f && scene.GetCachedMeshCount() == 1;
+    if (verbose) {
+        std::cout << "BLASCache: before=" << before << " after=" << after
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+// Culling enough renderables to go through the WorkerPool returns the same ascending list as
+// testing every box
+static bool runVisibilityCullCheck(bool verbose) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    MakeGrid(1, vertices, indices);
+    auto mesh = std::make_shared<Mesh>();
+    mesh->SetVertices(vertices);
+    mesh->SetIndices(indices);
+
+    World world;
+    std::mt19937 rng(36);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int i = 0; i < 40000; ++i) {
+        Entity entity = world.CreateEntity();
+        auto* transform = world.AddComponent<TransformComponent>(entity);
+        transform->transform.SetPosition(Vector3(-200.0f + 400.0f * unit(rng), -20.0f + 40.0f * unit(rng), -200.0f + 400.0f * unit(rng)));
+        world.AddComponent<MeshComponent>(entity, mesh);
+    }
+    VisibilitySystem visibility;
+    visibility.Update(&world);
+
+    Matrix4 view = Matrix4::LookAt(Vector3(0.0f, 5.0f, 0.0f), Vector3(30.0f, 0.0f, -40.0f), Vector3(0.0f, 1.0f, 0.0f));
+    Matrix4 viewProjection = Matrix4::Perspective(1.2f, 16.0f / 9.0f, 0.1f, 150.0f) * view;
+    std::vector<uint32_t> visible;
+    visibility.Cull(viewProjection, visible);
+
+    Frustum frustum = Frustum::FromMatrix(viewProjection);
+    std::vector<uint32_t> expected;
+    const auto& renderables = visibility.GetRenderables();
+    for (size_t i = 0; i < renderables.size(); ++i) {
+        if (frustum.IntersectsAABB(renderables[i].boundsMin, renderables[i].boundsMax)) {
+            expected.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    bool pass = renderables.size() == 40000 && !visible.empty() && visible == expected;
+    if (verbose) {
+        std::cout << "VisibilityCull: renderables=" << renderables.size()
+                  << " visible=" << visible.size() << " expected=" << expected.size()
+                  << " pass=" << (pass ? "yes" : "no") << std::endl;
+    }
+    return pass;
+}
+
+
+int main(int argc, char** argv) { (void)argc; (void)argv;
+    bool verbose = true;
+    bool allPass = true;
+
+    bool passMatrix = runMatrixCompositionCheck(verbose);
+    if (!passMatrix) allPass = false;
+    bool passHierarchyVersion = runHierarchyVersionCheck(verbose);
+    if (!passHierarchyVersion) allPass = false;
+    bool passBakedBVH = runBakedBVHValidationCheck(verbose);
+    if (!passBakedBVH) allPass = false;
+    bool passBLASCache = runBLASCacheCheck(verbose);
+    if (!passBLASCache) allPass = false;
+    bool passVisibilityCull = runVisibilityCullCheck(verbose);
+    if (!passVisibilityCull) allPass = false;
+    bool passLightClusters = runLightClusterCheck(verbose);
+    if (!passLightClusters) allPass = false;
+    bool passTextureCompression = runTextureCompressionCheck(verbose);
+    if (!passTextureCompression) allPass = false;
+    bool passOBJParse = runOBJParseCheck(verbose);
+    if (!passOBJParse) allPass = false;
+    bool passMeshOptimizer = runMeshOptimizerCheck(verbose);
+    if (!passMeshOptimizer) allPass = false;
+    bool passCookedMesh = runCookedMeshCheck(verbose);
+    if (!passCookedMesh) allPass = false;
+    bool passVertexPacking = runVertexPackingCheck(verbose);
+    if (!passVertexPacking) allPass = false;
+    bool passMeshSimplifier = runMeshSimplifierCheck(verbose);
+    if (!passMeshSimplifier) allPass = false;
+    bool passTextureAtlas = runTextureAtlasCheck(verbose);
+    if (!passTextureAtlas) allPass = false;
+    bool passRenderQueue = runRenderQueueCheck(verbose);
+    if (!passRenderQueue) allPass = false;
+    bool passBVHIntersect = runBVHIntersectCheck(verbose);
+    if (!passBVHIntersect) allPass = false;
+    bool passImageLoader = runImageLoaderCheck(verbose);
+    if (!passImageLoader) allPass = false;
+
+    return allPass ? 0 : 1;
+}
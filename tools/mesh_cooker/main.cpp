@@ -0,0 +1,81 @@
+#include "../../src/Rendering/Loaders/CookedMesh.h"
+#include "../../src/Rendering/Loaders/OBJLoader.h"
+#include "../../src/Core/Logging/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Converts OBJ files (with their MTL colors) into cooked meshes:
+//   MeshCooker [--force] [--no-bvh] [--no-collision] [--format float|packed|quantized]
+//              [--lods <count>] <input.obj>... [-o <output.gmesh>]
+// Without -o each input is written next to itself as <input>.gmesh, which is where the
+// asset cache looks for it. Inputs whose cooked file is newer are skipped unless --force.
+// The vertex format defaults to the one the OBJ loader picks (packed, or float when UVs tile
+// beyond [0, 1]); quantized also stores positions as 16-bit values within the mesh bounds.
+// Up to three simplified LODs are generated unless --lods says otherwise.
+int main(int argc, char* argv[]) {
+    using namespace GameEngine;
+
+    CookedMesh::CookOptions options;
+    bool force = false;
+    bool formatGiven = false;
+    std::string output;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--force") {
+            force = true;
+        } else if (arg == "--no-bvh") {
+            options.bakeBVH = false;
+        } else if (arg == "--no-collision") {
+            options.bakeCollision = false;
+        } else if (arg == "--format" && i + 1 < argc) {
+            std::string format = argv[++i];
+            formatGiven = true;
+            if (format == "float") {
+                options.vertexFormat = VertexFormat::Float;
+            } else if (format == "packed") {
+                options.vertexFormat = VertexFormat::Packed;
+            } else if (format == "quantized") {
+                options.vertexFormat = VertexFormat::PackedQuantized;
+            } else {
+                std::cerr << "Unknown vertex format: " << format << std::endl;
+                return 2;
+            }
+        } else if (arg == "--lods" && i + 1 < argc) {
+            options.lodLevels = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty() || (!output.empty() && inputs.size() != 1)) {
+        std::cerr << "Usage: MeshCooker [--force] [--no-bvh] [--no-collision] [--format float|packed|quantized] "
+                     "[--lods <count>] <input.obj>... [-o <output.gmesh>]" << std::endl;
+        return 2;
+    }
+
+    int failures = 0;
+    for (const std::string& input : inputs) {
+        std::string target = output.empty() ? CookedMesh::GetCookedPath(input) : output;
+        if (!force && output.empty() && CookedMesh::IsUpToDate(input)) {
+            Logger::Info("Up to date: " + target);
+            continue;
+        }
+        Mesh mesh = OBJLoader::LoadFromFile(input);
+        if (!formatGiven) {
+            options.vertexFormat = mesh.GetVertexFormat();
+        }
+        if (mesh.GetVertexCount() == 0 || !CookedMesh::WriteToFile(target, mesh, options)) {
+            Logger::Error("Failed to cook " + input);
+            ++failures;
+        }
+    }
+
+    Logger::Shutdown();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include "../../src/Rendering/Loaders/CookedTexture.h"
+#include "../../src/Rendering/Loaders/ImageLoader.h"
+#include "../../src/Rendering/Core/TextureCompressor.h"
+#include "../../src/Rendering/Core/TextureAtlas.h"
+#include "../../src/Core/Logging/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Converts PNG, TGA and BMP images into cooked textures with a full mip chain:
+//   TextureCooker [--force] [--format rgba8|bc1|bc2|bc3|bc7] [--linear] [--filter box|kaiser]
+//                 [--no-mips] [--verify] <input>... [-o <output.gtex>]
+//   TextureCooker --atlas <output.atlas> [--padding <texels>] [--format ...] <input>...
+// Without -o each input is written next to itself as <input>.gtex, which is where
+// Texture::LoadFromFile looks for it. Inputs whose cooked file is newer are skipped unless
+// --force. BC7 is the default format. --linear is for normal maps and masks: their mips are
+// filtered as stored instead of in linear light. --verify reads the cooked file back, decodes
+// level 0 on the CPU and prints its PSNR against the source, failing below 30 dB.
+// --atlas packs every input into one TextureAtlas instead, writing its UV remap table to
+// <output.atlas> and the texture to <output.atlas>.gtex; regions are named by input path.
+namespace {
+    constexpr double MinimumPSNR = 30.0;
+
+    double ComputePSNR(const GameEngine::TextureData& a, const GameEngine::TextureData& b) {
+        double squaredError = 0.0;
+        for (size_t i = 0; i < a.pixels.size(); ++i) {
+            double delta = double(a.pixels[i]) - double(b.pixels[i]);
+            squaredError += delta * delta;
+        }
+        if (squaredError == 0.0) {
+            return INFINITY;
+        }
+        return 10.0 * std::log10(255.0 * 255.0 / (squaredError / double(a.pixels.size())));
+    }
+
+    bool Verify(const std::string& target, const GameEngine::TextureData& source) {
+        using namespace GameEngine;
+        TextureMipChain chain;
+        if (!CookedTexture::LoadFromFile(target, chain)) {
+            return false;
+        }
+        TextureData decoded;
+        if (chain.compression == TextureCompression::None) {
+            decoded.width = chain.width;
+            decoded.height = chain.height;
+            decoded.channels = 4;
+            decoded.pixels = chain.levels[0];
+        } else if (!TextureCompressor::Decompress(chain.levels[0].data(), chain.levels[0].size(), chain.width, chain.height,
+                                                  chain.compression, decoded)) {
+            return false;
+        }
+        // BC1 stores no alpha; compare it as opaque
+        TextureData reference = source;
+        if (chain.compression == TextureCompression::DXT1) {
+            for (size_t i = 3; i < reference.pixels.size(); i += 4) {
+                reference.pixels[i] = 255;
+            }
+        }
+        double psnr = ComputePSNR(reference, decoded);
+        char line[160];
+        std::snprintf(line, sizeof(line), "%s: %d levels, %zu bytes, level 0 PSNR %.2f dB", target.c_str(),
+                      static_cast<int>(chain.levels.size()), chain.GetByteSize(), psnr);
+        std::cout << line << std::endl;
+        return psnr >= MinimumPSNR;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    using namespace GameEngine;
+
+    CookedTexture::CookOptions options;
+    bool force = false;
+    bool verify = false;
+    std::string output;
+    std::string atlasOutput;
+    AtlasSettings atlasSettings;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--force") {
+            force = true;
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "--linear") {
+            options.mips.sRGB = false;
+        } else if (arg == "--no-mips") {
+            options.mips.maxLevels = 1;
+        } else if (arg == "--format" && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format == "rgba8") {
+                options.compression = TextureCompression::None;
+            } else if (format == "bc1") {
+                options.compression = TextureCompression::DXT1;
+            } else if (format == "bc2") {
+                options.compression = TextureCompression::DXT3;
+            } else if (format == "bc3") {
+                options.compression = TextureCompression::DXT5;
+            } else if (format == "bc7") {
+                options.compression = TextureCompression::BC7;
+            } else {
+                std::cerr << "Unknown texture format: " << format << std::endl;
+                return 2;
+            }
+        } else if (arg == "--filter" && i + 1 < argc) {
+            std::string filter = argv[++i];
+            if (filter == "box") {
+                options.mips.filter = MipFilter::Box;
+            } else if (filter == "kaiser") {
+                options.mips.filter = MipFilter::Kaiser;
+            } else {
+                std::cerr << "Unknown mip filter: " << filter << std::endl;
+                return 2;
+            }
+        } else if (arg == "--atlas" && i + 1 < argc) {
+            atlasOutput = argv[++i];
+        } else if (arg == "--padding" && i + 1 < argc) {
+            atlasSettings.padding = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty() || (!output.empty() && inputs.size() != 1)) {
+        std::cerr << "Usage: TextureCooker [--force] [--format rgba8|bc1|bc2|bc3|bc7] [--linear] [--filter box|kaiser] "
+                     "[--no-mips] [--verify] <input>... [-o <output.gtex>]\n"
+                     "       TextureCooker --atlas <output.atlas> [--padding <texels>] [--format ...] <input>..." << std::endl;
+        return 2;
+    }
+
+    if (!atlasOutput.empty()) {
+        TextureAtlas atlas;
+        bool cooked = atlas.BuildFromFiles(inputs, atlasSettings) && atlas.WriteToFile(atlasOutput, options.compression);
+        if (!cooked) {
+            Logger::Error("Failed to cook atlas " + atlasOutput);
+        }
+        Logger::Shutdown();
+        return cooked ? 0 : 1;
+    }
+
+    int failures = 0;
+    for (const std::string& input : inputs) {
+        std::string target = output.empty() ? CookedTexture::GetCookedPath(input) : output;
+        if (!force && !verify && output.empty() && CookedTexture::IsUpToDate(input)) {
+            Logger::Info("Up to date: " + target);
+            continue;
+        }
+        TextureData image;
+        TextureMipChain chain;
+        if (!ImageLoader::LoadFromFile(input, image) || !CookedTexture::BuildMipChain(image, options, chain) ||
+            !CookedTexture::WriteToFile(target, chain)) {
+            Logger::Error("Failed to cook " + input);
+            ++failures;
+            continue;
+        }
+        if (verify && !Verify(target, image)) {
+            Logger::Error("Verification failed for " + target);
+            ++failures;
+        }
+    }
+
+    Logger::Shutdown();
+    return failures == 0 ? 0 : 1;
+}